@@ -35,6 +35,7 @@ cmake -D CMAKE_BUILD_TYPE:STRING=RELEASE \
       -D Trilinos_ENABLE_Ifpack2=ON \
       -D Trilinos_ENABLE_Zoltan2=ON \
       -D Trilinos_ENABLE_Anasazi=ON \
+      -D Tpetra_INST_FLOAT=ON \
       -D MueLu_ENABLE_TESTS=OFF \
       -D Trilinos_ENABLE_ALL_PACKAGES=OFF \
       -D Trilinos_ENABLE_ALL_OPTIONAL_PACKAGES=OFF \
@@ -69,6 +69,7 @@ cmake -D CMAKE_BUILD_TYPE=RELEASE \
       -D Trilinos_ENABLE_Ifpack2=ON \
       -D Trilinos_ENABLE_Zoltan2=ON \
       -D Trilinos_ENABLE_Anasazi=ON \
+      -D Tpetra_INST_FLOAT=ON \
       -D MueLu_ENABLE_TESTS=OFF \
       -D Kokkos_ENABLE_TESTS=OFF \
       -D Trilinos_ENABLE_ALL_PACKAGES=OFF -DTrilinos_ENABLE_ALL_OPTIONAL_PACKAGES=OFF -DTrilinos_ENABLE_TESTS=OFF \
@@ -0,0 +1,87 @@
+#!/bin/bash -e
+show_help() {
+    echo "Usage: $(basename "$0") [OPTION]"
+    echo "Compares the corner_gather and atomic_scatter node force modes of the SGH solver"
+    echo "Valid options:"
+    echo "  --fierro=<path>. Path to a Fierro executable built with the Kokkos OpenMP backend. Default is '\${SGH_BUILD_DIR}/src/Fierro'"
+    echo "  --input=<path>. Input file the benchmark decks are made from. Default is '\${SGH_BASE_DIR}/input.yaml'"
+    echo "  --num_elems=<Integers greater than 0>. Elements along each edge of the generated box. Default is 64"
+    echo "  --threads=<Integers greater than 0>. Number of OpenMP threads. Default is all cores"
+    echo "  --help: Display this help message"
+    echo " "
+    echo "Each mode runs in its own directory under ./force_mode_benchmark and the get_force and"
+    echo "update_velocity times are read back from its perf_report.json"
+    return 1
+}
+
+fierro="${SGH_BUILD_DIR}/src/Fierro"
+input="${SGH_BASE_DIR}/input.yaml"
+num_elems="64"
+threads=$(nproc)
+
+for arg in "$@"; do
+    case "$arg" in
+        --fierro=*)
+            fierro="${arg#*=}"
+            ;;
+        --input=*)
+            input="${arg#*=}"
+            ;;
+        --num_elems=*)
+            num_elems="${arg#*=}"
+            ;;
+        --threads=*)
+            threads="${arg#*=}"
+            ;;
+        --help)
+            show_help
+            exit 1
+            ;;
+        *)
+            echo "Error: Invalid argument or value specified."
+            show_help
+            exit 1
+            ;;
+    esac
+done
+
+if [ ! -x "$fierro" ]; then
+    echo "Error: Fierro executable not found at $fierro"
+    exit 1
+fi
+
+export OMP_NUM_THREADS=$threads
+export OMP_PROC_BIND=spread
+export OMP_PLACES=threads
+
+benchdir=$(pwd)/force_mode_benchmark
+mkdir -p "$benchdir"
+
+# seconds spent in a timer region, summed over the region paths ending in its name
+region_time() {
+    grep "/$2\"" "$1" | sed 's/.*"total_s": \([^,]*\),.*/\1/' | awk '{ sum += $1 } END { printf "%.4e", sum }'
+}
+
+for mode in corner_gather atomic_scatter; do
+    rundir="$benchdir/$mode"
+    mkdir -p "$rundir"
+
+    # same deck for both modes, only the force mode differs
+    sed -e "s/^dynamic_options:/dynamic_options:\n    node_force_mode: $mode/" \
+        -e "s/num_elems: \[.*\]/num_elems: [$num_elems, $num_elems, $num_elems]/" \
+        -e "s/timer_output_level: .*/timer_output_level: thorough/" \
+        "$input" > "$rundir/input.yaml"
+
+    echo "Running $mode with $OMP_NUM_THREADS threads on a ${num_elems}^3 box"
+    (cd "$rundir" && "$fierro" input.yaml > fierro.log 2>&1)
+done
+
+echo " "
+printf "%-16s %14s %18s %14s\n" "mode" "get_force (s)" "update_velocity (s)" "run (s)"
+for mode in corner_gather atomic_scatter; do
+    report="$benchdir/$mode/perf_report.json"
+    printf "%-16s %14s %18s %14s\n" "$mode" \
+        "$(region_time "$report" get_force)" \
+        "$(region_time "$report" update_velocity)" \
+        "$(grep "\"run\"" "$report" | sed 's/.*"total_s": \([^,]*\),.*/\1/')"
+done
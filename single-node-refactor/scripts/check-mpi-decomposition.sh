@@ -0,0 +1,100 @@
+#!/bin/bash -e
+show_help() {
+    echo "Usage: $(basename "$0") [OPTION]"
+    echo "Checks that a decomposed SGH run matches the single rank run of the same deck"
+    echo "Valid options:"
+    echo "  --fierro=<path>. Path to a Fierro executable built with ENABLE_MPI=ON. Default is '\${SGH_BUILD_DIR}/src/Fierro'"
+    echo "  --input=<path>. Input file to run. Default is '\${SGH_BASE_DIR}/input.yaml'"
+    echo "  --ranks=<Integers greater than 1>. Number of MPI ranks of the decomposed run. Default is 4"
+    echo "  --tolerance=<Number>. Largest allowed difference of KE, IE and TE relative to the single rank TE. Default is 1e-5"
+    echo "  --mpirun=<command>. MPI launcher. Default is 'mpirun'"
+    echo "  --help: Display this help message"
+    echo " "
+    echo "Each run goes in its own directory under ./mpi_decomposition_check and the end energies"
+    echo "are read back from its log. The sums are taken in a different order on each rank count,"
+    echo "so the energies agree to round-off, not bitwise."
+    return 1
+}
+
+fierro="${SGH_BUILD_DIR}/src/Fierro"
+input="${SGH_BASE_DIR}/input.yaml"
+ranks="4"
+tolerance="1e-5"
+mpirun="mpirun"
+
+for arg in "$@"; do
+    case "$arg" in
+        --fierro=*)
+            fierro="${arg#*=}"
+            ;;
+        --input=*)
+            input="${arg#*=}"
+            ;;
+        --ranks=*)
+            ranks="${arg#*=}"
+            ;;
+        --tolerance=*)
+            tolerance="${arg#*=}"
+            ;;
+        --mpirun=*)
+            mpirun="${arg#*=}"
+            ;;
+        --help)
+            show_help
+            exit 1
+            ;;
+        *)
+            echo "Error: Invalid argument or value specified."
+            show_help
+            exit 1
+            ;;
+    esac
+done
+
+if [ ! -x "$fierro" ]; then
+    echo "Error: Fierro executable not found at $fierro"
+    exit 1
+fi
+
+checkdir=$(pwd)/mpi_decomposition_check
+mkdir -p "$checkdir"
+
+# KE, IE and TE printed by rank 0 at the end of the run
+end_energies() {
+    grep "Time=End:" "$1" | tail -1 | sed 's/.*KE = \([^,]*\), IE = \([^,]*\), TE = \([^ ]*\).*/\1 \2 \3/'
+}
+
+for np in 1 "$ranks"; do
+    rundir="$checkdir/np$np"
+    mkdir -p "$rundir"
+    cp "$input" "$rundir/input.yaml"
+
+    echo "Running $(basename "$input") on $np rank(s)"
+    (cd "$rundir" && "$mpirun" -np "$np" "$fierro" input.yaml > fierro.log 2>&1)
+done
+
+serial=$(end_energies "$checkdir/np1/fierro.log")
+decomposed=$(end_energies "$checkdir/np$ranks/fierro.log")
+
+if [ -z "$serial" ] || [ -z "$decomposed" ]; then
+    echo "Error: end energies not found, see the logs in $checkdir"
+    exit 1
+fi
+
+echo " "
+printf "%-10s %16s %16s %16s\n" "ranks" "KE" "IE" "TE"
+printf "%-10s %16s %16s %16s\n" "1" $serial
+printf "%-10s %16s %16s %16s\n" "$ranks" $decomposed
+
+echo "$serial $decomposed $tolerance" | awk '{
+    scale = ($3 < 0) ? -$3 : $3
+    if (scale == 0) scale = 1
+    worst = 0
+    for (i = 1; i <= 3; i++) {
+        diff = $i - $(i + 3)
+        if (diff < 0) diff = -diff
+        if (diff / scale > worst) worst = diff / scale
+    }
+    printf "Largest relative difference %.3e, tolerance %s\n", worst, $7
+    exit (worst > $7) ? 1 : 0
+}' && echo "PASS" || { echo "FAIL: the decomposed run depends on the rank count"; exit 1; }
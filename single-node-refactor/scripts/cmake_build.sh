@@ -20,6 +20,20 @@ else
     echo "Error: Solver not supported."
 fi
 
+# MPI domain decomposition, run with mpirun -n <ranks> Fierro input.yaml
+if [ "${SGH_ENABLE_MPI}" = "ON" ]; then
+    cmake_options+=(
+        -D ENABLE_MPI=ON
+    )
+fi
+
+# Python module, import pyfierro from the build directory
+if [ "${SGH_BUILD_PYTHON}" = "ON" ]; then
+    cmake_options+=(
+        -D BUILD_PYTHON_MODULE=ON
+    )
+fi
+
 # Print CMake options for reference
 echo "CMake Options: ${cmake_options[@]}"
 
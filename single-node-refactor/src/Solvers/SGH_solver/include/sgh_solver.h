@@ -38,12 +38,21 @@
 #include "matar.h"
 #include "solver.h"
 #include "geometry_new.h"
+#include "elem_topology.h"
 // #include "io_utils.h"
 
 #include "simulation_parameters.h"
 
+#include <stdexcept>
+#include <vector>
+
 using namespace mtr; // matar namespace
 
+// stream compaction of a flag array, defined in active_lists.cpp
+long compact_active(const CArrayKokkos<size_t>& flags,
+    const DCArrayKokkos<size_t>& list,
+    const size_t num_entries);
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /// \class SGH
@@ -75,6 +84,77 @@ public:
     int rk_num_stages = 2;
     int cycle_stop    = 1000000000;
 
+    int rk_fused_kernels = 0; // 1 = use the fused element and node passes (3D only)
+
+    int simd_force_kernel = 0; // 1 = use the SIMD-packed corner force kernel (3D only)
+
+    // kernels specialised on the element topology, picked once in setup from the mesh
+    using timestep_kernel_t = void (SGH::*)(mesh_t&,
+                                            DCArrayKokkos<double>&, DCArrayKokkos<double>&,
+                                            DCArrayKokkos<double>&, DCArrayKokkos<double>&,
+                                            double, const double, const double, const double,
+                                            const double, const double, double&, const double,
+                                            const size_t);
+
+    using state_kernel_t = void (SGH::*)(const CArrayKokkos<material_t>&, const mesh_t&,
+                                         const DCArrayKokkos<double>&, const DCArrayKokkos<double>&,
+                                         DCArrayKokkos<double>&, DCArrayKokkos<double>&,
+                                         DCArrayKokkos<double>&, DCArrayKokkos<double>&,
+                                         const DCArrayKokkos<double>&, const DCArrayKokkos<double>&,
+                                         const DCArrayKokkos<double>&, const DCArrayKokkos<size_t>&,
+                                         const DCArrayKokkos<double>&, const double, const double,
+                                         const DCArrayKokkos<size_t>&, const long, const size_t);
+
+    timestep_kernel_t get_timestep_kernel = nullptr;
+    state_kernel_t    update_state_kernel = nullptr;
+
+    integrator::scheme time_integrator = integrator::rk;
+
+    force_assembly::mode node_force_mode = force_assembly::corner_gather;
+
+    int lts_num_levels = 1; // number of local time step levels, 1 = global time step (3D only)
+
+    // local time stepping data, the lists hold the elems and nodes of each level
+    CArrayKokkos<double> lts_elem_dt;
+    DCArrayKokkos<size_t> lts_elem_level;
+    DCArrayKokkos<size_t> lts_node_level;
+    CArrayKokkos<double> lts_corner_work;
+    std::vector<DCArrayKokkos<size_t>> lts_elem_lists;
+    std::vector<DCArrayKokkos<size_t>> lts_node_lists;
+    std::vector<size_t> lts_num_elems_in_level;
+    std::vector<size_t> lts_num_nodes_in_level;
+
+    int active_list_ival = 0; // cycles between active list rebuilds, 0 = sweep every element (3D only)
+
+    // compacted active elems and nodes, the counts are -1 until the first build
+    DCArrayKokkos<size_t> active_elem_list;
+    DCArrayKokkos<size_t> active_node_list;
+    CArrayKokkos<size_t> elem_active;
+    CArrayKokkos<size_t> node_active;
+    long num_active_elems = -1;
+    long num_active_nodes = -1;
+
+    // contact surface, gathered from the contact boundary sets before the first cycle
+    bool contact_initialized = false;
+    size_t num_contact_sets    = 0;
+    size_t num_contact_patches = 0;
+    size_t num_contact_nodes   = 0;
+    DCArrayKokkos<size_t> contact_patches;
+    DCArrayKokkos<size_t> contact_nodes;
+    CArrayKokkos<double> contact_patch_sign;   // orients each patch normal out of its elem
+    CArrayKokkos<double> contact_build_coords; // contact node positions at the last bin build
+    CArrayKokkos<double> contact_dvel;         // summed contact velocity corrections
+
+    // uniform bins of contact patches, rebuilt when a node moves past half the margin
+    CArrayKokkos<size_t> contact_bin_start;
+    CArrayKokkos<size_t> contact_bin_count;
+    CArrayKokkos<size_t> contact_bin_patches;
+    double contact_bin_origin[3] = { 0.0, 0.0, 0.0 };
+    double contact_bin_size = 0.0;
+    double contact_margin   = 0.0;
+    size_t contact_num_bins[3] = { 1, 1, 1 };
+    size_t contact_num_builds  = 0;
+
     SGH()  : Solver()
     {
     }
@@ -106,6 +186,18 @@ public:
 
         rk_num_stages = sim_param.dynamic_options.rk_num_stages;
 
+        rk_fused_kernels = sim_param.dynamic_options.rk_fused_kernels;
+
+        simd_force_kernel = sim_param.dynamic_options.simd_force_kernel;
+
+        time_integrator = sim_param.dynamic_options.time_integrator;
+
+        node_force_mode = sim_param.dynamic_options.node_force_mode;
+
+        lts_num_levels = sim_param.dynamic_options.lts_num_levels;
+
+        active_list_ival = sim_param.dynamic_options.active_list_ival;
+
         cycle_stop = sim_param.dynamic_options.cycle_stop;
 
         // initialize time, time_step, and cycles
@@ -128,6 +220,8 @@ public:
     {
         std::cout << "INSIDE SETUP FOR SGH SOLVER" << std::endl;
 
+        set_topology_kernels(mesh);
+
         std::cout << "Applying initial boundary conditions" << std::endl;
         boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, time_value);
     }
@@ -143,6 +237,44 @@ public:
     void execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node, elem_t& elem, corner_t& corner) override;
 
 
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn set_topology_kernels
+    ///
+    /// \brief Picks the kernel instantiations for the element topology of the mesh
+    ///
+    /// \param The simulation mesh
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void set_topology_kernels(const mesh_t& mesh)
+    {
+        switch (topology::get_elem_kind(mesh.num_dims, mesh.num_nodes_in_elem)) {
+            case topology::quad4_elem:
+                select_kernels<topology::quad4>();
+                break;
+            case topology::hex8_elem:
+                select_kernels<topology::hex8>();
+                break;
+            case topology::hex27_elem:
+            case topology::hex64_elem:
+                // the force, divergence, volume and velocity gradient kernels assume 8 node hexes
+                std::cout << "ERROR: SGH only supports linear hexes; the mesh has "
+                          << mesh.num_nodes_in_elem << " nodes per element" << std::endl;
+                throw std::runtime_error("**** HIGH ORDER HEXES NOT SUPPORTED BY SGH ****");
+            default:
+                std::cout << "ERROR: no SGH kernels for " << mesh.num_dims << "D elements with "
+                          << mesh.num_nodes_in_elem << " nodes" << std::endl;
+                throw std::runtime_error("**** ELEMENT TYPE NOT SUPPORTED BY SGH ****");
+        } // end switch
+    }
+
+    template <typename Topology>
+    void select_kernels()
+    {
+        get_timestep_kernel = &SGH::get_timestep<Topology>;
+        update_state_kernel = &SGH::update_state<Topology>;
+    }
+
     void finalize(simulation_parameters_t& sim_param) override
     {
         // Any finalize goes here, remove allocated memory, etc
@@ -153,14 +285,28 @@ public:
         const mesh_t& mesh,
         const CArrayKokkos<boundary_condition_t>& boundary,
         DCArrayKokkos<double>& node_vel,
-        const double time_value);
+        const double time_value,
+        const size_t rk_bin = 1);
 
     void boundary_contact(
         const mesh_t& mesh,
         const CArrayKokkos<boundary_condition_t>& boundary,
+        const DCArrayKokkos<double>& node_coords,
         DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& node_mass,
+        const double dt,
+        const bool   trapezoid,
         const double time_value);
 
+    void contact_setup(
+        const mesh_t& mesh,
+        const CArrayKokkos<boundary_condition_t>& boundary,
+        const DCArrayKokkos<double>& node_coords);
+
+    void contact_build_bins(
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_coords);
+
     // **** Functions defined in energy_sgh.cpp **** //
     void update_energy(
         double rk_alpha,
@@ -170,7 +316,10 @@ public:
         const DCArrayKokkos<double>& node_coords,
         DCArrayKokkos<double>& elem_sie,
         const DCArrayKokkos<double>& elem_mass,
-        const DCArrayKokkos<double>& corner_force);
+        const DCArrayKokkos<double>& corner_force,
+        const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+        const long num_list_elems = -1,
+        const size_t rk_bin = 1);
 
     // **** Functions defined in force_sgh.cpp **** //
     void get_force(
@@ -191,7 +340,11 @@ public:
         const double small,
         const DCArrayKokkos<double>& elem_statev,
         const double dt,
-        const double rk_alpha);
+        const double rk_alpha,
+        const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+        const long num_list_elems = -1,
+        const DCArrayKokkos<double>& node_force = DCArrayKokkos<double>(),
+        const size_t rk_bin = 1);
 
     void get_force_2D(
         const CArrayKokkos<material_t>& material,
@@ -213,6 +366,89 @@ public:
         const double dt,
         const double rk_alpha);
 
+    // **** Functions defined in force_sgh_simd.cpp **** //
+    void get_force_simd(
+        const CArrayKokkos<material_t>& material,
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& elem_den,
+        const DCArrayKokkos<double>& elem_sie,
+        const DCArrayKokkos<double>& elem_pres,
+        const DCArrayKokkos<double>& elem_stress,
+        const DCArrayKokkos<double>& elem_sspd,
+        const DCArrayKokkos<double>& elem_vol,
+        const DCArrayKokkos<double>& elem_div,
+        const DCArrayKokkos<size_t>& elem_mat_id,
+        DCArrayKokkos<double>& corner_force,
+        const double fuzz,
+        const double small,
+        const DCArrayKokkos<double>& elem_statev,
+        const double dt,
+        const double rk_alpha,
+        const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+        const long num_list_elems = -1,
+        const DCArrayKokkos<double>& node_force = DCArrayKokkos<double>(),
+        const size_t rk_bin = 1);
+
+    // **** Functions defined in fused_sgh.cpp **** //
+    void get_force_fused(
+        const CArrayKokkos<material_t>& material,
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& elem_den,
+        const DCArrayKokkos<double>& elem_sie,
+        const DCArrayKokkos<double>& elem_pres,
+        const DCArrayKokkos<double>& elem_stress,
+        const DCArrayKokkos<double>& elem_sspd,
+        const DCArrayKokkos<double>& elem_vol,
+        const DCArrayKokkos<double>& elem_div,
+        const CArrayKokkos<double>&  elem_div_new,
+        const DCArrayKokkos<size_t>& elem_mat_id,
+        DCArrayKokkos<double>& corner_force,
+        const double fuzz,
+        const double small,
+        const DCArrayKokkos<double>& elem_statev,
+        const double dt,
+        const double rk_alpha);
+
+    void update_velocity_position_fused(
+        double rk_alpha,
+        double dt,
+        const mesh_t& mesh,
+        DCArrayKokkos<double>& node_coords,
+        DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& node_mass,
+        const DCArrayKokkos<double>& corner_force);
+
+    void boundary_position(
+        double rk_alpha,
+        double dt,
+        const mesh_t& mesh,
+        DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& node_vel);
+
+    void update_energy_state_fused(
+        const CArrayKokkos<material_t>& material,
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& node_vel,
+        DCArrayKokkos<double>& elem_den,
+        DCArrayKokkos<double>& elem_pres,
+        DCArrayKokkos<double>& elem_stress,
+        DCArrayKokkos<double>& elem_sspd,
+        DCArrayKokkos<double>& elem_sie,
+        DCArrayKokkos<double>& elem_vol,
+        const DCArrayKokkos<double>& elem_mass,
+        DCArrayKokkos<double>& elem_div,
+        const CArrayKokkos<double>&  elem_div_new,
+        const DCArrayKokkos<size_t>& elem_mat_id,
+        const DCArrayKokkos<double>& elem_statev,
+        const DCArrayKokkos<double>& corner_force,
+        const double dt,
+        const double rk_alpha);
+
     // **** Functions defined in geometry.cpp **** //
     void update_position(
         double rk_alpha,
@@ -220,7 +456,10 @@ public:
         const size_t num_dims,
         const size_t num_nodes,
         DCArrayKokkos<double>& node_coords,
-        const DCArrayKokkos<double>& node_vel);
+        const DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<size_t>& node_list = DCArrayKokkos<size_t>(),
+        const long num_list_nodes = -1,
+        const size_t rk_bin = 1);
 
     // **** Functions defined in momentum.cpp **** //
     void update_velocity(
@@ -229,7 +468,11 @@ public:
         const mesh_t& mesh,
         DCArrayKokkos<double>& node_vel,
         const DCArrayKokkos<double>& node_mass,
-        const DCArrayKokkos<double>& corner_force);
+        const DCArrayKokkos<double>& corner_force,
+        const DCArrayKokkos<size_t>& node_list = DCArrayKokkos<size_t>(),
+        const long num_list_nodes = -1,
+        const DCArrayKokkos<double>& assembled_node_force = DCArrayKokkos<double>(),
+        const size_t rk_bin = 1);
 
     KOKKOS_FUNCTION
     void get_velgrad(
@@ -238,7 +481,8 @@ public:
         const DCArrayKokkos<double>&    node_vel,
         const ViewCArrayKokkos<double>& b_matrix,
         const double elem_vol,
-        const size_t elem_gid);
+        const size_t elem_gid,
+        const size_t rk_bin = 1);
 
     KOKKOS_FUNCTION
     void get_velgrad2D(
@@ -255,7 +499,10 @@ public:
         const mesh_t mesh,
         const DCArrayKokkos<double>& node_coords,
         const DCArrayKokkos<double>& node_vel,
-        const DCArrayKokkos<double>& elem_vol);
+        const DCArrayKokkos<double>& elem_vol,
+        const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+        const long num_list_elems = -1,
+        const size_t rk_bin = 1);
 
     void get_divergence2D(
         DCArrayKokkos<double>& elem_div,
@@ -276,6 +523,7 @@ public:
         const double vol);
 
     // **** Functions defined in properties.cpp **** //
+    template <typename Topology>
     void update_state(
         const CArrayKokkos<material_t>& material,
         const mesh_t& mesh,
@@ -291,24 +539,10 @@ public:
         const DCArrayKokkos<size_t>& elem_mat_id,
         const DCArrayKokkos<double>& elem_statev,
         const double dt,
-        const double rk_alpha);
-
-    void update_state2D(
-        const CArrayKokkos<material_t>& material,
-        const mesh_t& mesh,
-        const DCArrayKokkos<double>& node_coords,
-        const DCArrayKokkos<double>& node_vel,
-        DCArrayKokkos<double>& elem_den,
-        DCArrayKokkos<double>& elem_pres,
-        DCArrayKokkos<double>& elem_stress,
-        DCArrayKokkos<double>& elem_sspd,
-        const DCArrayKokkos<double>& elem_sie,
-        const DCArrayKokkos<double>& elem_vol,
-        const DCArrayKokkos<double>& elem_mass,
-        const DCArrayKokkos<size_t>& elem_mat_id,
-        const DCArrayKokkos<double>& elem_statev,
-        const double dt,
-        const double rk_alpha);
+        const double rk_alpha,
+        const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+        const long num_list_elems = -1,
+        const size_t rk_bin = 1);
 
     // **** Functions defined in time_integration.cpp **** //
     // NOTE: Consider pulling up
@@ -319,8 +553,50 @@ public:
         DCArrayKokkos<double>& elem_stress,
         const size_t num_dims,
         const size_t num_elems,
-        const size_t num_nodes);
+        const size_t num_nodes,
+        const size_t rk_bin = 0);
+
+    void rk_init_stress(
+        DCArrayKokkos<double>& elem_stress,
+        const size_t num_elems,
+        const size_t rk_bin);
+
+    void rk_sync(
+        const mesh_t& mesh,
+        node_t& node,
+        elem_t& elem,
+        size_t& rk_bin);
+
+    size_t get_lsrk_coefficients(
+        const integrator::scheme scheme,
+        double* lsrk_A,
+        double* lsrk_B,
+        double* lsrk_C);
+
+    void lsrk_update_energy(
+        const double lsrk_A,
+        const double lsrk_B,
+        const double dt,
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_vel,
+        const CArrayKokkos<double>&  node_vel_start,
+        const DCArrayKokkos<double>& node_coords,
+        DCArrayKokkos<double>& elem_sie,
+        const DCArrayKokkos<double>& elem_mass,
+        const DCArrayKokkos<double>& corner_force);
+
+    void lsrk_update_nodes(
+        const double lsrk_A,
+        const double lsrk_B,
+        const double dt,
+        const mesh_t& mesh,
+        DCArrayKokkos<double>& node_coords,
+        DCArrayKokkos<double>& node_vel,
+        CArrayKokkos<double>&  node_vel_start,
+        const DCArrayKokkos<double>& node_mass,
+        const DCArrayKokkos<double>& corner_force);
 
+    template <typename Topology>
     void get_timestep(
         mesh_t& mesh,
         DCArrayKokkos<double>& node_coords,
@@ -334,14 +610,16 @@ public:
         const double dt_min,
         const double dt_cfl,
         double&      dt,
-        const double fuzz);
+        const double fuzz,
+        const size_t rk_bin = 1);
 
-    void get_timestep2D(
-        mesh_t& mesh,
-        DCArrayKokkos<double>& node_coords,
-        DCArrayKokkos<double>& node_vel,
-        DCArrayKokkos<double>& elem_sspd,
-        DCArrayKokkos<double>& elem_vol,
+    // **** Functions defined in local_time_stepping.cpp **** //
+    void lts_setup(const mesh_t& mesh);
+
+    void get_lts_timestep(
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& elem_sspd,
         double time_value,
         const double graphics_time,
         const double time_final,
@@ -351,6 +629,59 @@ public:
         double&      dt,
         const double fuzz);
 
+    void lts_sort_levels(const mesh_t& mesh);
+
+    void lts_advance(
+        simulation_parameters_t& sim_param,
+        mesh_t& mesh,
+        node_t& node,
+        elem_t& elem,
+        corner_t& corner,
+        const double time_value,
+        const double dt);
+
+    void lts_update_velocity(
+        const double rk_alpha,
+        const double dt,
+        const bool   step_start,
+        const mesh_t& mesh,
+        const DCArrayKokkos<size_t>& node_list,
+        const size_t num_list_nodes,
+        DCArrayKokkos<double>& node_coords,
+        DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& node_mass,
+        const DCArrayKokkos<double>& corner_force);
+
+    void lts_update_position(
+        const double rk_alpha,
+        const double dt,
+        const bool   tally_work,
+        const mesh_t& mesh,
+        const DCArrayKokkos<size_t>& node_list,
+        const size_t num_list_nodes,
+        DCArrayKokkos<double>& node_coords,
+        const DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& corner_force,
+        CArrayKokkos<double>& corner_work);
+
+    void lts_update_energy(
+        const mesh_t& mesh,
+        const DCArrayKokkos<size_t>& elem_list,
+        const size_t num_list_elems,
+        const DCArrayKokkos<double>& node_coords,
+        DCArrayKokkos<double>& elem_sie,
+        const DCArrayKokkos<double>& elem_vol,
+        const DCArrayKokkos<double>& elem_mass,
+        CArrayKokkos<double>& corner_work);
+
+    // **** Functions defined in active_lists.cpp **** //
+    void build_active_lists(
+        const mesh_t& mesh,
+        const DCArrayKokkos<double>& node_vel,
+        const DCArrayKokkos<double>& elem_den,
+        const DCArrayKokkos<double>& elem_pres,
+        const size_t num_halo_layers);
+
     // **** Functions defined in user_mat.cpp **** //
     // NOTE: Pull up into high level
     KOKKOS_FUNCTION
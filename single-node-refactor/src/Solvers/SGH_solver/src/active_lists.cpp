@@ -0,0 +1,169 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#include "sgh_solver.h"
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn compact_active
+///
+/// \brief Stream compaction of a flag array, the ids of the flagged entries
+///        are written in order to the front of the list
+///
+/// \param Flag per entry, nonzero is kept
+/// \param List to fill, sized for every entry
+/// \param Number of entries
+///
+/// \return Number of flagged entries
+///
+/////////////////////////////////////////////////////////////////////////////
+long compact_active(const CArrayKokkos<size_t>& flags,
+    const DCArrayKokkos<size_t>& list,
+    const size_t num_entries)
+{
+    size_t num_active = 0;
+
+    Kokkos::parallel_scan("compact_active", Kokkos::RangePolicy<>(0, num_entries),
+        KOKKOS_LAMBDA(const size_t gid, size_t& offset, const bool final) {
+        if (flags(gid) != 0) {
+            if (final) {
+                list(offset) = gid;
+            }
+            offset++;
+        }
+    }, num_active);
+    Kokkos::fence();
+
+    return (long)num_active;
+} // end compact_active
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn build_active_lists
+///
+/// \brief Rebuilds the lists of elements and nodes the SGH kernels update.
+///        An element is a source when it holds non-void material and a node
+///        is moving or its pressure differs from a neighbor.  The sources
+///        are grown by halo layers of node-connected elements so a wave
+///        can not leave the active region before the next rebuild.
+///        Inactive elements keep their last corner forces, which stay valid
+///        while their nodes are at rest.
+///
+/// \param The simulation mesh
+/// \param View of nodal velocity data
+/// \param View of element density
+/// \param View of element pressure
+/// \param Number of halo layers around the source elements
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::build_active_lists(const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& elem_den,
+    const DCArrayKokkos<double>& elem_pres,
+    const size_t num_halo_layers)
+{
+    if (num_active_elems < 0) {
+        active_elem_list = DCArrayKokkos<size_t>(mesh.num_elems);
+        active_node_list = DCArrayKokkos<size_t>(mesh.num_nodes);
+        elem_active = CArrayKokkos<size_t>(mesh.num_elems);
+        node_active = CArrayKokkos<size_t>(mesh.num_nodes);
+    }
+
+    auto elem_flag = elem_active;
+    auto node_flag = node_active;
+
+    const double tiny_  = tiny;
+    const double small_ = small;
+
+    // ---- flag the source elements ----
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        size_t active = 0;
+
+        // void material is never a source
+        if (elem_den(elem_gid) > tiny_) {
+            for (size_t node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
+                const size_t node_gid = mesh.nodes_in_elem(elem_gid, node_lid);
+
+                double speed_sqrd = 0.0;
+                for (size_t dim = 0; dim < mesh.num_dims; dim++) {
+                    speed_sqrd += node_vel(1, node_gid, dim) * node_vel(1, node_gid, dim);
+                }
+                if (speed_sqrd > small_ * small_) {
+                    active = 1;
+                }
+            } // end for node_lid
+
+            for (size_t neighbor_lid = 0; neighbor_lid < mesh.num_elems_in_elem(elem_gid); neighbor_lid++) {
+                const size_t neighbor_gid = mesh.elems_in_elem(elem_gid, neighbor_lid);
+
+                const double pres_jump = fabs(elem_pres(neighbor_gid) - elem_pres(elem_gid));
+                if (pres_jump > small_ * (fabs(elem_pres(elem_gid)) + fabs(elem_pres(neighbor_gid))) + tiny_) {
+                    active = 1;
+                }
+            } // end for neighbor_lid
+        } // end if not void
+
+        elem_flag(elem_gid) = active;
+    }); // end parallel for
+
+    // ---- grow the sources by the halo layers, the last pass flags the nodes ----
+    for (size_t layer = 0; layer <= num_halo_layers; layer++) {
+        FOR_ALL(node_gid, 0, mesh.num_nodes, {
+            size_t active = 0;
+            for (size_t elem_lid = 0; elem_lid < mesh.num_corners_in_node(node_gid); elem_lid++) {
+                active = active | elem_flag(mesh.elems_in_node(node_gid, elem_lid));
+            }
+            node_flag(node_gid) = active;
+        }); // end parallel for
+
+        if (layer == num_halo_layers) {
+            break;
+        }
+
+        FOR_ALL(elem_gid, 0, mesh.num_elems, {
+            size_t active = 0;
+            for (size_t node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
+                active = active | node_flag(mesh.nodes_in_elem(elem_gid, node_lid));
+            }
+            elem_flag(elem_gid) = active;
+        }); // end parallel for
+    } // end for layer
+    Kokkos::fence();
+
+    // ---- compact the flags into the lists ----
+    num_active_elems = compact_active(elem_active, active_elem_list, mesh.num_elems);
+    num_active_nodes = compact_active(node_active, active_node_list, mesh.num_nodes);
+
+    return;
+} // end build_active_lists
@@ -44,12 +44,14 @@
 /// \param An array of boundary_condition_t that contain information about BCs
 /// \param A view into the nodal velocity array
 /// \param The current simulation time
+/// \param Runge Kutta bin of the nodal velocity
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::boundary_velocity(const mesh_t&     mesh,
     const CArrayKokkos<boundary_condition_t>& boundary,
     DCArrayKokkos<double>& node_vel,
-    const double time_value)
+    const double time_value,
+    const size_t rk_bin)
 {
     // Loop over boundary sets
     for (size_t bdy_set = 0; bdy_set < mesh.num_bdy_sets; bdy_set++) {
@@ -66,14 +68,14 @@ void SGH::boundary_velocity(const mesh_t&     mesh,
                 size_t bdy_node_gid = mesh.bdy_nodes_in_set(bdy_set, bdy_node_lid);
 
                 // Set velocity to zero in that directdion
-                node_vel(1, bdy_node_gid, direction) = 0.0;
+                node_vel(rk_bin, bdy_node_gid, direction) = 0.0;
             }
             else if (boundary(bdy_set).type == boundary_conds::fixed) {
                 size_t bdy_node_gid = mesh.bdy_nodes_in_set(bdy_set, bdy_node_lid);
 
                 for (size_t dim = 0; dim < mesh.num_dims; dim++) {
                     // Set velocity to zero
-                    node_vel(1, bdy_node_gid, dim) = 0.0;
+                    node_vel(rk_bin, bdy_node_gid, dim) = 0.0;
                 }
             } // end if
             else if (boundary(bdy_set).type == boundary_conds::velocity) {
@@ -92,7 +94,7 @@ void SGH::boundary_velocity(const mesh_t&     mesh,
                     && time_value <= boundary(bdy_set).hydro_bc_vel_t_end) {
                     double time_delta = time_value - boundary(bdy_set).hydro_bc_vel_t_start;
 
-                    node_vel(1, bdy_node_gid, direction) =
+                    node_vel(rk_bin, bdy_node_gid, direction) =
                         boundary(bdy_set).hydro_bc_vel_0 *
                         exp(-boundary(bdy_set).hydro_bc_vel_1 * time_delta);
                 } // end if on time
@@ -106,22 +108,766 @@ void SGH::boundary_velocity(const mesh_t&     mesh,
 
 /////////////////////////////////////////////////////////////////////////////
 ///
-/// \fn boundary_velocity
+/// \fn project_on_patch
 ///
-/// \brief Evolves the boundary according to a give velocity
+/// \brief Projects a point onto a quad patch along the patch normal
+///
+/// The bilinear patch coordinates of the point are found by Newton
+/// iterations in the tangent plane of the patch.
+///
+/// \param Patch node coordinates, in the cyclic order of nodes_in_patch
+/// \param Point coordinates
+/// \param Sign that orients the normal out of the patch elem
+/// \param Unit outward normal, the output
+/// \param Shape function values at the projection, the output
+/// \param Signed distance of the point above the patch, the output
+///
+/// \return true if the projection falls on the patch
+///
+/////////////////////////////////////////////////////////////////////////////
+KOKKOS_INLINE_FUNCTION
+static bool project_on_patch(const double x[4][3],
+    const double p[3],
+    const double sign,
+    double normal[3],
+    double shape[4],
+    double& gap)
+{
+    const double xi_k[4]  = { -1.0, 1.0, 1.0, -1.0 };
+    const double eta_k[4] = { -1.0, -1.0, 1.0, 1.0 };
+
+    // the diagonals give the normal of a warped patch
+    double d1[3], d2[3], center[3];
+    for (size_t dim = 0; dim < 3; dim++) {
+        d1[dim] = x[2][dim] - x[0][dim];
+        d2[dim] = x[3][dim] - x[1][dim];
+        center[dim] = 0.25 * (x[0][dim] + x[1][dim] + x[2][dim] + x[3][dim]);
+    }
+    normal[0] = d1[1] * d2[2] - d1[2] * d2[1];
+    normal[1] = d1[2] * d2[0] - d1[0] * d2[2];
+    normal[2] = d1[0] * d2[1] - d1[1] * d2[0];
+
+    double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length <= 0.0) {
+        return false;
+    }
+    for (size_t dim = 0; dim < 3; dim++) {
+        normal[dim] *= sign / length;
+    }
+
+    // tangent frame of the patch
+    double t1[3], t2[3];
+    double t1_dot_n = 0.0;
+    for (size_t dim = 0; dim < 3; dim++) {
+        t1[dim]   = (x[1][dim] - x[0][dim]) + (x[2][dim] - x[3][dim]);
+        t1_dot_n += t1[dim] * normal[dim];
+    }
+    length = 0.0;
+    for (size_t dim = 0; dim < 3; dim++) {
+        t1[dim] -= t1_dot_n * normal[dim];
+        length  += t1[dim] * t1[dim];
+    }
+    length = sqrt(length);
+    if (length <= 0.0) {
+        return false;
+    }
+    for (size_t dim = 0; dim < 3; dim++) {
+        t1[dim] /= length;
+    }
+    t2[0] = normal[1] * t1[2] - normal[2] * t1[1];
+    t2[1] = normal[2] * t1[0] - normal[0] * t1[2];
+    t2[2] = normal[0] * t1[1] - normal[1] * t1[0];
+
+    // patch and point in the tangent plane
+    double X[4][2];
+    double P[2] = { 0.0, 0.0 };
+    for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+        X[node_lid][0] = 0.0;
+        X[node_lid][1] = 0.0;
+        for (size_t dim = 0; dim < 3; dim++) {
+            X[node_lid][0] += (x[node_lid][dim] - center[dim]) * t1[dim];
+            X[node_lid][1] += (x[node_lid][dim] - center[dim]) * t2[dim];
+        }
+    }
+    for (size_t dim = 0; dim < 3; dim++) {
+        P[0] += (p[dim] - center[dim]) * t1[dim];
+        P[1] += (p[dim] - center[dim]) * t2[dim];
+    }
+
+    // Newton iterations on the bilinear map
+    double xi  = 0.0;
+    double eta = 0.0;
+    for (size_t iter = 0; iter < 5; iter++) {
+        double res[2] = { -P[0], -P[1] };
+        double jac[2][2] = { { 0.0, 0.0 }, { 0.0, 0.0 } };
+        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+            double N    = 0.25 * (1.0 + xi * xi_k[node_lid]) * (1.0 + eta * eta_k[node_lid]);
+            double dNxi = 0.25 * xi_k[node_lid] * (1.0 + eta * eta_k[node_lid]);
+            double dNet = 0.25 * eta_k[node_lid] * (1.0 + xi * xi_k[node_lid]);
+            for (size_t i = 0; i < 2; i++) {
+                res[i]    += N * X[node_lid][i];
+                jac[i][0] += dNxi * X[node_lid][i];
+                jac[i][1] += dNet * X[node_lid][i];
+            }
+        }
+
+        double det = jac[0][0] * jac[1][1] - jac[0][1] * jac[1][0];
+        if (fabs(det) <= 1.0e-30) {
+            return false;
+        }
+        xi  -= (jac[1][1] * res[0] - jac[0][1] * res[1]) / det;
+        eta -= (jac[0][0] * res[1] - jac[1][0] * res[0]) / det;
+    } // end for iter
+
+    // a small overlap keeps nodes on a patch edge from slipping between patches
+    const double edge_tol = 1.0e-3;
+    if (fabs(xi) > 1.0 + edge_tol || fabs(eta) > 1.0 + edge_tol) {
+        return false;
+    }
+    xi  = fmin(fmax(xi, -1.0), 1.0);
+    eta = fmin(fmax(eta, -1.0), 1.0);
+
+    gap = 0.0;
+    for (size_t dim = 0; dim < 3; dim++) {
+        double surf_point = 0.0;
+        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+            shape[node_lid] = 0.25 * (1.0 + xi * xi_k[node_lid]) * (1.0 + eta * eta_k[node_lid]);
+            surf_point     += shape[node_lid] * x[node_lid][dim];
+        }
+        gap += (p[dim] - surf_point) * normal[dim];
+    }
+
+    return true;
+} // end project_on_patch
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn patch_bin_range
+///
+/// \brief Range of bins overlapped by the bounding box of a patch grown by
+///        the contact margin
+///
+/// \param Patch node coordinates
+/// \param Bin grid origin
+/// \param Inverse of the bin size
+/// \param Number of bins in each direction
+/// \param Contact margin
+/// \param First bin in each direction, the output
+/// \param Last bin in each direction, the output
+///
+/////////////////////////////////////////////////////////////////////////////
+KOKKOS_INLINE_FUNCTION
+static void patch_bin_range(const double x[4][3],
+    const double origin[3],
+    const double inv_bin_size,
+    const size_t num_bins[3],
+    const double margin,
+    size_t lo[3],
+    size_t hi[3])
+{
+    for (size_t dim = 0; dim < 3; dim++) {
+        double x_min = x[0][dim];
+        double x_max = x[0][dim];
+        for (size_t node_lid = 1; node_lid < 4; node_lid++) {
+            x_min = fmin(x_min, x[node_lid][dim]);
+            x_max = fmax(x_max, x[node_lid][dim]);
+        }
+
+        long bin_lo = (long)floor((x_min - margin - origin[dim]) * inv_bin_size);
+        long bin_hi = (long)floor((x_max + margin - origin[dim]) * inv_bin_size);
+
+        const long last_bin = (long)num_bins[dim] - 1;
+        bin_lo = (bin_lo < 0) ? 0 : ((bin_lo > last_bin) ? last_bin : bin_lo);
+        bin_hi = (bin_hi < 0) ? 0 : ((bin_hi > last_bin) ? last_bin : bin_hi);
+
+        lo[dim] = (size_t)bin_lo;
+        hi[dim] = (size_t)bin_hi;
+    }
+} // end patch_bin_range
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn contact_setup
+///
+/// \brief Gathers the contact surface from the boundary sets of type contact
+///
+/// The contact patches are the union of the patches in the contact sets and
+/// the contact nodes are the nodes on those patches. Every contact node is
+/// checked against every contact patch, so both sides of an interface are
+/// searched. The search margin is half the size of the smallest patch.
 ///
 /// \param The simulation mesh
 /// \param An array of boundary_condition_t that contain information about BCs
-/// \param A view into the nodal velocity array
+/// \param View of the nodal position data
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::contact_setup(const mesh_t& mesh,
+    const CArrayKokkos<boundary_condition_t>& boundary,
+    const DCArrayKokkos<double>& node_coords)
+{
+    contact_initialized = true;
+
+    // the patches are quads, contact is 3D only
+    if (mesh.num_dims != 3 || mesh.num_bdy_sets == 0) {
+        return;
+    }
+
+    // ---- flag the contact sets and count their patches ----
+    DCArrayKokkos<size_t> set_is_contact(mesh.num_bdy_sets);
+    DCArrayKokkos<size_t> num_patches_in_set(mesh.num_bdy_sets);
+    FOR_ALL(bdy_set, 0, mesh.num_bdy_sets, {
+        set_is_contact(bdy_set) = (boundary(bdy_set).type == boundary_conds::contact) ? 1 : 0;
+        num_patches_in_set(bdy_set) = mesh.bdy_patches_in_set.stride(bdy_set);
+    }); // end parallel for
+    Kokkos::fence();
+    set_is_contact.update_host();
+    num_patches_in_set.update_host();
+
+    num_contact_sets = 0;
+    for (size_t bdy_set = 0; bdy_set < mesh.num_bdy_sets; bdy_set++) {
+        num_contact_sets += set_is_contact.host(bdy_set);
+    }
+
+    // ---- the contact patches, a patch can be in more than one contact set ----
+    CArrayKokkos<size_t> patch_flag(mesh.num_patches);
+    FOR_ALL(patch_gid, 0, mesh.num_patches, {
+        patch_flag(patch_gid) = 0;
+    });
+
+    for (size_t bdy_set = 0; bdy_set < mesh.num_bdy_sets; bdy_set++) {
+        if (set_is_contact.host(bdy_set) == 0) {
+            continue;
+        }
+        FOR_ALL(patch_lid, 0, num_patches_in_set.host(bdy_set), {
+            patch_flag(mesh.bdy_patches_in_set(bdy_set, patch_lid)) = 1;
+        });
+    } // end for bdy_set
+    Kokkos::fence();
+
+    contact_patches     = DCArrayKokkos<size_t>(mesh.num_patches);
+    num_contact_patches = (size_t)compact_active(patch_flag, contact_patches, mesh.num_patches);
+
+    if (num_contact_patches == 0) {
+        return;
+    }
+
+    auto patches = contact_patches;
+
+    // ---- the contact nodes ----
+    CArrayKokkos<size_t> node_flag(mesh.num_nodes);
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        node_flag(node_gid) = 0;
+    });
+    FOR_ALL(patch_lid, 0, num_contact_patches, {
+        for (size_t patch_node_lid = 0; patch_node_lid < mesh.num_nodes_in_patch; patch_node_lid++) {
+            node_flag(mesh.nodes_in_patch(patches(patch_lid), patch_node_lid)) = 1;
+        }
+    });
+    Kokkos::fence();
+
+    contact_nodes     = DCArrayKokkos<size_t>(mesh.num_nodes);
+    num_contact_nodes = (size_t)compact_active(node_flag, contact_nodes, mesh.num_nodes);
+
+    // ---- orient the patch normals out of their elem and find the smallest patch ----
+    contact_patch_sign = CArrayKokkos<double>(num_contact_patches);
+    auto patch_sign = contact_patch_sign;
+
+    double min_size_lcl;
+    double min_size;
+    REDUCE_MIN(patch_lid, 0, num_contact_patches, min_size_lcl, {
+        size_t patch_gid = patches(patch_lid);
+        size_t elem_gid  = mesh.elems_in_patch(patch_gid, 0);
+
+        double elem_center[3]  = { 0.0, 0.0, 0.0 };
+        double patch_center[3] = { 0.0, 0.0, 0.0 };
+        for (size_t node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
+            for (size_t dim = 0; dim < 3; dim++) {
+                elem_center[dim] += node_coords(1, mesh.nodes_in_elem(elem_gid, node_lid), dim) / mesh.num_nodes_in_elem;
+            }
+        }
+
+        double x[4][3];
+        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+            for (size_t dim = 0; dim < 3; dim++) {
+                x[node_lid][dim]   = node_coords(1, mesh.nodes_in_patch(patch_gid, node_lid), dim);
+                patch_center[dim] += 0.25 * x[node_lid][dim];
+            }
+        }
+
+        double d1[3], d2[3];
+        for (size_t dim = 0; dim < 3; dim++) {
+            d1[dim] = x[2][dim] - x[0][dim];
+            d2[dim] = x[3][dim] - x[1][dim];
+        }
+        double n[3];
+        n[0] = d1[1] * d2[2] - d1[2] * d2[1];
+        n[1] = d1[2] * d2[0] - d1[0] * d2[2];
+        n[2] = d1[0] * d2[1] - d1[1] * d2[0];
+
+        double outward = 0.0;
+        for (size_t dim = 0; dim < 3; dim++) {
+            outward += n[dim] * (patch_center[dim] - elem_center[dim]);
+        }
+        patch_sign(patch_lid) = (outward >= 0.0) ? 1.0 : -1.0;
+
+        // the patch area is half the cross product of the diagonals
+        double size = sqrt(0.5 * sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]));
+        if (size < min_size_lcl) {
+            min_size_lcl = size;
+        }
+    }, min_size);
+    Kokkos::fence();
+
+    contact_margin = 0.5 * min_size;
+
+    contact_build_coords = CArrayKokkos<double>(num_contact_nodes, 3);
+    contact_dvel = CArrayKokkos<double>(mesh.num_nodes, 3);
+
+    auto dvel = contact_dvel;
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        for (size_t dim = 0; dim < 3; dim++) {
+            dvel(node_gid, dim) = 0.0;
+        }
+    });
+    Kokkos::fence();
+
+    contact_build_bins(mesh, node_coords);
+
+    printf("Contact surface: %lu patches, %lu nodes, search margin = %e\n",
+           num_contact_patches, num_contact_nodes, contact_margin);
+
+    return;
+} // end contact_setup
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn contact_build_bins
+///
+/// \brief Sorts the contact patches into a uniform grid of bins
+///
+/// A patch goes in every bin its bounding box, grown by the contact margin,
+/// overlaps. The bins are at least as large as the largest grown patch, so
+/// a patch is in at most 8 bins and a node only searches its own bin. The
+/// bins are counted, scanned and filled in parallel.
+///
+/// \param The simulation mesh
+/// \param View of the nodal position data
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::contact_build_bins(const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords)
+{
+    auto nodes   = contact_nodes;
+    auto patches = contact_patches;
+    auto build_coords = contact_build_coords;
+
+    const double margin = contact_margin;
+
+    // ---- save the positions the bins are built from ----
+    FOR_ALL(node_lid, 0, num_contact_nodes, {
+        for (size_t dim = 0; dim < 3; dim++) {
+            build_coords(node_lid, dim) = node_coords(1, nodes(node_lid), dim);
+        }
+    });
+
+    // ---- bounding box of the contact nodes ----
+    double origin[3];
+    double extent[3];
+    for (size_t dim = 0; dim < 3; dim++) {
+        double x_min_lcl;
+        double x_max_lcl;
+        double x_min;
+        double x_max;
+        REDUCE_MIN(node_lid, 0, num_contact_nodes, x_min_lcl, {
+            double x = node_coords(1, nodes(node_lid), dim);
+            if (x < x_min_lcl) {
+                x_min_lcl = x;
+            }
+        }, x_min);
+        REDUCE_MAX(node_lid, 0, num_contact_nodes, x_max_lcl, {
+            double x = node_coords(1, nodes(node_lid), dim);
+            if (x > x_max_lcl) {
+                x_max_lcl = x;
+            }
+        }, x_max);
+
+        origin[dim] = x_min - margin;
+        extent[dim] = (x_max - x_min) + 2.0 * margin;
+    } // end for dim
+
+    // ---- the bins hold the largest patch with its margin ----
+    double max_size_lcl;
+    double max_size;
+    REDUCE_MAX(patch_lid, 0, num_contact_patches, max_size_lcl, {
+        size_t patch_gid = patches(patch_lid);
+        for (size_t dim = 0; dim < 3; dim++) {
+            double x_min = node_coords(1, mesh.nodes_in_patch(patch_gid, 0), dim);
+            double x_max = x_min;
+            for (size_t node_lid = 1; node_lid < 4; node_lid++) {
+                double x = node_coords(1, mesh.nodes_in_patch(patch_gid, node_lid), dim);
+                x_min = fmin(x_min, x);
+                x_max = fmax(x_max, x);
+            }
+            if (x_max - x_min > max_size_lcl) {
+                max_size_lcl = x_max - x_min;
+            }
+        }
+    }, max_size);
+    Kokkos::fence();
+
+    double bin_size = max_size + 2.0 * margin;
+
+    // coarsen the grid when the bodies are far apart, so the bins stay O(num patches)
+    size_t num_bins[3];
+    size_t total_bins = 1;
+    while (true) {
+        total_bins = 1;
+        for (size_t dim = 0; dim < 3; dim++) {
+            num_bins[dim] = (size_t)(extent[dim] / bin_size) + 1;
+            total_bins   *= num_bins[dim];
+        }
+        if (total_bins <= 4 * num_contact_patches + 64) {
+            break;
+        }
+        bin_size *= 2.0;
+    } // end while
+
+    for (size_t dim = 0; dim < 3; dim++) {
+        contact_bin_origin[dim] = origin[dim];
+        contact_num_bins[dim]   = num_bins[dim];
+    }
+    contact_bin_size = bin_size;
+
+    contact_bin_start = CArrayKokkos<size_t>(total_bins);
+    contact_bin_count = CArrayKokkos<size_t>(total_bins);
+
+    auto bin_start = contact_bin_start;
+    auto bin_count = contact_bin_count;
+
+    const double inv_bin_size = 1.0 / bin_size;
+    const double ox = origin[0];
+    const double oy = origin[1];
+    const double oz = origin[2];
+    const size_t nx = num_bins[0];
+    const size_t ny = num_bins[1];
+    const size_t nz = num_bins[2];
+
+    FOR_ALL(bin, 0, total_bins, {
+        bin_count(bin) = 0;
+    });
+
+    // ---- count the patches in each bin ----
+    FOR_ALL(patch_lid, 0, num_contact_patches, {
+        const double grid_origin[3] = { ox, oy, oz };
+        const size_t grid_bins[3]   = { nx, ny, nz };
+
+        double x[4][3];
+        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+            for (size_t dim = 0; dim < 3; dim++) {
+                x[node_lid][dim] = node_coords(1, mesh.nodes_in_patch(patches(patch_lid), node_lid), dim);
+            }
+        }
+
+        size_t lo[3], hi[3];
+        patch_bin_range(x, grid_origin, inv_bin_size, grid_bins, margin, lo, hi);
+
+        for (size_t k = lo[2]; k <= hi[2]; k++) {
+            for (size_t j = lo[1]; j <= hi[1]; j++) {
+                for (size_t i = lo[0]; i <= hi[0]; i++) {
+                    Kokkos::atomic_add(&bin_count(i + nx * (j + ny * k)), (size_t)1);
+                }
+            }
+        }
+    }); // end parallel for
+    Kokkos::fence();
+
+    // ---- offsets of the bins ----
+    size_t num_entries = 0;
+    Kokkos::parallel_scan("contact_bin_scan", Kokkos::RangePolicy<>(0, total_bins),
+        KOKKOS_LAMBDA(const size_t bin, size_t& offset, const bool final) {
+        if (final) {
+            bin_start(bin) = offset;
+        }
+        offset += bin_count(bin);
+    }, num_entries);
+    Kokkos::fence();
+
+    FOR_ALL(bin, 0, total_bins, {
+        bin_count(bin) = 0;
+    });
+
+    // ---- fill the bins, the counts are rebuilt as the fill cursors ----
+    contact_bin_patches = CArrayKokkos<size_t>(num_entries);
+    auto bin_patches = contact_bin_patches;
+
+    FOR_ALL(patch_lid, 0, num_contact_patches, {
+        const double grid_origin[3] = { ox, oy, oz };
+        const size_t grid_bins[3]   = { nx, ny, nz };
+
+        double x[4][3];
+        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
+            for (size_t dim = 0; dim < 3; dim++) {
+                x[node_lid][dim] = node_coords(1, mesh.nodes_in_patch(patches(patch_lid), node_lid), dim);
+            }
+        }
+
+        size_t lo[3], hi[3];
+        patch_bin_range(x, grid_origin, inv_bin_size, grid_bins, margin, lo, hi);
+
+        for (size_t k = lo[2]; k <= hi[2]; k++) {
+            for (size_t j = lo[1]; j <= hi[1]; j++) {
+                for (size_t i = lo[0]; i <= hi[0]; i++) {
+                    size_t bin  = i + nx * (j + ny * k);
+                    size_t slot = Kokkos::atomic_fetch_add(&bin_count(bin), (size_t)1);
+                    bin_patches(bin_start(bin) + slot) = patch_lid;
+                }
+            }
+        }
+    }); // end parallel for
+    Kokkos::fence();
+
+    contact_num_builds++;
+
+    return;
+} // end contact_build_bins
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn boundary_contact
+///
+/// \brief Kinematic node to surface contact on the contact boundary sets
+///
+/// Every contact node is projected onto the contact patches in its bin.
+/// A node that would pass through a patch in this step gets a normal
+/// impulse that stops it on the surface. The impulse is shared with the
+/// patch nodes through the shape functions, so momentum is conserved.
+/// The contact is frictionless. The impulses of all pairs are summed
+/// with atomics before they are applied, so the last bits of the result
+/// can change from run to run with the order of the additions.
+///
+/// The target velocity matches the position update that follows. With
+/// the trapezoidal update x1 = x0 + dt*(v0 + v1)/2 the gap is measured
+/// at x0 and the relative normal velocity at the end of the step must be
+/// 2*(-gap/dt) - v_rel0 for the node to land on the surface. With the
+/// explicit low storage update the gap is measured at x1 and the target
+/// is -gap/dt. The target is never negative, so a node does not leave
+/// the step still approaching the patch.
+///
+/// The bins are rebuilt only when a contact node has moved more than half
+/// the margin since the last build, which keeps the relative motion of any
+/// node and patch within the margin the patches were grown by.
+///
+/// \param The simulation mesh
+/// \param An array of boundary_condition_t that contain information about BCs
+/// \param View of the nodal position data
+/// \param View of the nodal velocity array
+/// \param View of the nodal mass array
+/// \param Time increment of the position update that follows
+/// \param True when the positions are updated with the average of vel(0) and vel(1)
 /// \param The current simulation time
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::boundary_contact(const mesh_t&     mesh,
     const CArrayKokkos<boundary_condition_t>& boundary,
+    const DCArrayKokkos<double>& node_coords,
     DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& node_mass,
+    const double dt,
+    const bool   trapezoid,
     const double time_value)
 {
-    
+    if (!contact_initialized) {
+        contact_setup(mesh, boundary, node_coords);
+    }
+
+    if (num_contact_patches == 0 || dt <= 0.0) {
+        return;
+    }
+
+    auto nodes   = contact_nodes;
+    auto patches = contact_patches;
+    auto build_coords = contact_build_coords;
+
+    // ---- rebuild the bins if a node moved more than half the margin ----
+    double move_lcl;
+    double max_move;
+    REDUCE_MAX(node_lid, 0, num_contact_nodes, move_lcl, {
+        double dist_sqrd = 0.0;
+        for (size_t dim = 0; dim < 3; dim++) {
+            double dx = node_coords(1, nodes(node_lid), dim) - build_coords(node_lid, dim);
+            dist_sqrd += dx * dx;
+        }
+        if (dist_sqrd > move_lcl) {
+            move_lcl = dist_sqrd;
+        }
+    }, max_move);
+    Kokkos::fence();
+
+    if (sqrt(max_move) > 0.5 * contact_margin) {
+        contact_build_bins(mesh, node_coords);
+    }
+
+    auto patch_sign  = contact_patch_sign;
+    auto bin_start   = contact_bin_start;
+    auto bin_count   = contact_bin_count;
+    auto bin_patches = contact_bin_patches;
+    auto dvel = contact_dvel;
+
+    const double margin = contact_margin;
+    const double inv_bin_size = 1.0 / contact_bin_size;
+    const double ox = contact_bin_origin[0];
+    const double oy = contact_bin_origin[1];
+    const double oz = contact_bin_origin[2];
+    const size_t nx = contact_num_bins[0];
+    const size_t ny = contact_num_bins[1];
+    const size_t nz = contact_num_bins[2];
+
+    // the trapezoidal update starts from the step start positions
+    const size_t pos_level = trapezoid ? 0 : 1;
+
+    // ---- narrow phase, each node takes the patch it would pass furthest through ----
+    FOR_ALL(node_lid, 0, num_contact_nodes, {
+        const size_t node_gid = nodes(node_lid);
+
+        double p[3];
+        double v_p[3];
+        double v_p0[3];
+        for (size_t dim = 0; dim < 3; dim++) {
+            p[dim]    = node_coords(pos_level, node_gid, dim);
+            v_p[dim]  = node_vel(1, node_gid, dim);
+            v_p0[dim] = node_vel(0, node_gid, dim);
+        }
+
+        // the bin of the node, the grid covers every contact node at the last build
+        long i = (long)floor((p[0] - ox) * inv_bin_size);
+        long j = (long)floor((p[1] - oy) * inv_bin_size);
+        long k = (long)floor((p[2] - oz) * inv_bin_size);
+        i = (i < 0) ? 0 : ((i > (long)nx - 1) ? (long)nx - 1 : i);
+        j = (j < 0) ? 0 : ((j > (long)ny - 1) ? (long)ny - 1 : j);
+        k = (k < 0) ? 0 : ((k > (long)nz - 1) ? (long)nz - 1 : k);
+        const size_t bin = (size_t)i + nx * ((size_t)j + ny * (size_t)k);
+
+        double best_pred = 0.0;
+        double best_gap  = 0.0;
+        double best_vrel = 0.0;
+        double best_vrel0 = 0.0;
+        double best_normal[3];
+        double best_shape[4];
+        size_t best_nodes[4];
+        size_t best_patch = 0;
+        bool   found = false;
+
+        for (size_t bin_lid = 0; bin_lid < bin_count(bin); bin_lid++) {
+            const size_t patch_lid = bin_patches(bin_start(bin) + bin_lid);
+            const size_t patch_gid = patches(patch_lid);
+
+            // skip the patches of other ensemble members, they overlap this one
+            const size_t elem_gid = mesh.elems_in_patch(patch_gid, 0);
+            if (elem_gid / mesh.num_member_elems != node_gid / mesh.num_member_nodes) {
+                continue;
+            }
+
+            // skip the patches on the elems of this node
+            bool own_elem = false;
+            for (size_t elem_node_lid = 0; elem_node_lid < mesh.num_nodes_in_elem; elem_node_lid++) {
+                if (mesh.nodes_in_elem(elem_gid, elem_node_lid) == node_gid) {
+                    own_elem = true;
+                }
+            }
+            if (own_elem) {
+                continue;
+            }
+
+            double x[4][3];
+            size_t patch_nodes[4];
+            for (size_t patch_node_lid = 0; patch_node_lid < 4; patch_node_lid++) {
+                patch_nodes[patch_node_lid] = mesh.nodes_in_patch(patch_gid, patch_node_lid);
+                for (size_t dim = 0; dim < 3; dim++) {
+                    x[patch_node_lid][dim] = node_coords(pos_level, patch_nodes[patch_node_lid], dim);
+                }
+            }
+
+            double normal[3];
+            double shape[4];
+            double gap;
+            if (!project_on_patch(x, p, patch_sign(patch_lid), normal, shape, gap)) {
+                continue;
+            }
+
+            // deeper than the margin is the far side of a body, not a contact
+            if (gap < -margin) {
+                continue;
+            }
+
+            // normal velocity of the node relative to the patch, at the start and end of the step
+            double v_rel  = 0.0;
+            double v_rel0 = 0.0;
+            for (size_t dim = 0; dim < 3; dim++) {
+                double v_surf  = 0.0;
+                double v_surf0 = 0.0;
+                for (size_t patch_node_lid = 0; patch_node_lid < 4; patch_node_lid++) {
+                    v_surf  += shape[patch_node_lid] * node_vel(1, patch_nodes[patch_node_lid], dim);
+                    v_surf0 += shape[patch_node_lid] * node_vel(0, patch_nodes[patch_node_lid], dim);
+                }
+                v_rel  += (v_p[dim] - v_surf) * normal[dim];
+                v_rel0 += (v_p0[dim] - v_surf0) * normal[dim];
+            }
+
+            // predicted gap at the end of the step, ties go to the lower patch id
+            // since the bins are filled in no particular order
+            double pred = trapezoid ? gap + 0.5 * dt * (v_rel0 + v_rel) : gap + v_rel * dt;
+            if (pred < best_pred || (found && pred == best_pred && patch_lid < best_patch)) {
+                best_pred  = pred;
+                best_patch = patch_lid;
+                best_gap  = gap;
+                best_vrel = v_rel;
+                best_vrel0 = v_rel0;
+                for (size_t dim = 0; dim < 3; dim++) {
+                    best_normal[dim] = normal[dim];
+                }
+                for (size_t patch_node_lid = 0; patch_node_lid < 4; patch_node_lid++) {
+                    best_shape[patch_node_lid] = shape[patch_node_lid];
+                    best_nodes[patch_node_lid] = patch_nodes[patch_node_lid];
+                }
+                found = true;
+            }
+        } // end for patches in bin
+
+        if (found) {
+            // impulse that brings the node to the surface at the end of the step
+            double inv_mass = 1.0 / node_mass(node_gid);
+            for (size_t patch_node_lid = 0; patch_node_lid < 4; patch_node_lid++) {
+                inv_mass += best_shape[patch_node_lid] * best_shape[patch_node_lid] / node_mass(best_nodes[patch_node_lid]);
+            }
+
+            // relative normal velocity at the end of the step that lands the node on the patch
+            double target = trapezoid ? 2.0 * (-best_gap / dt) - best_vrel0 : -best_gap / dt;
+            target = (target > 0.0) ? target : 0.0;
+            double impulse = (target - best_vrel) / inv_mass;
+
+            if (impulse > 0.0) {
+                for (size_t dim = 0; dim < 3; dim++) {
+                    Kokkos::atomic_add(&dvel(node_gid, dim), impulse * best_normal[dim] / node_mass(node_gid));
+                    for (size_t patch_node_lid = 0; patch_node_lid < 4; patch_node_lid++) {
+                        size_t patch_node_gid = best_nodes[patch_node_lid];
+                        Kokkos::atomic_add(&dvel(patch_node_gid, dim),
+                                           -best_shape[patch_node_lid] * impulse * best_normal[dim] / node_mass(patch_node_gid));
+                    }
+                }
+            } // end if compressive
+        } // end if found
+    }); // end parallel for
+    Kokkos::fence();
+
+    // ---- apply the summed corrections ----
+    FOR_ALL(node_lid, 0, num_contact_nodes, {
+        const size_t node_gid = nodes(node_lid);
+        for (size_t dim = 0; dim < 3; dim++) {
+            node_vel(1, node_gid, dim) += dvel(node_gid, dim);
+            dvel(node_gid, dim) = 0.0;
+        }
+    }); // end parallel for
+    Kokkos::fence();
 
     return;
 } // end boundary_contact function
\ No newline at end of file
@@ -48,6 +48,9 @@
 /// \param A view into the element specific internal energy
 /// \param A view into the element mass
 /// \param A view into the corner force data
+/// \param Optional list of the elements to update
+/// \param Number of elements in the list, -1 updates every element
+/// \param Runge Kutta bin to update, the other bin holds t_n
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::update_energy(double rk_alpha,
@@ -57,10 +60,19 @@ void SGH::update_energy(double rk_alpha,
     const DCArrayKokkos<double>& node_coords,
     DCArrayKokkos<double>& elem_sie,
     const DCArrayKokkos<double>& elem_mass,
-    const DCArrayKokkos<double>& corner_force)
+    const DCArrayKokkos<double>& corner_force,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const size_t rk_bin)
 {
-    // loop over all the elements in the mesh
-    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+    const size_t tn_bin = 1 - rk_bin;
+
+    // loop over the listed elements, or all of them if there is no list
+    const size_t num_loop_elems = (num_list_elems < 0) ? mesh.num_elems : (size_t)num_list_elems;
+
+    FOR_ALL(list_lid, 0, num_loop_elems, {
+        const size_t elem_gid = (num_list_elems < 0) ? list_lid : elem_list(list_lid);
+
         double elem_power = 0.0;
 
         // --- tally the contribution from each corner to the element ---
@@ -77,19 +89,19 @@ void SGH::update_energy(double rk_alpha,
 
             double node_radius = 1;
             if (mesh.num_dims == 2) {
-                node_radius = node_coords(1, node_gid, 1);
+                node_radius = node_coords(rk_bin, node_gid, 1);
             }
 
             // calculate the Power=F dot V for this corner
             for (size_t dim = 0; dim < mesh.num_dims; dim++) {
-                double half_vel = (node_vel(1, node_gid, dim) + node_vel(0, node_gid, dim)) * 0.5;
+                double half_vel = (node_vel(rk_bin, node_gid, dim) + node_vel(tn_bin, node_gid, dim)) * 0.5;
                 elem_power += corner_force(corner_gid, dim) * node_radius * half_vel;
             } // end for dim
         } // end for node_lid
 
         // update the specific energy
-        elem_sie(1, elem_gid) = elem_sie(0, elem_gid) -
-                                rk_alpha * dt / elem_mass(elem_gid) * elem_power;
+        elem_sie(rk_bin, elem_gid) = elem_sie(tn_bin, elem_gid) -
+                                     rk_alpha * dt / elem_mass(elem_gid) * elem_power;
     }); // end parallel loop over the elements
 
     return;
@@ -57,6 +57,10 @@
 /// \param Element state variable array
 /// \param Time step size
 /// \param The current Runge Kutta integration alpha value
+/// \param Optional list of the elements to update
+/// \param Number of elements in the list, -1 updates every element
+/// \param Optional zeroed nodal force the corner forces are atomically added to
+/// \param Runge Kutta bin holding the state the forces are evaluated at
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::get_force(const CArrayKokkos<material_t>& material,
@@ -76,11 +80,23 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
     const double small,
     const DCArrayKokkos<double>& elem_statev,
     const double dt,
-    const double rk_alpha
+    const double rk_alpha,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const DCArrayKokkos<double>& node_force,
+    const size_t rk_bin
     )
 {
+    // scatter into the nodal force when one is given
+    const bool scatter_force = (node_force.size() > 0);
+
     // --- calculate the forces acting on the nodes from the element ---
-    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+    // loop over the listed elements, or all of them if there is no list
+    const size_t num_loop_elems = (num_list_elems < 0) ? mesh.num_elems : (size_t)num_list_elems;
+
+    FOR_ALL(list_lid, 0, num_loop_elems, {
+        const size_t elem_gid = (num_list_elems < 0) ? list_lid : elem_list(list_lid);
+
         const size_t num_dims = 3;
         const size_t num_nodes_in_elem = 8;
 
@@ -119,7 +135,7 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
         double vol = elem_vol(elem_gid);
 
         // create a view of the stress_matrix
-        ViewCArrayKokkos<double> stress(&elem_stress(1, elem_gid, 0, 0), 3, 3);
+        ViewCArrayKokkos<double> stress(&elem_stress(rk_bin, elem_gid, 0, 0), 3, 3);
 
         // cut out the node_gids for this element
         ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), 8);
@@ -128,7 +144,8 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
         geometry::get_bmatrix(area_normal,
                               elem_gid,
                               node_coords,
-                              elem_node_gids);
+                              elem_node_gids,
+                              rk_bin);
 
         // --- Calculate the velocity gradient ---
         get_velgrad(vel_grad,
@@ -136,7 +153,8 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
                     node_vel,
                     area_normal,
                     vol,
-                    elem_gid);
+                    elem_gid,
+                    rk_bin);
 
         // the -1 is for the inward surface area normal,
         for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
@@ -186,7 +204,7 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
             // Get node global index and create view of nodal velocity
             int node_gid = mesh.nodes_in_elem(elem_gid, node_lid);
 
-            ViewCArrayKokkos<double> vel(&node_vel(1, node_gid, 0), num_dims);
+            ViewCArrayKokkos<double> vel(&node_vel(rk_bin, node_gid, 0), num_dims);
 
             vel_star(0) += 0.125 * vel(0);
             vel_star(1) += 0.125 * vel(1);
@@ -209,7 +227,7 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
             size_t node_gid = mesh.nodes_in_elem(elem_gid, node_lid);
 
             // Create view of nodal velocity
-            ViewCArrayKokkos<double> vel(&node_vel(1, node_gid, 0), num_dims);
+            ViewCArrayKokkos<double> vel(&node_vel(rk_bin, node_gid, 0), num_dims);
 
             // Get an estimate of the shock direction.
             mag_vel = sqrt( (vel(0) - vel_star(0) ) * (vel(0) - vel_star(0) )
@@ -361,7 +379,11 @@ void SGH::get_force(const CArrayKokkos<material_t>& material,
                     area_normal(node_lid, 0) * tau(0, dim)
                     + area_normal(node_lid, 1) * tau(1, dim)
                     + area_normal(node_lid, 2) * tau(2, dim)
-                    + phi * muc(node_lid) * (vel_star(dim) - node_vel(1, node_gid, dim));
+                    + phi * muc(node_lid) * (vel_star(dim) - node_vel(rk_bin, node_gid, dim));
+
+                if (scatter_force) {
+                    Kokkos::atomic_add(&node_force(node_gid, dim), corner_force(corner_gid, dim));
+                }
             } // end loop over dimension
         } // end for loop over nodes in elem
 
@@ -0,0 +1,426 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#include "sgh_solver.h"
+
+// number of elements evaluated together in the vector lanes, 8 doubles fill an AVX-512 register
+#ifndef SGH_SIMD_WIDTH
+#define SGH_SIMD_WIDTH 8
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_bmatrix_column_simd
+///
+/// \brief One column of the hex B matrix for a pack of elements.  The three
+///        columns are cyclic permutations of the same expression,
+///        B(:,0) = f(y,z), B(:,1) = f(z,x) and B(:,2) = f(x,y).
+///
+/// \param B matrix column, [node][lane]
+/// \param First coordinate of the permutation, [node][lane]
+/// \param Second coordinate of the permutation, [node][lane]
+///
+/////////////////////////////////////////////////////////////////////////////
+KOKKOS_INLINE_FUNCTION
+static void get_bmatrix_column_simd(double b[8][SGH_SIMD_WIDTH],
+    const double a[8][SGH_SIMD_WIDTH],
+    const double c[8][SGH_SIMD_WIDTH])
+{
+    const double twelth = 1. / 12.;
+
+    for (size_t lane = 0; lane < SGH_SIMD_WIDTH; lane++) {
+        b[0][lane] = (+a[1][lane] * (-c[2][lane] - c[3][lane] + c[4][lane] + c[5][lane])
+                      + a[2][lane] * (+c[1][lane] - c[3][lane])
+                      + a[3][lane] * (+c[1][lane] + c[2][lane] - c[4][lane] - c[7][lane])
+                      + a[4][lane] * (-c[1][lane] + c[3][lane] - c[5][lane] + c[7][lane])
+                      + a[5][lane] * (-c[1][lane] + c[4][lane])
+                      + a[7][lane] * (+c[3][lane] - c[4][lane])) * twelth;
+
+        b[1][lane] = (+a[0][lane] * (+c[2][lane] + c[3][lane] - c[4][lane] - c[5][lane])
+                      + a[2][lane] * (-c[0][lane] - c[3][lane] + c[5][lane] + c[6][lane])
+                      + a[3][lane] * (-c[0][lane] + c[2][lane])
+                      + a[4][lane] * (+c[0][lane] - c[5][lane])
+                      + a[5][lane] * (+c[0][lane] - c[2][lane] + c[4][lane] - c[6][lane])
+                      + a[6][lane] * (-c[2][lane] + c[5][lane])) * twelth;
+
+        b[2][lane] = (+a[0][lane] * (-c[1][lane] + c[3][lane])
+                      + a[1][lane] * (+c[0][lane] + c[3][lane] - c[5][lane] - c[6][lane])
+                      + a[3][lane] * (-c[0][lane] - c[1][lane] + c[6][lane] + c[7][lane])
+                      + a[5][lane] * (+c[1][lane] - c[6][lane])
+                      + a[6][lane] * (+c[1][lane] - c[3][lane] + c[5][lane] - c[7][lane])
+                      + a[7][lane] * (-c[3][lane] + c[6][lane])) * twelth;
+
+        b[3][lane] = (+a[0][lane] * (-c[1][lane] - c[2][lane] + c[4][lane] + c[7][lane])
+                      + a[1][lane] * (+c[0][lane] - c[2][lane])
+                      + a[2][lane] * (+c[0][lane] + c[1][lane] - c[6][lane] - c[7][lane])
+                      + a[4][lane] * (-c[0][lane] + c[7][lane])
+                      + a[6][lane] * (+c[2][lane] - c[7][lane])
+                      + a[7][lane] * (-c[0][lane] + c[2][lane] - c[4][lane] + c[6][lane])) * twelth;
+
+        b[4][lane] = (+a[0][lane] * (+c[1][lane] - c[3][lane] + c[5][lane] - c[7][lane])
+                      + a[1][lane] * (-c[0][lane] + c[5][lane])
+                      + a[3][lane] * (+c[0][lane] - c[7][lane])
+                      + a[5][lane] * (-c[0][lane] - c[1][lane] + c[6][lane] + c[7][lane])
+                      + a[6][lane] * (-c[5][lane] + c[7][lane])
+                      + a[7][lane] * (+c[0][lane] + c[3][lane] - c[5][lane] - c[6][lane])) * twelth;
+
+        b[5][lane] = (+a[0][lane] * (+c[1][lane] - c[4][lane])
+                      + a[1][lane] * (-c[0][lane] + c[2][lane] - c[4][lane] + c[6][lane])
+                      + a[2][lane] * (-c[1][lane] + c[6][lane])
+                      + a[4][lane] * (+c[0][lane] + c[1][lane] - c[6][lane] - c[7][lane])
+                      + a[6][lane] * (-c[1][lane] - c[2][lane] + c[4][lane] + c[7][lane])
+                      + a[7][lane] * (+c[4][lane] - c[6][lane])) * twelth;
+
+        b[6][lane] = (+a[1][lane] * (+c[2][lane] - c[5][lane])
+                      + a[2][lane] * (-c[1][lane] + c[3][lane] - c[5][lane] + c[7][lane])
+                      + a[3][lane] * (-c[2][lane] + c[7][lane])
+                      + a[4][lane] * (+c[5][lane] - c[7][lane])
+                      + a[5][lane] * (+c[1][lane] + c[2][lane] - c[4][lane] - c[7][lane])
+                      + a[7][lane] * (-c[2][lane] - c[3][lane] + c[4][lane] + c[5][lane])) * twelth;
+
+        b[7][lane] = (+a[0][lane] * (-c[3][lane] + c[4][lane])
+                      + a[2][lane] * (+c[3][lane] - c[6][lane])
+                      + a[3][lane] * (+c[0][lane] - c[2][lane] + c[4][lane] - c[6][lane])
+                      + a[4][lane] * (-c[0][lane] - c[3][lane] + c[5][lane] + c[6][lane])
+                      + a[5][lane] * (-c[4][lane] + c[6][lane])
+                      + a[6][lane] * (+c[2][lane] + c[3][lane] - c[4][lane] - c[5][lane])) * twelth;
+    } // end for lane
+
+    return;
+} // end get_bmatrix_column_simd
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_force_simd
+///
+/// \brief SIMD-packed variant of the 3D corner force calculation.  Each
+///        thread evaluates a pack of SGH_SIMD_WIDTH hexes with the element
+///        index in the innermost, fixed-length lane loops, so the B matrix,
+///        velocity gradient, MARS Riemann solve and corner forces compile to
+///        vector instructions on CPU backends.  Node data is gathered into
+///        the packs up front and the corner forces are scattered back at the
+///        end.  The trailing pack repeats its last element in the unused
+///        lanes and masks their writes.  Results match get_force, which
+///        remains the better choice on GPUs.
+///
+/// \param An array of material_t that contains material specific data
+/// \param The simulation mesh
+/// \param A view into the nodal position array
+/// \param A view into the nodal velocity array
+/// \param A view into the element density array
+/// \param A view into the element specific internal energy array
+/// \param A view into the element pressure array
+/// \param A view into the element stress array
+/// \param A view into the element sound speed array
+/// \param A view into the element volume array
+/// \param A view into the element divergence of velocity array
+/// \param A view into the element material identifier array
+/// \param A view into the corner force array
+/// \param fuzz
+/// \param small
+/// \param Element state variable array
+/// \param Time step size
+/// \param The current Runge Kutta integration alpha value
+/// \param Optional list of the elements to update
+/// \param Number of elements in the list, -1 updates every element
+/// \param Optional zeroed nodal force the corner forces are atomically added to
+/// \param Runge Kutta bin holding the state the forces are evaluated at
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::get_force_simd(const CArrayKokkos<material_t>& material,
+    const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& elem_den,
+    const DCArrayKokkos<double>& elem_sie,
+    const DCArrayKokkos<double>& elem_pres,
+    const DCArrayKokkos<double>& elem_stress,
+    const DCArrayKokkos<double>& elem_sspd,
+    const DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<double>& elem_div,
+    const DCArrayKokkos<size_t>& elem_mat_id,
+    DCArrayKokkos<double>& corner_force,
+    const double fuzz,
+    const double small,
+    const DCArrayKokkos<double>& elem_statev,
+    const double dt,
+    const double rk_alpha,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const DCArrayKokkos<double>& node_force,
+    const size_t rk_bin
+    )
+{
+    constexpr size_t W = SGH_SIMD_WIDTH;
+
+    // scatter into the nodal force when one is given
+    const bool scatter_force = (node_force.size() > 0);
+
+    // loop over the listed elements, or all of them if there is no list
+    const size_t num_loop_elems = (num_list_elems < 0) ? mesh.num_elems : (size_t)num_list_elems;
+    const size_t num_packs = (num_loop_elems + W - 1) / W;
+
+    FOR_ALL(pack_gid, 0, num_packs, {
+        const size_t num_nodes_in_elem = 8;
+
+        // ---- the elements in this pack, unused lanes repeat the last element ----
+        size_t elem_gids[W];
+        bool   lane_valid[W];
+        for (size_t lane = 0; lane < W; lane++) {
+            size_t list_lid = pack_gid * W + lane;
+            lane_valid[lane] = (list_lid < num_loop_elems);
+            if (!lane_valid[lane]) {
+                list_lid = num_loop_elems - 1;
+            }
+            elem_gids[lane] = (num_list_elems < 0) ? list_lid : elem_list(list_lid);
+        } // end for lane
+
+        // ---- gather the node data into [node][lane] packs ----
+        double x[8][W], y[8][W], z[8][W];
+        double u[8][W], v[8][W], w[8][W];
+
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            for (size_t lane = 0; lane < W; lane++) {
+                const size_t node_gid = mesh.nodes_in_elem(elem_gids[lane], node_lid);
+
+                x[node_lid][lane] = node_coords(rk_bin, node_gid, 0);
+                y[node_lid][lane] = node_coords(rk_bin, node_gid, 1);
+                z[node_lid][lane] = node_coords(rk_bin, node_gid, 2);
+
+                u[node_lid][lane] = node_vel(rk_bin, node_gid, 0);
+                v[node_lid][lane] = node_vel(rk_bin, node_gid, 1);
+                w[node_lid][lane] = node_vel(rk_bin, node_gid, 2);
+            } // end for lane
+        } // end for node_lid
+
+        // ---- gather the element data ----
+        double vol[W], div[W], pres[W], den[W], sspd[W];
+        double q1[W], q2[W];
+        double tau[3][3][W];
+
+        for (size_t lane = 0; lane < W; lane++) {
+            const size_t elem_gid = elem_gids[lane];
+            const size_t mat_id   = elem_mat_id(elem_gid);
+
+            vol[lane]  = elem_vol(elem_gid);
+            div[lane]  = elem_div(elem_gid);
+            pres[lane] = elem_pres(elem_gid);
+            den[lane]  = elem_den(elem_gid);
+            sspd[lane] = elem_sspd(elem_gid);
+
+            // compression or expansion coefficients, selected by the divergence sign
+            q1[lane] = (div[lane] < 0) ? material(mat_id).q1 : material(mat_id).q1ex;
+            q2[lane] = (div[lane] < 0) ? material(mat_id).q2 : material(mat_id).q2ex;
+
+            for (size_t i = 0; i < 3; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    tau[i][j][lane] = elem_stress(rk_bin, elem_gid, i, j);
+                }
+            }
+        } // end for lane
+
+        // ---- B matrix, the OUTWARD corner area normals ----
+        double b_x[8][W], b_y[8][W], b_z[8][W];
+        get_bmatrix_column_simd(b_x, y, z);
+        get_bmatrix_column_simd(b_y, z, x);
+        get_bmatrix_column_simd(b_z, x, y);
+
+        // ---- velocity gradient and curl ----
+        double mag_curl[W];
+        for (size_t lane = 0; lane < W; lane++) {
+            double grad[3][3];
+            for (size_t i = 0; i < 3; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    grad[i][j] = 0.0;
+                }
+            }
+
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                grad[0][0] += u[node_lid][lane] * b_x[node_lid][lane];
+                grad[0][1] += u[node_lid][lane] * b_y[node_lid][lane];
+                grad[0][2] += u[node_lid][lane] * b_z[node_lid][lane];
+                grad[1][0] += v[node_lid][lane] * b_x[node_lid][lane];
+                grad[1][1] += v[node_lid][lane] * b_y[node_lid][lane];
+                grad[1][2] += v[node_lid][lane] * b_z[node_lid][lane];
+                grad[2][0] += w[node_lid][lane] * b_x[node_lid][lane];
+                grad[2][1] += w[node_lid][lane] * b_y[node_lid][lane];
+                grad[2][2] += w[node_lid][lane] * b_z[node_lid][lane];
+            } // end for node_lid
+
+            const double inverse_vol = 1.0 / vol[lane];
+
+            const double curl_0 = (grad[2][1] - grad[1][2]) * inverse_vol;  // dw/dy - dv/dz
+            const double curl_1 = (grad[0][2] - grad[2][0]) * inverse_vol;  // du/dz - dw/dx
+            const double curl_2 = (grad[1][0] - grad[0][1]) * inverse_vol;  // dv/dx - du/dy
+
+            mag_curl[lane] = sqrt(curl_0 * curl_0 + curl_1 * curl_1 + curl_2 * curl_2);
+
+            // add the pressure to the Cauchy stress
+            for (size_t i = 0; i < 3; i++) {
+                tau[i][i][lane] -= pres[lane];
+            }
+        } // end for lane
+
+        // the -1 is for the inward surface area normal
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            for (size_t lane = 0; lane < W; lane++) {
+                b_x[node_lid][lane] = -b_x[node_lid][lane];
+                b_y[node_lid][lane] = -b_y[node_lid][lane];
+                b_z[node_lid][lane] = -b_z[node_lid][lane];
+            }
+        }
+
+        // ---- Multi-directional Approximate Riemann solver (MARS) ----
+        double vel_star[3][W];
+        double sum[4][W];
+        double muc[8][W];
+
+        for (size_t lane = 0; lane < W; lane++) {
+            // the average velocity of the elem is an estimate of the Riemann velocity
+            double avg_u = 0.0;
+            double avg_v = 0.0;
+            double avg_w = 0.0;
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                avg_u += 0.125 * u[node_lid][lane];
+                avg_v += 0.125 * v[node_lid][lane];
+                avg_w += 0.125 * w[node_lid][lane];
+            }
+
+            sum[0][lane] = 0.0;
+            sum[1][lane] = 0.0;
+            sum[2][lane] = 0.0;
+            sum[3][lane] = 0.0;
+
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                const double du = u[node_lid][lane] - avg_u;
+                const double dv = v[node_lid][lane] - avg_v;
+                const double dw = w[node_lid][lane] - avg_w;
+                const double mag_vel = sqrt(du * du + dv * dv + dw * dw);
+
+                // using a full tensoral Riemann jump relation
+                const double mag_area = sqrt(b_x[node_lid][lane] * b_x[node_lid][lane]
+                                             + b_y[node_lid][lane] * b_y[node_lid][lane]
+                                             + b_z[node_lid][lane] * b_z[node_lid][lane]);
+
+                const double mu_term = den[lane] * (q1[lane] * sspd[lane] + q2[lane] * mag_vel) * mag_area;
+
+                sum[0][lane] += mu_term * u[node_lid][lane];
+                sum[1][lane] += mu_term * v[node_lid][lane];
+                sum[2][lane] += mu_term * w[node_lid][lane];
+                sum[3][lane] += mu_term;
+
+                muc[node_lid][lane] = mu_term; // the impedance time surface area is stored here
+            } // end for node_lid
+
+            // the Riemann velocity, called vel_star
+            const double inverse_sum = (sum[3][lane] > fuzz) ? 1.0 / sum[3][lane] : 0.0;
+            vel_star[0][lane] = sum[0][lane] * inverse_sum;
+            vel_star[1][lane] = sum[1][lane] * inverse_sum;
+            vel_star[2][lane] = sum[2][lane] * inverse_sum;
+        } // end for lane
+
+        // ---- shock detector, the neighbor count differs per lane ----
+        double phi[W];
+        for (size_t lane = 0; lane < W; lane++) {
+            const size_t elem_gid = elem_gids[lane];
+
+            const double r_coef = 0.9;  // the coefficient on the ratio
+            const double n_coef = 1.0;  // the power on the limiting coefficient
+            double r_min = 1.0;         // the min ratio for the cell
+
+            for (size_t elem_lid = 0; elem_lid < mesh.num_elems_in_elem(elem_gid); elem_lid++) {
+                const size_t neighbor_gid = mesh.elems_in_elem(elem_gid, elem_lid);
+                const double r_face = r_coef * (elem_div(neighbor_gid) + small) / (div[lane] + small);
+                r_min = fmin(r_face, r_min);
+            }
+
+            phi[lane] = pow(1.0 - fmax(0.0, r_min), n_coef);
+        } // end for lane
+
+        for (size_t lane = 0; lane < W; lane++) {
+            // Mach number shock detector
+            const double omega    = 20.0; // weighting factor on Mach number
+            const double c_length = pow(vol[lane], 1.0 / 3.0); // characteristic length
+            const double alpha    = fmin(1.0, omega * (c_length * fabs(div[lane])) / (sspd[lane] + fuzz));
+
+            phi[lane] = alpha * phi[lane];
+        } // end for lane
+
+        // ---- corner forces, computed in the packs then scattered ----
+        double force_x[8][W], force_y[8][W], force_z[8][W];
+
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            for (size_t lane = 0; lane < W; lane++) {
+                const double ax = b_x[node_lid][lane];
+                const double ay = b_y[node_lid][lane];
+                const double az = b_z[node_lid][lane];
+                const double damp = phi[lane] * muc[node_lid][lane];
+
+                force_x[node_lid][lane] = ax * tau[0][0][lane] + ay * tau[1][0][lane] + az * tau[2][0][lane]
+                                          + damp * (vel_star[0][lane] - u[node_lid][lane]);
+                force_y[node_lid][lane] = ax * tau[0][1][lane] + ay * tau[1][1][lane] + az * tau[2][1][lane]
+                                          + damp * (vel_star[1][lane] - v[node_lid][lane]);
+                force_z[node_lid][lane] = ax * tau[0][2][lane] + ay * tau[1][2][lane] + az * tau[2][2][lane]
+                                          + damp * (vel_star[2][lane] - w[node_lid][lane]);
+            } // end for lane
+        } // end for node_lid
+
+        for (size_t lane = 0; lane < W; lane++) {
+            if (!lane_valid[lane]) {
+                continue;
+            }
+
+            const size_t elem_gid = elem_gids[lane];
+
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                const size_t corner_gid = mesh.corners_in_elem(elem_gid, node_lid);
+
+                corner_force(corner_gid, 0) = force_x[node_lid][lane];
+                corner_force(corner_gid, 1) = force_y[node_lid][lane];
+                corner_force(corner_gid, 2) = force_z[node_lid][lane];
+
+                if (scatter_force) {
+                    const size_t node_gid = mesh.nodes_in_elem(elem_gid, node_lid);
+                    Kokkos::atomic_add(&node_force(node_gid, 0), force_x[node_lid][lane]);
+                    Kokkos::atomic_add(&node_force(node_gid, 1), force_y[node_lid][lane]);
+                    Kokkos::atomic_add(&node_force(node_gid, 2), force_z[node_lid][lane]);
+                }
+            } // end for node_lid
+        } // end for lane
+
+        // the hypo strength update of get_force is still a placeholder, so there is nothing to pack
+    }); // end parallel for over element packs
+
+    return;
+} // end of routine
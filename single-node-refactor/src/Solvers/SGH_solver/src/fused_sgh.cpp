@@ -0,0 +1,531 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#include "sgh_solver.h"
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_force_fused
+///
+/// \brief Fused element pass for a 3D RK stage
+///
+/// Computes the B matrix, velocity gradient, divergence of velocity and
+/// the corner forces in a single loop over the elements.  This replaces
+/// the get_divergence and get_force passes.  The divergence computed here
+/// is written to elem_div_new so that the shock detector can read the
+/// neighbor divergence (elem_div) from the previous stage without a race;
+/// update_energy_state_fused copies it back into elem_div.
+///
+/// \param An array of material_t that contains material specific data
+/// \param The simulation mesh
+/// \param A view into the nodal position array
+/// \param A view into the nodal velocity array
+/// \param A view into the element density array
+/// \param A view into the element specific internal energy array
+/// \param A view into the element pressure array
+/// \param A view into the element stress array
+/// \param A view into the element sound speed array
+/// \param A view into the element volume array
+/// \param A view into the element divergence of velocity array (previous stage)
+/// \param Scratch array for the element divergence of velocity at this stage
+/// \param A view into the element material identifier array
+/// \param A view into the corner force data
+/// \param fuzz
+/// \param small
+/// \param Element state variable array
+/// \param Time step size
+/// \param The current Runge Kutta integration alpha value
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::get_force_fused(const CArrayKokkos<material_t>& material,
+    const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& elem_den,
+    const DCArrayKokkos<double>& elem_sie,
+    const DCArrayKokkos<double>& elem_pres,
+    const DCArrayKokkos<double>& elem_stress,
+    const DCArrayKokkos<double>& elem_sspd,
+    const DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<double>& elem_div,
+    const CArrayKokkos<double>&  elem_div_new,
+    const DCArrayKokkos<size_t>& elem_mat_id,
+    DCArrayKokkos<double>& corner_force,
+    const double fuzz,
+    const double small,
+    const DCArrayKokkos<double>& elem_statev,
+    const double dt,
+    const double rk_alpha
+    )
+{
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        const size_t num_dims = 3;
+        const size_t num_nodes_in_elem = 8;
+
+        // total Cauchy stress
+        double tau_array[9];
+
+        // corner area normals
+        double area_normal_array[24];
+
+        // the sums in the Riemann solver
+        double sum_array[4];
+
+        // corner shock impedance x |corner area normal|
+        double muc_array[8];
+
+        // Riemann velocity
+        double vel_star_array[3];
+
+        // velocity gradient
+        double vel_grad_array[9];
+
+        // nodal velocities of the element, gathered once
+        double elem_vel_array[24];
+
+        ViewCArrayKokkos<double> tau(tau_array, num_dims, num_dims);
+        ViewCArrayKokkos<double> area_normal(area_normal_array, num_nodes_in_elem, num_dims);
+        ViewCArrayKokkos<double> sum(sum_array, 4);
+        ViewCArrayKokkos<double> muc(muc_array, num_nodes_in_elem);
+        ViewCArrayKokkos<double> vel_star(vel_star_array, num_dims);
+        ViewCArrayKokkos<double> vel_grad(vel_grad_array, num_dims, num_dims);
+        ViewCArrayKokkos<double> elem_vel(elem_vel_array, num_nodes_in_elem, num_dims);
+
+        // element volume, current with node_coords from the previous stage
+        double vol = elem_vol(elem_gid);
+
+        // create a view of the stress_matrix
+        ViewCArrayKokkos<double> stress(&elem_stress(1, elem_gid, 0, 0), 3, 3);
+
+        // cut out the node_gids for this element
+        ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), 8);
+
+        // get the B matrix which are the OUTWARD corner area normals
+        geometry::get_bmatrix(area_normal,
+                              elem_gid,
+                              node_coords,
+                              elem_node_gids);
+
+        // gather the nodal velocities and the average (Riemann velocity estimate)
+        for (size_t dim = 0; dim < num_dims; dim++) {
+            vel_star(dim) = 0.0;
+        }
+
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = elem_node_gids(node_lid);
+
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                elem_vel(node_lid, dim) = node_vel(1, node_gid, dim);
+                vel_star(dim) += 0.125 * elem_vel(node_lid, dim);
+            }
+        } // end for node_lid
+
+        // --- Calculate the velocity gradient and divergence ---
+        double inverse_vol = 1.0 / vol;
+        for (size_t i = 0; i < num_dims; i++) {
+            for (size_t j = 0; j < num_dims; j++) {
+                double grad = 0.0;
+                for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                    grad += elem_vel(node_lid, i) * area_normal(node_lid, j);
+                }
+                vel_grad(i, j) = grad * inverse_vol;
+            }
+        } // end for i
+
+        double div = vel_grad(0, 0) + vel_grad(1, 1) + vel_grad(2, 2);
+        elem_div_new(elem_gid) = div;
+
+        // the -1 is for the inward surface area normal,
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                area_normal(node_lid, dim) = (-1.0) * area_normal(node_lid, dim);
+            } // end for
+        } // end for
+
+        // --- Calculate the Cauchy stress ---
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                tau(i, j) = stress(i, j);
+            } // end for
+        } // end for
+
+        // add the pressure
+        for (int i = 0; i < num_dims; i++) {
+            tau(i, i) -= elem_pres(elem_gid);
+        } // end for
+
+        // ---- Multi-directional Approximate Riemann solver (MARS) ----
+
+        // initialize sum term in MARS to zero
+        for (int i = 0; i < 4; i++) {
+            sum(i) = 0.0;
+        }
+
+        size_t mat_id = elem_mat_id(elem_gid);
+
+        // loop over the nodes of the elem
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            double mag_vel = sqrt( (elem_vel(node_lid, 0) - vel_star(0) ) * (elem_vel(node_lid, 0) - vel_star(0) )
+                + (elem_vel(node_lid, 1) - vel_star(1) ) * (elem_vel(node_lid, 1) - vel_star(1) )
+                + (elem_vel(node_lid, 2) - vel_star(2) ) * (elem_vel(node_lid, 2) - vel_star(2) ) );
+
+            // cell divergence indicates compression or expansions
+            if (div < 0) { // element in compression
+                muc(node_lid) = elem_den(elem_gid) *
+                                (material(mat_id).q1 * elem_sspd(elem_gid) + material(mat_id).q2 * mag_vel);
+            }
+            else{  // element in expansion
+                muc(node_lid) = elem_den(elem_gid) *
+                                (material(mat_id).q1ex * elem_sspd(elem_gid) + material(mat_id).q2ex * mag_vel);
+            } // end if on divergence sign
+
+            // Using a full tensoral Riemann jump relation
+            double mu_term = muc(node_lid)
+                             * sqrt(area_normal(node_lid, 0) * area_normal(node_lid, 0)
+                + area_normal(node_lid, 1) * area_normal(node_lid, 1)
+                + area_normal(node_lid, 2) * area_normal(node_lid, 2) );
+
+            sum(0) += mu_term * elem_vel(node_lid, 0);
+            sum(1) += mu_term * elem_vel(node_lid, 1);
+            sum(2) += mu_term * elem_vel(node_lid, 2);
+            sum(3) += mu_term;
+
+            muc(node_lid) = mu_term; // the impedance time surface area is stored here
+        } // end for node_lid loop over nodes of the elem
+
+        // The Riemann velocity, called vel_star
+        if (sum(3) > fuzz) {
+            for (size_t i = 0; i < num_dims; i++) {
+                vel_star(i) = sum(i) / sum(3);
+            }
+        }
+        else{
+            for (int i = 0; i < num_dims; i++) {
+                vel_star(i) = 0.0;
+            }
+        } // end if
+
+        // ---- Calculate the shock detector for the Riemann-solver ----
+        // same limiter as get_force, the neighbor divergence is lagged one stage
+        double r_face = 1.0;  // the ratio on the face
+        double r_min  = 1.0;  // the min ratio for the cell
+        double r_coef = 0.9;  // the coefficient on the ratio
+        double n_coef = 1.0;  // the power on the limiting coefficient
+
+        for (size_t elem_lid = 0; elem_lid < mesh.num_elems_in_elem(elem_gid); elem_lid++) {
+            size_t neighbor_gid = mesh.elems_in_elem(elem_gid, elem_lid);
+
+            r_face = r_coef * (elem_div(neighbor_gid) + small) / (div + small);
+
+            r_min = fmin(r_face, r_min);
+        } // end for elem_lid
+
+        double phi = 1.0 - fmax(0.0, r_min);
+        phi = pow(phi, n_coef);
+
+        //  Mach number shock detector
+        double omega    = 20.0; // weighting factor on Mach number
+        double third    = 1.0 / 3.0;
+        double c_length = pow(vol, third); // characteristic length
+        double alpha    = fmin(1.0, omega * (c_length * fabs(div)) / (elem_sspd(elem_gid) + fuzz) );
+
+        phi = alpha * phi;
+
+        // ---- Calculate the Riemann force on each node ----
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t corner_gid = mesh.corners_in_elem(elem_gid, node_lid);
+
+            for (int dim = 0; dim < num_dims; dim++) {
+                corner_force(corner_gid, dim) =
+                    area_normal(node_lid, 0) * tau(0, dim)
+                    + area_normal(node_lid, 1) * tau(1, dim)
+                    + area_normal(node_lid, 2) * tau(2, dim)
+                    + phi * muc(node_lid) * (vel_star(dim) - elem_vel(node_lid, dim));
+            } // end loop over dimension
+        } // end for loop over nodes in elem
+
+        // hypo elastic plastic model, vel_grad is available for the strength model
+        if (material(mat_id).strength_type == model::hypo) {
+            // --- call strength model ---
+            // material(mat_id).strength_model(elem_pres,
+            //                                 elem_stress,
+            //                                 elem_gid,
+            //                                 mat_id,
+            //                                 elem_statev,
+            //                                 elem_sspd,
+            //                                 elem_den(elem_gid),
+            //                                 elem_sie(elem_gid),
+            //                                 vel_grad,
+            //                                 elem_node_gids,
+            //                                 node_coords,
+            //                                 node_vel,
+            //                                 vol,
+            //                                 dt,
+            //                                 rk_alpha);
+        } // end logical on hypo strength model
+    }); // end parallel for loop over elements
+
+    return;
+} // end of routine
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn update_velocity_position_fused
+///
+/// \brief Fused node pass that evolves the nodal velocity and position
+///
+/// Replaces the update_velocity and update_position passes.  Nodes with
+/// velocity boundary conditions are corrected afterwards by boundary_position.
+///
+/// \param Runge Kutta time integration alpha
+/// \param Time step size
+/// \param The simulation mesh
+/// \param View of the nodal position data
+/// \param View of the nodal velocity array
+/// \param View of the nodal mass array
+/// \param View of the corner forces
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::update_velocity_position_fused(double rk_alpha,
+    double dt,
+    const mesh_t& mesh,
+    DCArrayKokkos<double>& node_coords,
+    DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& node_mass,
+    const DCArrayKokkos<double>& corner_force
+    )
+{
+    const size_t num_dims = mesh.num_dims;
+
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        double node_force[3];
+        for (size_t dim = 0; dim < num_dims; dim++) {
+            node_force[dim] = 0.0;
+        } // end for dim
+
+        // loop over all corners around the node and calculate the nodal force
+        for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
+            size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
+
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                node_force[dim] += corner_force(corner_gid, dim);
+            } // end for dim
+        } // end for corner_lid
+
+        // update the velocity and then the position with the half step velocity
+        for (int dim = 0; dim < num_dims; dim++) {
+            node_vel(1, node_gid, dim) = node_vel(0, node_gid, dim) +
+                                         rk_alpha * dt * node_force[dim] / node_mass(node_gid);
+
+            double half_vel = (node_vel(1, node_gid, dim) + node_vel(0, node_gid, dim)) * 0.5;
+            node_coords(1, node_gid, dim) = node_coords(0, node_gid, dim) + rk_alpha * dt * half_vel;
+        } // end for dim
+    }); // end for parallel for over nodes
+
+    return;
+} // end subroutine update_velocity_position_fused
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn boundary_position
+///
+/// \brief Re-integrates the position of the boundary set nodes
+///
+/// Used by the fused path after boundary_velocity has modified the
+/// velocity of the boundary nodes.
+///
+/// \param Runge Kutta time integration alpha
+/// \param Time step size
+/// \param The simulation mesh
+/// \param View of the nodal position data
+/// \param View of the nodal velocity data
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::boundary_position(double rk_alpha,
+    double dt,
+    const mesh_t& mesh,
+    DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel)
+{
+    const size_t num_dims = mesh.num_dims;
+
+    FOR_ALL(bdy_node_lid, 0, mesh.num_bdy_nodes, {
+        size_t node_gid = mesh.bdy_nodes(bdy_node_lid);
+
+        for (int dim = 0; dim < num_dims; dim++) {
+            double half_vel = (node_vel(1, node_gid, dim) + node_vel(0, node_gid, dim)) * 0.5;
+            node_coords(1, node_gid, dim) = node_coords(0, node_gid, dim) + rk_alpha * dt * half_vel;
+        }
+    }); // end parallel for over boundary nodes
+
+    return;
+} // end subroutine boundary_position
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn update_energy_state_fused
+///
+/// \brief Fused element pass that updates energy, volume, and state
+///
+/// Replaces the update_energy, geometry::get_vol and update_state passes
+/// for 3D meshes, and copies the divergence from get_force_fused into
+/// elem_div.
+///
+/// \param An array of material_t that contains material specific data
+/// \param The simulation mesh
+/// \param A view into the nodal position array
+/// \param A view into the nodal velocity array
+/// \param A view into the element density array
+/// \param A view into the element pressure array
+/// \param A view into the element stress array
+/// \param A view into the element sound speed array
+/// \param A view into the element specific internal energy array
+/// \param A view into the element volume array
+/// \param A view into the element mass
+/// \param A view into the element divergence of velocity array
+/// \param Divergence of velocity computed in get_force_fused
+/// \param A view into the element material identifier array
+/// \param A view into the element state variables
+/// \param A view into the corner force data
+/// \param Time step size
+/// \param The current Runge Kutta integration alpha value
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::update_energy_state_fused(const CArrayKokkos<material_t>& material,
+    const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel,
+    DCArrayKokkos<double>& elem_den,
+    DCArrayKokkos<double>& elem_pres,
+    DCArrayKokkos<double>& elem_stress,
+    DCArrayKokkos<double>& elem_sspd,
+    DCArrayKokkos<double>& elem_sie,
+    DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<double>& elem_mass,
+    DCArrayKokkos<double>& elem_div,
+    const CArrayKokkos<double>&  elem_div_new,
+    const DCArrayKokkos<size_t>& elem_mat_id,
+    const DCArrayKokkos<double>& elem_statev,
+    const DCArrayKokkos<double>& corner_force,
+    const double dt,
+    const double rk_alpha
+    )
+{
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        const size_t num_dims = 3;
+        const size_t num_nodes_in_elem = 8;
+
+        // cut out the node_gids for this element
+        ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
+
+        // --- Specific internal energy, Power = F dot V over the corners ---
+        double elem_power = 0.0;
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid   = elem_node_gids(node_lid);
+            size_t corner_gid = mesh.corners_in_elem(elem_gid, node_lid);
+
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                double half_vel = (node_vel(1, node_gid, dim) + node_vel(0, node_gid, dim)) * 0.5;
+                elem_power += corner_force(corner_gid, dim) * half_vel;
+            } // end for dim
+        } // end for node_lid
+
+        elem_sie(1, elem_gid) = elem_sie(0, elem_gid) -
+                                rk_alpha * dt / elem_mass(elem_gid) * elem_power;
+
+        // --- Volume for the next stage ---
+        geometry::get_vol_hex(elem_vol, elem_gid, node_coords, elem_node_gids);
+
+        // --- Divergence for the next stage shock detector ---
+        elem_div(elem_gid) = elem_div_new(elem_gid);
+
+        // --- Density ---
+        elem_den(elem_gid) = elem_mass(elem_gid) / elem_vol(elem_gid);
+
+        size_t mat_id = elem_mat_id(elem_gid);
+
+        // --- Stress ---
+        // hyper elastic plastic model
+        if (material(mat_id).strength_type == model::hyper) {
+            // corner area normals
+            double area_array[24];
+            ViewCArrayKokkos<double> area(area_array, num_nodes_in_elem, num_dims);
+
+            // velocity gradient
+            double vel_grad_array[9];
+            ViewCArrayKokkos<double> vel_grad(vel_grad_array, num_dims, num_dims);
+
+            // get the B matrix which are the OUTWARD corner area normals
+            geometry::get_bmatrix(area, elem_gid, node_coords, elem_node_gids);
+
+            // --- Calculate the velocity gradient ---
+            get_velgrad(vel_grad,
+                        elem_node_gids,
+                        node_vel,
+                        area,
+                        elem_vol(elem_gid),
+                        elem_gid);
+
+            // --- call strength model ---
+            // material(mat_id).strength_model(elem_pres,
+            //                                 elem_stress,
+            //                                 elem_gid,
+            //                                 mat_id,
+            //                                 elem_statev,
+            //                                 elem_sspd,
+            //                                 elem_den(elem_gid),
+            //                                 elem_sie(1, elem_gid),
+            //                                 vel_grad,
+            //                                 elem_node_gids,
+            //                                 node_coords,
+            //                                 node_vel,
+            //                                 elem_vol(elem_gid),
+            //                                 dt,
+            //                                 rk_alpha);
+        } // end logical on hyper strength model
+
+        // --- Pressure ---
+        material(mat_id).eos_model(elem_pres,
+                                   elem_stress,
+                                   elem_gid,
+                                   elem_mat_id(elem_gid),
+                                   elem_statev,
+                                   elem_sspd,
+                                   elem_den(elem_gid),
+                                   elem_sie(1, elem_gid));
+    }); // end parallel for
+    Kokkos::fence();
+
+    return;
+} // end subroutine update_energy_state_fused
@@ -0,0 +1,631 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#include "sgh_solver.h"
+
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_coarsest_level
+///
+/// \brief Returns the coarsest level whose step begins (or ends) at a fine
+///        substep.  Level l takes steps of 2^(num_levels-1-l) fine substeps,
+///        so every level at or finer than the returned one is on a step edge.
+///
+/// \param Fine substep index within the coarse step
+/// \param Number of time step levels
+///
+/////////////////////////////////////////////////////////////////////////////
+static size_t lts_coarsest_level(const size_t substep, const size_t num_levels)
+{
+    for (size_t level = 0; level < num_levels; level++) {
+        const size_t level_substeps = (size_t)1 << (num_levels - 1 - level);
+        if (substep % level_substeps == 0) {
+            return level;
+        }
+    }
+
+    return num_levels - 1;
+} // end lts_coarsest_level
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_setup
+///
+/// \brief Allocates the local time stepping level and work arrays
+///
+/// \param The simulation mesh
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_setup(const mesh_t& mesh)
+{
+    lts_elem_dt     = CArrayKokkos<double>(mesh.num_elems);
+    lts_elem_level  = DCArrayKokkos<size_t>(mesh.num_elems);
+    lts_node_level  = DCArrayKokkos<size_t>(mesh.num_nodes);
+    lts_corner_work = CArrayKokkos<double>(mesh.num_corners);
+
+    lts_corner_work.set_values(0.0);
+
+    lts_elem_lists.assign(lts_num_levels, DCArrayKokkos<size_t>());
+    lts_node_lists.assign(lts_num_levels, DCArrayKokkos<size_t>());
+    lts_num_elems_in_level.assign(lts_num_levels, 0);
+    lts_num_nodes_in_level.assign(lts_num_levels, 0);
+
+    return;
+} // end lts_setup
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_lts_timestep
+///
+/// \brief Calculates the coarse time step and bins every element into a
+///        power-of-two level of it.  The coarse step is up to 2^(levels-1)
+///        times the smallest stable element step.  A node takes the level
+///        of the finest element around it.
+///
+/// \param The simulation mesh
+/// \param View of nodal position data
+/// \param View of element sound speed
+/// \param Current time value
+/// \param Value of time to output graphics
+/// \param Final time of the simulation
+/// \param Maximum allowable time step
+/// \param Minimum allowable time step
+/// \param CFL number
+/// \param Coarse time step, input is the previous value
+/// \param Small number to prevent division by zero
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::get_lts_timestep(const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& elem_sspd,
+    double time_value,
+    const double graphics_time,
+    const double time_final,
+    const double dt_max,
+    const double dt_min,
+    const double dt_cfl,
+    double&      dt,
+    const double fuzz)
+{
+    auto elem_dt    = lts_elem_dt;
+    auto elem_level = lts_elem_level;
+    auto node_level = lts_node_level;
+
+    // increase dt by 10%, that is the largest dt value
+    dt = dt * 1.1;
+
+    double dt_lcl;
+    double min_dt_calc;
+    REDUCE_MIN(elem_gid, 0, mesh.num_elems, dt_lcl, {
+        // smallest distance between any two nodes of the hex
+        double dist_min = 1.0e30;
+        for (size_t node_a = 0; node_a < 8; node_a++) {
+            const size_t node_gid_a = mesh.nodes_in_elem(elem_gid, node_a);
+
+            for (size_t node_b = node_a + 1; node_b < 8; node_b++) {
+                const size_t node_gid_b = mesh.nodes_in_elem(elem_gid, node_b);
+
+                double dist = 0.0;
+                for (size_t dim = 0; dim < 3; dim++) {
+                    const double delta = node_coords(1, node_gid_b, dim) - node_coords(1, node_gid_a, dim);
+                    dist += delta * delta;
+                } // end for dim
+                dist_min = fmin(dist_min, sqrt(dist));
+            } // end for node_b
+        } // end for node_a
+
+        // local dt calc based on CFL
+        double dt_lcl_ = dt_cfl * dist_min / (elem_sspd(elem_gid) + fuzz);
+
+        // make dt be in bounds
+        dt_lcl_ = fmin(dt_lcl_, dt_max);
+        dt_lcl_ = fmax(dt_lcl_, dt_min);
+
+        elem_dt(elem_gid) = dt_lcl_;
+
+        if (dt_lcl_ < dt_lcl) {
+            dt_lcl = dt_lcl_;
+        }
+    }, min_dt_calc);  // end parallel reduction
+    Kokkos::fence();
+
+    // the coarse step is the finest stable step scaled to the coarsest level
+    const size_t max_level = lts_num_levels - 1;
+
+    dt = fmin(dt, min_dt_calc * (double)((size_t)1 << max_level));
+    dt = fmin(dt, dt_max);
+
+    // ensure time step hits the graphics time intervals
+    dt = fmin(dt, (graphics_time - time_value) + fuzz);
+
+    // make dt be exact for final time
+    dt = fmin(dt, time_final - time_value);
+
+    // ---- bin the elements, level l advances with dt/2^l ----
+    const double dt_coarse = dt;
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        double ratio = dt_coarse / elem_dt(elem_gid);
+        size_t level = 0;
+
+        while (level < max_level && ratio > 1.0) {
+            ratio *= 0.5;
+            level++;
+        }
+
+        elem_level(elem_gid) = level;
+    }); // end parallel for
+
+    // ---- a node advances with the finest element around it ----
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        size_t level = 0;
+
+        for (size_t elem_lid = 0; elem_lid < mesh.num_corners_in_node(node_gid); elem_lid++) {
+            const size_t elem_gid = mesh.elems_in_node(node_gid, elem_lid);
+            if (elem_level(elem_gid) > level) {
+                level = elem_level(elem_gid);
+            }
+        } // end for elem_lid
+
+        node_level(node_gid) = level;
+    }); // end parallel for
+    Kokkos::fence();
+
+    lts_sort_levels(mesh);
+
+    return;
+} // end get_lts_timestep
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_sort_levels
+///
+/// \brief Counting sort of the elements and nodes into one list per level
+///
+/// \param The simulation mesh
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_sort_levels(const mesh_t& mesh)
+{
+    lts_elem_level.update_host();
+    lts_node_level.update_host();
+
+    std::fill(lts_num_elems_in_level.begin(), lts_num_elems_in_level.end(), 0);
+    std::fill(lts_num_nodes_in_level.begin(), lts_num_nodes_in_level.end(), 0);
+
+    for (size_t elem_gid = 0; elem_gid < mesh.num_elems; elem_gid++) {
+        lts_num_elems_in_level[lts_elem_level.host(elem_gid)]++;
+    }
+    for (size_t node_gid = 0; node_gid < mesh.num_nodes; node_gid++) {
+        lts_num_nodes_in_level[lts_node_level.host(node_gid)]++;
+    }
+
+    // only reallocate a list when its level changed size
+    for (size_t level = 0; level < (size_t)lts_num_levels; level++) {
+        if (lts_num_elems_in_level[level] > 0 && lts_elem_lists[level].size() != lts_num_elems_in_level[level]) {
+            lts_elem_lists[level] = DCArrayKokkos<size_t>(lts_num_elems_in_level[level]);
+        }
+        if (lts_num_nodes_in_level[level] > 0 && lts_node_lists[level].size() != lts_num_nodes_in_level[level]) {
+            lts_node_lists[level] = DCArrayKokkos<size_t>(lts_num_nodes_in_level[level]);
+        }
+    } // end for level
+
+    std::vector<size_t> elem_count(lts_num_levels, 0);
+    std::vector<size_t> node_count(lts_num_levels, 0);
+
+    for (size_t elem_gid = 0; elem_gid < mesh.num_elems; elem_gid++) {
+        const size_t level = lts_elem_level.host(elem_gid);
+        lts_elem_lists[level].host(elem_count[level]++) = elem_gid;
+    }
+    for (size_t node_gid = 0; node_gid < mesh.num_nodes; node_gid++) {
+        const size_t level = lts_node_level.host(node_gid);
+        lts_node_lists[level].host(node_count[level]++) = node_gid;
+    }
+
+    for (size_t level = 0; level < (size_t)lts_num_levels; level++) {
+        if (lts_num_elems_in_level[level] > 0) {
+            lts_elem_lists[level].update_device();
+        }
+        if (lts_num_nodes_in_level[level] > 0) {
+            lts_node_lists[level].update_device();
+        }
+    } // end for level
+    Kokkos::fence();
+
+    return;
+} // end lts_sort_levels
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_advance
+///
+/// \brief Advances the solution one coarse step with local time stepping.
+///        The coarse step is split into 2^(levels-1) fine substeps.  At each
+///        substep the levels starting a step take the rk_num_stages stages
+///        of the global RK scheme over their own step: every stage
+///        recomputes their corner forces and moves their nodes, and the
+///        stages before the last update their volume and state.  The levels
+///        ending a step then update energy, volume and state.  Interface
+///        nodes belong to the finest level around them, so a coarse element
+///        holds its corner forces while its fine nodes subcycle, and the
+///        work those nodes do over the last stage is tallied per corner so
+///        the energy exchange stays conservative.
+///
+/// \param Simulation parameters
+/// \param The simulation mesh
+/// \param The simulation node data
+/// \param The simulation element data
+/// \param The simulation corner data
+/// \param Time at the start of the coarse step
+/// \param Coarse time step
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_advance(simulation_parameters_t& sim_param,
+    mesh_t& mesh,
+    node_t& node,
+    elem_t& elem,
+    corner_t& corner,
+    const double time_value,
+    const double dt)
+{
+    const size_t num_levels   = lts_num_levels;
+    const size_t num_substeps = (size_t)1 << (num_levels - 1);
+    const double dt_fine      = dt / (double)num_substeps;
+    const size_t num_stages   = rk_num_stages;
+
+    for (size_t substep = 0; substep < num_substeps; substep++) {
+        const size_t start_level = lts_coarsest_level(substep, num_levels);
+        const size_t end_level   = lts_coarsest_level(substep + 1, num_levels);
+
+        const double substep_time = time_value + substep * dt_fine;
+
+        // ---- the levels starting a step integrate it with the RK stages ----
+        for (size_t rk_stage = 0; rk_stage < num_stages; rk_stage++) {
+            const double rk_alpha   = 1.0 / ((double)num_stages - (double)rk_stage);
+            const bool   last_stage = (rk_stage + 1 == num_stages);
+
+            // ---- corner forces of the elements starting a step ----
+            for (size_t level = start_level; level < num_levels; level++) {
+                const size_t num_elems_in_level = lts_num_elems_in_level[level];
+                if (num_elems_in_level == 0) {
+                    continue;
+                }
+
+                const double dt_level = dt / (double)((size_t)1 << level);
+
+                get_divergence(elem.div,
+                               mesh,
+                               node.coords,
+                               node.vel,
+                               elem.vol,
+                               lts_elem_lists[level],
+                               num_elems_in_level);
+
+                get_force(sim_param.materials,
+                          mesh,
+                          node.coords,
+                          node.vel,
+                          elem.den,
+                          elem.sie,
+                          elem.pres,
+                          elem.stress,
+                          elem.sspd,
+                          elem.vol,
+                          elem.div,
+                          elem.mat_id,
+                          corner.force,
+                          fuzz,
+                          small,
+                          elem.statev,
+                          dt_level,
+                          rk_alpha,
+                          lts_elem_lists[level],
+                          num_elems_in_level);
+            } // end for level
+
+            // ---- velocities of the nodes starting a step ----
+            for (size_t level = start_level; level < num_levels; level++) {
+                if (lts_num_nodes_in_level[level] == 0) {
+                    continue;
+                }
+
+                lts_update_velocity(rk_alpha,
+                                    dt / (double)((size_t)1 << level),
+                                    rk_stage == 0,
+                                    mesh,
+                                    lts_node_lists[level],
+                                    lts_num_nodes_in_level[level],
+                                    node.coords,
+                                    node.vel,
+                                    node.mass,
+                                    corner.force);
+            } // end for level
+
+            // ---- apply velocity boundary conditions, contact runs never take local steps ----
+            boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, substep_time);
+
+            // ---- positions of the nodes starting a step, the last stage tallies the corner work ----
+            for (size_t level = start_level; level < num_levels; level++) {
+                if (lts_num_nodes_in_level[level] == 0) {
+                    continue;
+                }
+
+                lts_update_position(rk_alpha,
+                                    dt / (double)((size_t)1 << level),
+                                    last_stage,
+                                    mesh,
+                                    lts_node_lists[level],
+                                    lts_num_nodes_in_level[level],
+                                    node.coords,
+                                    node.vel,
+                                    corner.force,
+                                    lts_corner_work);
+            } // end for level
+
+            if (last_stage) {
+                continue;
+            }
+
+            // ---- volume and state of the elements starting a step for the next stage ----
+            // the energy is only updated from the tallied work at the end of the step
+            for (size_t level = start_level; level < num_levels; level++) {
+                const size_t num_elems_in_level = lts_num_elems_in_level[level];
+                if (num_elems_in_level == 0) {
+                    continue;
+                }
+
+                geometry::get_vol(elem.vol,
+                                  node.coords,
+                                  mesh,
+                                  lts_elem_lists[level],
+                                  num_elems_in_level);
+
+                update_state<topology::hex8>(sim_param.materials,
+                                             mesh,
+                                             node.coords,
+                                             node.vel,
+                                             elem.den,
+                                             elem.pres,
+                                             elem.stress,
+                                             elem.sspd,
+                                             elem.sie,
+                                             elem.vol,
+                                             elem.mass,
+                                             elem.mat_id,
+                                             elem.statev,
+                                             dt / (double)((size_t)1 << level),
+                                             rk_alpha,
+                                             lts_elem_lists[level],
+                                             num_elems_in_level);
+            } // end for level
+        } // end for rk_stage
+
+        // ---- energy, volume and state of the elements ending a step ----
+        for (size_t level = end_level; level < num_levels; level++) {
+            const size_t num_elems_in_level = lts_num_elems_in_level[level];
+            if (num_elems_in_level == 0) {
+                continue;
+            }
+
+            const double dt_level = dt / (double)((size_t)1 << level);
+
+            lts_update_energy(mesh,
+                              lts_elem_lists[level],
+                              num_elems_in_level,
+                              node.coords,
+                              elem.sie,
+                              elem.vol,
+                              elem.mass,
+                              lts_corner_work);
+
+            update_state<topology::hex8>(sim_param.materials,
+                                         mesh,
+                                         node.coords,
+                                         node.vel,
+                                         elem.den,
+                                         elem.pres,
+                                         elem.stress,
+                                         elem.sspd,
+                                         elem.sie,
+                                         elem.vol,
+                                         elem.mass,
+                                         elem.mat_id,
+                                         elem.statev,
+                                         dt_level,
+                                         1.0,
+                                         lts_elem_lists[level],
+                                         num_elems_in_level);
+        } // end for level
+    } // end for substep
+
+    return;
+} // end lts_advance
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_update_velocity
+///
+/// \brief Saves the start-of-step nodal state in rk bin 0 at the first
+///        stage and evolves the velocity of the listed nodes over the stage
+///        fraction of their own time step
+///
+/// \param Runge Kutta time integration alpha
+/// \param Time step of the listed nodes
+/// \param True at the first stage of the step
+/// \param The simulation mesh
+/// \param List of the nodes to update
+/// \param Number of nodes in the list
+/// \param View of nodal position data
+/// \param View of nodal velocity data
+/// \param View of nodal mass data
+/// \param View of corner forces
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_update_velocity(const double rk_alpha,
+    const double dt,
+    const bool   step_start,
+    const mesh_t& mesh,
+    const DCArrayKokkos<size_t>& node_list,
+    const size_t num_list_nodes,
+    DCArrayKokkos<double>& node_coords,
+    DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& node_mass,
+    const DCArrayKokkos<double>& corner_force)
+{
+    FOR_ALL(list_lid, 0, num_list_nodes, {
+        const size_t node_gid = node_list(list_lid);
+
+        for (size_t dim = 0; dim < 3; dim++) {
+            if (step_start) {
+                node_coords(0, node_gid, dim) = node_coords(1, node_gid, dim);
+                node_vel(0, node_gid, dim)    = node_vel(1, node_gid, dim);
+            }
+
+            // sum the corner forces acting on the node
+            double node_force = 0.0;
+            for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
+                const size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
+                node_force += corner_force(corner_gid, dim);
+            } // end for corner_lid
+
+            node_vel(1, node_gid, dim) = node_vel(0, node_gid, dim) + rk_alpha * dt * node_force / node_mass(node_gid);
+        } // end for dim
+    }); // end parallel for over the listed nodes
+
+    return;
+} // end lts_update_velocity
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_update_position
+///
+/// \brief Moves the listed nodes with the average of the start of step and
+///        stage velocities, and at the last stage tallies the work done by
+///        each corner force
+///
+/// \param Runge Kutta time integration alpha
+/// \param Time step of the listed nodes
+/// \param True at the last stage of the step
+/// \param The simulation mesh
+/// \param List of the nodes to update
+/// \param Number of nodes in the list
+/// \param View of nodal position data
+/// \param View of nodal velocity data
+/// \param View of corner forces
+/// \param Work done by each corner force since its element last updated energy
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_update_position(const double rk_alpha,
+    const double dt,
+    const bool   tally_work,
+    const mesh_t& mesh,
+    const DCArrayKokkos<size_t>& node_list,
+    const size_t num_list_nodes,
+    DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<double>& corner_force,
+    CArrayKokkos<double>& corner_work)
+{
+    FOR_ALL(list_lid, 0, num_list_nodes, {
+        const size_t node_gid = node_list(list_lid);
+
+        double disp[3];
+        for (size_t dim = 0; dim < 3; dim++) {
+            disp[dim] = 0.5 * rk_alpha * dt * (node_vel(0, node_gid, dim) + node_vel(1, node_gid, dim));
+            node_coords(1, node_gid, dim) = node_coords(0, node_gid, dim) + disp[dim];
+        } // end for dim
+
+        // each corner belongs to one node, so the tally is race free
+        if (tally_work) {
+            for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
+                const size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
+
+                double work = 0.0;
+                for (size_t dim = 0; dim < 3; dim++) {
+                    work += corner_force(corner_gid, dim) * disp[dim];
+                }
+                corner_work(corner_gid) += work;
+            } // end for corner_lid
+        } // end if tally
+    }); // end parallel for over the listed nodes
+
+    return;
+} // end lts_update_position
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lts_update_energy
+///
+/// \brief Updates the specific internal energy of the listed elements with
+///        the corner work done over their step, then their volume
+///
+/// \param The simulation mesh
+/// \param List of the elements to update
+/// \param Number of elements in the list
+/// \param View of nodal position data
+/// \param View of element specific internal energy
+/// \param View of element volume
+/// \param View of element mass
+/// \param Work done by each corner force, reset once consumed
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lts_update_energy(const mesh_t& mesh,
+    const DCArrayKokkos<size_t>& elem_list,
+    const size_t num_list_elems,
+    const DCArrayKokkos<double>& node_coords,
+    DCArrayKokkos<double>& elem_sie,
+    const DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<double>& elem_mass,
+    CArrayKokkos<double>& corner_work)
+{
+    FOR_ALL(list_lid, 0, num_list_elems, {
+        const size_t elem_gid = elem_list(list_lid);
+
+        double elem_work = 0.0;
+        for (size_t corner_lid = 0; corner_lid < mesh.num_nodes_in_elem; corner_lid++) {
+            const size_t corner_gid = mesh.corners_in_elem(elem_gid, corner_lid);
+            elem_work += corner_work(corner_gid);
+            corner_work(corner_gid) = 0.0;
+        } // end for corner_lid
+
+        elem_sie(1, elem_gid) -= elem_work / elem_mass(elem_gid);
+
+        // cut out the node_gids for this element
+        ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), 8);
+        geometry::get_vol_hex(elem_vol, elem_gid, node_coords, elem_node_gids);
+    }); // end parallel for over the listed elements
+
+    return;
+} // end lts_update_energy
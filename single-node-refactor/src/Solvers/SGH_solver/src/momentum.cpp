@@ -45,6 +45,10 @@
 /// \param View of the nodal velocity array
 /// \param View of the nodal mass array
 /// \param View of the corner forces
+/// \param Optional list of the nodes to update
+/// \param Number of nodes in the list, -1 updates every node
+/// \param Optional nodal force assembled by get_force, replaces the corner gather
+/// \param Runge Kutta bin to update, the other bin holds t_n
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::update_velocity(double rk_alpha,
@@ -52,33 +56,53 @@ void SGH::update_velocity(double rk_alpha,
     const mesh_t& mesh,
     DCArrayKokkos<double>& node_vel,
     const DCArrayKokkos<double>& node_mass,
-    const DCArrayKokkos<double>& corner_force
+    const DCArrayKokkos<double>& corner_force,
+    const DCArrayKokkos<size_t>& node_list,
+    const long num_list_nodes,
+    const DCArrayKokkos<double>& assembled_node_force,
+    const size_t rk_bin
     )
 {
     const size_t num_dims = mesh.num_dims;
 
-    // walk over the nodes to update the velocity
-    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+    // read the scattered nodal force when one is given
+    const bool scattered_force = (assembled_node_force.size() > 0);
+
+    const size_t tn_bin = 1 - rk_bin;
+
+    // walk over the listed nodes, or all of them if there is no list
+    const size_t num_loop_nodes = (num_list_nodes < 0) ? mesh.num_nodes : (size_t)num_list_nodes;
+
+    FOR_ALL(list_lid, 0, num_loop_nodes, {
+        const size_t node_gid = (num_list_nodes < 0) ? list_lid : node_list(list_lid);
+
         double node_force[3];
         for (size_t dim = 0; dim < num_dims; dim++) {
             node_force[dim] = 0.0;
         } // end for dim
 
-        // loop over all corners around the node and calculate the nodal force
-        for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
-            // Get corner gid
-            size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
-
-            // loop over dimension
+        if (scattered_force) {
             for (size_t dim = 0; dim < num_dims; dim++) {
-                node_force[dim] += corner_force(corner_gid, dim);
+                node_force[dim] = assembled_node_force(node_gid, dim);
             } // end for dim
-        } // end for corner_lid
+        }
+        else{
+            // loop over all corners around the node and calculate the nodal force
+            for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
+                // Get corner gid
+                size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
+
+                // loop over dimension
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    node_force[dim] += corner_force(corner_gid, dim);
+                } // end for dim
+            } // end for corner_lid
+        } // end if scattered
 
         // update the velocity
         for (int dim = 0; dim < num_dims; dim++) {
-            node_vel(1, node_gid, dim) = node_vel(0, node_gid, dim) +
-                                         rk_alpha * dt * node_force[dim] / node_mass(node_gid);
+            node_vel(rk_bin, node_gid, dim) = node_vel(tn_bin, node_gid, dim) +
+                                              rk_alpha * dt * node_force[dim] / node_mass(node_gid);
         } // end for dim
     }); // end for parallel for over nodes
 
@@ -97,6 +121,7 @@ void SGH::update_velocity(double rk_alpha,
 /// \param The finite element B matrix
 /// \param The volume of the particular element
 /// \param The global id of this particular element
+/// \param Runge Kutta bin of the nodal velocity
 ///
 /////////////////////////////////////////////////////////////////////////////
 KOKKOS_FUNCTION
@@ -105,7 +130,8 @@ void SGH::get_velgrad(ViewCArrayKokkos<double>& vel_grad,
     const DCArrayKokkos<double>&    node_vel,
     const ViewCArrayKokkos<double>& b_matrix,
     const double elem_vol,
-    const size_t elem_gid
+    const size_t elem_gid,
+    const size_t rk_bin
     )
 {
     const size_t num_nodes_in_elem = 8;
@@ -122,9 +148,9 @@ void SGH::get_velgrad(ViewCArrayKokkos<double>& vel_grad,
         // Get node gid
         size_t node_gid = elem_node_gids(node_lid);
 
-        u(node_lid) = node_vel(1, node_gid, 0);
-        v(node_lid) = node_vel(1, node_gid, 1);
-        w(node_lid) = node_vel(1, node_gid, 2);
+        u(node_lid) = node_vel(rk_bin, node_gid, 0);
+        v(node_lid) = node_vel(rk_bin, node_gid, 1);
+        w(node_lid) = node_vel(rk_bin, node_gid, 2);
     } // end for
 
     // --- calculate the velocity gradient terms ---
@@ -264,17 +290,28 @@ void SGH::get_velgrad2D(ViewCArrayKokkos<double>& vel_grad,
 /// \param View of the nodal position data
 /// \param View of the nodal velocity data
 /// \param View of the volumes of each element
+/// \param Optional list of the elements to update
+/// \param Number of elements in the list, -1 updates every element
+/// \param Runge Kutta bin of the nodal position and velocity
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::get_divergence(DCArrayKokkos<double>& elem_div,
     const mesh_t mesh,
     const DCArrayKokkos<double>& node_coords,
     const DCArrayKokkos<double>& node_vel,
-    const DCArrayKokkos<double>& elem_vol
+    const DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const size_t rk_bin
     )
 {
     // --- calculate the forces acting on the nodes from the element ---
-    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+    // loop over the listed elements, or all of them if there is no list
+    const size_t num_loop_elems = (num_list_elems < 0) ? mesh.num_elems : (size_t)num_list_elems;
+
+    FOR_ALL(list_lid, 0, num_loop_elems, {
+        const size_t elem_gid = (num_list_elems < 0) ? list_lid : elem_list(list_lid);
+
         const size_t num_nodes_in_elem = 8;
         const size_t num_dims = 3;
 
@@ -291,16 +328,16 @@ void SGH::get_divergence(DCArrayKokkos<double>& elem_div,
         // The b_matrix are the outward corner area normals
         double b_matrix_array[24];
         ViewCArrayKokkos<double> b_matrix(b_matrix_array, num_nodes_in_elem, num_dims);
-        geometry::get_bmatrix(b_matrix, elem_gid, node_coords, elem_node_gids);
+        geometry::get_bmatrix(b_matrix, elem_gid, node_coords, elem_node_gids, rk_bin);
 
         // get the vertex velocities for the elem
         for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
             // Get node gid
             size_t node_gid = elem_node_gids(node_lid);
 
-            u(node_lid) = node_vel(1, node_gid, 0);
-            v(node_lid) = node_vel(1, node_gid, 1);
-            w(node_lid) = node_vel(1, node_gid, 2);
+            u(node_lid) = node_vel(rk_bin, node_gid, 0);
+            v(node_lid) = node_vel(rk_bin, node_gid, 1);
+            w(node_lid) = node_vel(rk_bin, node_gid, 2);
         } // end for
 
         // --- calculate the velocity divergence terms ---
@@ -45,6 +45,9 @@
 /// \param Number of nodes in the mesh
 /// \param View of nodal position data
 /// \param View of nodal velocity data
+/// \param Optional list of the nodes to update
+/// \param Number of nodes in the list, -1 updates every node
+/// \param Runge Kutta bin to update, the other bin holds t_n
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::update_position(double rk_alpha,
@@ -52,13 +55,22 @@ void SGH::update_position(double rk_alpha,
     const size_t num_dims,
     const size_t num_nodes,
     DCArrayKokkos<double>& node_coords,
-    const DCArrayKokkos<double>& node_vel)
+    const DCArrayKokkos<double>& node_vel,
+    const DCArrayKokkos<size_t>& node_list,
+    const long num_list_nodes,
+    const size_t rk_bin)
 {
-    // loop over all the nodes in the mesh
-    FOR_ALL(node_gid, 0, num_nodes, {
+    const size_t tn_bin = 1 - rk_bin;
+
+    // loop over the listed nodes, or all of them if there is no list
+    const size_t num_loop_nodes = (num_list_nodes < 0) ? num_nodes : (size_t)num_list_nodes;
+
+    FOR_ALL(list_lid, 0, num_loop_nodes, {
+        const size_t node_gid = (num_list_nodes < 0) ? list_lid : node_list(list_lid);
+
         for (int dim = 0; dim < num_dims; dim++) {
-            double half_vel = (node_vel(1, node_gid, dim) + node_vel(0, node_gid, dim)) * 0.5;
-            node_coords(1, node_gid, dim) = node_coords(0, node_gid, dim) + rk_alpha * dt * half_vel;
+            double half_vel = (node_vel(rk_bin, node_gid, dim) + node_vel(tn_bin, node_gid, dim)) * 0.5;
+            node_coords(rk_bin, node_gid, dim) = node_coords(tn_bin, node_gid, dim) + rk_alpha * dt * half_vel;
         }
     }); // end parallel for over nodes
 } // end subroutine
\ No newline at end of file
@@ -38,7 +38,8 @@
 ///
 /// \fn update_state
 ///
-/// \brief This calls the models to update state
+/// \brief This calls the models to update state.  Templated on the element
+///        topology so the temporaries are exactly sized.
 ///
 /// \param An array of material_t that contains material specific data
 /// \param The simulation mesh
@@ -55,8 +56,12 @@
 /// \param A view into the element state variables
 /// \param Time step size
 /// \param The current Runge Kutta integration alpha value
+/// \param Optional list of the elements to update
+/// \param Number of elements in the list, -1 updates every element
+/// \param Runge Kutta bin holding the updated state
 ///
 /////////////////////////////////////////////////////////////////////////////
+template <typename Topology>
 void SGH::update_state(const CArrayKokkos<material_t>& material,
     const mesh_t& mesh,
     const DCArrayKokkos<double>& node_coords,
@@ -71,17 +76,20 @@ void SGH::update_state(const CArrayKokkos<material_t>& material,
     const DCArrayKokkos<size_t>& elem_mat_id,
     const DCArrayKokkos<double>& elem_statev,
     const double dt,
-    const double rk_alpha
+    const double rk_alpha,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const size_t rk_bin
     )
 {
-    // std::cout<<"Num elems in mesh  = " <<mesh.num_elems<<std::endl;
-    // loop over all the elements in the mesh
-    FOR_ALL(elem_gid, 0, mesh.num_elems, {
-        const size_t num_dims = mesh.num_dims;
-        const size_t num_nodes_in_elem = mesh.num_nodes_in_elem;
+    // loop over the listed elements, or all of them if there is no list
+    const size_t num_loop_elems = (num_list_elems < 0) ? mesh.num_elems : (size_t)num_list_elems;
 
-        // cut out the node_gids for this element
-        ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
+    FOR_ALL(list_lid, 0, num_loop_elems, {
+        const size_t elem_gid = (num_list_elems < 0) ? list_lid : elem_list(list_lid);
+
+        constexpr size_t num_dims = Topology::num_dims;
+        constexpr size_t num_nodes_in_elem = Topology::num_nodes_in_elem;
 
         // --- Density ---
         elem_den(elem_gid) = elem_mass(elem_gid) / elem_vol(elem_gid);
@@ -89,90 +97,71 @@ void SGH::update_state(const CArrayKokkos<material_t>& material,
         size_t mat_id = elem_mat_id(elem_gid);
 
         // --- Stress ---
-        // hyper elastic plastic model
-        if (material(mat_id).strength_type == model::hyper) {
-            // cut out the node_gids for this element
-            ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
-
-            // --- Density ---
-            elem_den(elem_gid) = elem_mass(elem_gid) / elem_vol(elem_gid);
-
-            // corner area normals
-            double area_array[24];
-            ViewCArrayKokkos<double> area(area_array, num_nodes_in_elem, num_dims);
-
-            // velocity gradient
-            double vel_grad_array[9];
-            ViewCArrayKokkos<double> vel_grad(vel_grad_array, num_dims, num_dims);
-
-            // get the B matrix which are the OUTWARD corner area normals
-            geometry::get_bmatrix(area, elem_gid, node_coords, elem_node_gids);
-
-            // --- Calculate the velocity gradient ---
-            get_velgrad(vel_grad,
-                        elem_node_gids,
-                        node_vel,
-                        area,
-                        elem_vol(elem_gid),
-                        elem_gid);
-
-            // --- call strength model ---
-            // material(mat_id).strength_model(elem_pres,
-            //                                 elem_stress,
-            //                                 elem_gid,
-            //                                 mat_id,
-            //                                 elem_statev,
-            //                                 elem_sspd,
-            //                                 elem_den(elem_gid),
-            //                                 elem_sie(elem_gid),
-            //                                 vel_grad,
-            //                                 elem_node_gids,
-            //                                 node_coords,
-            //                                 node_vel,
-            //                                 elem_vol(elem_gid),
-            //                                 dt,
-            //                                 rk_alpha);
-        } // end logical on hyper strength model
+        // hyper elastic plastic model, the B matrix is only available for linear hexes
+        if constexpr (num_dims == 3 && Topology::order == 1) {
+            if (material(mat_id).strength_type == model::hyper) {
+                // cut out the node_gids for this element
+                ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
+
+                // corner area normals
+                double area_array[num_nodes_in_elem * num_dims];
+                ViewCArrayKokkos<double> area(area_array, num_nodes_in_elem, num_dims);
+
+                // velocity gradient
+                double vel_grad_array[num_dims * num_dims];
+                ViewCArrayKokkos<double> vel_grad(vel_grad_array, num_dims, num_dims);
+
+                // get the B matrix which are the OUTWARD corner area normals
+                geometry::get_bmatrix(area, elem_gid, node_coords, elem_node_gids, rk_bin);
+
+                // --- Calculate the velocity gradient ---
+                get_velgrad(vel_grad,
+                            elem_node_gids,
+                            node_vel,
+                            area,
+                            elem_vol(elem_gid),
+                            elem_gid,
+                            rk_bin);
+
+                // --- call strength model ---
+                // material(mat_id).strength_model(elem_pres,
+                //                                 elem_stress,
+                //                                 elem_gid,
+                //                                 mat_id,
+                //                                 elem_statev,
+                //                                 elem_sspd,
+                //                                 elem_den(elem_gid),
+                //                                 elem_sie(elem_gid),
+                //                                 vel_grad,
+                //                                 elem_node_gids,
+                //                                 node_coords,
+                //                                 node_vel,
+                //                                 elem_vol(elem_gid),
+                //                                 dt,
+                //                                 rk_alpha);
+            } // end logical on hyper strength model
+        } // end if linear hex
 
         // --- Pressure ---
-        material(mat_id).eos_model(elem_pres,
-                                   elem_stress,
-                                   elem_gid,
-                                   elem_mat_id(elem_gid),
-                                   elem_statev,
-                                   elem_sspd,
-                                   elem_den(elem_gid),
-                                   elem_sie(1, elem_gid));
+        // the 2D RZ state update does not call the EOS yet
+        if constexpr (num_dims == 3) {
+            material(mat_id).eos_model(elem_pres,
+                                       elem_stress,
+                                       elem_gid,
+                                       elem_mat_id(elem_gid),
+                                       elem_statev,
+                                       elem_sspd,
+                                       elem_den(elem_gid),
+                                       elem_sie(rk_bin, elem_gid));
+        }
     }); // end parallel for
     Kokkos::fence();
 
     return;
 } // end method to update state
 
-/////////////////////////////////////////////////////////////////////////////
-///
-/// \fn update_state2D
-///
-/// \brief Updates the state for 2D elements
-///
-/// \param An array of material_t that contains material specific data
-/// \param The simulation mesh
-/// \param A view into the nodal position array
-/// \param A view into the nodal velocity array
-/// \param A view into the element density array
-/// \param A view into the element pressure array
-/// \param A view into the element stress array
-/// \param A view into the element sound speed array
-/// \param A view into the element specific internal energy array
-/// \param A view into the element volume array
-/// \param A view into the element mass
-/// \param A view into the element material identifier array
-/// \param A view into the element state variables
-/// \param Time step size
-/// \param The current Runge Kutta integration alpha value
-///
-/////////////////////////////////////////////////////////////////////////////
-void SGH::update_state2D(const CArrayKokkos<material_t>& material,
+// instantiations for the supported element topologies
+template void SGH::update_state<topology::quad4>(const CArrayKokkos<material_t>& material,
     const mesh_t& mesh,
     const DCArrayKokkos<double>& node_coords,
     const DCArrayKokkos<double>& node_vel,
@@ -186,79 +175,27 @@ void SGH::update_state2D(const CArrayKokkos<material_t>& material,
     const DCArrayKokkos<size_t>& elem_mat_id,
     const DCArrayKokkos<double>& elem_statev,
     const double dt,
-    const double rk_alpha
-    )
-{
-    // loop over all the elements in the mesh
-    FOR_ALL(elem_gid, 0, mesh.num_elems, {
-        const size_t num_dims = mesh.num_dims;
-        const size_t num_nodes_in_elem = mesh.num_nodes_in_elem;
-
-        // cut out the node_gids for this element
-        ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
-
-        // --- Density ---
-        elem_den(elem_gid) = elem_mass(elem_gid) / elem_vol(elem_gid);
-
-        size_t mat_id = elem_mat_id(elem_gid);
-
-        // --- Stress ---
-        // hyper elastic plastic model
-        if (material(mat_id).strength_type == model::hyper) {
-            // cut out the node_gids for this element
-            ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), num_nodes_in_elem);
-
-            // --- Density ---
-            elem_den(elem_gid) = elem_mass(elem_gid) / elem_vol(elem_gid);
-
-            // corner area normals
-            double area_array[8];
-            ViewCArrayKokkos<double> area(area_array, num_nodes_in_elem, num_dims);
-
-            // velocity gradient
-            double vel_grad_array[4];
-            ViewCArrayKokkos<double> vel_grad(vel_grad_array, num_dims, num_dims);
-
-            // get the B matrix which are the OUTWARD corner area normals
-            geometry::get_bmatrix(area, elem_gid, node_coords, elem_node_gids);
-
-            // --- Calculate the velocity gradient ---
-            get_velgrad(vel_grad,
-                        elem_node_gids,
-                        node_vel,
-                        area,
-                        elem_vol(elem_gid),
-                        elem_gid);
-
-            // --- call strength model ---
-            // material(mat_id).strength_model(elem_pres,
-            //                                 elem_stress,
-            //                                 elem_gid,
-            //                                 mat_id,
-            //                                 elem_statev,
-            //                                 elem_sspd,
-            //                                 elem_den(elem_gid),
-            //                                 elem_sie(elem_gid),
-            //                                 vel_grad,
-            //                                 elem_node_gids,
-            //                                 node_coords,
-            //                                 node_vel,
-            //                                 elem_vol(elem_gid),
-            //                                 dt,
-            //                                 rk_alpha);
-        } // end logical on hyper strength model
-
-        // --- Pressure ---
-        // material(mat_id).eos_model(elem_pres,
-        //                            elem_stress,
-        //                            elem_gid,
-        //                            elem_mat_id(elem_gid),
-        //                            elem_statev,
-        //                            elem_sspd,
-        //                            elem_den(elem_gid),
-        //                            elem_sie(1, elem_gid));
-    }); // end parallel for
-    Kokkos::fence();
-
-    return;
-} // end method to update state
+    const double rk_alpha,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const size_t rk_bin
+    );
+template void SGH::update_state<topology::hex8>(const CArrayKokkos<material_t>& material,
+    const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_coords,
+    const DCArrayKokkos<double>& node_vel,
+    DCArrayKokkos<double>& elem_den,
+    DCArrayKokkos<double>& elem_pres,
+    DCArrayKokkos<double>& elem_stress,
+    DCArrayKokkos<double>& elem_sspd,
+    const DCArrayKokkos<double>& elem_sie,
+    const DCArrayKokkos<double>& elem_vol,
+    const DCArrayKokkos<double>& elem_mass,
+    const DCArrayKokkos<size_t>& elem_mat_id,
+    const DCArrayKokkos<double>& elem_statev,
+    const double dt,
+    const double rk_alpha,
+    const DCArrayKokkos<size_t>& elem_list,
+    const long num_list_elems,
+    const size_t rk_bin
+    );
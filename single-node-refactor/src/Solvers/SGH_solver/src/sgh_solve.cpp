@@ -50,11 +50,41 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
 {
     std::cout << "In execute function in sgh solver" << std::endl;
 
+    PerfTimers  no_timers;
+    PerfTimers& timer = (timers != nullptr) ? *timers : no_timers;
+    const auto  thorough = output_options::thorough;
+
+    mesh_comms_t  no_comms;
+    mesh_comms_t& coms = (comms != nullptr) ? *comms : no_comms;
+
+    // estimated bytes moved by the RK sub-steps, for the bandwidth in the timer report
+    const double node_vec_bytes    = sizeof(double) * mesh.num_dims;
+    const double corner_vec_bytes  = mesh.num_corners * node_vec_bytes;
+    const double elem_gather_bytes = mesh.num_elems * mesh.num_nodes_in_elem * (2.0 * node_vec_bytes + sizeof(size_t));
+    const double div_bytes      = elem_gather_bytes + 2.0 * mesh.num_elems * sizeof(double);
+    const double force_bytes    = elem_gather_bytes + corner_vec_bytes + 16.0 * mesh.num_elems * sizeof(double);
+    const double velocity_bytes = mesh.num_nodes * (2.0 * node_vec_bytes + sizeof(double)) + corner_vec_bytes + mesh.num_corners * sizeof(size_t);
+    const double energy_bytes   = elem_gather_bytes + corner_vec_bytes + 3.0 * mesh.num_elems * sizeof(double);
+    const double position_bytes = mesh.num_nodes * 3.0 * node_vec_bytes;
+    const double vol_bytes      = mesh.num_elems * (mesh.num_nodes_in_elem * (node_vec_bytes + sizeof(size_t)) + sizeof(double));
+    const double state_bytes    = mesh.num_elems * 6.0 * sizeof(double);
+
     printf("Writing outputs to file at %f \n", time_value);
+    timer.start("output");
     mesh_writer.write_mesh(mesh, elem, node, corner, sim_param, time_value, graphics_times);
+    timer.stop();
 
     CArrayKokkos<double> node_extensive_mass(mesh.num_nodes);
 
+    // divergence scratch array for the fused RK stage kernels
+    CArrayKokkos<double> elem_div_fused;
+    if (rk_fused_kernels == 1 && mesh.num_dims == 3) {
+        elem_div_fused = CArrayKokkos<double>(mesh.num_elems);
+
+        // the fused shock detector reads the neighbor divergence from the previous stage
+        get_divergence(elem.div, mesh, node.coords, node.vel, elem.vol);
+    }
+
     // extensive energy tallies over the entire mesh
     double IE_t0 = 0.0;
     double KE_t0 = 0.0;
@@ -77,14 +107,14 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
         node_extensive_mass(node_gid) = node.mass(node_gid) * radius;
     }); // end parallel for
 
-    // extensive IE
-    REDUCE_SUM(elem_gid, 0, mesh.num_elems, IE_loc_sum, {
+    // extensive IE, the ghosts are tallied by their owner
+    REDUCE_SUM(elem_gid, 0, mesh.num_owned_elems, IE_loc_sum, {
         IE_loc_sum += elem.mass(elem_gid) * elem.sie(1, elem_gid);
     }, IE_sum);
-    IE_t0 = IE_sum;
+    IE_t0 = coms.global_sum(IE_sum);
 
     // extensive KE
-    REDUCE_SUM(node_gid, 0, mesh.num_nodes, KE_loc_sum, {
+    REDUCE_SUM(node_gid, 0, mesh.num_owned_nodes, KE_loc_sum, {
         double ke = 0;
         for (size_t dim = 0; dim < mesh.num_dims; dim++) {
             ke += node.vel(1, node_gid, dim) * node.vel(1, node_gid, dim); // 1/2 at end
@@ -98,11 +128,111 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
         }
     }, KE_sum);
     Kokkos::fence();
-    KE_t0 = 0.5 * KE_sum;
+    KE_t0 = 0.5 * coms.global_sum(KE_sum);
 
     // extensive TE
     TE_t0 = IE_t0 + KE_t0;
 
+    // low-storage RK coefficients, rk bin 0 of the nodes and energy holds the 2N-storage registers
+    const bool low_storage = (time_integrator != integrator::rk);
+
+    double lsrk_A[5];
+    double lsrk_B[5];
+    double lsrk_C[5];
+    size_t num_stages = rk_num_stages;
+    CArrayKokkos<double> lsrk_vel_start;
+    if (low_storage) {
+        num_stages     = get_lsrk_coefficients(time_integrator, lsrk_A, lsrk_B, lsrk_C);
+        lsrk_vel_start = CArrayKokkos<double>(mesh.num_nodes, mesh.num_dims);
+    }
+
+    // the two stress bins only differ once a strength model evolves the stress
+    auto   materials = sim_param.materials;
+    size_t num_strength_mats = 0;
+    size_t num_strength_loc  = 0;
+    REDUCE_SUM(mat_id, 0, materials.size(), num_strength_loc, {
+        if (materials(mat_id).strength_type != model::none) {
+            num_strength_loc += 1;
+        }
+    }, num_strength_mats);
+    const bool evolve_stress = (num_strength_mats > 0);
+
+    // gather the contact surface before the stepping scheme is chosen
+    contact_setup(mesh, sim_param.boundary_conditions, node.coords);
+
+    // the contact sets come from the input, so every rank takes the same branch below
+    const bool has_contact = (num_contact_sets > 0);
+
+    // contact is searched on each rank alone, a pair split over two ranks would be missed
+    if (has_contact && coms.num_ranks > 1) {
+        std::cout << "ERROR: contact boundary conditions are not supported with "
+                  << coms.num_ranks << " MPI ranks, run them on a single rank" << std::endl;
+        throw std::runtime_error("**** CONTACT IS NOT SUPPORTED WITH MPI DECOMPOSITION ****");
+    }
+
+    // local time stepping advances the coarse step in lts_advance, not the stage loop.
+    // The subcycles have no halo exchange, so a decomposed mesh takes the global step.
+    // Contact pairs nodes of different levels, so a contact run takes the global step too.
+    const bool local_time_stepping = (lts_num_levels > 1 && mesh.num_dims == 3 && coms.num_ranks == 1 &&
+                                      !has_contact);
+    if (local_time_stepping) {
+        lts_setup(mesh);
+        num_stages = 0;
+    }
+
+    if (lts_num_levels > 1 && !local_time_stepping && coms.rank == 0) {
+        std::cout << "WARNING: lts_num_levels = " << lts_num_levels << " needs a 3D mesh on a single rank "
+                  << "without contact, the run takes the global time step" << std::endl;
+    }
+
+    // the levels take the stages of the classic RK scheme
+    if (local_time_stepping && low_storage && coms.rank == 0) {
+        std::cout << "WARNING: the local time step levels use the " << rk_num_stages
+                  << " stage RK scheme, the low-storage time_integrator is not used" << std::endl;
+    }
+
+    // the fused kernels only replace the classic RK stage of a 3D mesh
+    if (rk_fused_kernels == 1 && (mesh.num_dims != 3 || low_storage || local_time_stepping) && coms.rank == 0) {
+        std::cout << "WARNING: rk_fused_kernels needs a 3D mesh with the classic RK scheme and no local "
+                  << "time stepping, the unfused kernels are used" << std::endl;
+    }
+
+    // atomic scatter assembles the node forces in get_force, an empty array keeps the corner gather.
+    // A decomposed mesh gathers, the ghost corner forces arrive after the force kernel.
+    const bool scatter_force = (node_force_mode == force_assembly::atomic_scatter && mesh.num_dims == 3 &&
+                                !low_storage && !local_time_stepping && rk_fused_kernels != 1 &&
+                                coms.num_ranks == 1);
+
+    DCArrayKokkos<double> scatter_node_force;
+    if (scatter_force) {
+        node.force = DCArrayKokkos<double>(mesh.num_nodes, mesh.num_dims, "node_force");
+        scatter_node_force = node.force;
+    }
+
+    if (node_force_mode == force_assembly::atomic_scatter && !scatter_force && coms.rank == 0) {
+        std::cout << "WARNING: node_force_mode atomic_scatter needs a 3D mesh on a single rank with the classic, "
+                  << "unfused RK scheme and no local time stepping, the corner forces are gathered" << std::endl;
+    }
+
+    // active lists restrict the RK stage kernels, every entity is swept until the first build.
+    // Inactive corner forces never reach a scattered node force, so the lists need the gather.
+    const bool active_lists = (active_list_ival > 0 && mesh.num_dims == 3 && !low_storage &&
+                               !local_time_stepping && rk_fused_kernels != 1 && !scatter_force &&
+                               coms.num_ranks == 1);
+
+    if (active_list_ival > 0 && !active_lists && coms.rank == 0) {
+        std::cout << "WARNING: active_list_ival needs a 3D mesh on a single rank with the classic, unfused RK "
+                  << "scheme, the corner gather and no local time stepping, every element is swept" << std::endl;
+    }
+
+    // the classic RK scheme swaps the roles of the two rk bins each cycle instead of copying t_n.
+    // The 2D, fused, active list and contact kernels read the state from bin 1, so they copy.
+    const bool swap_rk_bins = (!low_storage && !local_time_stepping && mesh.num_dims == 3 &&
+                               rk_fused_kernels != 1 && !active_lists && !has_contact);
+
+    // the rk bin holding the current state
+    size_t rk_bin = 1;
+
     // a flag to exit the calculation
     size_t stop_calc = 0;
 
@@ -116,38 +246,44 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
             break;
         }
 
+        timer.start("cycle");
+
         cached_pregraphics_dt = dt;
         // get the step
-        if (mesh.num_dims == 2) {
-            get_timestep2D(mesh,
-                           node.coords,
-                           node.vel,
-                           elem.sspd,
-                           elem.vol,
-                           time_value,
-                           graphics_time,
-                           time_final,
-                           dt_max,
-                           dt_min,
-                           dt_cfl,
-                           dt,
-                           fuzz);
+        timer.start("get_timestep", thorough);
+        if (local_time_stepping) {
+            get_lts_timestep(mesh,
+                             node.coords,
+                             elem.sspd,
+                             time_value,
+                             graphics_time,
+                             time_final,
+                             dt_max,
+                             dt_min,
+                             dt_cfl,
+                             dt,
+                             fuzz);
         }
         else{
-            get_timestep(mesh,
-                         node.coords,
-                         node.vel,
-                         elem.sspd,
-                         elem.vol,
-                         time_value,
-                         graphics_time,
-                         time_final,
-                         dt_max,
-                         dt_min,
-                         dt_cfl,
-                         dt,
-                         fuzz);
-        } // end if 2D
+            (this->*get_timestep_kernel)(mesh,
+                                         node.coords,
+                                         node.vel,
+                                         elem.sspd,
+                                         elem.vol,
+                                         time_value,
+                                         graphics_time,
+                                         time_final,
+                                         dt_max,
+                                         dt_min,
+                                         dt_cfl,
+                                         dt,
+                                         fuzz,
+                                         rk_bin);
+        } // end if local time stepping
+
+        // every rank takes the smallest step
+        dt = coms.global_min(dt);
+        timer.stop();
 
         if (cycle == 0) {
             printf("cycle = %lu, time = %f, time step = %f \n", cycle, time_value, dt);
@@ -161,21 +297,144 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
         //  integrate the solution forward to t(n+1) via Runge Kutta (RK) method
         // ---------------------------------------------------------------------
 
-        // save the values at t_n
-        rk_init(node.coords,
-                node.vel,
-                elem.sie,
-                elem.stress,
-                mesh.num_dims,
-                mesh.num_elems,
-                mesh.num_nodes);
+        // save the values at t_n, the swapped bins and the low-storage schemes only copy the stress
+        if (swap_rk_bins) {
+            // the current state becomes t_n and the stages overwrite the other bin
+            rk_bin = 1 - rk_bin;
+
+            if (evolve_stress) {
+                timer.start("rk_init", thorough);
+                rk_init_stress(elem.stress, mesh.num_elems, rk_bin);
+                timer.stop();
+            }
+        }
+        else if (low_storage) {
+            // the stress is not a register, bin 0 keeps t_n for the strength models
+            if (evolve_stress) {
+                timer.start("rk_init", thorough);
+                rk_init_stress(elem.stress, mesh.num_elems, 0);
+                timer.stop();
+            }
+        }
+        else if (!local_time_stepping) {
+            timer.start("rk_init", thorough);
+            rk_init(node.coords,
+                    node.vel,
+                    elem.sie,
+                    elem.stress,
+                    mesh.num_dims,
+                    mesh.num_elems,
+                    mesh.num_nodes);
+            timer.stop();
+        }
+
+        // subcycle the fine levels through the coarse step
+        if (local_time_stepping) {
+            timer.start("lts_advance");
+            lts_advance(sim_param, mesh, node, elem, corner, time_value, dt);
+            timer.stop();
+        }
 
         // integrate solution forward in time
-        for (size_t rk_stage = 0; rk_stage < rk_num_stages; rk_stage++) {
-            // ---- RK coefficient ----
+        for (size_t rk_stage = 0; rk_stage < num_stages; rk_stage++) {
+            // ---- RK coefficient, the fraction of dt the stage advances the state ----
             double rk_alpha = 1.0 / ((double)rk_num_stages - (double)rk_stage);
+            if (low_storage) {
+                rk_alpha = lsrk_C[rk_stage];
+            }
+
+            // with swapped bins the first stage is evaluated at t_n in the other bin
+            const size_t eval_bin = (swap_rk_bins && rk_stage == 0) ? 1 - rk_bin : rk_bin;
+
+            timer.start("rk_stage");
+
+            // ---- Fused path: one element pass, one node pass, one element pass ----
+            if (rk_fused_kernels == 1 && mesh.num_dims == 3 && !low_storage) {
+                // B matrix, velocity gradient, divergence and corner forces
+                timer.start("get_force_fused", thorough);
+                get_force_fused(sim_param.materials,
+                                mesh,
+                                node.coords,
+                                node.vel,
+                                elem.den,
+                                elem.sie,
+                                elem.pres,
+                                elem.stress,
+                                elem.sspd,
+                                elem.vol,
+                                elem.div,
+                                elem_div_fused,
+                                elem.mat_id,
+                                corner.force,
+                                fuzz,
+                                small,
+                                elem.statev,
+                                dt,
+                                rk_alpha);
+                timer.stop(div_bytes + force_bytes);
+
+                // ---- copy the owned corner forces to the ghost elems ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange_corners(mesh, corner.force, mesh.num_dims);
+                timer.stop();
+
+                // nodal velocity and position
+                timer.start("update_velocity_position_fused", thorough);
+                update_velocity_position_fused(rk_alpha,
+                                               dt,
+                                               mesh,
+                                               node.coords,
+                                               node.vel,
+                                               node.mass,
+                                               corner.force);
+                timer.stop(velocity_bytes + position_bytes);
+
+                // contact and boundary conditions, then re-integrate the boundary node positions
+                timer.start("boundary_conditions", thorough);
+                boundary_contact(mesh, sim_param.boundary_conditions, node.coords, node.vel, node.mass, rk_alpha * dt, true, time_value);
+                boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, time_value);
+                boundary_position(rk_alpha, dt, mesh, node.coords, node.vel);
+                timer.stop();
+
+                // ---- copy the owned nodal values to the other ranks ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange(node.vel, 1, mesh.num_dims);
+                coms.halo_exchange(node.coords, 1, mesh.num_dims);
+                timer.stop();
+
+                // specific internal energy, volume, density, and eos
+                timer.start("update_energy_state_fused", thorough);
+                update_energy_state_fused(sim_param.materials,
+                                          mesh,
+                                          node.coords,
+                                          node.vel,
+                                          elem.den,
+                                          elem.pres,
+                                          elem.stress,
+                                          elem.sspd,
+                                          elem.sie,
+                                          elem.vol,
+                                          elem.mass,
+                                          elem.div,
+                                          elem_div_fused,
+                                          elem.mat_id,
+                                          elem.statev,
+                                          corner.force,
+                                          dt,
+                                          rk_alpha);
+                timer.stop(energy_bytes + vol_bytes + state_bytes);
+
+                // ---- copy the owned elem state to the ghost elems ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange_elem_state(elem);
+                timer.stop();
+
+                timer.stop(); // rk_stage
+                continue;
+            } // end if fused
 
             // ---- Calculate velocity divergence for the element ----
+            timer.start("get_divergence", thorough);
             if (mesh.num_dims == 2) {
                 get_divergence2D(elem.div,
                                  mesh,
@@ -188,10 +447,15 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
                                mesh,
                                node.coords,
                                node.vel,
-                               elem.vol);
+                               elem.vol,
+                               active_elem_list,
+                               num_active_elems,
+                               eval_bin);
             } // end if 2D
+            timer.stop(div_bytes);
 
             // ---- calculate the forces on the vertices and evolve stress (hypo model) ----
+            timer.start("get_force", thorough);
             if (mesh.num_dims == 2) {
                 get_force_2D(sim_param.materials,
                              mesh,
@@ -213,99 +477,200 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
                              rk_alpha);
             }
             else{
-                get_force(sim_param.materials,
-                          mesh,
-                          node.coords,
-                          node.vel,
-                          elem.den,
-                          elem.sie,
-                          elem.pres,
-                          elem.stress,
-                          elem.sspd,
-                          elem.vol,
-                          elem.div,
-                          elem.mat_id,
-                          corner.force,
-                          fuzz,
-                          small,
-                          elem.statev,
-                          dt,
-                          rk_alpha);
+                if (scatter_force) {
+                    scatter_node_force.set_values(0.0);
+                }
+
+                if (simd_force_kernel == 1) {
+                    get_force_simd(sim_param.materials,
+                                   mesh,
+                                   node.coords,
+                                   node.vel,
+                                   elem.den,
+                                   elem.sie,
+                                   elem.pres,
+                                   elem.stress,
+                                   elem.sspd,
+                                   elem.vol,
+                                   elem.div,
+                                   elem.mat_id,
+                                   corner.force,
+                                   fuzz,
+                                   small,
+                                   elem.statev,
+                                   dt,
+                                   rk_alpha,
+                                   active_elem_list,
+                                   num_active_elems,
+                                   scatter_node_force,
+                                   eval_bin);
+                }
+                else{
+                    get_force(sim_param.materials,
+                              mesh,
+                              node.coords,
+                              node.vel,
+                              elem.den,
+                              elem.sie,
+                              elem.pres,
+                              elem.stress,
+                              elem.sspd,
+                              elem.vol,
+                              elem.div,
+                              elem.mat_id,
+                              corner.force,
+                              fuzz,
+                              small,
+                              elem.statev,
+                              dt,
+                              rk_alpha,
+                              active_elem_list,
+                              num_active_elems,
+                              scatter_node_force,
+                              eval_bin);
+                } // end if simd
             }
-
-            // ---- Update nodal velocities ---- //
-            update_velocity(rk_alpha,
-                            dt,
-                            mesh,
-                            node.vel,
-                            node.mass,
-                            corner.force);
-
-            // ---- apply velocity boundary conditions to the boundary patches----
-            boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, time_value);
-
-
-            // ---- apply contact boundary conditions to the boundary patches----
-            boundary_contact(mesh, sim_param.boundary_conditions, node.vel, time_value);
-
-            // mpi_coms();
-
-            // ---- Update specific internal energy in the elements ----
-            update_energy(rk_alpha,
-                          dt,
-                          mesh,
-                          node.vel,
-                          node.coords,
-                          elem.sie,
-                          elem.mass,
-                          corner.force);
-
-            // ---- Update nodal positions ----
-            update_position(rk_alpha,
-                            dt,
-                            mesh.num_dims,
-                            mesh.num_nodes,
-                            node.coords,
-                            node.vel);
+            timer.stop(force_bytes);
+
+            // ---- copy the owned corner forces to the ghost elems ----
+            timer.start("halo_exchange", thorough);
+            coms.halo_exchange_corners(mesh, corner.force, mesh.num_dims);
+            timer.stop();
+
+            if (low_storage) {
+                // ---- Update nodal positions and velocities ----
+                timer.start("lsrk_update_nodes", thorough);
+                lsrk_update_nodes(lsrk_A[rk_stage],
+                                  lsrk_B[rk_stage],
+                                  dt,
+                                  mesh,
+                                  node.coords,
+                                  node.vel,
+                                  lsrk_vel_start,
+                                  node.mass,
+                                  corner.force);
+                timer.stop(velocity_bytes + position_bytes);
+
+                // ---- apply contact and velocity boundary conditions ----
+                timer.start("boundary_conditions", thorough);
+                boundary_contact(mesh, sim_param.boundary_conditions, node.coords, node.vel, node.mass, dt, false, time_value);
+                boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, time_value);
+                timer.stop();
+
+                // ---- copy the owned nodal values to the other ranks ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange(node.vel, 1, mesh.num_dims);
+                coms.halo_exchange(node.coords, 1, mesh.num_dims);
+                timer.stop();
+
+                // ---- Update specific internal energy with the half step velocity ----
+                timer.start("lsrk_update_energy", thorough);
+                lsrk_update_energy(lsrk_A[rk_stage],
+                                   lsrk_B[rk_stage],
+                                   dt,
+                                   mesh,
+                                   node.vel,
+                                   lsrk_vel_start,
+                                   node.coords,
+                                   elem.sie,
+                                   elem.mass,
+                                   corner.force);
+                timer.stop(energy_bytes);
+            }
+            else{
+                // ---- Update nodal velocities ---- //
+                timer.start("update_velocity", thorough);
+                update_velocity(rk_alpha,
+                                dt,
+                                mesh,
+                                node.vel,
+                                node.mass,
+                                corner.force,
+                                active_node_list,
+                                num_active_nodes,
+                                scatter_node_force,
+                                rk_bin);
+                timer.stop(velocity_bytes);
+
+                // ---- apply contact boundary conditions to the boundary patches----
+                timer.start("boundary_conditions", thorough);
+                boundary_contact(mesh, sim_param.boundary_conditions, node.coords, node.vel, node.mass, rk_alpha * dt, true, time_value);
+
+                // ---- apply velocity boundary conditions to the boundary patches----
+                // after contact, so a prescribed velocity is not changed by a contact impulse
+                boundary_velocity(mesh, sim_param.boundary_conditions, node.vel, time_value, rk_bin);
+                timer.stop();
+
+                // ---- copy the owned nodal velocities to the other ranks ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange(node.vel, rk_bin, mesh.num_dims);
+                timer.stop();
+
+                // ---- Update specific internal energy in the elements ----
+                timer.start("update_energy", thorough);
+                update_energy(rk_alpha,
+                              dt,
+                              mesh,
+                              node.vel,
+                              node.coords,
+                              elem.sie,
+                              elem.mass,
+                              corner.force,
+                              active_elem_list,
+                              num_active_elems,
+                              rk_bin);
+                timer.stop(energy_bytes);
+
+                // ---- Update nodal positions ----
+                timer.start("update_position", thorough);
+                update_position(rk_alpha,
+                                dt,
+                                mesh.num_dims,
+                                mesh.num_nodes,
+                                node.coords,
+                                node.vel,
+                                active_node_list,
+                                num_active_nodes,
+                                rk_bin);
+                timer.stop(position_bytes);
+
+                // ---- copy the owned nodal positions to the other ranks ----
+                timer.start("halo_exchange", thorough);
+                coms.halo_exchange(node.coords, rk_bin, mesh.num_dims);
+                timer.stop();
+            } // end if low storage
 
             // ---- Calculate cell volume for next time step ----
-            geometry::get_vol(elem.vol, node.coords, mesh);
+            timer.start("get_vol", thorough);
+            geometry::get_vol(elem.vol, node.coords, mesh, active_elem_list, num_active_elems, rk_bin);
+            timer.stop(vol_bytes);
 
             // ---- Calculate elem state (den, pres, sound speed, stress) for next time step ----
-            if (mesh.num_dims == 2) {
-                update_state2D(sim_param.materials,
-                               mesh,
-                               node.coords,
-                               node.vel,
-                               elem.den,
-                               elem.pres,
-                               elem.stress,
-                               elem.sspd,
-                               elem.sie,
-                               elem.vol,
-                               elem.mass,
-                               elem.mat_id,
-                               elem.statev,
-                               dt,
-                               rk_alpha);
-            }
-            else{
-                update_state(sim_param.materials,
-                             mesh,
-                             node.coords,
-                             node.vel,
-                             elem.den,
-                             elem.pres,
-                             elem.stress,
-                             elem.sspd,
-                             elem.sie,
-                             elem.vol,
-                             elem.mass,
-                             elem.mat_id,
-                             elem.statev,
-                             dt,
-                             rk_alpha);
-            }
+            timer.start("update_state", thorough);
+            (this->*update_state_kernel)(sim_param.materials,
+                                         mesh,
+                                         node.coords,
+                                         node.vel,
+                                         elem.den,
+                                         elem.pres,
+                                         elem.stress,
+                                         elem.sspd,
+                                         elem.sie,
+                                         elem.vol,
+                                         elem.mass,
+                                         elem.mat_id,
+                                         elem.statev,
+                                         dt,
+                                         rk_alpha,
+                                         active_elem_list,
+                                         num_active_elems,
+                                         rk_bin);
+            timer.stop(state_bytes);
+
+            // ---- copy the owned elem state to the ghost elems ----
+            timer.start("halo_exchange", thorough);
+            coms.halo_exchange_elem_state(elem);
+            timer.stop();
             // ----
             // Notes on strength:
             //    1) hyper-elastic strength models are called in update_state
@@ -314,6 +679,7 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
 
             // calculate the new corner masses if 2D
             if (mesh.num_dims == 2) {
+                timer.start("rz_node_mass", thorough);
                 // calculate the nodal areal mass
                 FOR_ALL(node_gid, 0, mesh.num_nodes, {
                     node.mass(node_gid) = 0.0;
@@ -340,9 +706,19 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
                         } // end for over neighboring nodes
                     } // end if
                 }); // end parallel for over elem_gid
+                timer.stop();
             } // end of if 2D-RZ
+
+            timer.stop(); // rk_stage
         } // end of RK loop
 
+        // ---- rebuild the active lists, the halo covers the cycles until the next build ----
+        if (active_lists && cycle % active_list_ival == 0) {
+            timer.start("build_active_lists", thorough);
+            build_active_lists(mesh, node.vel, elem.den, elem.pres, active_list_ival + 1);
+            timer.stop();
+        }
+
         // increment the time
         time_value += dt;
 
@@ -363,13 +739,28 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
         // write outputs
         if (write == 1) {
             printf("Writing outputs to file at %f \n", graphics_time);
+            timer.start("output");
+            rk_sync(mesh, node, elem, rk_bin);
             mesh_writer.write_mesh(mesh, elem, node, corner, sim_param, time_value, graphics_times);
+            timer.stop();
 
             graphics_time = time_value + graphics_dt_ival;
 
             dt = cached_pregraphics_dt;
         } // end if
 
+        timer.stop(); // cycle
+        timer.end_cycle();
+
+        // in-situ analysis and steering of the live state
+        if (cycle_callback) {
+            rk_sync(mesh, node, elem, rk_bin);
+
+            if (!cycle_callback(cycle, time_value, dt)) {
+                stop_calc = 1;
+            }
+        }
+
         // end of calculation
         if (time_value >= time_final) {
             break;
@@ -381,6 +772,9 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
 
     printf("\nCalculation time in seconds: %f \n", calc_time * 1e-9);
 
+    // the state is left in rk bin 1 for the tallies and the caller
+    rk_sync(mesh, node, elem, rk_bin);
+
     // ---- Calculate energy tallies ----
     double IE_tend = 0.0;
     double KE_tend = 0.0;
@@ -392,13 +786,13 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
     KE_sum     = 0.0;
 
     // extensive IE
-    REDUCE_SUM(elem_gid, 0, mesh.num_elems, IE_loc_sum, {
+    REDUCE_SUM(elem_gid, 0, mesh.num_owned_elems, IE_loc_sum, {
         IE_loc_sum += elem.mass(elem_gid) * elem.sie(1, elem_gid);
     }, IE_sum);
-    IE_tend = IE_sum;
+    IE_tend = coms.global_sum(IE_sum);
 
     // extensive KE
-    REDUCE_SUM(node_gid, 0, mesh.num_nodes, KE_loc_sum, {
+    REDUCE_SUM(node_gid, 0, mesh.num_owned_nodes, KE_loc_sum, {
         double ke = 0;
         for (size_t dim = 0; dim < mesh.num_dims; dim++) {
             ke += node.vel(1, node_gid, dim) * node.vel(1, node_gid, dim); // 1/2 at end
@@ -412,14 +806,16 @@ void SGH::execute(simulation_parameters_t& sim_param, mesh_t& mesh, node_t& node
         }
     }, KE_sum);
     Kokkos::fence();
-    KE_tend = 0.5 * KE_sum;
+    KE_tend = 0.5 * coms.global_sum(KE_sum);
 
     // extensive TE
     TE_tend = IE_tend + KE_tend;
 
-    printf("Time=0:   KE = %f, IE = %f, TE = %f \n", KE_t0, IE_t0, TE_t0);
-    printf("Time=End: KE = %f, IE = %f, TE = %f \n", KE_tend, IE_tend, TE_tend);
-    printf("total energy conservation error = %e \n\n", TE_tend - TE_t0);
+    if (coms.rank == 0) {
+        printf("Time=0:   KE = %f, IE = %f, TE = %f \n", KE_t0, IE_t0, TE_t0);
+        printf("Time=End: KE = %f, IE = %f, TE = %f \n", KE_tend, IE_tend, TE_tend);
+        printf("total energy conservation error = %e \n\n", TE_tend - TE_t0);
+    }
 } // end of SGH solve
 
 /////////////////////////////////////////////////////////////////////////////
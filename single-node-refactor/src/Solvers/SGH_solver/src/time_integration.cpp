@@ -47,6 +47,7 @@
 /// \param Number of dimension (REMOVE)
 /// \param Number of elements
 /// \param Number of nodes
+/// \param Runge Kutta bin that receives the copy of the other bin
 ///
 /////////////////////////////////////////////////////////////////////////////
 void SGH::rk_init(DCArrayKokkos<double>& node_coords,
@@ -55,25 +56,28 @@ void SGH::rk_init(DCArrayKokkos<double>& node_coords,
     DCArrayKokkos<double>& elem_stress,
     const size_t num_dims,
     const size_t num_elems,
-    const size_t num_nodes)
+    const size_t num_nodes,
+    const size_t rk_bin)
 {
+    const size_t src_bin = 1 - rk_bin;
+
     // save elem quantities
     FOR_ALL(elem_gid, 0, num_elems, {
         // stress is always 3D even with 2D-RZ
         for (size_t i = 0; i < 3; i++) {
             for (size_t j = 0; j < 3; j++) {
-                elem_stress(0, elem_gid, i, j) = elem_stress(1, elem_gid, i, j);
+                elem_stress(rk_bin, elem_gid, i, j) = elem_stress(src_bin, elem_gid, i, j);
             }
         }  // end for
 
-        elem_sie(0, elem_gid) = elem_sie(1, elem_gid);
+        elem_sie(rk_bin, elem_gid) = elem_sie(src_bin, elem_gid);
     }); // end parallel for
 
     // save nodal quantities
     FOR_ALL(node_gid, 0, num_nodes, {
         for (size_t i = 0; i < num_dims; i++) {
-            node_coords(0, node_gid, i) = node_coords(1, node_gid, i);
-            node_vel(0, node_gid, i)    = node_vel(1, node_gid, i);
+            node_coords(rk_bin, node_gid, i) = node_coords(src_bin, node_gid, i);
+            node_vel(rk_bin, node_gid, i)    = node_vel(src_bin, node_gid, i);
         }
     }); // end parallel for
     Kokkos::fence();
@@ -83,137 +87,293 @@ void SGH::rk_init(DCArrayKokkos<double>& node_coords,
 
 /////////////////////////////////////////////////////////////////////////////
 ///
-/// \fn get_timestep
+/// \fn rk_init_stress
 ///
-/// \brief This function calculates the time step by finding the shortest distance
-///        between any two nodes in the mesh.
+/// \brief Copies only the element stress into a Runge Kutta bin
 ///
-/// WARNING WARNING :  Only works for 3D, 8 node elements
+/// The schemes that swap the bins or keep a register in bin 0 still need
+/// the stress at t_n next to the stage stress once a strength model
+/// evolves it.
 ///
-/// \param Simulation mesh
-/// \param View of nodal position data
-/// \param View of nodal velocity data
-/// \param View of element sound speed
-/// \param View of element volume
+/// \param View of element stress
+/// \param Number of elements
+/// \param Runge Kutta bin that receives the copy of the other bin
 ///
-/// REMOVE EXCESS TIME RELATED VARIABLES
+/////////////////////////////////////////////////////////////////////////////
+void SGH::rk_init_stress(DCArrayKokkos<double>& elem_stress,
+    const size_t num_elems,
+    const size_t rk_bin)
+{
+    const size_t src_bin = 1 - rk_bin;
+
+    FOR_ALL(elem_gid, 0, num_elems, {
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                elem_stress(rk_bin, elem_gid, i, j) = elem_stress(src_bin, elem_gid, i, j);
+            }
+        }  // end for
+    }); // end parallel for
+    Kokkos::fence();
+
+    return;
+} // end rk_init_stress
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn rk_sync
+///
+/// \brief Moves the current state back into rk bin 1 when the bins are swapped
+///
+/// The mesh writer, the cycle callback and the energy tallies read bin 1.
+/// Nothing is copied when the current state is already there.
+///
+/// \param The simulation mesh
+/// \param The nodal state
+/// \param The element state
+/// \param Runge Kutta bin holding the current state, set to 1
 ///
 /////////////////////////////////////////////////////////////////////////////
-void SGH::get_timestep(mesh_t& mesh,
-    DCArrayKokkos<double>&     node_coords,
-    DCArrayKokkos<double>&     node_vel,
-    DCArrayKokkos<double>&     elem_sspd,
-    DCArrayKokkos<double>&     elem_vol,
-    double time_value,
-    const double graphics_time,
-    const double time_final,
-    const double dt_max,
-    const double dt_min,
-    const double dt_cfl,
-    double&      dt,
-    const double fuzz)
+void SGH::rk_sync(const mesh_t& mesh,
+    node_t& node,
+    elem_t& elem,
+    size_t& rk_bin)
 {
-    // increase dt by 10%, that is the largest dt value
-    dt = dt * 1.1;
+    if (rk_bin == 1) {
+        return;
+    }
 
-    double dt_lcl;
-    double min_dt_calc;
-    REDUCE_MIN(elem_gid, 0, mesh.num_elems, dt_lcl, {
-        double coords0[24];  // element coords
-        ViewCArrayKokkos<double> coords(coords0, 8, 3);
+    rk_init(node.coords,
+            node.vel,
+            elem.sie,
+            elem.stress,
+            mesh.num_dims,
+            mesh.num_elems,
+            mesh.num_nodes,
+            1);
 
-        double distance0[28];  // array for holding distances between each node
-        ViewCArrayKokkos<double> dist(distance0, 28);
+    rk_bin = 1;
+} // end rk_sync
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_lsrk_coefficients
+///
+/// \brief Gets the coefficients of a 2N-storage low-storage RK scheme
+///
+/// Each stage updates a register dU and the solution U as
+///     dU = A(stage) dU + dt F(U)
+///     U  = U + B(stage) dU
+/// With A(0) = 0 the register does not need to be initialized, so rk bin 0
+/// of the coordinates, velocity and energy is used as the register and they
+/// are not copied per cycle. The stress keeps t_n in bin 0.
+///
+/// C(stage) is the time reached at the end of the stage as a fraction of dt,
+/// the register holds dt times a weight r with r = A(stage) r + 1.
+///
+/// \param Low-storage scheme
+/// \param Array of at least 5 values for the A coefficients
+/// \param Array of at least 5 values for the B coefficients
+/// \param Array of at least 5 values for the stage time fractions
+///
+/// \return Number of stages
+///
+/////////////////////////////////////////////////////////////////////////////
+size_t SGH::get_lsrk_coefficients(const integrator::scheme scheme,
+    double* lsrk_A,
+    double* lsrk_B,
+    double* lsrk_C)
+{
+    size_t num_stages = 0;
+
+    if (scheme == integrator::lsrk3) {
+        // Williamson (1980), 3 stages, 3rd order
+        lsrk_A[0] = 0.0;
+        lsrk_A[1] = -5.0 / 9.0;
+        lsrk_A[2] = -153.0 / 128.0;
+
+        lsrk_B[0] = 1.0 / 3.0;
+        lsrk_B[1] = 15.0 / 16.0;
+        lsrk_B[2] = 8.0 / 15.0;
+
+        num_stages = 3;
+    }
+    else if (scheme == integrator::lsrk4) {
+        // Carpenter and Kennedy (1994), 5 stages, 4th order
+        lsrk_A[0] = 0.0;
+        lsrk_A[1] = -567301805773.0 / 1357537059087.0;
+        lsrk_A[2] = -2404267990393.0 / 2016746695238.0;
+        lsrk_A[3] = -3550918686646.0 / 2091501179385.0;
+        lsrk_A[4] = -1275806237668.0 / 842570457699.0;
+
+        lsrk_B[0] = 1432997174477.0 / 9575080441755.0;
+        lsrk_B[1] = 5161836677717.0 / 13612068292357.0;
+        lsrk_B[2] = 1720146321549.0 / 2090206949498.0;
+        lsrk_B[3] = 3134564353537.0 / 4481467310338.0;
+        lsrk_B[4] = 2277821191437.0 / 14882151754819.0;
+
+        num_stages = 5;
+    }
+    else{
+        throw std::runtime_error("**** NOT A LOW-STORAGE RK SCHEME ****");
+    }
+
+    // the stage time fractions
+    double weight   = 0.0;
+    double fraction = 0.0;
+    for (size_t stage = 0; stage < num_stages; stage++) {
+        weight   = lsrk_A[stage] * weight + 1.0;
+        fraction = fraction + lsrk_B[stage] * weight;
+        lsrk_C[stage] = fraction;
+    } // end for stage
+
+    return num_stages;
+} // end get_lsrk_coefficients
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lsrk_update_energy
+///
+/// \brief Low-storage RK stage update of the specific internal energy
+///
+/// The power uses the average of the velocity before and after the stage,
+/// the same half step velocity update_energy uses, so this is called after
+/// lsrk_update_nodes and the velocity boundary conditions. The energy
+/// register is elem_sie(0).
+///
+/// \param A coefficient of the stage
+/// \param B coefficient of the stage
+/// \param Time step size
+/// \param The simulation mesh
+/// \param A view into the nodal velocity data
+/// \param The nodal velocity at the start of the stage
+/// \param A view into the nodal position data
+/// \param A view into the element specific internal energy
+/// \param A view into the element mass
+/// \param A view into the corner force data
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lsrk_update_energy(const double lsrk_A,
+    const double lsrk_B,
+    const double dt,
+    const mesh_t& mesh,
+    const DCArrayKokkos<double>& node_vel,
+    const CArrayKokkos<double>&  node_vel_start,
+    const DCArrayKokkos<double>& node_coords,
+    DCArrayKokkos<double>& elem_sie,
+    const DCArrayKokkos<double>& elem_mass,
+    const DCArrayKokkos<double>& corner_force)
+{
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        double elem_power = 0.0;
+
+        for (size_t node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
+            size_t node_gid   = mesh.nodes_in_elem(elem_gid, node_lid);
+            size_t corner_gid = mesh.corners_in_elem(elem_gid, node_lid);
+
+            double node_radius = 1;
+            if (mesh.num_dims == 2) {
+                node_radius = node_coords(1, node_gid, 1);
+            }
 
-        // Getting the coordinates of the element
-        for (size_t node_lid = 0; node_lid < 8; node_lid++) {
             for (size_t dim = 0; dim < mesh.num_dims; dim++) {
-                coords(node_lid, dim) = node_coords(1, mesh.nodes_in_elem(elem_gid, node_lid), dim);
+                double half_vel = (node_vel(1, node_gid, dim) + node_vel_start(node_gid, dim)) * 0.5;
+                elem_power += corner_force(corner_gid, dim) * node_radius * half_vel;
             } // end for dim
-        } // end for loop over node_lid
+        } // end for node_lid
 
-        // loop conditions needed for distance calculation
-        size_t countA = 0;
-        size_t countB = 1;
-        size_t a;
-        size_t b;
-        size_t loop = 0;
-
-        // Only works for 3D
-        // Solving for the magnitude of distance between each node
-        for (size_t i = 0; i < 28; i++) {
-            a = countA;
-            b = countB;
-
-            // returns magnitude of distance between each node, 28 total options
-            dist(i) = fabs(sqrt((pow((coords(b, 0) - coords(a, 0)), 2.0)
-                                 + pow((coords(b, 1) - coords(a, 1)), 2.0)
-                                 + pow((coords(b, 2) - coords(a, 2)), 2.0))));
-
-            countB++;
-            countA++;
-
-            // tricky indexing
-            if (countB > 7) {
-                loop++;
-                countB = 1 + loop;
-                countA = 0;
-            }
-        } // end for i
+        elem_sie(0, elem_gid)  = lsrk_A * elem_sie(0, elem_gid) - dt / elem_mass(elem_gid) * elem_power;
+        elem_sie(1, elem_gid) += lsrk_B * elem_sie(0, elem_gid);
+    }); // end parallel loop over the elements
 
-        double dist_min = dist(0);
+    return;
+} // end lsrk_update_energy
 
-        for (int i = 0; i < 28; ++i) {
-            dist_min = fmin(dist(i), dist_min);
-        }
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn lsrk_update_nodes
+///
+/// \brief Low-storage RK stage update of the nodal position and velocity
+///
+/// The position is advanced with the stage velocity before the velocity is
+/// updated. The registers are node_coords(0) and node_vel(0). The velocity
+/// at the start of the stage is saved for lsrk_update_energy.
+///
+/// \param A coefficient of the stage
+/// \param B coefficient of the stage
+/// \param Time step size
+/// \param The simulation mesh
+/// \param View of the nodal position data
+/// \param View of the nodal velocity data
+/// \param Nodal velocity at the start of the stage, filled here
+/// \param View of the nodal mass
+/// \param View of the corner forces
+///
+/////////////////////////////////////////////////////////////////////////////
+void SGH::lsrk_update_nodes(const double lsrk_A,
+    const double lsrk_B,
+    const double dt,
+    const mesh_t& mesh,
+    DCArrayKokkos<double>& node_coords,
+    DCArrayKokkos<double>& node_vel,
+    CArrayKokkos<double>&  node_vel_start,
+    const DCArrayKokkos<double>& node_mass,
+    const DCArrayKokkos<double>& corner_force)
+{
+    const size_t num_dims = mesh.num_dims;
 
-        // local dt calc based on CFL
-        double dt_lcl_ = dt_cfl * dist_min / (elem_sspd(elem_gid) + fuzz);
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        double node_force[3];
+        for (size_t dim = 0; dim < num_dims; dim++) {
+            node_force[dim] = 0.0;
+        } // end for dim
 
-        // make dt be in bounds
-        dt_lcl_ = fmin(dt_lcl_, dt_max);               // make dt small than dt_max
-        dt_lcl_ = fmax(dt_lcl_, dt_min);               // make dt larger than dt_min
+        for (size_t corner_lid = 0; corner_lid < mesh.num_corners_in_node(node_gid); corner_lid++) {
+            size_t corner_gid = mesh.corners_in_node(node_gid, corner_lid);
 
-        if (dt_lcl_ < dt_lcl) {
-            dt_lcl = dt_lcl_;
-        }
-    }, min_dt_calc);  // end parallel reduction
-    Kokkos::fence();
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                node_force[dim] += corner_force(corner_gid, dim);
+            } // end for dim
+        } // end for corner_lid
 
-    // save the min dt
-    if (min_dt_calc < dt) {
-        dt = min_dt_calc;
-    }
+        for (size_t dim = 0; dim < num_dims; dim++) {
+            node_vel_start(node_gid, dim) = node_vel(1, node_gid, dim);
 
-    // ensure time step hits the graphics time intervals
-    dt = fmin(dt, (graphics_time - time_value) + fuzz);
+            node_coords(0, node_gid, dim)  = lsrk_A * node_coords(0, node_gid, dim) + dt * node_vel(1, node_gid, dim);
+            node_coords(1, node_gid, dim) += lsrk_B * node_coords(0, node_gid, dim);
+
+            node_vel(0, node_gid, dim)  = lsrk_A * node_vel(0, node_gid, dim) + dt * node_force[dim] / node_mass(node_gid);
+            node_vel(1, node_gid, dim) += lsrk_B * node_vel(0, node_gid, dim);
+        } // end for dim
+    }); // end parallel for over nodes
 
-    // make dt be exact for final time
-    dt = fmin(dt, time_final - time_value);
     return;
-} // end get_timestep
+} // end lsrk_update_nodes
 
 /////////////////////////////////////////////////////////////////////////////
 ///
-/// \fn get_timestep2D
+/// \fn get_timestep
 ///
 /// \brief This function calculates the time step by finding the shortest distance
-///        between any two nodes in the mesh.
-///
-/// WARNING WARNING :  Only works for 2D, 4 node elements
+///        between any two nodes of each element.  Templated on the element
+///        topology so the node pair loops and coordinate buffer are sized
+///        at compile time.
 ///
 /// \param Simulation mesh
 /// \param View of nodal position data
 /// \param View of nodal velocity data
 /// \param View of element sound speed
 /// \param View of element volume
+/// \param Runge Kutta bin holding the current state
+///
+/// REMOVE EXCESS TIME RELATED VARIABLES
 ///
 /////////////////////////////////////////////////////////////////////////////
-void SGH::get_timestep2D(mesh_t& mesh,
-    DCArrayKokkos<double>& node_coords,
-    DCArrayKokkos<double>& node_vel,
-    DCArrayKokkos<double>& elem_sspd,
-    DCArrayKokkos<double>& elem_vol,
+template <typename Topology>
+void SGH::get_timestep(mesh_t& mesh,
+    DCArrayKokkos<double>&     node_coords,
+    DCArrayKokkos<double>&     node_vel,
+    DCArrayKokkos<double>&     elem_sspd,
+    DCArrayKokkos<double>&     elem_vol,
     double time_value,
     const double graphics_time,
     const double time_final,
@@ -221,7 +381,8 @@ void SGH::get_timestep2D(mesh_t& mesh,
     const double dt_min,
     const double dt_cfl,
     double&      dt,
-    const double fuzz)
+    const double fuzz,
+    const size_t rk_bin)
 {
     // increase dt by 10%, that is the largest dt value
     dt = dt * 1.1;
@@ -229,45 +390,37 @@ void SGH::get_timestep2D(mesh_t& mesh,
     double dt_lcl;
     double min_dt_calc;
     REDUCE_MIN(elem_gid, 0, mesh.num_elems, dt_lcl, {
-        double coords0[8];  // element coords
-        ViewCArrayKokkos<double> coords(coords0, 4, 2);
+        constexpr size_t num_dims = Topology::num_dims;
+        constexpr size_t num_nodes_in_elem = Topology::num_nodes_in_elem;
 
-        double distance0[6];  // array for holding distances between each node
-        ViewCArrayKokkos<double> dist(distance0, 6);
+        double coords0[num_nodes_in_elem * num_dims];  // element coords
+        ViewCArrayKokkos<double> coords(coords0, num_nodes_in_elem, num_dims);
 
-        // Getting the coordinates of the nodes of the element
-        for (size_t node_lid = 0; node_lid < 4; node_lid++) {
-            for (size_t dim = 0; dim < mesh.num_dims; dim++) {
-                coords(node_lid, dim) = node_coords(1, mesh.nodes_in_elem(elem_gid, node_lid), dim);
+        // Getting the coordinates of the element
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                coords(node_lid, dim) = node_coords(rk_bin, mesh.nodes_in_elem(elem_gid, node_lid), dim);
             } // end for dim
         } // end for loop over node_lid
 
-        // Only works for 2D
-        // Solving for the magnitude of distance between each node
-        size_t count = 0;
-        for (size_t i = 0; i < 3; i++) {
-            for (size_t j = i + 1; j <= 3; j++) {
-                // returns magnitude of distance between each node, 6 total options
-                dist(count) = fabs(
-                                 sqrt(pow((coords(i, 0) - coords(j, 0)), 2.0)
-                        + pow((coords(i, 1) - coords(j, 1)), 2.0) )
-                    );
-                count++;
-            } // end for j
-        } // end for i
-
-        double dist_min = dist(0);
-
-        for (int i = 0; i < 6; ++i) {
-            dist_min = fmin(dist(i), dist_min);
-        }
+        // Solving for the magnitude of distance between each pair of nodes
+        double dist_min = 1.0e30;
+        for (size_t node_a = 0; node_a < num_nodes_in_elem; node_a++) {
+            for (size_t node_b = node_a + 1; node_b < num_nodes_in_elem; node_b++) {
+                double dist = 0.0;
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    dist += (coords(node_b, dim) - coords(node_a, dim)) * (coords(node_b, dim) - coords(node_a, dim));
+                }
+                dist_min = fmin(dist_min, sqrt(dist));
+            } // end for node_b
+        } // end for node_a
 
         // local dt calc based on CFL
         double dt_lcl_ = dt_cfl * dist_min / (elem_sspd(elem_gid) + fuzz);
 
         // make dt be in bounds
-        dt_lcl_ = fmin(dt_lcl_, dt_max);    // make dt small than dt_max
-        dt_lcl_ = fmax(dt_lcl_, dt_min);    // make dt larger than dt_min
+        dt_lcl_ = fmin(dt_lcl_, dt_max);               // make dt small than dt_max
+        dt_lcl_ = fmax(dt_lcl_, dt_min);               // make dt larger than dt_min
 
         if (dt_lcl_ < dt_lcl) {
             dt_lcl = dt_lcl_;
@@ -285,6 +438,35 @@ void SGH::get_timestep2D(mesh_t& mesh,
 
     // make dt be exact for final time
     dt = fmin(dt, time_final - time_value);
-
     return;
-} // end get_timestep2D
+} // end get_timestep
+
+// instantiations for the supported element topologies
+template void SGH::get_timestep<topology::quad4>(mesh_t& mesh,
+    DCArrayKokkos<double>&     node_coords,
+    DCArrayKokkos<double>&     node_vel,
+    DCArrayKokkos<double>&     elem_sspd,
+    DCArrayKokkos<double>&     elem_vol,
+    double time_value,
+    const double graphics_time,
+    const double time_final,
+    const double dt_max,
+    const double dt_min,
+    const double dt_cfl,
+    double&      dt,
+    const double fuzz,
+    const size_t rk_bin);
+template void SGH::get_timestep<topology::hex8>(mesh_t& mesh,
+    DCArrayKokkos<double>&     node_coords,
+    DCArrayKokkos<double>&     node_vel,
+    DCArrayKokkos<double>&     elem_sspd,
+    DCArrayKokkos<double>&     elem_vol,
+    double time_value,
+    const double graphics_time,
+    const double time_final,
+    const double dt_max,
+    const double dt_min,
+    const double dt_cfl,
+    double&      dt,
+    const double fuzz,
+    const size_t rk_bin);
@@ -48,7 +48,8 @@ enum bdy_tag
     z_plane   = 2,  // tag an z-plane
     cylinder  = 3,  // tag an cylindrical surface
     sphere    = 4,   // tag a spherical surface
-    global    = 5   // tag all boundary patches (used for contact only)
+    global    = 5,  // tag all boundary patches (used for contact only)
+    contact_surface = 6  // tag every boundary patch of the mesh as a contact surface
     //read_file = 5   // read from a file currently unsupported
 };
 
@@ -82,7 +83,8 @@ static std::map<std::string, boundary_conds::bdy_tag> bc_geometry_map
     { "z_plane", boundary_conds::z_plane },
     { "cylinder", boundary_conds::cylinder },
     { "sphere", boundary_conds::sphere },
-    {"global", boundary_conds::global }
+    {"global", boundary_conds::global },
+    { "contact_surface", boundary_conds::contact_surface }
     // { "read_file", boundary_conds::read_file }
 };
 
@@ -37,6 +37,40 @@
 #include <stdio.h>
 #include "matar.h"
 
+namespace integrator
+{
+// time integration scheme
+enum scheme
+{
+    rk = 0,         // rk_num_stages stage RK, t_n is saved in rk bin 0 every cycle
+    lsrk3 = 1,      // 3 stage, 3rd order, 2N-storage low-storage RK (Williamson)
+    lsrk4 = 2,      // 5 stage, 4th order, 2N-storage low-storage RK (Carpenter-Kennedy)
+};
+} // end of namespace
+
+static std::map<std::string, integrator::scheme> time_integrator_map
+{
+    { "rk", integrator::rk },
+    { "lsrk3", integrator::lsrk3 },
+    { "lsrk4", integrator::lsrk4 }
+};
+
+namespace force_assembly
+{
+// how the corner forces reach the nodes
+enum mode
+{
+    corner_gather = 0,   // update_velocity gathers the corner forces around each node
+    atomic_scatter = 1,  // get_force atomically adds the corner forces into a node force array
+};
+} // end of namespace
+
+static std::map<std::string, force_assembly::mode> node_force_mode_map
+{
+    { "corner_gather", force_assembly::corner_gather },
+    { "atomic_scatter", force_assembly::atomic_scatter }
+};
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /// \struct dynamic_options_t
@@ -60,6 +94,16 @@ struct dynamic_options_t
 
     int rk_num_stages = 2;      ///< Number of RK stages
     int rk_num_bins   = 2;      ///< Number of memory bins for time integration
+    int rk_fused_kernels = 0;   ///< 1 = fused element/node passes per RK stage (3D SGH)
+    int simd_force_kernel = 0;  ///< 1 = SIMD-packed corner force kernel (3D SGH, CPU backends)
+
+    integrator::scheme time_integrator = integrator::rk; ///< Time integration scheme
+
+    int lts_num_levels = 1;     ///< Number of power-of-two local time step levels, 1 = global dt
+
+    int active_list_ival = 0;   ///< Cycles between rebuilds of the active elem/node lists, 0 = sweep all
+
+    force_assembly::mode node_force_mode = force_assembly::corner_gather; ///< Corner to node force assembly
 }; // output_options_t
 
 // ----------------------------------
@@ -78,7 +122,13 @@ static std::vector<std::string> str_dyn_opts_inps
     "tiny",
     "small",
     "rk_num_stages",
-    "rk_num_bins"
+    "rk_num_bins",
+    "rk_fused_kernels",
+    "simd_force_kernel",
+    "time_integrator",
+    "lts_num_levels",
+    "active_list_ival",
+    "node_force_mode"
 };
 
 #endif // end Header Guard
\ No newline at end of file
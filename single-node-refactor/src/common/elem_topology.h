@@ -0,0 +1,115 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef ELEM_TOPOLOGY_H
+#define ELEM_TOPOLOGY_H
+
+#include <stddef.h>
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \namespace topology
+///
+/// \brief Compile-time element topologies.  Kernels templated on these
+///        get constexpr loop bounds and exactly sized temporaries, and the
+///        solver picks the instantiation once from the mesh.
+///
+/////////////////////////////////////////////////////////////////////////////
+namespace topology
+{
+/// 4 node linear quadrilateral, used for 2D RZ meshes
+struct quad4
+{
+    static constexpr size_t num_dims = 2;
+    static constexpr size_t order    = 1;
+    static constexpr size_t num_nodes_in_elem = 4;
+};
+
+/// 8 node linear hexahedron
+struct hex8
+{
+    static constexpr size_t num_dims = 3;
+    static constexpr size_t order    = 1;
+    static constexpr size_t num_nodes_in_elem = 8;
+};
+
+/// Lagrange hexahedron of polynomial order Order, (Order+1)^3 nodes
+template <size_t Order>
+struct hexN
+{
+    static constexpr size_t num_dims = 3;
+    static constexpr size_t order    = Order;
+    static constexpr size_t num_nodes_in_elem = (Order + 1) * (Order + 1) * (Order + 1);
+};
+
+// element types recognised from the mesh sizes; SGH has kernels for quad4 and hex8 only
+enum elem_kind
+{
+    unsupported = 0,
+    quad4_elem  = 1,
+    hex8_elem   = 2,
+    hex27_elem  = 3,
+    hex64_elem  = 4,
+};
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_elem_kind
+///
+/// \brief Identifies the element topology from the mesh sizes
+///
+/// \param Number of dimensions of the mesh
+/// \param Number of nodes in each element
+///
+/////////////////////////////////////////////////////////////////////////////
+inline elem_kind get_elem_kind(const size_t num_dims, const size_t num_nodes_in_elem)
+{
+    if (num_dims == quad4::num_dims && num_nodes_in_elem == quad4::num_nodes_in_elem) {
+        return quad4_elem;
+    }
+    if (num_dims == hex8::num_dims && num_nodes_in_elem == hex8::num_nodes_in_elem) {
+        return hex8_elem;
+    }
+    if (num_dims == hexN<2>::num_dims && num_nodes_in_elem == hexN<2>::num_nodes_in_elem) {
+        return hex27_elem;
+    }
+    if (num_dims == hexN<3>::num_dims && num_nodes_in_elem == hexN<3>::num_nodes_in_elem) {
+        return hex64_elem;
+    }
+
+    return unsupported;
+} // end get_elem_kind
+} // end namespace topology
+
+#endif // end Header Guard
@@ -0,0 +1,248 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef FIERRO_ENSEMBLE_H
+#define FIERRO_ENSEMBLE_H
+
+#include <stdio.h>
+#include <vector>
+
+#include "matar.h"
+#include "mesh.h"
+#include "state.h"
+#include "ensemble_options.h"
+
+using namespace mtr;
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn replicate_mesh
+///
+/// \brief Replaces the mesh with num_members disjoint copies of it
+///
+/// Member m holds nodes m*num_member_nodes to (m+1)*num_member_nodes-1, and
+/// its elems are numbered the same way. The copies sit on top of each other,
+/// so the boundary sets and region fills select the same entities in every
+/// member. Every solver kernel then advances all the members in one launch.
+/// The connectivity of the replicated mesh is built once for the whole
+/// ensemble.
+///
+/// \param Simulation mesh
+/// \param Element state data
+/// \param Node state data
+/// \param Corner state data
+/// \param Number of ensemble members
+/// \param Number of RK bins
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void replicate_mesh(mesh_t& mesh, elem_t& elem, node_t& node, corner_t& corner,
+    const size_t num_members, const int rk_num_bins)
+{
+    if (num_members <= 1) {
+        return;
+    }
+
+    const int    num_dims  = mesh.num_dims;
+    const size_t num_nodes = mesh.num_nodes;
+    const size_t num_elems = mesh.num_elems;
+    const size_t num_nodes_in_elem = mesh.num_nodes_in_elem;
+
+    const size_t num_ens_nodes = num_members * num_nodes;
+    const size_t num_ens_elems = num_members * num_elems;
+
+    // --- stage the member coordinates, connectivity and original ids ---
+    std::vector<double> coords_tmp(rk_num_bins * num_nodes * num_dims);
+    for (int rk = 0; rk < rk_num_bins; rk++) {
+        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+            for (int dim = 0; dim < num_dims; dim++) {
+                coords_tmp[(rk * num_nodes + node_gid) * num_dims + dim] = node.coords(rk, node_gid, dim);
+            }
+        }
+    }
+
+    std::vector<size_t> nodes_in_elem_tmp(num_elems * num_nodes_in_elem);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            nodes_in_elem_tmp[elem_gid * num_nodes_in_elem + node_lid] = mesh.nodes_in_elem.host(elem_gid, node_lid);
+        }
+    }
+
+    // the members are written one after the other in the original order
+    CArray<size_t> node_orig_gids(num_ens_nodes);
+    CArray<size_t> elem_orig_gids(num_ens_elems);
+    for (size_t member = 0; member < num_members; member++) {
+        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+            size_t orig_gid = mesh.renumbered ? mesh.node_orig_gids(node_gid) : node_gid;
+            node_orig_gids(member * num_nodes + node_gid) = member * num_nodes + orig_gid;
+        }
+        for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+            size_t orig_gid = mesh.renumbered ? mesh.elem_orig_gids(elem_gid) : elem_gid;
+            elem_orig_gids(member * num_elems + elem_gid) = member * num_elems + orig_gid;
+        }
+    }
+
+    // --- rebuild the mesh and state with the members side by side ---
+    mesh.initialize_nodes(num_ens_nodes);
+    node.initialize(rk_num_bins, num_ens_nodes, num_dims);
+    for (int rk = 0; rk < rk_num_bins; rk++) {
+        for (size_t member = 0; member < num_members; member++) {
+            for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+                for (int dim = 0; dim < num_dims; dim++) {
+                    node.coords(rk, member * num_nodes + node_gid, dim) = coords_tmp[(rk * num_nodes + node_gid) * num_dims + dim];
+                }
+            }
+        }
+    }
+
+    mesh.initialize_elems(num_ens_elems, num_dims);
+    elem.initialize(rk_num_bins, num_ens_elems, 3); // always 3D here, even for 2D
+    for (size_t member = 0; member < num_members; member++) {
+        for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                mesh.nodes_in_elem.host(member * num_elems + elem_gid, node_lid) =
+                    member * num_nodes + nodes_in_elem_tmp[elem_gid * num_nodes_in_elem + node_lid];
+            }
+        }
+    }
+    mesh.nodes_in_elem.update_device();
+
+    size_t num_corners = num_ens_elems * num_nodes_in_elem;
+    mesh.initialize_corners(num_corners);
+    corner.initialize(num_corners, num_dims);
+
+    mesh.num_members      = num_members;
+    mesh.num_member_nodes = num_nodes;
+    mesh.num_member_elems = num_elems;
+
+    mesh.renumbered     = true;
+    mesh.node_orig_gids = node_orig_gids;
+    mesh.elem_orig_gids = elem_orig_gids;
+
+    mesh.build_connectivity();
+
+    printf("Ensemble of %lu members, %lu elems and %lu nodes per member\n",
+           num_members, num_elems, num_nodes);
+
+    return;
+} // end replicate_mesh
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn write_ensemble_report
+///
+/// \brief Writes the swept values and the energy tallies of every member
+///        to a csv file, one line per member
+///
+/// \param Name of the report file
+/// \param Ensemble options
+/// \param Simulation mesh
+/// \param Node state data
+/// \param Element state data
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void write_ensemble_report(const char* file_name,
+    const ensemble_options_t& ensemble_options,
+    const mesh_t& mesh,
+    const node_t& node,
+    const elem_t& elem)
+{
+    const size_t num_members      = mesh.num_members;
+    const size_t num_member_nodes = mesh.num_member_nodes;
+    const size_t num_member_elems = mesh.num_member_elems;
+
+    // IE, KE and max pressure of each member
+    DCArrayKokkos<double> tallies(num_members, 3);
+    FOR_ALL(member, 0, num_members, {
+        tallies(member, 0) = 0.0;
+        tallies(member, 1) = 0.0;
+        tallies(member, 2) = -1.0e200;
+    });
+    Kokkos::fence();
+
+    FOR_ALL(elem_gid, 0, mesh.num_elems, {
+        size_t member = elem_gid / num_member_elems;
+        Kokkos::atomic_add(&tallies(member, 0), elem.mass(elem_gid) * elem.sie(1, elem_gid));
+        Kokkos::atomic_max(&tallies(member, 2), elem.pres(elem_gid));
+    });
+
+    FOR_ALL(node_gid, 0, mesh.num_nodes, {
+        size_t member = node_gid / num_member_nodes;
+
+        double ke = 0.0;
+        for (size_t dim = 0; dim < mesh.num_dims; dim++) {
+            ke += node.vel(1, node_gid, dim) * node.vel(1, node_gid, dim);
+        }
+
+        // the 2D-RZ node mass is areal
+        double radius = 1.0;
+        if (mesh.num_dims == 2) {
+            radius = node.coords(1, node_gid, 1);
+        }
+        Kokkos::atomic_add(&tallies(member, 1), 0.5 * node.mass(node_gid) * radius * ke);
+    });
+    Kokkos::fence();
+    tallies.update_host();
+
+    const char* str_sweeps[ensemble::num_fill_vars] = { "den", "sie", "u", "v", "w", "speed", "eos_var" };
+
+    FILE* out = fopen(file_name, "w");
+
+    fprintf(out, "member");
+    for (size_t var = 0; var < ensemble::num_fill_vars; var++) {
+        if (!ensemble_options.sweeps[var].empty()) {
+            fprintf(out, ",%s", str_sweeps[var]);
+        }
+    }
+    fprintf(out, ",KE,IE,TE,max_pres\n");
+
+    for (size_t member = 0; member < num_members; member++) {
+        fprintf(out, "%lu", member);
+        for (size_t var = 0; var < ensemble::num_fill_vars; var++) {
+            if (!ensemble_options.sweeps[var].empty()) {
+                fprintf(out, ",%.10e", ensemble_options.member_value((ensemble::fill_var)var, member));
+            }
+        }
+        fprintf(out, ",%.10e,%.10e,%.10e,%.10e\n",
+                tallies.host(member, 1),
+                tallies.host(member, 0),
+                tallies.host(member, 0) + tallies.host(member, 1),
+                tallies.host(member, 2));
+    } // end for member
+
+    fclose(out);
+
+    return;
+} // end write_ensemble_report
+
+#endif // end Header Guard
@@ -0,0 +1,108 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef FIERRO_ENSEMBLE_OPTIONS_H
+#define FIERRO_ENSEMBLE_OPTIONS_H
+#include <stdio.h>
+#include <vector>
+#include "matar.h"
+
+namespace ensemble
+{
+// region fill values that can differ between ensemble members
+enum fill_var
+{
+    den = 0,            // density
+    sie = 1,            // specific internal energy
+    u = 2,              // x velocity of a cartesian fill
+    v = 3,              // y velocity of a cartesian fill
+    w = 4,              // z velocity of a cartesian fill
+    speed = 5,          // speed of a radial or spherical fill
+    eos_var = 6,        // the eos_var_id EOS global variable
+    num_fill_vars = 7
+};
+} // end of namespace
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \struct ensemble_options_t
+///
+/// \brief Stores the ensemble options.  The members share the mesh and are
+///        advanced together, they differ only in the values swept over the
+///        region fill region_id.  A sweep is either one value per member or
+///        [first, last], which is spaced evenly over the members.
+///
+/////////////////////////////////////////////////////////////////////////////
+struct ensemble_options_t
+{
+    int num_members = 1;    ///< Number of ensemble members, 1 = a single simulation
+    int region_id   = 0;    ///< Region fill the sweeps are applied to
+    int eos_var_id  = 0;    ///< EOS global variable the eos_var sweep is applied to
+
+    std::vector<double> sweeps[ensemble::num_fill_vars]; ///< Swept values, empty = not swept
+
+    // value of a swept fill variable for a member
+    double member_value(const ensemble::fill_var var, const int member) const
+    {
+        const std::vector<double>& vals = sweeps[var];
+
+        if (vals.size() == (size_t)num_members) {
+            return vals[member];
+        }
+        else if (vals.size() == 2 && num_members > 1) {
+            return vals[0] + (vals[1] - vals[0]) * (double)member / (double)(num_members - 1);
+        }
+
+        return vals[0];
+    }
+}; // ensemble_options_t
+
+// ----------------------------------
+// valid inputs for ensemble options
+// ----------------------------------
+static std::vector<std::string> str_ensemble_opts_inps
+{
+    "num_members",
+    "region_id",
+    "eos_var_id",
+    "den",
+    "sie",
+    "u",
+    "v",
+    "w",
+    "speed",
+    "eos_var"
+};
+
+#endif // end Header Guard
@@ -62,13 +62,15 @@ namespace geometry
 /// \param Global index of the element
 /// \param View of nodal position data
 /// \param View of the elements node ids
+/// \param Runge Kutta bin of the nodal positions
 ///
 /////////////////////////////////////////////////////////////////////////////
 KOKKOS_INLINE_FUNCTION
 void get_bmatrix(const ViewCArrayKokkos<double>& B_matrix,
     const size_t elem_gid,
     const DCArrayKokkos<double>&    node_coords,
-    const ViewCArrayKokkos<size_t>& elem_node_gids)
+    const ViewCArrayKokkos<size_t>& elem_node_gids,
+    const size_t rk_bin = 1)
 {
     const size_t num_nodes = 8;
 
@@ -83,9 +85,9 @@ void get_bmatrix(const ViewCArrayKokkos<double>& B_matrix,
 
     // get the coordinates of the nodes(rk,elem,node) in this element
     for (int node_lid = 0; node_lid < num_nodes; node_lid++) {
-        x(node_lid) = node_coords(1, elem_node_gids(node_lid), 0);
-        y(node_lid) = node_coords(1, elem_node_gids(node_lid), 1);
-        z(node_lid) = node_coords(1, elem_node_gids(node_lid), 2);
+        x(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 0);
+        y(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 1);
+        z(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 2);
     }     // end for
 
     double twelth = 1. / 12.;
@@ -269,13 +271,15 @@ void get_bmatrix(const ViewCArrayKokkos<double>& B_matrix,
 /// \param Global index of the element
 /// \param Nodal coordinates
 /// \param Global ids of the nodes in this element
+/// \param Runge Kutta bin of the nodal positions
 ///
 /////////////////////////////////////////////////////////////////////////////
 KOKKOS_INLINE_FUNCTION
 void get_vol_quad(const DCArrayKokkos<double>& elem_vol,
     const size_t elem_gid,
     const DCArrayKokkos<double>&    node_coords,
-    const ViewCArrayKokkos<size_t>& elem_node_gids)
+    const ViewCArrayKokkos<size_t>& elem_node_gids,
+    const size_t rk_bin = 1)
 {
     elem_vol(elem_gid) = 0.0;
 
@@ -290,8 +294,8 @@ void get_vol_quad(const DCArrayKokkos<double>& elem_vol,
 
     // get the coordinates of the nodes(rk,elem,node) in this element
     for (int node_lid = 0; node_lid < num_nodes; node_lid++) {
-        x(node_lid) = node_coords(1, elem_node_gids(node_lid), 0);
-        y(node_lid) = node_coords(1, elem_node_gids(node_lid), 1);
+        x(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 0);
+        y(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 1);
     }     // end for
 
     /* ensight node order   0 1 2 3
@@ -313,6 +317,7 @@ void get_vol_quad(const DCArrayKokkos<double>& elem_vol,
 /// \param View of element volume data
 /// \param Global element index
 /// \param View into nodal position data
+/// \param Global ids of the nodes in this element
 /// \param Runge Kutta time integration level
 ///
 /////////////////////////////////////////////////////////////////////////////
@@ -320,7 +325,8 @@ KOKKOS_INLINE_FUNCTION
 void get_vol_hex(const DCArrayKokkos<double>& elem_vol,
     const size_t elem_gid,
     const DCArrayKokkos<double>&    node_coords,
-    const ViewCArrayKokkos<size_t>& elem_node_gids)
+    const ViewCArrayKokkos<size_t>& elem_node_gids,
+    const size_t rk_bin = 1)
 {
     const size_t num_nodes = 8;
 
@@ -335,9 +341,9 @@ void get_vol_hex(const DCArrayKokkos<double>& elem_vol,
 
     // get the coordinates of the nodes(rk,elem,node) in this element
     for (int node_lid = 0; node_lid < num_nodes; node_lid++) {
-        x(node_lid) = node_coords(1, elem_node_gids(node_lid), 0);
-        y(node_lid) = node_coords(1, elem_node_gids(node_lid), 1);
-        z(node_lid) = node_coords(1, elem_node_gids(node_lid), 2);
+        x(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 0);
+        y(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 1);
+        z(node_lid) = node_coords(rk_bin, elem_node_gids(node_lid), 2);
     }     // end for
 
     double twelth = 1. / 12.;
@@ -362,20 +368,40 @@ void get_vol_hex(const DCArrayKokkos<double>& elem_vol,
 ///
 /// \fn get_vol
 ///
-/// \brief Compute Volume of each finite element
+/// \brief Compute Volume of each finite element, or of the listed elements
 ///
 /////////////////////////////////////////////////////////////////////////////
 inline void get_vol(const DCArrayKokkos<double>& elem_vol,
     const DCArrayKokkos<double>& node_coords,
-    const mesh_t& mesh)
+    const mesh_t& mesh,
+    const DCArrayKokkos<size_t>& elem_list = DCArrayKokkos<size_t>(),
+    const long num_list_elems = -1,
+    const size_t rk_bin = 1)
 {
     const size_t num_dims = mesh.num_dims;
 
+    if (num_list_elems >= 0) {
+        FOR_ALL(list_lid, 0, (size_t)num_list_elems, {
+                const size_t elem_gid = elem_list(list_lid);
+
+                // cut out the node_gids for this element
+                ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), mesh.num_nodes_in_elem);
+                if (num_dims == 2) {
+                    get_vol_quad(elem_vol, elem_gid, node_coords, elem_node_gids, rk_bin);
+                }
+                else{
+                    get_vol_hex(elem_vol, elem_gid, node_coords, elem_node_gids, rk_bin);
+                }
+            });
+        Kokkos::fence();
+        return;
+    } // end if list
+
     if (num_dims == 2) {
         FOR_ALL(elem_gid, 0, mesh.num_elems, {
                 // cut out the node_gids for this element
                 ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), 4);
-                get_vol_quad(elem_vol, elem_gid, node_coords, elem_node_gids);
+                get_vol_quad(elem_vol, elem_gid, node_coords, elem_node_gids, rk_bin);
             });
         Kokkos::fence();
     }
@@ -383,7 +409,7 @@ inline void get_vol(const DCArrayKokkos<double>& elem_vol,
         FOR_ALL(elem_gid, 0, mesh.num_elems, {
                 // cut out the node_gids for this element
                 ViewCArrayKokkos<size_t> elem_node_gids(&mesh.nodes_in_elem(elem_gid, 0), 8);
-                get_vol_hex(elem_vol, elem_gid, node_coords, elem_node_gids);
+                get_vol_hex(elem_vol, elem_gid, node_coords, elem_node_gids, rk_bin);
             });
         Kokkos::fence();
     }     // end if
@@ -616,7 +642,7 @@ void get_area_weights2D(const ViewCArrayKokkos<double>& corner_areas,
 /// \brief routine for checking to see if a vertex is on a boundary
 ///
 /// \param Global id of a patch
-/// \param Boundary condition tag (bc_tag = 0 xplane, 1 yplane, 2 zplane, 3 cylinder, 4 is shell)
+/// \param Boundary condition tag (bc_tag = 0 xplane, 1 yplane, 2 zplane, 3 cylinder, 4 is shell, 6 is every boundary patch)
 /// \param Plane value
 /// \param Simulation mesh
 /// \param Nodal coordinates
@@ -683,6 +709,10 @@ size_t check_bdy(const size_t patch_gid,
                 is_on_bdy += 1;
             }
         } // end if on type
+        // every boundary patch, used for contact
+        else if (this_bc_tag == 6) {
+            is_on_bdy += 1;
+        } // end if on type
     } // end for nodes in the patch
 
     // if all nodes in the patch are on the geometry
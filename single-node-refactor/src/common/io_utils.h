@@ -38,11 +38,257 @@
 #include "mesh.h"
 #include "state.h"
 #include "simulation_parameters.h"
+#include "perf_timers.h"
 
 #include <map>
 #include <memory>
 #include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
 #include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn get_sfc_key
+///
+/// \brief Space filling curve key of a point on an integer lattice
+///
+/// The Hilbert key uses Skilling's transpose algorithm, the Morton key
+/// interleaves the bits of the lattice coordinates.
+///
+/// \param Lattice coordinates, overwritten for the Hilbert curve
+/// \param Number of dimensions
+/// \param Number of bits per coordinate
+/// \param Type of curve
+///
+/////////////////////////////////////////////////////////////////////////////
+inline uint64_t get_sfc_key(uint32_t X[3], const int num_dims, const int num_bits,
+    const mesh_input::renumber_type curve)
+{
+    if (curve == mesh_input::hilbert) {
+        const uint32_t M = 1u << (num_bits - 1);
+
+        // inverse undo
+        for (uint32_t Q = M; Q > 1; Q >>= 1) {
+            uint32_t P = Q - 1;
+            for (int i = 0; i < num_dims; i++) {
+                if (X[i] & Q) {
+                    X[0] ^= P;
+                }
+                else{
+                    uint32_t t = (X[0] ^ X[i]) & P;
+                    X[0] ^= t;
+                    X[i] ^= t;
+                }
+            } // end for i
+        } // end for Q
+
+        // gray encode
+        for (int i = 1; i < num_dims; i++) {
+            X[i] ^= X[i - 1];
+        }
+
+        uint32_t t = 0;
+        for (uint32_t Q = M; Q > 1; Q >>= 1) {
+            if (X[num_dims - 1] & Q) {
+                t ^= Q - 1;
+            }
+        }
+
+        for (int i = 0; i < num_dims; i++) {
+            X[i] ^= t;
+        }
+    } // end if hilbert
+
+    // interleave the bits, most significant first
+    uint64_t key = 0;
+    for (int bit = num_bits - 1; bit >= 0; bit--) {
+        for (int i = 0; i < num_dims; i++) {
+            key = (key << 1) | ((X[i] >> bit) & 1u);
+        }
+    }
+
+    return key;
+} // end get_sfc_key
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn renumber_mesh
+///
+/// \brief Reorders the nodes and elems along a space filling curve
+///
+/// Must be called after the node coordinates and nodes_in_elem are set and
+/// before build_connectivity, so corners, patches and all other connectivity
+/// inherit the new ordering. The original ids are saved in the mesh so the
+/// outputs can refer back to them.
+///
+/// \param Simulation mesh
+/// \param Node state data
+/// \param Number of dimensions
+/// \param Number of RK bins
+/// \param Type of space filling curve
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void renumber_mesh(mesh_t& mesh, node_t& node, const int num_dims, const int rk_num_bins,
+    const mesh_input::renumber_type curve)
+{
+    if (curve == mesh_input::no_renumber) {
+        return;
+    }
+
+    const size_t num_nodes = mesh.num_nodes;
+    const size_t num_elems = mesh.num_elems;
+    const size_t num_nodes_in_elem = mesh.num_nodes_in_elem;
+
+    // 2D keys fit 2x31 bits, 3D keys 3x21 bits
+    const int num_bits = (num_dims == 3) ? 21 : 31;
+    const double lattice_max = (double)((1u << num_bits) - 1u);
+
+    // --- bounding box of the mesh ---
+    double x_min[3] = { 0.0, 0.0, 0.0 };
+    double x_max[3] = { 0.0, 0.0, 0.0 };
+    for (int dim = 0; dim < num_dims; dim++) {
+        x_min[dim] = node.coords(0, 0, dim);
+        x_max[dim] = node.coords(0, 0, dim);
+    }
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        for (int dim = 0; dim < num_dims; dim++) {
+            x_min[dim] = fmin(x_min[dim], node.coords(0, node_gid, dim));
+            x_max[dim] = fmax(x_max[dim], node.coords(0, node_gid, dim));
+        }
+    }
+
+    // key of a point in the bounding box
+    auto point_key = [&](const double* x) {
+        uint32_t X[3] = { 0, 0, 0 };
+        for (int dim = 0; dim < num_dims; dim++) {
+            double extent = x_max[dim] - x_min[dim];
+            double scaled = (extent > 0.0) ? (x[dim] - x_min[dim]) / extent : 0.0;
+            X[dim] = (uint32_t)(scaled * lattice_max);
+        }
+        return get_sfc_key(X, num_dims, num_bits, curve);
+    };
+
+    // --- sort the nodes ---
+    std::vector<uint64_t> node_keys(num_nodes);
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        double x[3] = { 0.0, 0.0, 0.0 };
+        for (int dim = 0; dim < num_dims; dim++) {
+            x[dim] = node.coords(0, node_gid, dim);
+        }
+        node_keys[node_gid] = point_key(x);
+    }
+
+    std::vector<size_t> node_order(num_nodes);  // new id -> original id
+    std::iota(node_order.begin(), node_order.end(), 0);
+    std::stable_sort(node_order.begin(), node_order.end(),
+                     [&](size_t a, size_t b) { return node_keys[a] < node_keys[b]; });
+
+    std::vector<size_t> node_new_gid(num_nodes); // original id -> new id
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        node_new_gid[node_order[node_gid]] = node_gid;
+    }
+
+    // --- sort the elems by the key of their centroid ---
+    std::vector<uint64_t> elem_keys(num_elems);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        double x[3] = { 0.0, 0.0, 0.0 };
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(elem_gid, node_lid);
+            for (int dim = 0; dim < num_dims; dim++) {
+                x[dim] += node.coords(0, node_gid, dim) / (double)num_nodes_in_elem;
+            }
+        }
+        elem_keys[elem_gid] = point_key(x);
+    }
+
+    std::vector<size_t> elem_order(num_elems);  // new id -> original id
+    std::iota(elem_order.begin(), elem_order.end(), 0);
+    std::stable_sort(elem_order.begin(), elem_order.end(),
+                     [&](size_t a, size_t b) { return elem_keys[a] < elem_keys[b]; });
+
+    // --- permute the node coordinates in every rk bin ---
+    std::vector<double> coords_tmp(num_nodes * num_dims);
+    for (int rk = 0; rk < rk_num_bins; rk++) {
+        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+            for (int dim = 0; dim < num_dims; dim++) {
+                coords_tmp[node_gid * num_dims + dim] = node.coords(rk, node_order[node_gid], dim);
+            }
+        }
+        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+            for (int dim = 0; dim < num_dims; dim++) {
+                node.coords(rk, node_gid, dim) = coords_tmp[node_gid * num_dims + dim];
+            }
+        }
+    } // end for rk
+
+    // --- permute the elems and map their node ids ---
+    std::vector<size_t> nodes_in_elem_tmp(num_elems * num_nodes_in_elem);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(elem_order[elem_gid], node_lid);
+            nodes_in_elem_tmp[elem_gid * num_nodes_in_elem + node_lid] = node_new_gid[node_gid];
+        }
+    }
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            mesh.nodes_in_elem.host(elem_gid, node_lid) = nodes_in_elem_tmp[elem_gid * num_nodes_in_elem + node_lid];
+        }
+    }
+    mesh.nodes_in_elem.update_device();
+
+    // --- save the original ids for the outputs ---
+    mesh.renumbered     = true;
+    mesh.node_orig_gids = CArray<size_t>(num_nodes);
+    mesh.elem_orig_gids = CArray<size_t>(num_elems);
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        mesh.node_orig_gids(node_gid) = node_order[node_gid];
+    }
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        mesh.elem_orig_gids(elem_gid) = elem_order[elem_gid];
+    }
+
+    printf("Renumbered nodes and elems along a %s curve\n",
+           (curve == mesh_input::hilbert) ? "Hilbert" : "Morton");
+
+    return;
+} // end renumber_mesh
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn finish_mesh
+///
+/// \brief Renumbers the mesh if requested and builds the connectivity
+///
+/// \param Simulation mesh
+/// \param Node state data
+/// \param Number of dimensions
+/// \param Number of RK bins
+/// \param Type of space filling curve
+/// \param Timers, may be null
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void finish_mesh(mesh_t& mesh, node_t& node, const int num_dims, const int rk_num_bins,
+    const mesh_input::renumber_type curve, PerfTimers* timers)
+{
+    PerfTimers  no_timers;
+    PerfTimers& timer = (timers != nullptr) ? *timers : no_timers;
+
+    // Reorder the nodes and elems for locality
+    timer.start("renumber");
+    renumber_mesh(mesh, node, num_dims, rk_num_bins, curve);
+    timer.stop();
+
+    // Build connectivity
+    timer.start("connectivity");
+    mesh.build_connectivity();
+    timer.stop();
+} // end finish_mesh
 
 /////////////////////////////////////////////////////////////////////////////
 ///
@@ -62,6 +308,10 @@ public:
 
     char* mesh_file_ = NULL;
 
+    mesh_input::renumber_type renumber_ = mesh_input::no_renumber;
+
+    PerfTimers* timers = nullptr; // owned by the driver
+
     MeshReader() {} // Simulation_Parameters& _simparam);
 
     ~MeshReader() = default;
@@ -80,6 +330,20 @@ public:
         mesh_file_ = MESH;
     }
 
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn set_renumber
+    ///
+    /// \brief Sets the space filling curve used to renumber the mesh on read
+    ///
+    /// \param Type of renumbering
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void set_renumber(mesh_input::renumber_type renumber)
+    {
+        renumber_ = renumber;
+    }
+
     // Reads and initializes the mesh and geometric state entities
     /////////////////////////////////////////////////////////////////////////////
     ///
@@ -229,8 +493,8 @@ public:
         // Close mesh input file
         fclose(in);
 
-        // Build connectivity
-        mesh.build_connectivity();
+        // Renumber and build connectivity
+        finish_mesh(mesh, node, num_dims, rk_num_bins, renumber_, timers);
 
         return;
     }
@@ -251,6 +515,8 @@ class MeshBuilder
 {
 public:
 
+    PerfTimers* timers = nullptr; // owned by the driver
+
     MeshBuilder() {}
 
     ~MeshBuilder()
@@ -418,8 +684,8 @@ public:
         mesh.initialize_corners(num_corners);
         corner.initialize(num_corners, num_dim);
 
-        // Build connectivity
-        mesh.build_connectivity();
+        // Renumber and build connectivity
+        finish_mesh(mesh, node, num_dim, rk_num_bins, sim_param.mesh_input.renumber, timers);
     } // end build_2d_box
 
     /////////////////////////////////////////////////////////////////////////////
@@ -545,8 +811,8 @@ public:
         mesh.initialize_corners(num_corners);
         corner.initialize(num_corners, num_dim);
 
-        // Build connectivity
-        mesh.build_connectivity();
+        // Renumber and build connectivity
+        finish_mesh(mesh, node, num_dim, rk_num_bins, sim_param.mesh_input.renumber, timers);
     } // end build_2d_box
 
     /////////////////////////////////////////////////////////////////////////////
@@ -687,8 +953,8 @@ public:
         mesh.initialize_corners(num_corners);
         corner.initialize(num_corners, num_dim);
 
-        // Build connectivity
-        mesh.build_connectivity();
+        // Renumber and build connectivity
+        finish_mesh(mesh, node, num_dim, rk_num_bins, sim_param.mesh_input.renumber, timers);
     } // end build_3d_box
 
     /////////////////////////////////////////////////////////////////////////////
@@ -801,6 +1067,35 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \struct ensight_snapshot_t
+///
+/// \brief Host staging copy of the state written in one graphics dump
+///
+/////////////////////////////////////////////////////////////////////////////
+struct ensight_snapshot_t
+{
+    int graphics_id = 0;
+    bool write_geometry = true;     ///< false if the mesh did not move since the last dump
+    int  geometry_id    = 0;        ///< graphics id of the geometry file to reuse
+
+    size_t num_nodes = 0;
+    size_t num_elems = 0;
+    size_t num_dims  = 3;
+    size_t num_nodes_in_elem = 8;
+
+    std::vector<float> coords;      ///< x block, then y block, then z block
+    std::vector<int>   conn;        ///< 1 based node index per elem
+    std::vector<int>   node_ids;    ///< original ids when the mesh was renumbered
+    std::vector<int>   elem_ids;
+
+    std::vector<float> elem_fields; ///< one block of num_elems per scalar variable
+    std::vector<float> vec_fields;  ///< x, y, z blocks of num_nodes per vector variable
+
+    std::vector<double> times;      ///< all graphics times up to and including this dump
+}; // ensight_snapshot_t
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /// \class MeshWriter
@@ -811,18 +1106,76 @@ public:
 /// with its associated state data from solvers in Fierro. Currently only ensight
 /// outputs are supported
 ///
+/// Ensight dumps are written as binary Ensight Gold by a background thread.
+/// The solver only waits for the copy of the state into a host staging
+/// buffer. Two buffers are used so the next snapshot can be taken while the
+/// previous dump is being written, and a new dump waits for the one in
+/// flight to finish before it is handed to the writer thread.
+///
 /////////////////////////////////////////////////////////////////////////////
 class MeshWriter
 {
 private:
     int graphics_id = 0;
 
+    // base name of the output files, tagged with the rank of a decomposed run
+    std::string output_name_ = "Outputs_SGH";
+
+    static const int num_scalar_vars = 9;
+    static const int num_vec_vars    = 2;
+
+    // double buffered host staging data and the thread writing it
+    ensight_snapshot_t snapshots_[2];
+    int next_snapshot_ = 0;
+    std::thread writer_thread_;
+
+    // node coordinates of the last geometry file, to detect mesh motion
+    std::vector<double> last_geo_coords_;
+    int last_geo_id_ = -1;
+
 public:
 
     MeshWriter() {}
 
     ~MeshWriter()
     {
+        wait_for_output();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn set_rank
+    ///
+    /// \brief Tags the output files with the rank when the mesh is decomposed
+    ///
+    /// Each rank writes its owned elems to its own ensight case, which can be
+    /// loaded together in a viewer.
+    ///
+    /// \param Rank of this process
+    /// \param Number of ranks
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void set_rank(const int rank, const int num_ranks)
+    {
+        if (num_ranks > 1) {
+            char name[64];
+            sprintf(name, "Outputs_SGH_r%05d", rank);
+            output_name_ = name;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn wait_for_output
+    ///
+    /// \brief Blocks until the graphics dump in flight, if any, is on disk
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void wait_for_output()
+    {
+        if (writer_thread_.joinable()) {
+            writer_thread_.join();
+        }
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -867,7 +1220,7 @@ public:
     ///
     /// \fn write_ensight
     ///
-    /// \brief Writes an ensight output file
+    /// \brief Snapshots the state and writes a binary ensight dump in the background
     ///
     /// \param Simulation mesh
     /// \param Element related state
@@ -887,47 +1240,12 @@ public:
         double time_value,
         CArray<double> graphics_times)
     {
-        // Update host data
-        elem.den.update_host();
-        elem.pres.update_host();
-        elem.stress.update_host();
-        elem.sspd.update_host();
-        elem.sie.update_host();
-        elem.vol.update_host();
-        elem.mass.update_host();
-        elem.mat_id.update_host();
-
-        node.coords.update_host();
-        node.vel.update_host();
-        node.mass.update_host();
-        Kokkos::fence();
-
-        const int num_scalar_vars = 9;
-        const int num_vec_vars    = 2;
-
-        std::string name_tmp;
-        name_tmp = "Outputs_SGH";
-
-        char* name = new char [name_tmp.length() + 1];
-        std::strcpy(name, name_tmp.c_str());
-
-        const char scalar_var_names[num_scalar_vars][15] = {
-            "den", "pres", "sie", "vol", "mass", "sspd", "speed", "mat_id", "elem_switch"
-        };
-
-        const char vec_var_names[num_vec_vars][15] = {
-            "pos", "vel"
-        };
-
-        // short hand
+        // short hand, the ghost elems of a decomposed mesh are written by their owner
         const size_t num_nodes = mesh.num_nodes;
-        const size_t num_elems = mesh.num_elems;
+        const size_t num_elems = mesh.num_owned_elems;
         const size_t num_dims  = mesh.num_dims;
 
-        // save the cell state to an array for exporting to graphics files
-        auto elem_fields = CArray<double>(num_elems, num_scalar_vars);
-        int  elem_switch = 1;
-
+        // element averaged speed, computed on the device before the copy
         DCArrayKokkos<double> speed(num_elems);
         FOR_ALL(elem_gid, 0, num_elems, {
             double elem_vel[3]; // note:initialization with a list won't work
@@ -957,236 +1275,312 @@ public:
         }); // end parallel for
         speed.update_host();
 
-        // save the output scale fields to a single 2D array
-        double e_switch = 1;
-        for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
-            // save outputs
-            elem_fields(elem_gid, 0) = elem.den.host(elem_gid);
-            elem_fields(elem_gid, 1) = elem.pres.host(elem_gid);
-            elem_fields(elem_gid, 2) = elem.sie.host(1, elem_gid);
-            elem_fields(elem_gid, 3) = elem.vol.host(elem_gid);
-            elem_fields(elem_gid, 4) = elem.mass.host(elem_gid);
-            elem_fields(elem_gid, 5) = elem.sspd.host(elem_gid);
-            elem_fields(elem_gid, 6) = speed.host(elem_gid);
-            elem_fields(elem_gid, 7) = (double)elem.mat_id.host(elem_gid);
-            elem_fields(elem_gid, 8) = e_switch;
-            elem_switch *= -1;
-        } // end for elements
+        // Update host data
+        elem.den.update_host();
+        elem.pres.update_host();
+        elem.sspd.update_host();
+        elem.sie.update_host();
+        elem.vol.update_host();
+        elem.mass.update_host();
+        elem.mat_id.update_host();
 
-        // save the vertex vector fields to an array for exporting to graphics files
-        CArray<double> vec_fields(num_nodes, num_vec_vars, 3);
+        node.coords.update_host();
+        node.vel.update_host();
+        Kokkos::fence();
 
-        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
-            // position, var 0
-            vec_fields(node_gid, 0, 0) = node.coords.host(1, node_gid, 0);
-            vec_fields(node_gid, 0, 1) = node.coords.host(1, node_gid, 1);
-            if (num_dims == 2) {
-                vec_fields(node_gid, 0, 2) = 0.0;
+        // ---------------------------------------------------------------------------
+        // Take the snapshot into the free staging buffer
+        // ---------------------------------------------------------------------------
+        ensight_snapshot_t& snap = snapshots_[next_snapshot_];
+
+        snap.graphics_id = graphics_id;
+        snap.num_nodes   = num_nodes;
+        snap.num_elems   = num_elems;
+        snap.num_dims    = num_dims;
+        snap.num_nodes_in_elem = mesh.num_nodes_in_elem;
+
+        // the geometry is only rewritten when a node moved since the last geometry file
+        bool moved = (last_geo_id_ < 0) || (last_geo_coords_.size() != num_nodes * num_dims);
+        if (!moved) {
+            for (size_t node_gid = 0; node_gid < num_nodes && !moved; node_gid++) {
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    if (node.coords.host(1, node_gid, dim) != last_geo_coords_[node_gid * num_dims + dim]) {
+                        moved = true;
+                        break;
+                    }
+                }
             }
-            else{
-                vec_fields(node_gid, 0, 2) = node.coords.host(1, node_gid, 2);
+        }
+
+        if (moved) {
+            last_geo_coords_.resize(num_nodes * num_dims);
+            for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    last_geo_coords_[node_gid * num_dims + dim] = node.coords.host(1, node_gid, dim);
+                }
             }
+            last_geo_id_ = graphics_id;
+        }
+        snap.write_geometry = moved;
+        snap.geometry_id    = last_geo_id_;
 
-            // position, var 1
-            vec_fields(node_gid, 1, 0) = node.vel.host(1, node_gid, 0);
-            vec_fields(node_gid, 1, 1) = node.vel.host(1, node_gid, 1);
-            if (num_dims == 2) {
-                vec_fields(node_gid, 1, 2) = 0.0;
+        // nodal vectors, the first one is the position which is also the geometry
+        snap.vec_fields.resize(num_vec_vars * 3 * num_nodes);
+        for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+            for (size_t dim = 0; dim < 3; dim++) {
+                float pos = (dim < num_dims) ? (float)node.coords.host(1, node_gid, dim) : 0.0f;
+                float vel = (dim < num_dims) ? (float)node.vel.host(1, node_gid, dim) : 0.0f;
+                snap.vec_fields[(0 * 3 + dim) * num_nodes + node_gid] = pos;
+                snap.vec_fields[(1 * 3 + dim) * num_nodes + node_gid] = vel;
             }
-            else{
-                vec_fields(node_gid, 1, 2) = node.vel.host(1, node_gid, 2);
+        }
+
+        if (moved) {
+            snap.coords.assign(snap.vec_fields.begin(), snap.vec_fields.begin() + 3 * num_nodes);
+
+            snap.conn.resize(num_elems * mesh.num_nodes_in_elem);
+            for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+                for (size_t node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
+                    snap.conn[elem_gid * mesh.num_nodes_in_elem + node_lid] =
+                        (int)mesh.nodes_in_elem.host(elem_gid, node_lid) + 1; // note: node_gid starts at 1
+                }
+            }
+
+            snap.node_ids.clear();
+            snap.elem_ids.clear();
+            if (mesh.renumbered) {
+                snap.node_ids.resize(num_nodes);
+                snap.elem_ids.resize(num_elems);
+                for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+                    snap.node_ids[node_gid] = (int)mesh.node_orig_gids(node_gid) + 1;
+                }
+                for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+                    snap.elem_ids[elem_gid] = (int)mesh.elem_orig_gids(elem_gid) + 1;
+                }
             }
-        } // end for loop over vertices
+        } // end if moved
+
+        // save the output scalar fields
+        snap.elem_fields.resize(num_scalar_vars * num_elems);
+        double e_switch = 1;
+        for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+            snap.elem_fields[0 * num_elems + elem_gid] = (float)elem.den.host(elem_gid);
+            snap.elem_fields[1 * num_elems + elem_gid] = (float)elem.pres.host(elem_gid);
+            snap.elem_fields[2 * num_elems + elem_gid] = (float)elem.sie.host(1, elem_gid);
+            snap.elem_fields[3 * num_elems + elem_gid] = (float)elem.vol.host(elem_gid);
+            snap.elem_fields[4 * num_elems + elem_gid] = (float)elem.mass.host(elem_gid);
+            snap.elem_fields[5 * num_elems + elem_gid] = (float)elem.sspd.host(elem_gid);
+            snap.elem_fields[6 * num_elems + elem_gid] = (float)speed.host(elem_gid);
+            snap.elem_fields[7 * num_elems + elem_gid] = (float)elem.mat_id.host(elem_gid);
+            snap.elem_fields[8 * num_elems + elem_gid] = (float)e_switch;
+        } // end for elements
+
+        graphics_times(graphics_id) = time_value;
+        snap.times.assign(&graphics_times(0), &graphics_times(0) + graphics_id + 1);
+
+        // ---------------------------------------------------------------------------
+        // Throttle on the dump in flight, then hand this one to the writer thread
+        // ---------------------------------------------------------------------------
+        wait_for_output();
+
+        writer_thread_ = std::thread(&MeshWriter::write_ensight_snapshot, this, next_snapshot_);
+
+        next_snapshot_ = 1 - next_snapshot_;
+
+        // increment graphics id counter
+        graphics_id++;
+
+        return;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn write_ensight_snapshot
+    ///
+    /// \brief Writes one staged snapshot as binary Ensight Gold files
+    ///
+    /// Runs on the writer thread and only touches the staging buffer.
+    ///
+    /// \param Index of the staging buffer
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void write_ensight_snapshot(const int snapshot_id)
+    {
+        const ensight_snapshot_t& snap = snapshots_[snapshot_id];
+
+        const char* name = output_name_.c_str();
+
+        const char scalar_var_names[num_scalar_vars][15] = {
+            "den", "pres", "sie", "vol", "mass", "sspd", "speed", "mat_id", "elem_switch"
+        };
+
+        const char vec_var_names[num_vec_vars][15] = {
+            "pos", "vel"
+        };
+
+        const char* elem_type = (snap.num_dims == 3) ? "hexa8" : "quad4";
+
+        const int num_nodes = (int)snap.num_nodes;
+        const int num_elems = (int)snap.num_elems;
 
         //  ---------------------------------------------------------------------------
         //  Setup of file and directoring for exporting
         //  ---------------------------------------------------------------------------
-        FILE* out[20];   // the output files that are written to
+        FILE* out;
         char  filename[128];
 
         struct stat st;
 
         if (stat("ensight", &st) != 0) {
-            system("mkdir ensight");
+            mkdir("ensight", 0755);
         }
 
         if (stat("ensight/data", &st) != 0) {
-            system("mkdir ensight/data");
+            mkdir("ensight/data", 0755);
         }
 
         //  ---------------------------------------------------------------------------
-        //  Write the Geometry file
+        //  Write the Geometry file, or link to the last one if the mesh did not move
         //  ---------------------------------------------------------------------------
-        sprintf(filename, "ensight/data/%s.%05d.geo", name, graphics_id);
-        // filename has the full string
-
-        out[0] = fopen(filename, "w");
-
-        fprintf(out[0], "A graphics dump by Fierro \n");
-        fprintf(out[0], "%s", "EnSight Gold geometry\n");
-        fprintf(out[0], "%s", "node id assign\n");
-        fprintf(out[0], "%s", "element id assign\n");
-
-        fprintf(out[0], "part\n");
-        fprintf(out[0], "%10d\n", 1);
-        fprintf(out[0], "Mesh\n");
-
-        // --- vertices ---
-        fprintf(out[0], "coordinates\n");
-        fprintf(out[0], "%10lu\n", num_nodes);
-
-        // write all components of the point coordinates
-        for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-            fprintf(out[0], "%12.5e\n", node.coords.host(1, node_gid, 0));
-        }
-
-        for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-            fprintf(out[0], "%12.5e\n", node.coords.host(1, node_gid, 1));
-        }
-
-        for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-            if (num_dims == 3) {
-                fprintf(out[0], "%12.5e\n", node.coords.host(1, node_gid, 2));
+        sprintf(filename, "ensight/data/%s.%05d.geo", name, snap.graphics_id);
+
+        if (snap.write_geometry) {
+            out = fopen(filename, "wb");
+
+            write_ensight_string(out, "C Binary");
+            write_ensight_string(out, "A graphics dump by Fierro");
+            write_ensight_string(out, "EnSight Gold geometry");
+            write_ensight_string(out, snap.node_ids.empty() ? "node id assign" : "node id given");
+            write_ensight_string(out, snap.elem_ids.empty() ? "element id assign" : "element id given");
+
+            write_ensight_string(out, "part");
+            write_ensight_int(out, 1);
+            write_ensight_string(out, "Mesh");
+
+            // --- vertices ---
+            write_ensight_string(out, "coordinates");
+            write_ensight_int(out, num_nodes);
+            if (!snap.node_ids.empty()) {
+                fwrite(snap.node_ids.data(), sizeof(int), num_nodes, out);
             }
-            else{
-                fprintf(out[0], "%12.5e\n", 0.0);
+            fwrite(snap.coords.data(), sizeof(float), 3 * num_nodes, out);
+
+            // --- elements ---
+            write_ensight_string(out, elem_type);
+            write_ensight_int(out, num_elems);
+            if (!snap.elem_ids.empty()) {
+                fwrite(snap.elem_ids.data(), sizeof(int), num_elems, out);
             }
-        }
+            fwrite(snap.conn.data(), sizeof(int), snap.conn.size(), out);
 
-        // --- elements ---
-        if (num_dims == 3) {
-            fprintf(out[0], "hexa8\n");
+            fclose(out);
         }
         else{
-            fprintf(out[0], "quad4\n");
-        }
-        fprintf(out[0], "%10lu\n", num_elems);
-
-        // write all global point numbers for this cell
-        for (int elem_gid = 0; elem_gid < num_elems; elem_gid++) {
-            for (int node_lid = 0; node_lid < mesh.num_nodes_in_elem; node_lid++) {
-                fprintf(out[0], "%10lu\t", mesh.nodes_in_elem.host(elem_gid, node_lid) + 1); // note: node_gid starts at 1
+            char geo_filename[128];
+            sprintf(geo_filename, "ensight/data/%s.%05d.geo", name, snap.geometry_id);
+            remove(filename);
+            if (link(geo_filename, filename) != 0) {
+                printf("WARNING: could not link %s to %s\n", filename, geo_filename);
             }
-            fprintf(out[0], "\n");
-        }
-
-        fclose(out[0]);
+        } // end if geometry
 
         // ---------------------------------------------------------------------------
         // Write the Scalar variable files
         // ---------------------------------------------------------------------------
-
-        // ensight_vars = (den, pres,...)
         for (int var = 0; var < num_scalar_vars; var++) {
-            // write a scalar value
-            sprintf(filename, "ensight/data/%s.%05d.%s", name, graphics_id, scalar_var_names[var]);
+            sprintf(filename, "ensight/data/%s.%05d.%s", name, snap.graphics_id, scalar_var_names[var]);
 
-            out[0] = fopen(filename, "w");
-
-            fprintf(out[0], "Per_elem scalar values\n");
-            fprintf(out[0], "part\n");
-            fprintf(out[0], "%10d\n", 1);
-            if (num_dims == 3) {
-                fprintf(out[0], "hexa8\n");
-            }
-            else{
-                fprintf(out[0], "quad4\n");
-            }
+            out = fopen(filename, "wb");
 
-            for (int elem_id = 0; elem_id < num_elems; elem_id++) {
-                fprintf(out[0], "%12.5e\n", elem_fields(elem_id, var));
-            }
+            write_ensight_string(out, "Per_elem scalar values");
+            write_ensight_string(out, "part");
+            write_ensight_int(out, 1);
+            write_ensight_string(out, elem_type);
+            fwrite(&snap.elem_fields[var * num_elems], sizeof(float), num_elems, out);
 
-            fclose(out[0]);
+            fclose(out);
         } // end for var
 
         //  ---------------------------------------------------------------------------
         //  Write the Vector variable files
         //  ---------------------------------------------------------------------------
-
-        // ensight vector vars = (position, velocity, force)
         for (int var = 0; var < num_vec_vars; var++) {
-            sprintf(filename, "ensight/data/%s.%05d.%s", name, graphics_id, vec_var_names[var]);
-
-            out[0] = fopen(filename, "w");
-            // fprintf(out[0],"Per_node vector values\n");
-            // fprintf(out[0],"part\n");
-            // fprintf(out[0],"%10d \n",1);
-            // fprintf(out[0],"hexa8\n"); // WARNING, maybe bug here?
-
-            fprintf(out[0], "Per_node vector values\n");
-            fprintf(out[0], "part\n");
-            fprintf(out[0], "%10d\n", 1);
-            fprintf(out[0], "block\n");
+            sprintf(filename, "ensight/data/%s.%05d.%s", name, snap.graphics_id, vec_var_names[var]);
 
-            for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-                fprintf(out[0], "%12.5e\n", vec_fields(node_gid, var, 0));
-            }
-
-            for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-                fprintf(out[0], "%12.5e\n", vec_fields(node_gid, var, 1));
-            }
+            out = fopen(filename, "wb");
 
-            for (int node_gid = 0; node_gid < num_nodes; node_gid++) {
-                fprintf(out[0], "%12.5e\n", vec_fields(node_gid, var, 2));
-            }
+            write_ensight_string(out, "Per_node vector values");
+            write_ensight_string(out, "part");
+            write_ensight_int(out, 1);
+            write_ensight_string(out, "coordinates");
+            fwrite(&snap.vec_fields[var * 3 * num_nodes], sizeof(float), 3 * num_nodes, out);
 
-            fclose(out[0]);
+            fclose(out);
         } // end for var
 
         // ---------------------------------------------------------------------------
         // Write the case file
         // ---------------------------------------------------------------------------
-
         sprintf(filename, "ensight/%s.case", name);
-        out[0] = fopen(filename, "w");
+        out = fopen(filename, "w");
 
-        fprintf(out[0], "FORMAT\n");
-        fprintf(out[0], "type: ensight gold\n");
-        fprintf(out[0], "GEOMETRY\n");
+        fprintf(out, "FORMAT\n");
+        fprintf(out, "type: ensight gold\n");
+        fprintf(out, "GEOMETRY\n");
 
-        sprintf(filename, "model: data/%s.*****.geo\n", name);
-        fprintf(out[0], "%s", filename);
-        fprintf(out[0], "VARIABLE\n");
+        fprintf(out, "model: data/%s.*****.geo\n", name);
+        fprintf(out, "VARIABLE\n");
 
         for (int var = 0; var < num_scalar_vars; var++) {
-            sprintf(filename,
-                    "scalar per element: %s data/%s.*****.%s\n",
+            fprintf(out, "scalar per element: %s data/%s.*****.%s\n",
                     scalar_var_names[var], name, scalar_var_names[var]);
-            fprintf(out[0], "%s", filename);
         }
 
         for (int var = 0; var < num_vec_vars; var++) {
-            sprintf(filename,
-                    "vector per node: %s data/%s.*****.%s\n",
+            fprintf(out, "vector per node: %s data/%s.*****.%s\n",
                     vec_var_names[var], name, vec_var_names[var]);
-            fprintf(out[0], "%s", filename);
         }
 
-        fprintf(out[0], "TIME\n");
-        fprintf(out[0], "time set: 1\n");
-        fprintf(out[0], "number of steps: %4d\n", graphics_id + 1);
-        fprintf(out[0], "filename start number: 0\n");
-        fprintf(out[0], "filename increment: 1\n");
-        fprintf(out[0], "time values: \n");
+        fprintf(out, "TIME\n");
+        fprintf(out, "time set: 1\n");
+        fprintf(out, "number of steps: %4d\n", snap.graphics_id + 1);
+        fprintf(out, "filename start number: 0\n");
+        fprintf(out, "filename increment: 1\n");
+        fprintf(out, "time values: \n");
 
-        graphics_times(graphics_id) = time_value;
-
-        for (int i = 0; i <= graphics_id; i++) {
-            fprintf(out[0], "%12.5e\n", graphics_times(i));
+        for (size_t i = 0; i < snap.times.size(); i++) {
+            fprintf(out, "%12.5e\n", snap.times[i]);
         }
-        fclose(out[0]);
-
-        // ---------------------------------------------------------------------------
-        // Done writing the graphics dump
-        // ---------------------------------------------------------------------------
+        fclose(out);
 
-        // increment graphics id counter
-        graphics_id++;
+        return;
+    }
 
-        delete[] name;
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn write_ensight_string
+    ///
+    /// \brief Writes an 80 character record to a binary ensight file
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    static void write_ensight_string(FILE* out, const char* str)
+    {
+        char buffer[80];
+        memset(buffer, 0, 80);
+        strncpy(buffer, str, 79);
+        fwrite(buffer, sizeof(char), 80, out);
+    }
 
-        return;
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn write_ensight_int
+    ///
+    /// \brief Writes a single int to a binary ensight file
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    static void write_ensight_int(FILE* out, int value)
+    {
+        fwrite(&value, sizeof(int), 1, out);
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -112,6 +112,16 @@ struct mesh_t
 
     size_t num_corners;
 
+    // owned nodes and elems come first, the rest are ghosts of a decomposed mesh
+    size_t num_owned_nodes;
+    size_t num_owned_elems;
+
+    // an ensemble mesh holds num_members copies of a member mesh, member m owns
+    // the nodes and elems from m*num_member_nodes and m*num_member_elems
+    size_t num_members = 1;
+    size_t num_member_nodes;
+    size_t num_member_elems;
+
     size_t num_patches;
     size_t num_surfs;           // high_order mesh class
 
@@ -185,10 +195,21 @@ struct mesh_t
     RaggedRightArrayKokkos<size_t> bdy_nodes_in_set;
     DCArrayKokkos<size_t> num_bdy_nodes_in_set;
 
+    // ---- renumbering ----
+
+    // true if the nodes and elems were reordered along a space filling curve
+    bool renumbered = false;
+
+    // original (input) ids of the nodes and elems, only set if renumbered
+    CArray<size_t> node_orig_gids;
+    CArray<size_t> elem_orig_gids;
+
     // initialization methods
     void initialize_nodes(const size_t num_nodes_inp)
     {
         num_nodes = num_nodes_inp;
+        num_owned_nodes = num_nodes_inp;
+        num_member_nodes = num_nodes_inp;
 
         return;
     }; // end method
@@ -202,6 +223,8 @@ struct mesh_t
             num_nodes_in_elem *= 2;
         }
         num_elems       = num_elems_inp;
+        num_owned_elems = num_elems_inp;
+        num_member_elems = num_elems_inp;
         nodes_in_elem   = DCArrayKokkos<size_t>(num_elems, num_nodes_in_elem);
         corners_in_elem = CArrayKokkos<size_t>(num_elems, num_nodes_in_elem);
 
@@ -53,6 +53,14 @@ enum type
     Box = 0,       // Create the mesh using the mesh builder
     Cylinder = 1,           // Read in the mesh from a file
 };
+
+// renumbering of the nodes and elems applied before building connectivity
+enum renumber_type
+{
+    no_renumber = 0,    // Keep the input ordering
+    morton = 1,         // Sort along a Morton (Z-order) curve
+    hilbert = 2,        // Sort along a Hilbert curve
+};
 } // end of namespace
 
 static std::map<std::string, mesh_input::source> mesh_input_source_map
@@ -67,6 +75,13 @@ static std::map<std::string, mesh_input::type> mesh_input_type_map
     { "Cylinder", mesh_input::Cylinder }
 };
 
+static std::map<std::string, mesh_input::renumber_type> mesh_input_renumber_map
+{
+    { "none", mesh_input::no_renumber },
+    { "morton", mesh_input::morton },
+    { "hilbert", mesh_input::hilbert }
+};
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /// \struct mesh_input_t
@@ -85,6 +100,7 @@ struct mesh_input_t
     std::vector<double> length { 1.0, 1.0, 1.0 };   ///< x,y,z length of generated mesh
     std::vector<int> num_elems { 2, 2, 2 };         ///< Number of elements along x,y, z for generating a mesh.
     size_t p_order = 1;
+    mesh_input::renumber_type renumber = mesh_input::no_renumber; ///< Space filling curve renumbering of nodes and elems
 
     // WARNING, NOT YET PARSED
     double inner_radius   = 0.0;     ///< Inner radius for generating 2D RZ mesh
@@ -109,6 +125,7 @@ static std::vector<std::string> str_mesh_inps
     "length",
     "num_elems",
     "polynomial_order",
+    "renumber",
     "inner_radius",
     "outer_radius",
     "starting_angle",
@@ -0,0 +1,781 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+#ifndef FIERRO_MPI_COMS_H
+#define FIERRO_MPI_COMS_H
+
+#include <stdio.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include "matar.h"
+#include "mesh.h"
+#include "state.h"
+
+using namespace mtr;
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \struct mesh_comms_t
+///
+/// \brief Halo exchange plan and global reductions of a decomposed mesh
+///
+/// The local mesh of a rank holds its owned elems followed by one layer of
+/// ghost elems, the elems sharing a node with an owned elem. The owned nodes
+/// are numbered first. A node is owned by the lowest rank owning an elem
+/// around it, and that rank holds every elem around the node.
+///
+/// The ghost layer does not hold every neighbor of a ghost elem, so a rank
+/// can not compute the corner forces or state of its ghosts. The owner of
+/// each elem sends its corner forces after the force kernel and its state
+/// after the state update, and the owner of each node sends the nodal
+/// values, so every rank sums the same corner forces as a single rank.
+/// On a single rank, or without HAVE_MPI, every call is a no-op.
+///
+/////////////////////////////////////////////////////////////////////////////
+struct mesh_comms_t
+{
+    int rank = 0;
+    int num_ranks = 1;
+
+    // neighbor ranks, the nodes of neighbor i are in [offsets[i], offsets[i+1])
+    std::vector<int>    send_ranks;
+    std::vector<size_t> send_offsets;
+    std::vector<int>    recv_ranks;
+    std::vector<size_t> recv_offsets;
+
+    size_t num_send_nodes = 0;
+    size_t num_recv_nodes = 0;
+
+    // local ids of the nodes sent to and received from the neighbors
+    DCArrayKokkos<size_t> send_nodes;
+    DCArrayKokkos<size_t> recv_nodes;
+
+    // packed values, up to 3 per node
+    DCArrayKokkos<double> send_buf;
+    DCArrayKokkos<double> recv_buf;
+
+    // the same plan for the ghost elems
+    std::vector<int>    elem_send_ranks;
+    std::vector<size_t> elem_send_offsets;
+    std::vector<int>    elem_recv_ranks;
+    std::vector<size_t> elem_recv_offsets;
+
+    size_t num_send_elems = 0;
+    size_t num_recv_elems = 0;
+
+    DCArrayKokkos<size_t> send_elems;
+    DCArrayKokkos<size_t> recv_elems;
+
+    // packed values, sized for the larger of the corner values and the elem state
+    DCArrayKokkos<double> elem_send_buf;
+    DCArrayKokkos<double> elem_recv_buf;
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn initialize
+    ///
+    /// \brief Gets the rank and number of ranks, MPI must already be initialized
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void initialize()
+    {
+#ifdef HAVE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn exchange_buffers
+    ///
+    /// \brief Sends the packed blocks to the neighbors and receives theirs
+    ///
+    /// \param Ranks the blocks are sent to
+    /// \param Offsets of the sent blocks, in items
+    /// \param Packed values to send
+    /// \param Ranks the blocks are received from
+    /// \param Offsets of the received blocks, in items
+    /// \param Packed values received
+    /// \param Number of values per item
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void exchange_buffers(const std::vector<int>& to_ranks, const std::vector<size_t>& to_offsets,
+        const DCArrayKokkos<double>& send_vals,
+        const std::vector<int>& from_ranks, const std::vector<size_t>& from_offsets,
+        const DCArrayKokkos<double>& recv_vals, const size_t num_vals)
+    {
+#ifdef HAVE_MPI
+        send_vals.update_host();
+
+        std::vector<MPI_Request> requests(from_ranks.size() + to_ranks.size());
+
+        for (size_t neighbor = 0; neighbor < from_ranks.size(); neighbor++) {
+            int count = (int)((from_offsets[neighbor + 1] - from_offsets[neighbor]) * num_vals);
+            MPI_Irecv(&recv_vals.host(from_offsets[neighbor] * num_vals), count, MPI_DOUBLE,
+                      from_ranks[neighbor], 0, MPI_COMM_WORLD, &requests[neighbor]);
+        }
+
+        for (size_t neighbor = 0; neighbor < to_ranks.size(); neighbor++) {
+            int count = (int)((to_offsets[neighbor + 1] - to_offsets[neighbor]) * num_vals);
+            MPI_Isend(&send_vals.host(to_offsets[neighbor] * num_vals), count, MPI_DOUBLE,
+                      to_ranks[neighbor], 0, MPI_COMM_WORLD, &requests[from_ranks.size() + neighbor]);
+        }
+
+        MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        recv_vals.update_device();
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn halo_exchange
+    ///
+    /// \brief Overwrites the nodes owned by another rank with the owner's values
+    ///
+    /// \param Nodal field (rk_bin, node_gid, dim)
+    /// \param RK bin to exchange
+    /// \param Number of dimensions
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void halo_exchange(const DCArrayKokkos<double>& field, const size_t rk_bin, const size_t num_dims)
+    {
+#ifdef HAVE_MPI
+        if (num_ranks == 1) {
+            return;
+        }
+
+        // local copies for the device lambdas
+        DCArrayKokkos<size_t> send_list = send_nodes;
+        DCArrayKokkos<size_t> recv_list = recv_nodes;
+        DCArrayKokkos<double> send_vals = send_buf;
+        DCArrayKokkos<double> recv_vals = recv_buf;
+
+        // pack the owned values on the device
+        FOR_ALL(send_lid, 0, num_send_nodes, {
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                send_vals(send_lid * num_dims + dim) = field(rk_bin, send_list(send_lid), dim);
+            }
+        }); // end parallel for
+        Kokkos::fence();
+
+        exchange_buffers(send_ranks, send_offsets, send_vals, recv_ranks, recv_offsets, recv_vals, num_dims);
+
+        // unpack the ghost values
+        FOR_ALL(recv_lid, 0, num_recv_nodes, {
+            for (size_t dim = 0; dim < num_dims; dim++) {
+                field(rk_bin, recv_list(recv_lid), dim) = recv_vals(recv_lid * num_dims + dim);
+            }
+        }); // end parallel for
+        Kokkos::fence();
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn halo_exchange_corners
+    ///
+    /// \brief Overwrites the corner values of the ghost elems with the owner's
+    ///
+    /// Called after the force kernel, the owner of an elem holds every
+    /// neighbor of it and computes its corner forces as a single rank would.
+    ///
+    /// \param Simulation mesh
+    /// \param Corner field (corner_gid, dim)
+    /// \param Number of dimensions
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void halo_exchange_corners(const mesh_t& mesh, const DCArrayKokkos<double>& field, const size_t num_dims)
+    {
+#ifdef HAVE_MPI
+        if (num_ranks == 1) {
+            return;
+        }
+
+        DCArrayKokkos<size_t> send_list = send_elems;
+        DCArrayKokkos<size_t> recv_list = recv_elems;
+        DCArrayKokkos<double> send_vals = elem_send_buf;
+        DCArrayKokkos<double> recv_vals = elem_recv_buf;
+        CArrayKokkos<size_t>  corners_in_elem = mesh.corners_in_elem;
+
+        const size_t num_corners_in_elem = mesh.num_nodes_in_elem;
+        const size_t num_vals = num_corners_in_elem * num_dims;
+
+        FOR_ALL(send_lid, 0, num_send_elems, {
+            for (size_t corner_lid = 0; corner_lid < num_corners_in_elem; corner_lid++) {
+                size_t corner_gid = corners_in_elem(send_list(send_lid), corner_lid);
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    send_vals(send_lid * num_vals + corner_lid * num_dims + dim) = field(corner_gid, dim);
+                }
+            }
+        }); // end parallel for
+        Kokkos::fence();
+
+        exchange_buffers(elem_send_ranks, elem_send_offsets, send_vals, elem_recv_ranks, elem_recv_offsets, recv_vals, num_vals);
+
+        FOR_ALL(recv_lid, 0, num_recv_elems, {
+            for (size_t corner_lid = 0; corner_lid < num_corners_in_elem; corner_lid++) {
+                size_t corner_gid = corners_in_elem(recv_list(recv_lid), corner_lid);
+                for (size_t dim = 0; dim < num_dims; dim++) {
+                    field(corner_gid, dim) = recv_vals(recv_lid * num_vals + corner_lid * num_dims + dim);
+                }
+            }
+        }); // end parallel for
+        Kokkos::fence();
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn halo_exchange_elem_state
+    ///
+    /// \brief Overwrites the state of the ghost elems with the owner's
+    ///
+    /// Sends the specific internal energy and stress of every RK bin, then the
+    /// density, pressure and sound speed, so the next force kernel and time
+    /// step constraint see the same ghost state as a single rank.
+    ///
+    /// \param Element state data
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void halo_exchange_elem_state(const elem_t& elem)
+    {
+#ifdef HAVE_MPI
+        if (num_ranks == 1) {
+            return;
+        }
+
+        DCArrayKokkos<size_t> send_list = send_elems;
+        DCArrayKokkos<size_t> recv_list = recv_elems;
+        DCArrayKokkos<double> send_vals = elem_send_buf;
+        DCArrayKokkos<double> recv_vals = elem_recv_buf;
+
+        DCArrayKokkos<double> sie    = elem.sie;
+        DCArrayKokkos<double> stress = elem.stress;
+        DCArrayKokkos<double> den    = elem.den;
+        DCArrayKokkos<double> pres   = elem.pres;
+        DCArrayKokkos<double> sspd   = elem.sspd;
+
+        const size_t rk_num_bins = elem.sie.dims(0);
+        const size_t num_vals    = elem_state_vals(rk_num_bins);
+
+        FOR_ALL(send_lid, 0, num_send_elems, {
+            size_t elem_gid = send_list(send_lid);
+            size_t val = send_lid * num_vals;
+            for (size_t rk = 0; rk < rk_num_bins; rk++) {
+                send_vals(val++) = sie(rk, elem_gid);
+                for (size_t i = 0; i < 3; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        send_vals(val++) = stress(rk, elem_gid, i, j);
+                    }
+                }
+            }
+            send_vals(val++) = den(elem_gid);
+            send_vals(val++) = pres(elem_gid);
+            send_vals(val)   = sspd(elem_gid);
+        }); // end parallel for
+        Kokkos::fence();
+
+        exchange_buffers(elem_send_ranks, elem_send_offsets, send_vals, elem_recv_ranks, elem_recv_offsets, recv_vals, num_vals);
+
+        FOR_ALL(recv_lid, 0, num_recv_elems, {
+            size_t elem_gid = recv_list(recv_lid);
+            size_t val = recv_lid * num_vals;
+            for (size_t rk = 0; rk < rk_num_bins; rk++) {
+                sie(rk, elem_gid) = recv_vals(val++);
+                for (size_t i = 0; i < 3; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        stress(rk, elem_gid, i, j) = recv_vals(val++);
+                    }
+                }
+            }
+            den(elem_gid)  = recv_vals(val++);
+            pres(elem_gid) = recv_vals(val++);
+            sspd(elem_gid) = recv_vals(val);
+        }); // end parallel for
+        Kokkos::fence();
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn elem_state_vals
+    ///
+    /// \brief Number of values packed per elem by halo_exchange_elem_state
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    static size_t elem_state_vals(const size_t rk_num_bins)
+    {
+        return rk_num_bins * 10 + 3; // sie and the 3x3 stress of every bin, den, pres and sspd
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn global_min
+    ///
+    /// \brief Minimum of a value over all ranks
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    double global_min(double value) const
+    {
+#ifdef HAVE_MPI
+        if (num_ranks > 1) {
+            MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+        }
+#endif
+        return value;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn global_sum
+    ///
+    /// \brief Sum of a value over all ranks
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    double global_sum(double value) const
+    {
+#ifdef HAVE_MPI
+        if (num_ranks > 1) {
+            MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        }
+#endif
+        return value;
+    }
+}; // end mesh_comms_t
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn rcb_partition
+///
+/// \brief Recursive coordinate bisection of the elems over a range of ranks
+///
+/// The ids in [begin, end) are split along the longest extent of their
+/// centroids, with the split proportional to the ranks on each side. Ties
+/// are broken by id, so every rank computes the same partition.
+///
+/// \param Elem ids, reordered in place
+/// \param First id in the range
+/// \param One past the last id in the range
+/// \param Elem centroids (elem_gid * 3 + dim)
+/// \param Number of dimensions
+/// \param First rank of the range
+/// \param Number of ranks in the range
+/// \param Owning rank of each elem, the output
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void rcb_partition(std::vector<size_t>& elem_ids, const size_t begin, const size_t end,
+    const std::vector<double>& centroids, const int num_dims,
+    const int first_rank, const int num_parts, std::vector<int>& elem_owner)
+{
+    if (num_parts == 1) {
+        for (size_t i = begin; i < end; i++) {
+            elem_owner[elem_ids[i]] = first_rank;
+        }
+        return;
+    }
+
+    // longest extent of the centroids in the range
+    double x_min[3] = { 0.0, 0.0, 0.0 };
+    double x_max[3] = { 0.0, 0.0, 0.0 };
+    for (int dim = 0; dim < num_dims; dim++) {
+        x_min[dim] = centroids[elem_ids[begin] * 3 + dim];
+        x_max[dim] = x_min[dim];
+    }
+    for (size_t i = begin; i < end; i++) {
+        for (int dim = 0; dim < num_dims; dim++) {
+            x_min[dim] = fmin(x_min[dim], centroids[elem_ids[i] * 3 + dim]);
+            x_max[dim] = fmax(x_max[dim], centroids[elem_ids[i] * 3 + dim]);
+        }
+    }
+
+    int cut_dim = 0;
+    for (int dim = 1; dim < num_dims; dim++) {
+        if (x_max[dim] - x_min[dim] > x_max[cut_dim] - x_min[cut_dim]) {
+            cut_dim = dim;
+        }
+    }
+
+    // split the elems in proportion to the ranks on each side
+    const int    left_parts = num_parts / 2;
+    const size_t mid = begin + (end - begin) * left_parts / num_parts;
+
+    std::nth_element(elem_ids.begin() + begin, elem_ids.begin() + mid, elem_ids.begin() + end,
+                     [&](size_t a, size_t b) {
+        double xa = centroids[a * 3 + cut_dim];
+        double xb = centroids[b * 3 + cut_dim];
+        return (xa < xb) || (xa == xb && a < b);
+    });
+
+    rcb_partition(elem_ids, begin, mid, centroids, num_dims, first_rank, left_parts, elem_owner);
+    rcb_partition(elem_ids, mid, end, centroids, num_dims, first_rank + left_parts, num_parts - left_parts, elem_owner);
+} // end rcb_partition
+
+#ifdef HAVE_MPI
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn build_halo_plan
+///
+/// \brief Tells each owner which of its items this rank needs, and builds the plan
+///
+/// \param Global ids this rank needs from each rank, grouped by owner
+/// \param Local id of each global id
+/// \param Ranks the items are sent to, the output
+/// \param Offsets of the sent blocks, the output
+/// \param Ranks the items are received from, the output
+/// \param Offsets of the received blocks, the output
+/// \param Local ids of the sent items, the output
+/// \param Local ids of the received items, the output
+/// \param Label of the lists
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void build_halo_plan(const std::vector<std::vector<size_t>>& needed_from, const std::vector<long>& local_id,
+    std::vector<int>& send_ranks, std::vector<size_t>& send_offsets,
+    std::vector<int>& recv_ranks, std::vector<size_t>& recv_offsets,
+    DCArrayKokkos<size_t>& send_list, DCArrayKokkos<size_t>& recv_list, const std::string& label)
+{
+    const int num_ranks = (int)needed_from.size();
+
+    std::vector<int> recv_counts(num_ranks, 0);
+    std::vector<int> send_counts(num_ranks, 0);
+    for (int owner = 0; owner < num_ranks; owner++) {
+        recv_counts[owner] = (int)needed_from[owner].size();
+    }
+    MPI_Alltoall(recv_counts.data(), 1, MPI_INT, send_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    std::vector<int> recv_displs(num_ranks + 1, 0);
+    std::vector<int> send_displs(num_ranks + 1, 0);
+    for (int other = 0; other < num_ranks; other++) {
+        recv_displs[other + 1] = recv_displs[other] + recv_counts[other];
+        send_displs[other + 1] = send_displs[other] + send_counts[other];
+    }
+
+    std::vector<unsigned long long> requested_gids(recv_displs[num_ranks]);
+    for (int owner = 0; owner < num_ranks; owner++) {
+        for (size_t i = 0; i < needed_from[owner].size(); i++) {
+            requested_gids[recv_displs[owner] + i] = needed_from[owner][i];
+        }
+    }
+
+    std::vector<unsigned long long> send_gids(send_displs[num_ranks]);
+    MPI_Alltoallv(requested_gids.data(), recv_counts.data(), recv_displs.data(), MPI_UNSIGNED_LONG_LONG,
+                  send_gids.data(), send_counts.data(), send_displs.data(), MPI_UNSIGNED_LONG_LONG,
+                  MPI_COMM_WORLD);
+
+    send_ranks.clear();
+    recv_ranks.clear();
+    send_offsets.assign(1, 0);
+    recv_offsets.assign(1, 0);
+    for (int other = 0; other < num_ranks; other++) {
+        if (send_counts[other] > 0) {
+            send_ranks.push_back(other);
+            send_offsets.push_back(send_displs[other + 1]);
+        }
+        if (recv_counts[other] > 0) {
+            recv_ranks.push_back(other);
+            recv_offsets.push_back(recv_displs[other + 1]);
+        }
+    }
+
+    // all the send and recv blocks are contiguous, the empty ones add nothing to the offsets
+    send_list = DCArrayKokkos<size_t>(std::max(send_gids.size(), (size_t)1), label + "_send");
+    recv_list = DCArrayKokkos<size_t>(std::max(requested_gids.size(), (size_t)1), label + "_recv");
+
+    for (size_t send_lid = 0; send_lid < send_gids.size(); send_lid++) {
+        send_list.host(send_lid) = (size_t)local_id[send_gids[send_lid]];
+    }
+    for (size_t recv_lid = 0; recv_lid < requested_gids.size(); recv_lid++) {
+        recv_list.host(recv_lid) = (size_t)local_id[requested_gids[recv_lid]];
+    }
+    send_list.update_device();
+    recv_list.update_device();
+} // end build_halo_plan
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn decompose_mesh
+///
+/// \brief Replaces the global mesh with this rank's part and one ghost layer
+///
+/// Every rank holds the same global mesh on entry. The elems are partitioned
+/// by recursive coordinate bisection, the local mesh is extracted and its
+/// connectivity rebuilt, and the halo plans are set up by sending each owner
+/// the ids of the nodes and ghost elems this rank needs from it. Must be
+/// called after the mesh is read or built and before the boundary sets and
+/// region fills.
+/// The global ids are saved as the original ids so the outputs refer back
+/// to the input mesh.
+///
+/// \param Simulation mesh
+/// \param Element state data
+/// \param Node state data
+/// \param Corner state data
+/// \param Halo plan of this rank, the output
+/// \param Number of RK bins
+///
+/////////////////////////////////////////////////////////////////////////////
+inline void decompose_mesh(mesh_t& mesh, elem_t& elem, node_t& node, corner_t& corner,
+    mesh_comms_t& comms, const int rk_num_bins)
+{
+#ifdef HAVE_MPI
+    const int rank      = comms.rank;
+    const int num_ranks = comms.num_ranks;
+
+    if (num_ranks == 1) {
+        return;
+    }
+
+    const int    num_dims  = mesh.num_dims;
+    const size_t num_nodes = mesh.num_nodes;
+    const size_t num_elems = mesh.num_elems;
+    const size_t num_nodes_in_elem = mesh.num_nodes_in_elem;
+
+    if (num_elems < (size_t)num_ranks) {
+        printf("ERROR: %lu elems can not be split over %d ranks\n", num_elems, num_ranks);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    // --- partition the elems by their centroids ---
+    std::vector<double> centroids(num_elems * 3, 0.0);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(elem_gid, node_lid);
+            for (int dim = 0; dim < num_dims; dim++) {
+                centroids[elem_gid * 3 + dim] += node.coords(0, node_gid, dim) / (double)num_nodes_in_elem;
+            }
+        }
+    }
+
+    std::vector<size_t> elem_ids(num_elems);
+    std::iota(elem_ids.begin(), elem_ids.end(), 0);
+    std::vector<int> elem_owner(num_elems, 0);
+    rcb_partition(elem_ids, 0, num_elems, centroids, num_dims, 0, num_ranks, elem_owner);
+
+    // --- elems around each node, in CSR form ---
+    std::vector<size_t> elems_in_node_start(num_nodes + 1, 0);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            elems_in_node_start[mesh.nodes_in_elem.host(elem_gid, node_lid) + 1]++;
+        }
+    }
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        elems_in_node_start[node_gid + 1] += elems_in_node_start[node_gid];
+    }
+
+    std::vector<size_t> elems_in_node(elems_in_node_start[num_nodes]);
+    std::vector<size_t> fill_count(num_nodes, 0);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(elem_gid, node_lid);
+            elems_in_node[elems_in_node_start[node_gid] + fill_count[node_gid]++] = elem_gid;
+        }
+    }
+
+    // a node is owned by the lowest rank owning an elem around it
+    std::vector<int> node_owner(num_nodes, num_ranks);
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        for (size_t i = elems_in_node_start[node_gid]; i < elems_in_node_start[node_gid + 1]; i++) {
+            node_owner[node_gid] = std::min(node_owner[node_gid], elem_owner[elems_in_node[i]]);
+        }
+    }
+
+    // --- local elems, the owned elems then the ghost layer ---
+    std::vector<char> elem_is_local(num_elems, 0);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        if (elem_owner[elem_gid] != rank) {
+            continue;
+        }
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(elem_gid, node_lid);
+            for (size_t i = elems_in_node_start[node_gid]; i < elems_in_node_start[node_gid + 1]; i++) {
+                elem_is_local[elems_in_node[i]] = 1;
+            }
+        }
+    }
+
+    std::vector<size_t> local_elems; // local id -> global id
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        if (elem_owner[elem_gid] == rank) {
+            local_elems.push_back(elem_gid);
+        }
+    }
+    const size_t num_owned_elems = local_elems.size();
+
+    // the ghosts are grouped by owner, like the node copies below
+    std::vector<long> elem_local_id(num_elems, -1);
+    for (size_t elem_lid = 0; elem_lid < num_owned_elems; elem_lid++) {
+        elem_local_id[local_elems[elem_lid]] = (long)elem_lid;
+    }
+
+    std::vector<std::vector<size_t>> elems_needed_from(num_ranks);
+    for (size_t elem_gid = 0; elem_gid < num_elems; elem_gid++) {
+        if (elem_is_local[elem_gid] && elem_owner[elem_gid] != rank) {
+            elems_needed_from[elem_owner[elem_gid]].push_back(elem_gid);
+        }
+    }
+    for (int owner = 0; owner < num_ranks; owner++) {
+        for (size_t elem_gid : elems_needed_from[owner]) {
+            elem_local_id[elem_gid] = (long)local_elems.size();
+            local_elems.push_back(elem_gid);
+        }
+    }
+
+    // --- local nodes, the owned nodes then the copies ---
+    std::vector<char> node_is_local(num_nodes, 0);
+    for (size_t elem_gid : local_elems) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            node_is_local[mesh.nodes_in_elem.host(elem_gid, node_lid)] = 1;
+        }
+    }
+
+    std::vector<size_t> local_nodes; // local id -> global id
+    std::vector<long>   node_local_id(num_nodes, -1);
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        if (node_is_local[node_gid] && node_owner[node_gid] == rank) {
+            node_local_id[node_gid] = (long)local_nodes.size();
+            local_nodes.push_back(node_gid);
+        }
+    }
+    const size_t num_owned_nodes = local_nodes.size();
+
+    // the copies are grouped by owner, so each owner's values arrive in one block
+    std::vector<std::vector<size_t>> needed_from(num_ranks);
+    for (size_t node_gid = 0; node_gid < num_nodes; node_gid++) {
+        if (node_is_local[node_gid] && node_owner[node_gid] != rank) {
+            needed_from[node_owner[node_gid]].push_back(node_gid);
+        }
+    }
+    for (int owner = 0; owner < num_ranks; owner++) {
+        for (size_t node_gid : needed_from[owner]) {
+            node_local_id[node_gid] = (long)local_nodes.size();
+            local_nodes.push_back(node_gid);
+        }
+    }
+
+    const size_t num_local_nodes = local_nodes.size();
+    const size_t num_local_elems = local_elems.size();
+
+    // --- halo plans in local ids ---
+    build_halo_plan(needed_from, node_local_id, comms.send_ranks, comms.send_offsets,
+                    comms.recv_ranks, comms.recv_offsets, comms.send_nodes, comms.recv_nodes, "halo_nodes");
+    comms.num_send_nodes = comms.send_offsets.back();
+    comms.num_recv_nodes = comms.recv_offsets.back();
+    comms.send_buf = DCArrayKokkos<double>(std::max(comms.num_send_nodes, (size_t)1) * 3, "halo_send_buf");
+    comms.recv_buf = DCArrayKokkos<double>(std::max(comms.num_recv_nodes, (size_t)1) * 3, "halo_recv_buf");
+
+    build_halo_plan(elems_needed_from, elem_local_id, comms.elem_send_ranks, comms.elem_send_offsets,
+                    comms.elem_recv_ranks, comms.elem_recv_offsets, comms.send_elems, comms.recv_elems, "halo_elems");
+    comms.num_send_elems = comms.elem_send_offsets.back();
+    comms.num_recv_elems = comms.elem_recv_offsets.back();
+
+    const size_t elem_vals = std::max(num_nodes_in_elem * num_dims, mesh_comms_t::elem_state_vals(rk_num_bins));
+    comms.elem_send_buf = DCArrayKokkos<double>(std::max(comms.num_send_elems, (size_t)1) * elem_vals, "halo_elem_send_buf");
+    comms.elem_recv_buf = DCArrayKokkos<double>(std::max(comms.num_recv_elems, (size_t)1) * elem_vals, "halo_elem_recv_buf");
+
+    // --- stage the local coordinates, connectivity and original ids ---
+    std::vector<double> coords_tmp(rk_num_bins * num_local_nodes * num_dims);
+    for (int rk = 0; rk < rk_num_bins; rk++) {
+        for (size_t node_lid = 0; node_lid < num_local_nodes; node_lid++) {
+            for (int dim = 0; dim < num_dims; dim++) {
+                coords_tmp[(rk * num_local_nodes + node_lid) * num_dims + dim] = node.coords(rk, local_nodes[node_lid], dim);
+            }
+        }
+    }
+
+    std::vector<size_t> nodes_in_elem_tmp(num_local_elems * num_nodes_in_elem);
+    for (size_t elem_lid = 0; elem_lid < num_local_elems; elem_lid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            size_t node_gid = mesh.nodes_in_elem.host(local_elems[elem_lid], node_lid);
+            nodes_in_elem_tmp[elem_lid * num_nodes_in_elem + node_lid] = (size_t)node_local_id[node_gid];
+        }
+    }
+
+    // compose with the space filling curve ids if the global mesh was renumbered
+    CArray<size_t> node_orig_gids(num_local_nodes);
+    CArray<size_t> elem_orig_gids(num_local_elems);
+    for (size_t node_lid = 0; node_lid < num_local_nodes; node_lid++) {
+        node_orig_gids(node_lid) = mesh.renumbered ? mesh.node_orig_gids(local_nodes[node_lid]) : local_nodes[node_lid];
+    }
+    for (size_t elem_lid = 0; elem_lid < num_local_elems; elem_lid++) {
+        elem_orig_gids(elem_lid) = mesh.renumbered ? mesh.elem_orig_gids(local_elems[elem_lid]) : local_elems[elem_lid];
+    }
+
+    // --- rebuild the mesh and state on the local part ---
+    mesh.initialize_nodes(num_local_nodes);
+    node.initialize(rk_num_bins, num_local_nodes, num_dims);
+    for (int rk = 0; rk < rk_num_bins; rk++) {
+        for (size_t node_lid = 0; node_lid < num_local_nodes; node_lid++) {
+            for (int dim = 0; dim < num_dims; dim++) {
+                node.coords(rk, node_lid, dim) = coords_tmp[(rk * num_local_nodes + node_lid) * num_dims + dim];
+            }
+        }
+    }
+
+    mesh.initialize_elems(num_local_elems, num_dims);
+    elem.initialize(rk_num_bins, num_local_elems, 3); // always 3D here, even for 2D
+    for (size_t elem_lid = 0; elem_lid < num_local_elems; elem_lid++) {
+        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+            mesh.nodes_in_elem.host(elem_lid, node_lid) = nodes_in_elem_tmp[elem_lid * num_nodes_in_elem + node_lid];
+        }
+    }
+    mesh.nodes_in_elem.update_device();
+
+    size_t num_corners = num_local_elems * num_nodes_in_elem;
+    mesh.initialize_corners(num_corners);
+    corner.initialize(num_corners, num_dims);
+
+    mesh.num_owned_nodes = num_owned_nodes;
+    mesh.num_owned_elems = num_owned_elems;
+
+    mesh.renumbered     = true;
+    mesh.node_orig_gids = node_orig_gids;
+    mesh.elem_orig_gids = elem_orig_gids;
+
+    mesh.build_connectivity();
+
+    printf("Rank %d: %lu of %lu local elems and %lu of %lu local nodes owned, %lu halo neighbors\n",
+           rank, num_owned_elems, num_local_elems, num_owned_nodes, num_local_nodes,
+           std::max(comms.elem_send_ranks.size(), comms.elem_recv_ranks.size()));
+#endif
+    return;
+} // end decompose_mesh
+
+#endif // end Header Guard
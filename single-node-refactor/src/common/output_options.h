@@ -49,7 +49,9 @@ enum format
 // timer output level
 enum timer_output_level
 {
-    thorough = 0,
+    off = 0,        // no timers
+    standard = 1,   // setup phases, cycles, RK stages, and outputs
+    thorough = 2,   // standard plus every RK sub-step, fenced for accuracy
 };
 } // end of namespace
 
@@ -61,6 +63,8 @@ static std::map<std::string, output_options::format> output_format_map
 
 static std::map<std::string, output_options::timer_output_level> timer_output_level_map
 {
+    { "off", output_options::off },
+    { "standard", output_options::standard },
     { "thorough", output_options::thorough }
 };
 
@@ -74,7 +78,7 @@ static std::map<std::string, output_options::timer_output_level> timer_output_le
 struct output_options_t
 {
     output_options::format format;  ///< Format for the output files
-    output_options::timer_output_level timer_level; ///< How often to output mesh WARNING: CURRENTLY UNUSED
+    output_options::timer_output_level timer_level = output_options::off; ///< Detail of the timers written to perf_report.json
 
     double graphics_time_step   = 1.0;  ///< How often to write a graphics dump in time
     int graphics_iteration_step = 2000000;  ///< How often to write a graphics dump by iteration count
@@ -0,0 +1,267 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef FIERRO_PERF_TIMERS_H
+#define FIERRO_PERF_TIMERS_H
+
+#include <stdio.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "matar.h"
+#include "output_options.h"
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \struct perf_region_t
+///
+/// \brief Timing statistics for a single named region
+///
+/////////////////////////////////////////////////////////////////////////////
+struct perf_region_t
+{
+    size_t calls = 0;           ///< Number of times the region was entered (kernel launches for leaf regions)
+    double total_time = 0.0;    ///< Cumulative wall time in seconds
+    double cycle_time = 0.0;    ///< Wall time in the current cycle
+    double max_cycle_time = 0.0; ///< Largest wall time in a single cycle
+    double bytes = 0.0;         ///< Estimated bytes moved, cumulative
+}; // perf_region_t
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \class PerfTimers
+///
+/// \brief Hierarchical wall clock timers with a JSON report
+///
+/// Regions are nested with start/stop, and the full path of the stack
+/// ("execute/rk_stage/get_force") is used as the region name. Every region
+/// is also pushed as a Kokkos profiling region so external tools see the
+/// same hierarchy. Regions that require a higher timer level than the one
+/// requested are skipped. At the thorough level the device is fenced
+/// before a region is stopped, so asynchronous kernels are attributed to
+/// the region that launched them.
+///
+/////////////////////////////////////////////////////////////////////////////
+class PerfTimers
+{
+private:
+    using timer_clock_t = std::chrono::high_resolution_clock;
+
+    output_options::timer_output_level level_ = output_options::off;
+
+    std::vector<std::string> stack_;
+    std::vector<timer_clock_t::time_point> start_times_;
+    std::vector<bool> active_;
+
+    std::map<std::string, perf_region_t> regions_;
+    std::vector<std::string> order_;   // first-seen order for the report
+
+    size_t num_cycles_ = 0;
+
+public:
+
+    PerfTimers() {}
+
+    ~PerfTimers() {}
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn set_level
+    ///
+    /// \brief Sets the timer level, regions above this level are not timed
+    ///
+    /// \param Timer level from the output options
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void set_level(output_options::timer_output_level level)
+    {
+        level_ = level;
+    }
+
+    output_options::timer_output_level level() const
+    {
+        return level_;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn start
+    ///
+    /// \brief Enters a named region nested in the current one
+    ///
+    /// \param Region name
+    /// \param Minimum timer level at which the region is timed
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void start(const std::string& name,
+               output_options::timer_output_level min_level = output_options::standard)
+    {
+        bool active = (level_ != output_options::off && level_ >= min_level);
+        active_.push_back(active);
+
+        if (!active) {
+            return;
+        }
+
+        std::string path = stack_.empty() ? name : stack_.back() + "/" + name;
+        stack_.push_back(path);
+
+        if (regions_.find(path) == regions_.end()) {
+            regions_[path] = perf_region_t();
+            order_.push_back(path);
+        }
+
+        Kokkos::Profiling::pushRegion(path);
+        start_times_.push_back(timer_clock_t::now());
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn stop
+    ///
+    /// \brief Leaves the innermost region
+    ///
+    /// \param Estimated bytes moved by the region, used for bandwidth
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void stop(double bytes = 0.0)
+    {
+        if (active_.empty()) {
+            return;
+        }
+
+        bool active = active_.back();
+        active_.pop_back();
+
+        if (!active) {
+            return;
+        }
+
+        if (level_ == output_options::thorough) {
+            Kokkos::fence();
+        }
+
+        double time = std::chrono::duration<double>(timer_clock_t::now() - start_times_.back()).count();
+        start_times_.pop_back();
+
+        Kokkos::Profiling::popRegion();
+
+        perf_region_t& region = regions_[stack_.back()];
+        region.calls++;
+        region.total_time += time;
+        region.cycle_time += time;
+        region.bytes += bytes;
+
+        stack_.pop_back();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn end_cycle
+    ///
+    /// \brief Closes the per-cycle accumulation for every region
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void end_cycle()
+    {
+        if (level_ == output_options::off) {
+            return;
+        }
+
+        num_cycles_++;
+
+        for (auto& pair : regions_) {
+            if (pair.second.cycle_time > pair.second.max_cycle_time) {
+                pair.second.max_cycle_time = pair.second.cycle_time;
+            }
+            pair.second.cycle_time = 0.0;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \fn write_report
+    ///
+    /// \brief Writes the region statistics as JSON and a summary to stdout
+    ///
+    /// \param Path of the JSON file
+    ///
+    /////////////////////////////////////////////////////////////////////////////
+    void write_report(const std::string& file_name)
+    {
+        if (level_ == output_options::off || order_.empty()) {
+            return;
+        }
+
+        FILE* out = fopen(file_name.c_str(), "w");
+        if (out == NULL) {
+            printf("WARNING: could not open %s for the performance report\n", file_name.c_str());
+            return;
+        }
+
+        fprintf(out, "{\n");
+        fprintf(out, "  \"num_cycles\": %lu,\n", num_cycles_);
+        fprintf(out, "  \"regions\": [\n");
+
+        for (size_t i = 0; i < order_.size(); i++) {
+            const perf_region_t& region = regions_[order_[i]];
+
+            double mean_cycle_time = (num_cycles_ > 0) ? region.total_time / (double)num_cycles_ : region.total_time;
+            double bandwidth = (region.total_time > 0.0) ? region.bytes / region.total_time * 1e-9 : 0.0;
+
+            fprintf(out, "    {\"name\": \"%s\", \"calls\": %lu, \"total_s\": %.6e, "
+                    "\"mean_per_cycle_s\": %.6e, \"max_per_cycle_s\": %.6e, "
+                    "\"bytes\": %.6e, \"bandwidth_GBps\": %.6e}%s\n",
+                    order_[i].c_str(), region.calls, region.total_time,
+                    mean_cycle_time, region.max_cycle_time,
+                    region.bytes, bandwidth,
+                    (i + 1 < order_.size()) ? "," : "");
+        }
+
+        fprintf(out, "  ]\n");
+        fprintf(out, "}\n");
+        fclose(out);
+
+        printf("\n---- Performance summary (%s) ----\n", file_name.c_str());
+        for (const auto& name : order_) {
+            const perf_region_t& region = regions_[name];
+            printf("%-50s calls = %8lu, time = %12.5e s\n", name.c_str(), region.calls, region.total_time);
+        }
+        printf("\n");
+    }
+}; // end PerfTimers
+
+#endif // end Header Guard
@@ -44,6 +44,7 @@
 #include "output_options.h"
 #include "boundary_conditions.h"
 #include "dynamic_options.h"
+#include "ensemble_options.h"
 
 /////////////////////////////////////////////////////////////////////////////
 ///
@@ -60,6 +61,8 @@ struct simulation_parameters_t
 
     dynamic_options_t dynamic_options;  ///< Simulation timing and dynamic options
 
+    ensemble_options_t ensemble_options; ///< Ensemble members that share the mesh
+
     std::vector<solver_input_t> solver_inputs;  ///< Solvers to use during the simulation
 
     CArrayKokkos<boundary_condition_t> boundary_conditions; ///< Simulation boundary conditions
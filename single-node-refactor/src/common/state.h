@@ -50,6 +50,7 @@ struct node_t
     DCArrayKokkos<double> coords; ///< Nodal coordinates
     DCArrayKokkos<double> vel;  ///< Nodal velocity
     DCArrayKokkos<double> mass; ///< Nodal mass
+    DCArrayKokkos<double> force; ///< Nodal force, only allocated by the atomic scatter force mode
 
     // initialization method (num_rk_storage_bins, num_nodes, num_dims)
     void initialize(size_t num_rk, size_t num_nodes, size_t num_dims)
@@ -36,6 +36,8 @@
 #include "parse_yaml.h"
 #include "solver.h"
 #include "simulation_parameters.h"
+#include "mpi_coms.h"
+#include "ensemble.h"
 
 // Headers for solver classes
 #include "sgh_solver.h"
@@ -54,6 +56,12 @@ public:
     MeshBuilder mesh_builder;
     simulation_parameters_t sim_param;
 
+    // phase timers, reported in perf_report.json
+    PerfTimers timers;
+
+    // rank, halo plan and reductions of the decomposed mesh
+    mesh_comms_t comms;
+
     int num_dims = 3;
 
     // ---------------------------------------------------------------------
@@ -84,6 +92,8 @@ public:
     void initialize()
     {
         std::cout << "Inside driver initialize" << std::endl;
+        comms.initialize();
+
         Yaml::Node root;
         try
         {
@@ -98,10 +108,18 @@ public:
         parse_yaml(root, sim_param);
         std::cout << "Finished  parsing YAML file" << std::endl;
 
+        timers.set_level(sim_param.output_options.timer_level);
+        mesh_reader.timers  = &timers;
+        mesh_builder.timers = &timers;
+
+        timers.start("initialize");
+
+        timers.start("mesh_read");
         if (sim_param.mesh_input.source == mesh_input::file) {
             // Create and/or read mesh
             std::cout << "Mesh file path: " << sim_param.mesh_input.file_path << std::endl;
             mesh_reader.set_mesh_file(sim_param.mesh_input.file_path.data());
+            mesh_reader.set_renumber(sim_param.mesh_input.renumber);
             mesh_reader.read_mesh(mesh, elem, node, corner, num_dims, sim_param.dynamic_options.rk_num_bins);
         }
         else if (sim_param.mesh_input.source == mesh_input::generate) {
@@ -111,6 +129,24 @@ public:
             throw std::runtime_error("**** NO MESH INPUT OPTIONS PROVIDED IN YAML ****");
             return;
         }
+        timers.stop();
+
+        // --- tile the mesh once per ensemble member, the members run in the same kernels ---
+        if (sim_param.ensemble_options.num_members > 1) {
+            if (comms.num_ranks > 1) {
+                throw std::runtime_error("**** AN ENSEMBLE CAN NOT BE SPLIT OVER MPI RANKS ****");
+            }
+            timers.start("replicate_mesh");
+            replicate_mesh(mesh, elem, node, corner, sim_param.ensemble_options.num_members, sim_param.dynamic_options.rk_num_bins);
+            timers.stop();
+        }
+
+        // --- split the mesh over the ranks, every rank holds the global mesh up to here ---
+        if (comms.num_ranks > 1) {
+            timers.start("decompose");
+            decompose_mesh(mesh, elem, node, corner, comms, sim_param.dynamic_options.rk_num_bins);
+            timers.stop();
+        }
 
         // mesh_builder.build_mesh(mesh, elem, node, corner, sim_param);
 
@@ -119,9 +155,11 @@ public:
         printf("Num BC's = %d\n", num_bcs);
 
         // --- calculate bdy sets ---//
+        timers.start("boundary_sets");
         mesh.init_bdy_sets(num_bcs);
         tag_bdys(sim_param.boundary_conditions, mesh, node.coords);
         mesh.build_boundry_node_sets(sim_param.boundary_conditions, mesh);
+        timers.stop();
 
         // Calculate element volume
         geometry::get_vol(elem.vol, node.coords, mesh);
@@ -131,16 +169,23 @@ public:
         elem.statev = DCArrayKokkos<double>(mesh.num_elems, sim_param.materials(0).eos_global_vars.size()); // WARNING: HACK
 
         // --- apply the fill instructions over the Elements---//
+        timers.start("fill_regions");
         fill_regions();
+        timers.stop();
 
         // Create solvers
         for (int solver_id = 0; solver_id < sim_param.solver_inputs.size(); solver_id++) {
             if (sim_param.solver_inputs[solver_id].method == solver_input::SGH) {
                 SGH* sgh_solver = new SGH(); // , mesh, node, elem, corner
                 sgh_solver->initialize(sim_param);
+                sgh_solver->timers = &timers;
+                sgh_solver->comms  = &comms;
+                sgh_solver->mesh_writer.set_rank(comms.rank, comms.num_ranks);
                 solvers.push_back(sgh_solver);
             }
         }
+
+        timers.stop();
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -153,9 +198,11 @@ public:
     void setup()
     {
         std::cout << "Inside driver setup" << std::endl;
+        timers.start("setup");
         for (auto& solver : solvers) {
             solver->setup(sim_param, mesh, node, elem, corner);
         }
+        timers.stop();
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -168,9 +215,11 @@ public:
     void run()
     {
         std::cout << "Inside driver run" << std::endl;
+        timers.start("run");
         for (auto& solver : solvers) {
             solver->execute(sim_param, mesh, node, elem, corner);
         }
+        timers.stop();
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -185,6 +234,22 @@ public:
     void finalize()
     {
         std::cout << "Inside driver finalize" << std::endl;
+
+        // machine readable timing report, one per rank of a decomposed run
+        if (comms.num_ranks > 1) {
+            char report_name[64];
+            sprintf(report_name, "perf_report_r%05d.json", comms.rank);
+            timers.write_report(report_name);
+        }
+        else{
+            timers.write_report("perf_report.json");
+        }
+
+        // energies of each ensemble member, the solver only prints the ensemble totals
+        if (mesh.num_members > 1) {
+            write_ensemble_report("ensemble_report.csv", sim_param.ensemble_options, mesh, node, elem);
+        }
+
         for (auto& solver : solvers) {
             if (solver->finalize_flag) {
                 solver->finalize(sim_param);
@@ -209,6 +274,36 @@ public:
         int num_fills = sim_param.region_fills.size();
         printf("Num Fills's = %d\n", num_fills);
 
+        // ---- swept fill values of the ensemble members ----
+        const ensemble_options_t& ensemble_options = sim_param.ensemble_options;
+
+        const size_t num_members      = mesh.num_members;
+        const size_t num_member_elems = mesh.num_member_elems;
+        const int    swept_region_id  = (num_members > 1) ? ensemble_options.region_id : -1;
+        const size_t eos_var_id       = ensemble_options.eos_var_id;
+
+        // the swept ids index device arrays, so they are range checked before any kernel runs
+        if (num_members > 1) {
+            if (swept_region_id < 0 || swept_region_id >= num_fills) {
+                throw std::runtime_error("**** ENSEMBLE REGION_ID IS NOT A REGION FILL ****");
+            }
+            if (!ensemble_options.sweeps[ensemble::eos_var].empty() && eos_var_id >= elem.statev.dims(1)) {
+                throw std::runtime_error("**** ENSEMBLE EOS_VAR_ID IS NOT AN ELEMENT STATE VARIABLE ****");
+            }
+        }
+
+        DCArrayKokkos<double> member_fill(num_members, ensemble::num_fill_vars);
+        DCArrayKokkos<size_t> fill_swept(ensemble::num_fill_vars);
+        for (size_t var = 0; var < ensemble::num_fill_vars; var++) {
+            fill_swept.host(var) = ensemble_options.sweeps[var].empty() ? 0 : 1;
+            for (size_t member = 0; member < num_members; member++) {
+                member_fill.host(member, var) = (fill_swept.host(var) == 1) ?
+                                                ensemble_options.member_value((ensemble::fill_var)var, member) : 0.0;
+            }
+        }
+        member_fill.update_device();
+        fill_swept.update_device();
+
         for (int f_id = 0; f_id < num_fills; f_id++) {
             // // voxel mesh setup
             // if (read_voxel_file.host(f_id) == 1)
@@ -333,14 +428,34 @@ public:
 
                     // paint the material state on the element
                     if (fill_this == 1) {
+                        // fill values, the swept fill of an ensemble takes them from the member
+                        double fill_vals[ensemble::num_fill_vars];
+                        fill_vals[ensemble::den]   = sim_param.region_fills(f_id).den;
+                        fill_vals[ensemble::sie]   = sim_param.region_fills(f_id).sie;
+                        fill_vals[ensemble::u]     = sim_param.region_fills(f_id).u;
+                        fill_vals[ensemble::v]     = sim_param.region_fills(f_id).v;
+                        fill_vals[ensemble::w]     = sim_param.region_fills(f_id).w;
+                        fill_vals[ensemble::speed] = sim_param.region_fills(f_id).speed;
+                        fill_vals[ensemble::eos_var] = 0.0;
+
+                        size_t member = elem_gid / num_member_elems;
+                        bool swept_fill = (f_id == swept_region_id);
+                        if (swept_fill) {
+                            for (size_t var = 0; var < ensemble::num_fill_vars; var++) {
+                                if (fill_swept(var) == 1) {
+                                    fill_vals[var] = member_fill(member, var);
+                                }
+                            }
+                        } // end if swept
+
                         // density
-                        elem.den(elem_gid) = sim_param.region_fills(f_id).den;
+                        elem.den(elem_gid) = fill_vals[ensemble::den];
 
                         // mass
                         elem.mass(elem_gid) = elem.den(elem_gid) * elem.vol(elem_gid);
 
                         // specific internal energy
-                        elem.sie(rk_level, elem_gid) = sim_param.region_fills(f_id).sie;
+                        elem.sie(rk_level, elem_gid) = fill_vals[ensemble::sie];
 
                         elem.mat_id(elem_gid) = sim_param.region_fills(f_id).material_id;
 
@@ -364,6 +479,11 @@ public:
                             } // end for
                         } // end logical on type
 
+                        // swept EOS global variable of an ensemble member
+                        if (swept_fill && fill_swept(ensemble::eos_var) == 1) {
+                            elem.statev(elem_gid, eos_var_id) = fill_vals[ensemble::eos_var];
+                        }
+
                         // --- stress tensor ---
                         // always 3D even for 2D-RZ
                         for (size_t i = 0; i < 3; i++) {
@@ -391,10 +511,10 @@ public:
                             switch (sim_param.region_fills(f_id).velocity) {
                                 case init_conds::cartesian:
                                     {
-                                        node.vel(rk_level, node_gid, 0) = sim_param.region_fills(f_id).u;
-                                        node.vel(rk_level, node_gid, 1) = sim_param.region_fills(f_id).v;
+                                        node.vel(rk_level, node_gid, 0) = fill_vals[ensemble::u];
+                                        node.vel(rk_level, node_gid, 1) = fill_vals[ensemble::v];
                                         if (mesh.num_dims == 3) {
-                                            node.vel(rk_level, node_gid, 2) = sim_param.region_fills(f_id).w;
+                                            node.vel(rk_level, node_gid, 2) = fill_vals[ensemble::w];
                                         }
 
                                         break;
@@ -423,8 +543,8 @@ public:
                                             }
                                         } // end for
 
-                                        node.vel(rk_level, node_gid, 0) = sim_param.region_fills(f_id).speed * dir[0];
-                                        node.vel(rk_level, node_gid, 1) = sim_param.region_fills(f_id).speed * dir[1];
+                                        node.vel(rk_level, node_gid, 0) = fill_vals[ensemble::speed] * dir[0];
+                                        node.vel(rk_level, node_gid, 1) = fill_vals[ensemble::speed] * dir[1];
                                         if (mesh.num_dims == 3) {
                                             node.vel(rk_level, node_gid, 2) = 0.0;
                                         }
@@ -455,10 +575,10 @@ public:
                                             }
                                         } // end for
 
-                                        node.vel(rk_level, node_gid, 0) = sim_param.region_fills(f_id).speed * dir[0];
-                                        node.vel(rk_level, node_gid, 1) = sim_param.region_fills(f_id).speed * dir[1];
+                                        node.vel(rk_level, node_gid, 0) = fill_vals[ensemble::speed] * dir[0];
+                                        node.vel(rk_level, node_gid, 1) = fill_vals[ensemble::speed] * dir[1];
                                         if (mesh.num_dims == 3) {
-                                            node.vel(rk_level, node_gid, 2) = sim_param.region_fills(f_id).speed * dir[2];
+                                            node.vel(rk_level, node_gid, 2) = fill_vals[ensemble::speed] * dir[2];
                                         }
 
                                         break;
@@ -493,7 +613,7 @@ public:
                             size_t mat_id = f_id;
                             double gamma  = elem.statev(elem_gid, 4); // gamma value WARNING: BUG HERE
                             elem.sie(rk_level, elem_gid) =
-                                elem.pres(elem_gid) / (sim_param.region_fills(f_id).den * (gamma - 1.0));
+                                elem.pres(elem_gid) / (fill_vals[ensemble::den] * (gamma - 1.0));
                         } // end if
                     } // end if fill
                 } // end RK loop
@@ -35,6 +35,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <Kokkos_Core.hpp>
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
 #include <sys/stat.h>
 
 #include "matar.h"
@@ -60,6 +63,10 @@ int main(int argc, char* argv[])
         return 0;
     } // end if
 
+#ifdef HAVE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
     Kokkos::initialize();
 
     // Create driver on heap
@@ -76,6 +83,10 @@ int main(int argc, char* argv[])
 
     Kokkos::finalize();
 
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
     std::cout << "**** End of main **** " << std::endl;
     return 0;
 }
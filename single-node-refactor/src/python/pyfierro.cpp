@@ -0,0 +1,278 @@
+/**********************************************************************************************
+  2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/functional.h>
+
+#include <Kokkos_Core.hpp>
+
+#include "matar.h"
+#include "driver.h"
+
+namespace py = pybind11;
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn host_array
+///
+/// \brief NumPy array over the host mirror of a DCArrayKokkos, no data is
+///        copied.  The array keeps its owner alive.
+///
+/// \param Array with the host mirror
+/// \param Python object that owns the array
+///
+/////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static py::array host_array(const DCArrayKokkos<T>& array, py::handle owner)
+{
+    if (array.size() == 0) {
+        return py::array_t<T>(0);
+    }
+
+    // MATAR arrays are row major
+    std::vector<py::ssize_t> shape(array.order());
+    std::vector<py::ssize_t> strides(array.order());
+    py::ssize_t stride = sizeof(T);
+    for (int i = (int)array.order() - 1; i >= 0; i--) {
+        shape[i]   = array.dims(i);
+        strides[i] = stride;
+        stride    *= array.dims(i);
+    }
+
+    return py::array_t<T>(shape, strides, array.host_pointer(), owner);
+} // end host_array
+
+// copies between the device and the host mirror, skipping unallocated arrays
+template<typename T>
+static void update_host(DCArrayKokkos<T>& array)
+{
+    if (array.size() > 0) {
+        array.update_host();
+    }
+}
+
+template<typename T>
+static void update_device(DCArrayKokkos<T>& array)
+{
+    if (array.size() > 0) {
+        array.update_device();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \class PyDriver
+///
+/// \brief Driver that keeps its own copy of the input file name
+///
+/////////////////////////////////////////////////////////////////////////////
+class PyDriver : public Driver
+{
+public:
+
+    std::string yaml_path;
+
+    PyDriver(const std::string& yaml) : Driver(nullptr), yaml_path(yaml)
+    {
+        yaml_file = &yaml_path[0];
+    }
+
+    // copies the state from the device to the host mirrors
+    void update_host()
+    {
+        Kokkos::fence();
+
+        ::update_host(mesh.nodes_in_elem);
+
+        ::update_host(node.coords);
+        ::update_host(node.vel);
+        ::update_host(node.mass);
+
+        ::update_host(elem.den);
+        ::update_host(elem.pres);
+        ::update_host(elem.stress);
+        ::update_host(elem.sspd);
+        ::update_host(elem.sie);
+        ::update_host(elem.vol);
+        ::update_host(elem.div);
+        ::update_host(elem.mass);
+        ::update_host(elem.mat_id);
+        ::update_host(elem.statev);
+    }
+
+    // copies the host mirrors to the device, after a script changed the state
+    void update_device()
+    {
+        ::update_device(node.coords);
+        ::update_device(node.vel);
+        ::update_device(node.mass);
+
+        ::update_device(elem.den);
+        ::update_device(elem.pres);
+        ::update_device(elem.stress);
+        ::update_device(elem.sspd);
+        ::update_device(elem.sie);
+        ::update_device(elem.vol);
+        ::update_device(elem.div);
+        ::update_device(elem.mass);
+        ::update_device(elem.mat_id);
+        ::update_device(elem.statev);
+
+        Kokkos::fence();
+    }
+
+    // calls a script after every cycle of every solver, the host mirrors are
+    // current in the call and any change the script makes is copied back
+    void set_cycle_callback(std::function<bool(size_t, double, double)> callback, bool sync)
+    {
+        for (auto& solver : solvers) {
+            if (!callback) {
+                solver->cycle_callback = nullptr;
+                continue;
+            }
+
+            solver->cycle_callback = [this, callback, sync](size_t cycle, double time, double dt) {
+                if (sync) {
+                    update_host();
+                }
+
+                bool keep_going = callback(cycle, time, dt);
+
+                if (sync) {
+                    update_device();
+                }
+                return keep_going;
+            };
+        } // end for solver
+    }
+}; // end PyDriver
+
+PYBIND11_MODULE(pyfierro, m)
+{
+    m.doc() = "In-situ access to the state of the Fierro single-node-refactor solvers";
+
+    // ---- Kokkos, once per process ----
+    m.def("initialize", []() {
+        if (!Kokkos::is_initialized()) {
+            Kokkos::initialize();
+        }
+    }, "Initializes Kokkos, call before creating a Driver");
+
+    m.def("finalize", []() {
+        if (Kokkos::is_initialized()) {
+            Kokkos::finalize();
+        }
+    }, "Finalizes Kokkos, call after every Driver and array is released");
+
+    // ---- mesh ----
+    py::class_<mesh_t>(m, "Mesh")
+        .def_readonly("num_dims", &mesh_t::num_dims)
+        .def_readonly("num_nodes", &mesh_t::num_nodes)
+        .def_readonly("num_elems", &mesh_t::num_elems)
+        .def_readonly("num_owned_nodes", &mesh_t::num_owned_nodes)
+        .def_readonly("num_owned_elems", &mesh_t::num_owned_elems)
+        .def_readonly("num_nodes_in_elem", &mesh_t::num_nodes_in_elem)
+        .def_readonly("num_members", &mesh_t::num_members)
+        .def_property_readonly("nodes_in_elem", [](py::object self) {
+            return host_array(self.cast<mesh_t&>().nodes_in_elem, self);
+        });
+
+    // ---- nodal state, the leading dimension of coords and vel is the rk bin ----
+    py::class_<node_t>(m, "Node")
+        .def_property_readonly("coords", [](py::object self) {
+            return host_array(self.cast<node_t&>().coords, self);
+        })
+        .def_property_readonly("vel", [](py::object self) {
+            return host_array(self.cast<node_t&>().vel, self);
+        })
+        .def_property_readonly("mass", [](py::object self) {
+            return host_array(self.cast<node_t&>().mass, self);
+        });
+
+    // ---- element state, the leading dimension of stress and sie is the rk bin ----
+    py::class_<elem_t>(m, "Elem")
+        .def_property_readonly("den", [](py::object self) {
+            return host_array(self.cast<elem_t&>().den, self);
+        })
+        .def_property_readonly("pres", [](py::object self) {
+            return host_array(self.cast<elem_t&>().pres, self);
+        })
+        .def_property_readonly("stress", [](py::object self) {
+            return host_array(self.cast<elem_t&>().stress, self);
+        })
+        .def_property_readonly("sspd", [](py::object self) {
+            return host_array(self.cast<elem_t&>().sspd, self);
+        })
+        .def_property_readonly("sie", [](py::object self) {
+            return host_array(self.cast<elem_t&>().sie, self);
+        })
+        .def_property_readonly("vol", [](py::object self) {
+            return host_array(self.cast<elem_t&>().vol, self);
+        })
+        .def_property_readonly("div", [](py::object self) {
+            return host_array(self.cast<elem_t&>().div, self);
+        })
+        .def_property_readonly("mass", [](py::object self) {
+            return host_array(self.cast<elem_t&>().mass, self);
+        })
+        .def_property_readonly("mat_id", [](py::object self) {
+            return host_array(self.cast<elem_t&>().mat_id, self);
+        })
+        .def_property_readonly("statev", [](py::object self) {
+            return host_array(self.cast<elem_t&>().statev, self);
+        });
+
+    // ---- driver lifecycle, the same order as main.cpp ----
+    py::class_<PyDriver>(m, "Driver")
+        .def(py::init<const std::string&>(), py::arg("yaml_file"))
+        .def("initialize", &PyDriver::initialize, "Parses the input, builds the mesh and fills the regions")
+        .def("setup", &PyDriver::setup, "Calls the setup of every solver")
+        .def("run", &PyDriver::run, "Runs every solver to the end time or until the cycle callback returns False")
+        .def("finalize", &PyDriver::finalize, "Writes the reports and deletes the solvers")
+        .def("update_host", &PyDriver::update_host, "Copies the state from the device to the NumPy arrays")
+        .def("update_device", &PyDriver::update_device, "Copies the NumPy arrays to the device")
+        .def("set_cycle_callback", &PyDriver::set_cycle_callback,
+             py::arg("callback"), py::arg("sync") = true,
+             "Calls callback(cycle, time, dt) after every cycle, a False return ends the run")
+        .def_property_readonly("mesh", [](PyDriver& self) -> mesh_t& { return self.mesh; },
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("node", [](PyDriver& self) -> node_t& { return self.node; },
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("elem", [](PyDriver& self) -> elem_t& { return self.elem; },
+                               py::return_value_policy::reference_internal);
+} // end PYBIND11_MODULE
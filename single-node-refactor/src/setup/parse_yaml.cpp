@@ -42,6 +42,7 @@
 #include <variant>
 #include <algorithm>
 #include <map>
+#include <stdexcept>
 
 #include "matar.h"
 #include "parse_yaml.h"
@@ -261,6 +262,12 @@ void parse_yaml(Yaml::Node& root, simulation_parameters_t& sim_param)
     }
     parse_dynamic_options(root, sim_param.dynamic_options);
 
+    if (VERBOSE) {
+        printf("\n");
+        std::cout << "Parsing YAML ensemble options:" << std::endl;
+    }
+    parse_ensemble_options(root, sim_param.ensemble_options);
+
     if (VERBOSE) {
         printf("\n");
         std::cout << "Parsing YAML output options:" << std::endl;
@@ -292,6 +299,9 @@ void parse_yaml(Yaml::Node& root, simulation_parameters_t& sim_param)
     }
     // parse the material yaml text into a vector of materials
     parse_materials(root, sim_param.materials, sim_param.eos_global_vars);
+
+    // the ensemble ids refer to regions and materials, so they are checked last
+    validate_ensemble_options(sim_param);
 }
 
 // =================================================================================
@@ -462,6 +472,74 @@ void parse_dynamic_options(Yaml::Node& root, dynamic_options_t& dynamic_options)
             int rk_num_bins = yaml[a_word].As<int>();
             dynamic_options.rk_num_bins = rk_num_bins;
         }
+        //  Use the fused RK stage kernels
+        else if (a_word.compare("rk_fused_kernels") == 0) {
+            int rk_fused_kernels = yaml[a_word].As<int>();
+            dynamic_options.rk_fused_kernels = rk_fused_kernels;
+        }
+        //  Number of local time stepping levels
+        else if (a_word.compare("lts_num_levels") == 0) {
+            int lts_num_levels = yaml[a_word].As<int>();
+            if (lts_num_levels < 1) {
+                std::cout << "ERROR: invalid lts_num_levels input in YAML file: " << lts_num_levels << std::endl;
+                std::cout << "Valid options are integers of 1 or larger" << std::endl;
+            }
+            else{
+                dynamic_options.lts_num_levels = lts_num_levels;
+            }
+        }
+        //  Cycles between rebuilds of the active element and node lists
+        else if (a_word.compare("active_list_ival") == 0) {
+            int active_list_ival = yaml[a_word].As<int>();
+            if (active_list_ival < 0) {
+                std::cout << "ERROR: invalid active_list_ival input in YAML file: " << active_list_ival << std::endl;
+                std::cout << "Valid options are integers of 0 or larger" << std::endl;
+            }
+            else{
+                dynamic_options.active_list_ival = active_list_ival;
+            }
+        }
+        //  Corner to node force assembly
+        else if (a_word.compare("node_force_mode") == 0) {
+            std::string node_force_mode = yaml[a_word].As<std::string>();
+
+            auto map = node_force_mode_map;
+
+            if (map.find(node_force_mode) != map.end()) {
+                dynamic_options.node_force_mode = map[node_force_mode];
+            }
+            else{
+                std::cout << "ERROR: invalid node_force_mode input in YAML file: " << node_force_mode << std::endl;
+                std::cout << "Valid options are: " << std::endl;
+
+                for (const auto& pair : map) {
+                    std::cout << "\t" << pair.first << std::endl;
+                }
+            } // end if
+        }
+        //  Use the SIMD-packed corner force kernel
+        else if (a_word.compare("simd_force_kernel") == 0) {
+            int simd_force_kernel = yaml[a_word].As<int>();
+            dynamic_options.simd_force_kernel = simd_force_kernel;
+        }
+        //  Time integration scheme
+        else if (a_word.compare("time_integrator") == 0) {
+            std::string time_integrator = yaml[a_word].As<std::string>();
+
+            auto map = time_integrator_map;
+
+            if (map.find(time_integrator) != map.end()) {
+                dynamic_options.time_integrator = map[time_integrator];
+            }
+            else{
+                std::cout << "ERROR: invalid time_integrator input in YAML file: " << time_integrator << std::endl;
+                std::cout << "Valid options are: " << std::endl;
+
+                for (const auto& pair : map) {
+                    std::cout << "\t" << pair.first << std::endl;
+                }
+            } // end if
+        }
         else {
             std::cout << "ERROR: invalid input: " << a_word << std::endl;
             std::cout << "Valid options are: " << std::endl;
@@ -472,6 +550,120 @@ void parse_dynamic_options(Yaml::Node& root, dynamic_options_t& dynamic_options)
     } // end for words in dynamic options
 } // end of function to parse region
 
+// =================================================================================
+//    Parse Ensemble Options
+// =================================================================================
+void parse_ensemble_options(Yaml::Node& root, ensemble_options_t& ensemble_options)
+{
+    Yaml::Node& yaml = root["ensemble_options"];
+
+    // get the ensemble variables names set by the user
+    std::vector<std::string> user_ensemble_inps;
+
+    // extract words from the input file and validate they are correct
+    validate_inputs(yaml, user_ensemble_inps, str_ensemble_opts_inps);
+
+    // swept fill values, in the order of ensemble::fill_var
+    std::vector<std::string> str_sweeps { "den", "sie", "u", "v", "w", "speed", "eos_var" };
+
+    // loop over the words in the ensemble input definition
+    for (auto& a_word : user_ensemble_inps) {
+        if (VERBOSE) {
+            std::cout << a_word << std::endl;
+        }
+
+        auto sweep = std::find(str_sweeps.begin(), str_sweeps.end(), a_word);
+
+        //  Number of ensemble members
+        if (a_word.compare("num_members") == 0) {
+            int num_members = yaml[a_word].As<int>();
+            if (num_members < 1) {
+                std::cout << "ERROR: invalid num_members input in YAML file: " << num_members << std::endl;
+                std::cout << "Valid options are integers of 1 or larger" << std::endl;
+            }
+            else{
+                ensemble_options.num_members = num_members;
+            }
+        }
+        //  Region fill the sweeps are applied to
+        else if (a_word.compare("region_id") == 0) {
+            int region_id = yaml[a_word].As<int>();
+            ensemble_options.region_id = region_id;
+        }
+        //  EOS global variable of the eos_var sweep
+        else if (a_word.compare("eos_var_id") == 0) {
+            int eos_var_id = yaml[a_word].As<int>();
+            ensemble_options.eos_var_id = eos_var_id;
+        }
+        //  Values swept over the members
+        else if (sweep != str_sweeps.end()) {
+            std::string values = yaml[a_word].As<std::string>();
+            if (VERBOSE) {
+                std::cout << "\t" << a_word << " = " << values << std::endl;
+            }
+
+            std::vector<std::string> numbers = exact_array_values(values, ",");
+
+            std::vector<double> val;
+            for (auto& number : numbers) {
+                val.push_back(std::stod(number));
+            }
+
+            ensemble_options.sweeps[sweep - str_sweeps.begin()] = val;
+        }
+        else {
+            std::cout << "ERROR: invalid input: " << a_word << std::endl;
+            std::cout << "Valid options are: " << std::endl;
+            for (const auto& element : str_ensemble_opts_inps) {
+                std::cout << element << std::endl;
+            }
+        }
+    } // end for words in ensemble options
+
+    // a sweep is one value per member or the [first, last] range
+    for (size_t var = 0; var < ensemble::num_fill_vars; var++) {
+        size_t num_vals = ensemble_options.sweeps[var].size();
+        if (num_vals != 0 && num_vals != 2 && num_vals != (size_t)ensemble_options.num_members) {
+            std::cout << "ERROR: ensemble sweep " << str_sweeps[var] << " has " << num_vals << " values" << std::endl;
+            std::cout << "Valid options are [first, last] or one value per member" << std::endl;
+            ensemble_options.sweeps[var].clear();
+        }
+    } // end for var
+} // end of function to parse ensemble options
+
+// =================================================================================
+//    Check the ensemble ids against the parsed regions and materials
+// =================================================================================
+void validate_ensemble_options(const simulation_parameters_t& sim_param)
+{
+    const ensemble_options_t& ensemble_options = sim_param.ensemble_options;
+
+    if (ensemble_options.num_members < 2) {
+        return;
+    }
+
+    int num_regions = sim_param.region_fills.size();
+    if (ensemble_options.region_id < 0 || ensemble_options.region_id >= num_regions) {
+        std::cout << "ERROR: ensemble region_id " << ensemble_options.region_id
+                  << " is not one of the " << num_regions << " regions" << std::endl;
+        throw std::runtime_error("**** INVALID ENSEMBLE REGION_ID ****");
+    }
+
+    if (ensemble_options.sweeps[ensemble::eos_var].empty()) {
+        return;
+    }
+
+    // the swept variable must be one of the EOS global variables of the region material
+    size_t mat_id = sim_param.region_fills(ensemble_options.region_id).material_id;
+    int    num_eos_global_vars = (mat_id < sim_param.eos_global_vars.size()) ? sim_param.eos_global_vars[mat_id].size() : 0;
+    if (ensemble_options.eos_var_id < 0 || ensemble_options.eos_var_id >= num_eos_global_vars) {
+        std::cout << "ERROR: ensemble eos_var_id " << ensemble_options.eos_var_id
+                  << " is not one of the " << num_eos_global_vars
+                  << " eos_global_vars of material " << mat_id << std::endl;
+        throw std::runtime_error("**** INVALID ENSEMBLE EOS_VAR_ID ****");
+    }
+} // end of function to validate ensemble options
+
 // =================================================================================
 //    Parse Mesh options
 // =================================================================================
@@ -630,6 +822,28 @@ void parse_mesh_input(Yaml::Node& root, mesh_input_t& mesh_input)
 
             mesh_input.p_order = p_order;
         } // polynomial order
+        // Space filling curve renumbering
+        else if (a_word.compare("renumber") == 0) {
+            std::string renumber = root["mesh_options"][a_word].As<std::string>();
+
+            auto map = mesh_input_renumber_map;
+
+            // set the renumbering type
+            if (map.find(renumber) != map.end()) {
+                mesh_input.renumber = map[renumber];
+                if (VERBOSE) {
+                    std::cout << "\trenumber = " << renumber << std::endl;
+                }
+            }
+            else{
+                std::cout << "ERROR: invalid mesh option input in YAML file: " << renumber << std::endl;
+                std::cout << "Valid options are: " << std::endl;
+
+                for (const auto& pair : map) {
+                    std::cout << "\t" << pair.first << std::endl;
+                }
+            } // end if
+        } // renumber
         // inner radius for 2D RZ meshes
         else if (a_word.compare("inner_radius") == 0) {
             double inner_radius = root["mesh_options"][a_word].As<double>();
@@ -53,6 +53,7 @@ struct material_t;
 struct output_options_t;
 struct boundary_condition_t;
 struct dynamic_options_t;
+struct ensemble_options_t;
 
 using namespace mtr;
 
@@ -84,6 +85,12 @@ void parse_solver_input(Yaml::Node& root, std::vector<solver_input_t>& solver_in
 // Parse dynamic time related options
 void parse_dynamic_options(Yaml::Node& root, dynamic_options_t& dynamic_options);
 
+// Parse the ensemble options
+void parse_ensemble_options(Yaml::Node& root, ensemble_options_t& ensemble_options);
+
+// Check the ensemble options against the parsed regions and materials
+void validate_ensemble_options(const simulation_parameters_t& sim_param);
+
 // Parse the mesh related data
 void parse_mesh_input(Yaml::Node& root, mesh_input_t& mesh_input);
 
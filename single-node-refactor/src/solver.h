@@ -35,6 +35,7 @@
 #ifndef FIERRO_SOLVER_H
 #define FIERRO_SOLVER_H
 
+#include <functional>
 #include <map>
 #include <memory>
 
@@ -44,6 +45,8 @@
 #include "region.h"
 #include "boundary_conditions.h"
 #include "io_utils.h"
+#include "perf_timers.h"
+#include "mpi_coms.h"
 
 struct simulation_parameters_t;
 
@@ -53,6 +56,13 @@ public:
 
     MeshWriter mesh_writer;
 
+    PerfTimers* timers = nullptr; // owned by the driver
+
+    mesh_comms_t* comms = nullptr; // owned by the driver, null on a single rank
+
+    // called after every cycle with (cycle, time, dt), returning false ends the calculation
+    std::function<bool(size_t, double, double)> cycle_callback;
+
     // ---------------------------------------------------------------------
     //    state data type declarations
     // ---------------------------------------------------------------------
@@ -19,6 +19,7 @@ struct Mesh {
     mtr::CArray<double> points;
     mtr::CArray<int> element_point_index;
     mtr::CArray<int> element_types;
+    mtr::CArray<int> element_materials; // Optional, one material id per element.
     int num_dim;
     int p_order;
 
@@ -3,8 +3,10 @@
 #include "Mesh.h"
 #include <memory>
 #include "MeshBuilderInput.h"
+#include "MeshIO.h"
 
 namespace MeshBuilder {
     Mesh build_mesh(std::shared_ptr<MeshBuilderInput> input);
+    Mesh build_voxel_mesh(const MeshIO::VoxelGrid& grid);
     void build_mesh_from_file(std::string mesh_file);
 }
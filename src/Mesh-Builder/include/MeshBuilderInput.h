@@ -18,7 +18,8 @@ namespace {
 
 SERIALIZABLE_ENUM(MeshType,
     Box,
-    Cylinder
+    Cylinder,
+    Voxel
 )
 
 SERIALIZABLE_ENUM(FileType,
@@ -48,6 +49,7 @@ struct MeshBuilderConfig {
     
     static inline std::string example_box();
     static inline std::string example_cylinder();
+    static inline std::string example_voxel();
 };
 YAML_ADD_REQUIRED_FIELDS_FOR(MeshBuilderConfig, input, output)
 IMPL_YAML_SERIALIZABLE_FOR(MeshBuilderConfig, input, output)
@@ -156,6 +158,27 @@ struct Input_Cylinder
 IMPL_YAML_SERIALIZABLE_WITH_BASE(Input_Cylinder, Input_Rectilinear, inner_radius, start_angle)
 
 
+/**
+ * \brief Hex mesh of the occupied voxels of a voxel file.
+ * 
+ * The voxel file is a VTK rectilinear grid with one cell scalar, 
+ * such as the output of fierro-voxelizer. Voxels with a value of 0 are void
+ * and are not meshed, any other value is the material id of the voxel.
+ * The origin is added to the coordinates of the voxel file.
+*/
+struct Input_Voxel
+    : MeshBuilderInput::Register<Input_Voxel, MeshType::Voxel> {
+
+    std::string voxel_file;
+
+    void validate() {
+        if (origin.size() != 3)
+            throw Yaml::ConfigurationException("Voxel meshes are 3D, the origin must have 3 values.");
+    }
+};
+YAML_ADD_REQUIRED_FIELDS_FOR(Input_Voxel, voxel_file)
+IMPL_YAML_SERIALIZABLE_WITH_BASE(Input_Voxel, MeshBuilderInput, voxel_file)
+
 inline std::string MeshBuilderConfig::example_box() {
     MeshBuilderConfig config;
     config.input = std::make_shared<Input_Rectilinear>();
@@ -167,3 +190,9 @@ inline std::string MeshBuilderConfig::example_cylinder() {
     config.input = std::make_shared<Input_Cylinder>();
     return Yaml::to_string(config);
 }
+
+inline std::string MeshBuilderConfig::example_voxel() {
+    MeshBuilderConfig config;
+    config.input = std::make_shared<Input_Voxel>();
+    return Yaml::to_string(config);
+}
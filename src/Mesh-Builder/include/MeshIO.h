@@ -1,5 +1,6 @@
 #pragma once
 #include "Mesh.h"
+#include <istream>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -20,11 +21,28 @@ namespace MeshIO {
         VTK
     };
 
+    /**
+     * \brief A rectilinear grid of voxels, as written by fierro-voxelizer.
+     *
+     * `x`, `y` and `z` are the voxel edge coordinates along each axis.
+     * `values` holds one value per voxel with x varying fastest,
+     * where 0 is void and any other value is the material id.
+    */
+    struct VoxelGrid {
+        std::vector<double> x, y, z;
+        std::vector<int> values;
+    };
+
     Mesh read_vtk(std::string filename, bool verbose=false);
     Mesh read_vtk(std::istream& in, bool verbose=false);
     void write_vtk(std::string filename, std::string file_location, const Mesh& mesh, bool verbose=false);
     void write_vtk(std::ostream& out, const Mesh& mesh);
 
+    VoxelGrid read_voxel_vtk(std::string filename);
+    VoxelGrid read_voxel_vtk(std::istream& in);
+    void write_voxel_vtk(std::string filename, std::string file_location, const VoxelGrid& grid, bool verbose=false);
+    void write_voxel_vtk(std::ostream& out, const VoxelGrid& grid);
+
     Mesh read_ensight(std::string filename, bool verbose=false);
     void write_ensight(std::string filename, const Mesh& mesh, bool verbose=false);
 
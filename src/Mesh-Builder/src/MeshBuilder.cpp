@@ -205,6 +205,101 @@ Mesh build_rectilinear(const Input_Rectilinear& input) {
     return mesh;
 }
 
+/**
+ * \brief Builds a linear hex mesh of only the occupied voxels of a voxel grid.
+ * 
+ * A point is created only if an occupied voxel uses it, and voxels that 
+ * touch share their points, so the mesh is conforming. The voxel values
+ * are kept as the element material ids.
+*/
+Mesh MeshBuilder::build_voxel_mesh(const MeshIO::VoxelGrid& grid) {
+    int num_points[3] = { (int)grid.x.size(), (int)grid.y.size(), (int)grid.z.size() };
+    int num_voxels[3] = { num_points[0] - 1, num_points[1] - 1, num_points[2] - 1 };
+
+    // --- Number the points of the occupied voxels ---
+    // a point id of -1 is not used by any occupied voxel
+    std::vector<int> point_ids(num_points[0] * num_points[1] * num_points[2], -1);
+    int num_elems = 0;
+    for (int k = 0; k < num_voxels[2]; k++) {
+        for (int j = 0; j < num_voxels[1]; j++) {
+            for (int i = 0; i < num_voxels[0]; i++) {
+                if (grid.values[get_id(i, j, k, num_voxels[0], num_voxels[1])] == 0)
+                    continue;
+
+                num_elems++;
+                for (int k_local = 0; k_local <= 1; k_local++)
+                    for (int j_local = 0; j_local <= 1; j_local++)
+                        for (int i_local = 0; i_local <= 1; i_local++)
+                            point_ids[get_id(i + i_local, j + j_local, k + k_local, num_points[0], num_points[1])] = 0;
+            }
+        }
+    }
+
+    // points are numbered in the (i,j,k) order of the grid
+    int total_points = 0;
+    for (auto& point_id : point_ids) {
+        if (point_id == 0)
+            point_id = total_points++;
+    }
+
+    auto mesh = Mesh();
+    mesh.num_dim = 3;
+    mesh.p_order = 1;
+    mesh.points = CArray <double> (total_points, 3);
+    mesh.element_point_index = CArray <int> (num_elems, 8);
+    mesh.element_types = CArray <int> (num_elems);
+    mesh.element_materials = CArray <int> (num_elems);
+
+    // --- Build nodes ---
+    for (int k = 0; k < num_points[2]; k++) {
+        for (int j = 0; j < num_points[1]; j++) {
+            for (int i = 0; i < num_points[0]; i++) {
+                int point_id = point_ids[get_id(i, j, k, num_points[0], num_points[1])];
+                if (point_id < 0)
+                    continue;
+
+                mesh.points(point_id, 0) = grid.x[i];
+                mesh.points(point_id, 1) = grid.y[j];
+                mesh.points(point_id, 2) = grid.z[k];
+            }
+        }
+    }
+
+    // --- Build elems ---
+    // the point ids of an elem are in the (i,j,k) order, the same as build_rectilinear
+    int elem_id = 0;
+    for (int k = 0; k < num_voxels[2]; k++) {
+        for (int j = 0; j < num_voxels[1]; j++) {
+            for (int i = 0; i < num_voxels[0]; i++) {
+                int material_id = grid.values[get_id(i, j, k, num_voxels[0], num_voxels[1])];
+                if (material_id == 0)
+                    continue;
+
+                int point_id_local = 0;
+                for (int k_local = 0; k_local <= 1; k_local++) {
+                    for (int j_local = 0; j_local <= 1; j_local++) {
+                        for (int i_local = 0; i_local <= 1; i_local++) {
+                            mesh.element_point_index(elem_id, point_id_local) = 
+                                point_ids[get_id(i + i_local, j + j_local, k + k_local, num_points[0], num_points[1])];
+                            point_id_local++;
+                        }
+                    }
+                }
+
+                mesh.element_types(elem_id) = 12; // Linear Hex
+                mesh.element_materials(elem_id) = material_id;
+                elem_id++;
+            }
+        }
+    }
+
+    std::cout << "Meshed " << num_elems << " of " 
+              << num_voxels[0] * num_voxels[1] * num_voxels[2] << " voxels with " 
+              << total_points << " points" << std::endl;
+
+    return mesh;
+}
+
 /**
  * \brief Given a mesh in cylindrical space, convert it to a mesh in rectilinear space.
  * 
@@ -242,6 +337,11 @@ Mesh MeshBuilder::build_mesh(std::shared_ptr<MeshBuilderInput> input) {
         mesh = build_rectilinear(*std::dynamic_pointer_cast<Input_Rectilinear>(input));
         cylinder_transform(mesh, *std::dynamic_pointer_cast<Input_Cylinder>(input));
         break;
+    case MeshType::Voxel:
+        mesh = build_voxel_mesh(
+            MeshIO::read_voxel_vtk(std::dynamic_pointer_cast<Input_Voxel>(input)->voxel_file)
+        );
+        break;
     default:
         throw std::runtime_error("Unsupported mesh shape.");
     }
@@ -265,4 +365,15 @@ void MeshBuilder::build_mesh_from_file(std::string mesh_file){
             MeshIO::write_vtk(config.output.name, config.output.file_location, mesh, true);
             break;
     }
+
+    // The solvers assign materials with region volumes rather than from the mesh file.
+    // Write the voxel grid moved to the mesh origin, so a vtk region volume
+    // with a voxel_value picks out the elements of each material.
+    if (config.input->type == MeshType::Voxel) {
+        auto grid = MeshIO::read_voxel_vtk(std::dynamic_pointer_cast<Input_Voxel>(config.input)->voxel_file);
+        for (auto& x : grid.x) x += config.input->origin[0];
+        for (auto& y : grid.y) y += config.input->origin[1];
+        for (auto& z : grid.z) z += config.input->origin[2];
+        MeshIO::write_voxel_vtk(config.output.name + "_materials", config.output.file_location, grid, true);
+    }
 }
@@ -106,6 +106,15 @@ namespace {
         for (size_t i = 0; i < num_elems; i++) {
             out << -i << std::endl;
         }
+
+        if (mesh.element_materials.size() > 0) {
+            out << std::endl;
+            out << "SCALARS " << "material_id " << "int " << "1" << std::endl;
+            out << "LOOKUP_TABLE " << "default " << std::endl;
+            for (size_t i = 0; i < num_elems; i++) {
+                out << mesh.element_materials(i) << std::endl;
+            }
+        }
     }
 
     template<typename T>
@@ -260,6 +269,115 @@ Mesh MeshIO::read_vtk(std::istream& in, bool verbose) {
     return mesh;
 }
 
+MeshIO::VoxelGrid MeshIO::read_voxel_vtk(std::istream& in) {
+    VoxelGrid grid;
+
+    // The voxel file is whitespace separated, so it is read a token at a time.
+    auto read_coordinates = [&](std::vector<double>& coords) {
+        size_t num_coords;
+        std::string type;
+        in >> num_coords >> type;
+        coords.resize(num_coords);
+        for (size_t i = 0; i < num_coords; i++)
+            in >> coords[i];
+    };
+
+    size_t num_cells = 0;
+    std::string token;
+    while (in >> token) {
+        if (token == "X_COORDINATES")
+            read_coordinates(grid.x);
+        else if (token == "Y_COORDINATES")
+            read_coordinates(grid.y);
+        else if (token == "Z_COORDINATES")
+            read_coordinates(grid.z);
+        else if (token == "CELL_DATA")
+            in >> num_cells;
+        else if (token == "LOOKUP_TABLE" && grid.values.size() == 0) {
+            // Only the first cell scalar is read.
+            std::string table_name;
+            in >> table_name;
+            grid.values.resize(num_cells);
+            for (size_t i = 0; i < num_cells; i++) {
+                double value;
+                in >> value;
+                grid.values[i] = (int)std::round(value);
+            }
+        }
+    }
+
+    if (grid.x.size() < 2 || grid.y.size() < 2 || grid.z.size() < 2)
+        throw std::runtime_error("Voxel file must hold X, Y and Z coordinates of a 3D rectilinear grid.");
+    
+    size_t num_voxels = (grid.x.size() - 1) * (grid.y.size() - 1) * (grid.z.size() - 1);
+    if (grid.values.size() != num_voxels)
+        throw std::runtime_error(
+            "Voxel file has " + std::to_string(grid.values.size()) 
+            + " cell values for " + std::to_string(num_voxels) + " voxels."
+        );
+
+    return grid;
+}
+
+MeshIO::VoxelGrid MeshIO::read_voxel_vtk(std::string filename) {
+    std::ifstream in(filename);
+    if (!in.is_open())
+        throw std::runtime_error("Could not open voxel file: " + filename);
+
+    auto grid = read_voxel_vtk(in);
+
+    in.close();
+    return grid;
+}
+
+/**
+ * \brief Writes a voxel grid in the same format as fierro-voxelizer.
+ * 
+ * The voxel values are written as the material_id cell scalar, all on one line,
+ * which is how the vtk volume of the solver regions reads them.
+*/
+void MeshIO::write_voxel_vtk(std::ostream& out, const VoxelGrid& grid) {
+    out << "# vtk DataFile Version 3.0" << std::endl;
+    out << "Voxel materials for Fierro" << std::endl;
+    out << "ASCII" << std::endl;
+    out << "DATASET RECTILINEAR_GRID" << std::endl;
+    out << "DIMENSIONS " << grid.x.size() << " " << grid.y.size() << " " << grid.z.size() << std::endl;
+
+    auto write_coordinates = [&](const char* name, const std::vector<double>& coords) {
+        out << name << " " << coords.size() << " float" << std::endl;
+        for (auto coord : coords)
+            out << coord << " ";
+        out << std::endl;
+    };
+    write_coordinates("X_COORDINATES", grid.x);
+    write_coordinates("Y_COORDINATES", grid.y);
+    write_coordinates("Z_COORDINATES", grid.z);
+
+    out << std::endl;
+    out << "CELL_DATA " << grid.values.size() << std::endl;
+    out << "SCALARS " << "material_id " << "int " << "1" << std::endl;
+    out << "LOOKUP_TABLE " << "default" << std::endl;
+    for (auto value : grid.values)
+        out << value << " ";
+    out << std::endl;
+}
+
+void MeshIO::write_voxel_vtk(std::string filename, std::string file_location, const VoxelGrid& grid, bool verbose) {
+    std::filesystem::path path;
+    if (file_location == "none"){
+        IOUtilities::mkdir("vtk");
+        path = std::filesystem::path("vtk") / (filename + ".vtk");
+    } else {
+        path = std::filesystem::path(file_location) / (filename + ".vtk");
+    }
+
+    std::ofstream out(path.c_str(), std::ofstream::out);
+    if (verbose)
+        std::cout << "Creating file: " << path.string() << std::endl;
+    write_voxel_vtk(out, grid);
+    out.close();
+}
+
 Mesh MeshIO::read_vtk(std::string filename, bool verbose) {
     std::ifstream in(filename);
     
@@ -26,6 +26,10 @@ int main(int argc, char *argv[]) {
         std::cout << "Example cylinder input file: " << std::endl;
         std::cout << MeshBuilderConfig::example_cylinder() << std::endl;
         return 0;
+    } else if (command == "Voxel") {
+        std::cout << "Example voxel input file: " << std::endl;
+        std::cout << MeshBuilderConfig::example_voxel() << std::endl;
+        return 0;
     }
     
     MeshBuilder::build_mesh_from_file(argv[1]);
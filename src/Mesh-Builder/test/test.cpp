@@ -105,4 +105,63 @@ TEST(MeshBuilder, ExampleBox) {
     Yaml::from_string_strict(MeshBuilderConfig::example_box(), in);
 
     EXPECT_EQ(in.input->type, MeshType::Box);
-}
\ No newline at end of file
+}
+TEST(MeshBuilder, ExampleVoxel) {
+    MeshBuilderConfig in;
+    Yaml::from_string_strict(MeshBuilderConfig::example_voxel(), in);
+
+    EXPECT_EQ(in.input->type, MeshType::Voxel);
+}
+
+TEST(MeshBuilder, VoxelOccupiedOnly) {
+    // 2x2x1 voxels with the (1, 1) voxel void, in the format written by fierro-voxelizer.
+    std::stringstream buffer(R"(# vtk DataFile Version 3.0
+Mesh for Fierro
+ASCII
+DATASET RECTILINEAR_GRID
+DIMENSIONS 3 3 2
+X_COORDINATES 3 float
+0 0.5 1
+Y_COORDINATES 3 float
+0 0.5 1
+Z_COORDINATES 2 float
+0 0.5
+CELL_DATA 4
+SCALARS density float 1
+LOOKUP_TABLE default
+1
+2
+1
+0
+)");
+
+    Mesh mesh = MeshBuilder::build_voxel_mesh(MeshIO::read_voxel_vtk(buffer));
+
+    // The 3 occupied voxels share their points, so only 8 of the 9 corners on each layer are used.
+    EXPECT_EQ(mesh.element_point_index.dims(0), 3);
+    EXPECT_EQ(mesh.points.dims(0), 16);
+    EXPECT_EQ(mesh.element_materials(0), 1);
+    EXPECT_EQ(mesh.element_materials(1), 2);
+    EXPECT_EQ(mesh.element_materials(2), 1);
+    
+    // The first two voxels share their +x/-x face.
+    EXPECT_EQ(mesh.element_point_index(0, 1), mesh.element_point_index(1, 0));
+    EXPECT_EQ(mesh.element_point_index(0, 7), mesh.element_point_index(1, 6));
+}
+
+TEST(MeshBuilder, VoxelWriteRead) {
+    MeshIO::VoxelGrid grid;
+    grid.x = { 0, 0.5, 1 };
+    grid.y = { 0, 0.5 };
+    grid.z = { 1, 1.5 };
+    grid.values = { 3, 0 };
+
+    std::stringstream buffer;
+    MeshIO::write_voxel_vtk(buffer, grid);
+    auto read_grid = MeshIO::read_voxel_vtk(buffer);
+
+    EXPECT_EQ(read_grid.x, grid.x);
+    EXPECT_EQ(read_grid.y, grid.y);
+    EXPECT_EQ(read_grid.z, grid.z);
+    EXPECT_EQ(read_grid.values, grid.values);
+}
@@ -38,6 +38,7 @@
 #include "Simulation_Parameters/Simulation_Parameters.h"
 
 #define BC_EPSILON 1.0e-8
+#define MAX_ELEM_NODES 8
 using namespace utils;
 
 FEA_Module::FEA_Module(Solver* Solver_Pointer)
@@ -122,12 +123,98 @@ FEA_Module::FEA_Module(Solver* Solver_Pointer)
 
     // output data
     noutput = 0;
+
+    // device quadrature tables are built on first use
+    quadrature_tables_init = false;
 }
 
 FEA_Module::~FEA_Module()
 {
 }
 
+/* ----------------------------------------------------------------------
+   Tabulate quadrature weights and basis values/derivatives for device kernels
+------------------------------------------------------------------------- */
+
+void FEA_Module::init_quadrature_tables()
+{
+    if (quadrature_tables_init)
+    {
+        return;
+    }
+
+    int nodes_per_elem = elem->num_basis();
+    int z_quad, y_quad, x_quad;
+    num_quadrature_points = std::pow(num_gauss_points, num_dim);
+
+    quadrature_weights = DCArrayKokkos<real_t>(num_quadrature_points, "quadrature_weights");
+    quadrature_basis_values = DCArrayKokkos<real_t>(num_quadrature_points, nodes_per_elem, "quadrature_basis_values");
+    quadrature_basis_derivatives = DCArrayKokkos<real_t>(num_quadrature_points, 3, nodes_per_elem, "quadrature_basis_derivatives");
+    quadrature_node_order = DCArrayKokkos<size_t>(nodes_per_elem, "quadrature_node_order");
+
+    CArray<real_t> legendre_nodes_1D(num_gauss_points);
+    CArray<real_t> legendre_weights_1D(num_gauss_points);
+    elements::legendre_nodes_1D(legendre_nodes_1D, num_gauss_points);
+    elements::legendre_weights_1D(legendre_weights_1D, num_gauss_points);
+
+    real_t pointer_quad_coordinate[3];
+    real_t pointer_basis_values[MAX_ELEM_NODES];
+    real_t pointer_basis_derivative_s1[MAX_ELEM_NODES];
+    real_t pointer_basis_derivative_s2[MAX_ELEM_NODES];
+    real_t pointer_basis_derivative_s3[MAX_ELEM_NODES];
+    ViewCArray<real_t> quad_coordinate(pointer_quad_coordinate, 3);
+    ViewCArray<real_t> basis_values(pointer_basis_values, nodes_per_elem);
+    ViewCArray<real_t> basis_derivative_s1(pointer_basis_derivative_s1, nodes_per_elem);
+    ViewCArray<real_t> basis_derivative_s2(pointer_basis_derivative_s2, nodes_per_elem);
+    ViewCArray<real_t> basis_derivative_s3(pointer_basis_derivative_s3, nodes_per_elem);
+
+    for (int iquad = 0; iquad < num_quadrature_points; iquad++)
+    {
+        // set current quadrature point
+        z_quad = iquad / (num_gauss_points * num_gauss_points);
+        y_quad = (iquad % (num_gauss_points * num_gauss_points)) / num_gauss_points;
+        x_quad = iquad % num_gauss_points;
+        quad_coordinate(0) = legendre_nodes_1D(x_quad);
+        quad_coordinate(1) = legendre_nodes_1D(y_quad);
+        quad_coordinate(2) = legendre_nodes_1D(z_quad);
+
+        quadrature_weights.host(iquad) = legendre_weights_1D(x_quad) * legendre_weights_1D(y_quad) * legendre_weights_1D(z_quad);
+
+        // compute shape functions and their derivatives at this point for the element type
+        elem->basis(basis_values, quad_coordinate);
+        elem->partial_xi_basis(basis_derivative_s1, quad_coordinate);
+        elem->partial_eta_basis(basis_derivative_s2, quad_coordinate);
+        elem->partial_mu_basis(basis_derivative_s3, quad_coordinate);
+
+        for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+        {
+            quadrature_basis_values.host(iquad, node_loop) = basis_values(node_loop);
+            quadrature_basis_derivatives.host(iquad, 0, node_loop) = basis_derivative_s1(node_loop);
+            quadrature_basis_derivatives.host(iquad, 1, node_loop) = basis_derivative_s2(node_loop);
+            quadrature_basis_derivatives.host(iquad, 2, node_loop) = basis_derivative_s3(node_loop);
+        }
+    }
+
+    // basis functions follow ijk ordering; connectivity may be stored in ensight order
+    for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+    {
+        quadrature_node_order.host(node_loop) = node_loop;
+    }
+    if (Solver_Pointer_->active_node_ordering_convention == Solver::ENSIGHT && nodes_per_elem == 8)
+    {
+        quadrature_node_order.host(2) = 3;
+        quadrature_node_order.host(3) = 2;
+        quadrature_node_order.host(6) = 7;
+        quadrature_node_order.host(7) = 6;
+    }
+
+    quadrature_weights.update_device();
+    quadrature_basis_values.update_device();
+    quadrature_basis_derivatives.update_device();
+    quadrature_node_order.update_device();
+    quadrature_tables_init = true;
+}
+
 /* ----------------------------------------------------------------------
    find which boundary patches correspond to the given BC.
    bc_tag = 0 xplane, 1 yplane, 2 zplane, 3 cylinder, 4 is shell
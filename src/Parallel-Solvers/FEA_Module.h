@@ -158,6 +158,8 @@ public:
 
     virtual void update_forward_solve(Teuchos::RCP<const MV> zp) {}
 
+    void init_quadrature_tables();
+
     virtual void local_matrix(int ielem, CArrayKokkos<real_t, array_layout, device_type, memory_traits>& Local_Matrix) {}
 
     virtual void local_matrix_multiply(int ielem, CArrayKokkos<real_t, array_layout, device_type, memory_traits>& Local_Matrix) {}
@@ -323,6 +325,14 @@ public:
     int  penalty_power;
     bool nodal_density_flag;
 
+    // basis tables at the quadrature points for the device kernels; filled once from the host element
+    bool quadrature_tables_init;
+    int  num_quadrature_points;
+    DCArrayKokkos<real_t> quadrature_weights; // (quadrature point)
+    DCArrayKokkos<real_t> quadrature_basis_values; // (quadrature point, basis)
+    DCArrayKokkos<real_t> quadrature_basis_derivatives; // (quadrature point, reference direction, basis)
+    DCArrayKokkos<size_t> quadrature_node_order; // basis index to element connectivity index
+
     // runtime and counters for performance output
     double linear_solve_time, hessvec_time, hessvec_linear_time;
     int    update_count, hessvec_count;
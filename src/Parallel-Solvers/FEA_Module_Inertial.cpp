@@ -599,9 +599,9 @@ void FEA_Module_Inertial::compute_nodal_gradients(const_host_vec_array design_va
             // assign contribution to every local node this element has
             for (int node_loop = 0; node_loop < elem->num_basis(); node_loop++)
             {
-                if (map->isNodeGlobalElement(nodes_in_elem(ielem, node_loop)))
+                if (map->isNodeGlobalElement(nodes_in_elem(ielem, convert_node_order(node_loop))))
                 {
-                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, node_loop));
+                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, convert_node_order(node_loop)));
                     design_gradients(local_node_id, 0) += weight_multiply * basis_values(node_loop) * Jacobian;
                 }
             }
@@ -609,6 +609,216 @@ void FEA_Module_Inertial::compute_nodal_gradients(const_host_vec_array design_va
     }
 }
 
+/* ----------------------------------------------------------------------
+   Compute the mass of each element on the device from device views of the
+   design; estimated with quadrature
+------------------------------------------------------------------------- */
+
+void FEA_Module_Inertial::compute_element_masses(const_vec_array design_densities, bool max_flag, bool use_initial_coords)
+{
+    // local number of uniquely assigned elements
+    size_t nonoverlap_nelements = element_map->getLocalNumElements();
+    int    nodes_per_elem = elem->num_basis();
+
+    // tables only cover linear 3D elements; others go through the host path
+    if (num_dim != 3 || nodes_per_elem > MAX_ELEM_NODES)
+    {
+        auto host_design_densities = Kokkos::create_mirror_view_and_copy(HostSpace(), design_densities);
+        compute_element_masses(const_host_vec_array(host_design_densities), max_flag, use_initial_coords);
+        return;
+    }
+
+    vec_array Element_Masses = Global_Element_Masses->getLocalView<device_type>(Tpetra::Access::ReadWrite);
+
+    if (!nodal_density_flag)
+    {
+        compute_element_volumes();
+        const_vec_array Element_Volumes = Global_Element_Volumes->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+        FOR_ALL_CLASS(nonoverlapping_ielem, 0, nonoverlap_nelements, {
+            Element_Masses(nonoverlapping_ielem, 0) = Element_Volumes(nonoverlapping_ielem, 0) * design_densities(nonoverlapping_ielem, 0);
+        }); // end parallel for
+        Kokkos::fence();
+        return;
+    }
+
+    init_quadrature_tables();
+
+    const_vec_array all_node_coords;
+    if (use_initial_coords)
+    {
+        all_node_coords = all_initial_node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+    }
+    else
+    {
+        all_node_coords = all_node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+    }
+    const_vec_array       all_design_densities = all_node_densities_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+    const_elem_conn_array nodes_in_elem = global_nodes_in_elem_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+
+    auto element_local_map     = element_map->getLocalMap();
+    auto all_element_local_map = all_element_map->getLocalMap();
+    auto all_node_local_map    = all_node_map->getLocalMap();
+    const int num_quad = num_quadrature_points;
+
+    // loop over elements and use quadrature rule to compute mass from Jacobian determinant
+    FOR_ALL_CLASS(nonoverlapping_ielem, 0, nonoverlap_nelements, {
+        LO ielem = all_element_local_map.getLocalElement(element_local_map.getGlobalElement(nonoverlapping_ielem));
+        real_t nodal_positions[MAX_ELEM_NODES][3];
+        real_t nodal_density[MAX_ELEM_NODES];
+
+        // acquire set of nodes for this local element
+        for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+        {
+            LO local_node_id = all_node_local_map.getLocalElement(nodes_in_elem(ielem, quadrature_node_order(node_loop)));
+            for (int idim = 0; idim < 3; idim++)
+            {
+                nodal_positions[node_loop][idim] = all_node_coords(local_node_id, idim);
+            }
+            nodal_density[node_loop] = all_design_densities(local_node_id, 0);
+        }
+
+        real_t element_mass = 0;
+        for (int iquad = 0; iquad < num_quad; iquad++)
+        {
+            // transpose of the Jacobian; row i holds derivatives of x,y,z w.r.t reference direction i
+            real_t JT[3][3] = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+            for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+            {
+                for (int irow = 0; irow < 3; irow++)
+                {
+                    for (int idim = 0; idim < 3; idim++)
+                    {
+                        JT[irow][idim] += nodal_positions[node_loop][idim] * quadrature_basis_derivatives(iquad, irow, node_loop);
+                    }
+                }
+            }
+
+            // compute the determinant of the Jacobian
+            real_t Jacobian = JT[0][0] * (JT[1][1] * JT[2][2] - JT[2][1] * JT[1][2]) -
+                              JT[0][1] * (JT[1][0] * JT[2][2] - JT[2][0] * JT[1][2]) +
+                              JT[0][2] * (JT[1][0] * JT[2][1] - JT[2][0] * JT[1][1]);
+            if (Jacobian < 0)
+            {
+                Jacobian = -Jacobian;
+            }
+
+            // compute density
+            real_t current_density = 0;
+            if (max_flag)
+            {
+                current_density = 1;
+            }
+            else
+            {
+                for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+                {
+                    current_density += nodal_density[node_loop] * quadrature_basis_values(iquad, node_loop);
+                }
+            }
+
+            element_mass += current_density * quadrature_weights(iquad) * Jacobian;
+        }
+        Element_Masses(nonoverlapping_ielem, 0) = element_mass;
+    }); // end parallel for
+    Kokkos::fence();
+}
+
+/* ----------------------------------------------------------------------
+   Compute the gradients of mass function with respect to nodal densities
+   on the device from device views of the design
+------------------------------------------------------------------------- */
+
+void FEA_Module_Inertial::compute_nodal_gradients(const_vec_array design_variables, vec_array design_gradients, bool use_initial_coords)
+{
+    int nodes_per_elem = elem->num_basis();
+
+    // tables only cover linear 3D elements; others go through the host path
+    if (num_dim != 3 || nodes_per_elem > MAX_ELEM_NODES)
+    {
+        auto host_design_variables = Kokkos::create_mirror_view_and_copy(HostSpace(), design_variables);
+        auto host_design_gradients = Kokkos::create_mirror_view(HostSpace(), design_gradients);
+        compute_nodal_gradients(const_host_vec_array(host_design_variables), host_vec_array(host_design_gradients), use_initial_coords);
+        Kokkos::deep_copy(design_gradients, host_design_gradients);
+        return;
+    }
+
+    init_quadrature_tables();
+
+    const_vec_array all_node_coords;
+    if (use_initial_coords)
+    {
+        all_node_coords = all_initial_node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+    }
+    else
+    {
+        all_node_coords = all_node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+    }
+    const_elem_conn_array nodes_in_elem = global_nodes_in_elem_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+
+    auto all_node_local_map = all_node_map->getLocalMap();
+    auto node_local_map     = map->getLocalMap();
+    const LO  invalid_index = Teuchos::OrdinalTraits<LO>::invalid();
+    const int num_quad = num_quadrature_points;
+
+    // initialize design gradients to 0
+    FOR_ALL_CLASS(init, 0, nlocal_nodes, {
+        design_gradients(init, 0) = 0;
+    }); // end parallel for
+    Kokkos::fence();
+
+    // loop over elements and scatter each quadrature contribution to the locally owned nodes
+    FOR_ALL_CLASS(ielem, 0, rnum_elem, {
+        real_t nodal_positions[MAX_ELEM_NODES][3];
+
+        // acquire set of nodes for this local element
+        for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+        {
+            LO local_node_id = all_node_local_map.getLocalElement(nodes_in_elem(ielem, quadrature_node_order(node_loop)));
+            for (int idim = 0; idim < 3; idim++)
+            {
+                nodal_positions[node_loop][idim] = all_node_coords(local_node_id, idim);
+            }
+        }
+
+        for (int iquad = 0; iquad < num_quad; iquad++)
+        {
+            // transpose of the Jacobian; row i holds derivatives of x,y,z w.r.t reference direction i
+            real_t JT[3][3] = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+            for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+            {
+                for (int irow = 0; irow < 3; irow++)
+                {
+                    for (int idim = 0; idim < 3; idim++)
+                    {
+                        JT[irow][idim] += nodal_positions[node_loop][idim] * quadrature_basis_derivatives(iquad, irow, node_loop);
+                    }
+                }
+            }
+
+            // compute the determinant of the Jacobian
+            real_t Jacobian = JT[0][0] * (JT[1][1] * JT[2][2] - JT[2][1] * JT[1][2]) -
+                              JT[0][1] * (JT[1][0] * JT[2][2] - JT[2][0] * JT[1][2]) +
+                              JT[0][2] * (JT[1][0] * JT[2][1] - JT[2][0] * JT[1][1]);
+            if (Jacobian < 0)
+            {
+                Jacobian = -Jacobian;
+            }
+
+            // assign contribution to every local node this element has
+            for (int node_loop = 0; node_loop < nodes_per_elem; node_loop++)
+            {
+                LO local_node_id = node_local_map.getLocalElement(nodes_in_elem(ielem, quadrature_node_order(node_loop)));
+                if (local_node_id != invalid_index)
+                {
+                    Kokkos::atomic_add(&design_gradients(local_node_id, 0),
+                                       quadrature_weights(iquad) * quadrature_basis_values(iquad, node_loop) * Jacobian);
+                }
+            }
+        }
+    }); // end parallel for
+    Kokkos::fence();
+}
+
 /* ------------------------------------------------------------------------------------------------------------------------
    Compute the moment of each element for a specified component; estimated with quadrature
 --------------------------------------------------------------------------------------------------------------------------- */
@@ -1190,9 +1400,9 @@ void FEA_Module_Inertial::compute_moment_gradients(const_host_vec_array design_v
             // assign contribution to every local node this element has
             for (int node_loop = 0; node_loop < elem->num_basis(); node_loop++)
             {
-                if (map->isNodeGlobalElement(nodes_in_elem(ielem, node_loop)))
+                if (map->isNodeGlobalElement(nodes_in_elem(ielem, convert_node_order(node_loop))))
                 {
-                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, node_loop));
+                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, convert_node_order(node_loop)));
                     design_gradients(local_node_id, 0) += weight_multiply * basis_values(node_loop) * current_position(moment_component) * Jacobian;
                 }
             }
@@ -1878,9 +2088,9 @@ void FEA_Module_Inertial::compute_moment_of_inertia_gradients(const_host_vec_arr
             // assign contribution to every local node this element has
             for (int node_loop = 0; node_loop < elem->num_basis(); node_loop++)
             {
-                if (map->isNodeGlobalElement(nodes_in_elem(ielem, node_loop)))
+                if (map->isNodeGlobalElement(nodes_in_elem(ielem, convert_node_order(node_loop))))
                 {
-                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, node_loop));
+                    local_node_id = map->getLocalElement(nodes_in_elem(ielem, convert_node_order(node_loop)));
                     if (inertia_component == 0)
                     {
                         delx1 = current_position(1) - inertia_center[1];
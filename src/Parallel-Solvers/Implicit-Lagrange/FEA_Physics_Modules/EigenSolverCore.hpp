@@ -0,0 +1,109 @@
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef EIGEN_SOLVER_CORE_HPP
+#define EIGEN_SOLVER_CORE_HPP
+
+//Trilinos
+#include <Teuchos_ParameterList.hpp>
+#include <Tpetra_Operator.hpp>
+#include <Tpetra_MultiVector.hpp>
+#include <Tpetra_CrsMatrix.hpp>
+#include <BelosLinearProblem.hpp>
+#include <BelosSolverFactory.hpp>
+#include <BelosTpetraAdapter.hpp>
+
+/* ----------------------------------------------------------------------
+   Shift-invert spectral transformation for the generalized problem
+   K x = lambda M x. Applies (K - sigma M)^{-1} M using a preconditioned
+   Krylov solve, so the eigenvalues closest to sigma become the largest
+   magnitude eigenvalues theta = 1/(lambda - sigma) of this operator.
+------------------------------------------------------------------------- */
+
+template<class Scalar, class LocalOrdinal, class GlobalOrdinal, class Node>
+class ShiftInvertOperator : public Tpetra::Operator<Scalar,LocalOrdinal,GlobalOrdinal,Node> {
+public:
+  typedef Tpetra::MultiVector<Scalar,LocalOrdinal,GlobalOrdinal,Node> vector_type;
+  typedef Tpetra::Operator<Scalar,LocalOrdinal,GlobalOrdinal,Node> operator_type;
+  typedef Tpetra::Map<LocalOrdinal,GlobalOrdinal,Node> map_type;
+
+  ShiftInvertOperator(Teuchos::RCP<const operator_type> shifted_K, Teuchos::RCP<const operator_type> M,
+                      Teuchos::RCP<operator_type> prec, int maxIts, double tol) :
+                      shifted_K_(shifted_K), M_(M), prec_(prec) {
+    belosList_ = Teuchos::parameterList();
+    belosList_->set("Maximum Iterations",    maxIts);
+    belosList_->set("Convergence Tolerance", tol);
+    Belos::SolverFactory<Scalar,vector_type,operator_type> solverFactory;
+    solver_ = solverFactory.create("Pseudo Block CG", belosList_);
+  }
+
+  Teuchos::RCP<const map_type> getDomainMap() const override { return M_->getDomainMap(); }
+
+  Teuchos::RCP<const map_type> getRangeMap() const override { return shifted_K_->getRangeMap(); }
+
+  void apply(const vector_type &X, vector_type &Y, Teuchos::ETransp mode = Teuchos::NO_TRANS,
+             Scalar alpha = Teuchos::ScalarTraits<Scalar>::one(),
+             Scalar beta = Teuchos::ScalarTraits<Scalar>::zero()) const override {
+    size_t num_vectors = X.getNumVectors();
+    Teuchos::RCP<vector_type> MX = Teuchos::rcp(new vector_type(M_->getRangeMap(), num_vectors));
+    Teuchos::RCP<vector_type> solution = Teuchos::rcp(new vector_type(shifted_K_->getDomainMap(), num_vectors));
+    M_->apply(X, *MX);
+
+    //each column of the block is an independent solve against the same hierarchy
+    Teuchos::RCP<Belos::LinearProblem<Scalar,vector_type,operator_type>> problem =
+      Teuchos::rcp(new Belos::LinearProblem<Scalar,vector_type,operator_type>(shifted_K_, solution, MX));
+    if(!prec_.is_null()) problem->setRightPrec(prec_);
+    problem->setProblem();
+    solver_->setProblem(problem);
+    solver_->solve();
+    total_iterations_ += solver_->getNumIters();
+
+    Y.update(alpha, *solution, beta);
+  }
+
+  int getTotalIterations() const { return total_iterations_; }
+
+private:
+  Teuchos::RCP<const operator_type> shifted_K_;
+  Teuchos::RCP<const operator_type> M_;
+  Teuchos::RCP<operator_type> prec_;
+  Teuchos::RCP<Teuchos::ParameterList> belosList_;
+  Teuchos::RCP<Belos::SolverManager<Scalar,vector_type,operator_type>> solver_;
+  mutable int total_iterations_ = 0;
+};
+
+#endif // end EIGEN_SOLVER_CORE_HPP
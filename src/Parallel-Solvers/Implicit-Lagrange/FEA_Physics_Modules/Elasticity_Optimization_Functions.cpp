@@ -92,6 +92,7 @@
 #include <MueLu_ParameterListInterpreter.hpp>
 #include <MueLu_Utilities.hpp>
 #include <DriverCore.hpp>
+#include <MixedPrecisionCore.hpp>
 
 #define MAX_ELEM_NODES 8
 #define STRAIN_EPSILON 0.000000001
@@ -189,8 +190,6 @@ void FEA_Module_Elasticity::compute_displacement_constraint_gradients(const_host
     adjoints_allocated = true;
   }
   Teuchos::RCP<MV> lambda = adjoint_displacements_distributed;
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xlambda = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(lambda));
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xB = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(adjoint_equation_RHS_distributed));
   
   host_vec_array adjoint_equation_RHS_view = adjoint_equation_RHS_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
   
@@ -217,47 +216,11 @@ void FEA_Module_Elasticity::compute_displacement_constraint_gradients(const_host
   //Global_Nodal_RHS->describe(*fos,Teuchos::VERB_EXTREME);
 
   //assign reduced stiffness matrix entries for linear solver
-  if(!matrix_bc_reduced){
-  LO stride_index;
-  for(LO i=0; i < local_nrows; i++){
-    if((Node_DOF_Boundary_Condition_Type(i)==DISPLACEMENT_CONDITION)){
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        Original_Stiffness_Entries(i,j) = Stiffness_Matrix(i,j);
-        Original_Stiffness_Entry_Indices(i,j) = j;
-        if(local_dof_id == i){
-          Stiffness_Matrix(i,j) = 1;
-        }
-        else{     
-          Stiffness_Matrix(i,j) = 0;
-        }
-      }//stride for
-    }
-    else{
-      stride_index = 0;
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        if((Node_DOF_Boundary_Condition_Type(local_dof_id)==DISPLACEMENT_CONDITION)){
-          Original_Stiffness_Entries(i,stride_index) = Stiffness_Matrix(i,j);
-          Original_Stiffness_Entry_Indices(i,stride_index) = j;   
-          Stiffness_Matrix(i,j) = 0;
-          stride_index++;
-        }
-      }
-    }
-  }//row for
-  
-  matrix_bc_reduced = true;
-  }
+  reduce_bc_matrix();
   
   //solve for adjoint vector
   int num_iter = 2000;
   double solve_tol = 1e-05;
-  int cacheSize = 0;
-  std::string solveType         = "belos";
-  std::string belosType         = "cg";
   // =========================================================================
   // Preconditioner construction
   // =========================================================================
@@ -280,7 +243,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_gradients(const_host
   // }
   real_t current_cpu_time2 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xlambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  linear_solve(lambda, adjoint_equation_RHS_distributed, num_iter, solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time2;
 
@@ -646,15 +609,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_gradients(const_host
   }
   
   //restore values of K for any scalar or matrix vector products
-  if(matrix_bc_reduced){
-    for(LO i = 0; i < local_nrows; i++){
-      for(LO j = 0; j < Original_Stiffness_Entries_Strides(i); j++){
-        access_index = Original_Stiffness_Entry_Indices(i,j);
-        Stiffness_Matrix(i,access_index) = Original_Stiffness_Entries(i,j);
-      }
-    }//row for
-    matrix_bc_reduced = false;
-  }
+  restore_bc_matrix();
 
 }
 
@@ -695,10 +650,6 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   }
 
   Teuchos::RCP<MV> lambda = adjoint_displacements_distributed;
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xlambda = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(lambda));
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xpsi_lambda = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(psi_adjoint_vector_distributed));
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xphi_lambda = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(phi_adjoint_vector_distributed));
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xB = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(adjoint_equation_RHS_distributed));
   
   host_vec_array adjoint_equation_RHS_view = adjoint_equation_RHS_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
   
@@ -795,47 +746,11 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   //Global_Nodal_RHS->describe(*fos,Teuchos::VERB_EXTREME);
 
   //assign reduced stiffness matrix entries for linear solver
-  if(!matrix_bc_reduced){
-  LO stride_index;
-  for(LO i=0; i < local_nrows; i++){
-    if((Node_DOF_Boundary_Condition_Type(i)==DISPLACEMENT_CONDITION)){
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        Original_Stiffness_Entries(i,j) = Stiffness_Matrix(i,j);
-        Original_Stiffness_Entry_Indices(i,j) = j;
-        if(local_dof_id == i){
-          Stiffness_Matrix(i,j) = 1;
-        }
-        else{     
-          Stiffness_Matrix(i,j) = 0;
-        }
-      }//stride for
-    }
-    else{
-      stride_index = 0;
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        if((Node_DOF_Boundary_Condition_Type(local_dof_id)==DISPLACEMENT_CONDITION)){
-          Original_Stiffness_Entries(i,stride_index) = Stiffness_Matrix(i,j);
-          Original_Stiffness_Entry_Indices(i,stride_index) = j;   
-          Stiffness_Matrix(i,j) = 0;
-          stride_index++;
-        }
-      }
-    }
-  }//row for
-  
-  matrix_bc_reduced = true;
-  }
+  reduce_bc_matrix();
   
   //solve for adjoint vector
   int num_iter = 2000;
   double solve_tol = 1e-05;
-  int cacheSize = 0;
-  std::string solveType         = "belos";
-  std::string belosType         = "cg";
   // =========================================================================
   // Preconditioner construction
   // =========================================================================
@@ -858,7 +773,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   // }
   real_t current_cpu_time2 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xlambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  linear_solve(lambda, adjoint_equation_RHS_distributed, num_iter, solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time2;
 
@@ -1233,7 +1148,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   // }
   real_t current_cpu_time3 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xpsi_lambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  linear_solve(psi_adjoint_vector_distributed, adjoint_equation_RHS_distributed, num_iter, solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time3;
 
@@ -1604,7 +1519,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   // }
   real_t current_cpu_time4 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xphi_lambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  linear_solve(phi_adjoint_vector_distributed, adjoint_equation_RHS_distributed, num_iter, solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time4;
 
@@ -2057,15 +1972,7 @@ void FEA_Module_Elasticity::compute_displacement_constraint_hessian_vec(const_ho
   }//end element loop for hessian vector product
 
   //restore values of K for any scalar or matrix vector products
-  if(matrix_bc_reduced){
-    for(LO i = 0; i < local_nrows; i++){
-      for(LO j = 0; j < Original_Stiffness_Entries_Strides(i); j++){
-        access_index = Original_Stiffness_Entry_Indices(i,j);
-        Stiffness_Matrix(i,access_index) = Original_Stiffness_Entries(i,j);
-      }
-    }//row for
-    matrix_bc_reduced = false;
-  }
+  restore_bc_matrix();
 
   hessvec_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time;
 }
@@ -57,6 +57,7 @@
 #include <Tpetra_Map.hpp>
 #include <Tpetra_MultiVector.hpp>
 #include <Tpetra_CrsMatrix.hpp>
+#include <TpetraExt_MatrixMatrix.hpp>
 #include "Tpetra_Details_makeColMap.hpp"
 #include "Tpetra_Details_DefaultTypes.hpp"
 #include "Tpetra_Details_FixedHashTable.hpp"
@@ -92,6 +93,8 @@
 #include <MueLu_ParameterListInterpreter.hpp>
 #include <MueLu_Utilities.hpp>
 #include <DriverCore.hpp>
+#include <MixedPrecisionCore.hpp>
+#include <EigenSolverCore.hpp>
 
 //Eigensolver
 #include "AnasaziConfigDefs.hpp"
@@ -100,6 +103,7 @@
 #include "AnasaziBasicEigenproblem.hpp"
 #include "AnasaziBlockDavidsonSolMgr.hpp"
 #include "AnasaziBlockKrylovSchurSolMgr.hpp"
+#include "AnasaziLOBPCGSolMgr.hpp"
 
 #define MAX_ELEM_NODES 8
 #define STRAIN_EPSILON 0.000000001
@@ -123,6 +127,10 @@ FEA_Module_Elasticity::FEA_Module_Elasticity(
 
   module_params = &in_params;
   simparam = &Implicit_Solver_Pointer_->simparam;
+#ifndef HAVE_TPETRA_INST_FLOAT
+  if(module_params->mixed_precision_preconditioner)
+    throw std::runtime_error("mixed_precision_preconditioner requires Trilinos built with float scalar instantiation (Tpetra_INST_FLOAT=ON)");
+#endif
   
   //TO parameters
   penalty_power = simparam->optimization_options.simp_penalty_power;
@@ -140,7 +148,8 @@ FEA_Module_Elasticity::FEA_Module_Elasticity(
   linear_solve_time = hessvec_time = hessvec_linear_time = 0;
 
   //preconditioner construction
-  Eigen_Hierarchy_Constructed = Hierarchy_Constructed = false;
+  Hierarchy_Constructed = false;
+  direct_factorization_current = false;
 
   gradient_print_sync = 0;
 
@@ -1858,6 +1867,8 @@ void FEA_Module_Elasticity::assemble_matrix(){
   }
 
   matrix_bc_reduced = false;
+  //new matrix values; the direct solver factors have to be recomputed
+  direct_factorization_current = false;
 
   
   Teuchos::RCP<const Tpetra::Map<LO,GO,node_type> > colmap = Global_Stiffness_Matrix->getCrsGraph()->getColMap();
@@ -4232,6 +4243,238 @@ void FEA_Module_Elasticity::compute_adjoint_gradients(const_host_vec_array desig
 
 }
 
+/* ----------------------------------------------------------------------
+   Compute the gradient of strain energy with respect to nodal densities
+   on the device from device views of the design
+------------------------------------------------------------------------- */
+
+void FEA_Module_Elasticity::compute_adjoint_gradients(const_vec_array design_variables, vec_array design_gradients){
+  int nodes_per_elem = elem->num_basis();
+
+  //tables only cover linear 3D elements with nodal densities; others go through the host path
+  if(num_dim != 3 || nodes_per_elem > MAX_ELEM_NODES || !nodal_density_flag){
+    auto host_design_variables = Kokkos::create_mirror_view_and_copy(HostSpace(), design_variables);
+    auto host_design_gradients = Kokkos::create_mirror_view(HostSpace(), design_gradients);
+    compute_adjoint_gradients(const_host_vec_array(host_design_variables), host_vec_array(host_design_gradients));
+    Kokkos::deep_copy(design_gradients, host_design_gradients);
+    return;
+  }
+
+  init_quadrature_tables();
+
+  const_vec_array all_node_coords = all_node_coords_distributed->getLocalView<device_type> (Tpetra::Access::ReadOnly);
+  const_vec_array all_node_displacements = all_node_displacements_distributed->getLocalView<device_type> (Tpetra::Access::ReadOnly);
+  const_vec_array all_node_densities = all_node_densities_distributed->getLocalView<device_type> (Tpetra::Access::ReadOnly);
+  const_elem_conn_array nodes_in_elem = global_nodes_in_elem_distributed->getLocalView<device_type> (Tpetra::Access::ReadOnly);
+
+  auto all_node_local_map = all_node_map->getLocalMap();
+  auto all_dof_local_map = all_dof_map->getLocalMap();
+  auto node_local_map = map->getLocalMap();
+  const LO invalid_index = Teuchos::OrdinalTraits<LO>::invalid();
+  const int num_quad = num_quadrature_points;
+
+  //material parameters of Gradient_Element_Material_Properties and its anisotropic form
+  real_t unit_scaling = simparam->get_unit_scaling();
+  const real_t density_epsilon = simparam->optimization_options.density_epsilon;
+  const bool SIMP_modulus = module_params->material.SIMP_modulus;
+  const bool linear_cell_modulus = module_params->material.linear_cell_modulus;
+  const bool anisotropic_lattice = module_params->anisotropic_lattice;
+  const int simp_power = penalty_power;
+  const real_t modulus_scale = 1/unit_scaling/unit_scaling;
+  const real_t elastic_modulus = module_params->material.elastic_modulus;
+  const real_t poisson_ratio = module_params->material.poisson_ratio;
+  const real_t modulus_density_slope = module_params->material.modulus_density_slope;
+  const real_t shear_modulus_density_slope = module_params->material.shear_modulus_density_slope;
+  real_t elastic_moduli[3], shear_moduli[3], poisson_ratios[3];
+  for(int idim = 0; idim < 3; idim++){
+    elastic_moduli[idim] = module_params->material.elastic_moduli[idim];
+    shear_moduli[idim] = module_params->material.shear_moduli[idim];
+    poisson_ratios[idim] = module_params->material.poisson_ratios[idim];
+  }
+
+  //gradient of the body force, see Gradient_Body_Term
+  const bool body_term = body_term_flag;
+  real_t gradient_force_density[3] = {0, 0, 0};
+  if(body_term && gravity_flag){
+    for(int idim = 0; idim < 3; idim++)
+      gradient_force_density[idim] = gravity_vector[idim];
+  }
+
+  //initialize gradient value to zero
+  FOR_ALL_CLASS(inode, 0, nlocal_nodes, {
+    design_gradients(inode,0) = 0;
+  }); // end parallel for
+  Kokkos::fence();
+
+  //loop through each element and assign the contribution to compliance gradient for each of its local nodes
+  FOR_ALL_CLASS(ielem, 0, rnum_elem, {
+    real_t nodal_positions[MAX_ELEM_NODES][3];
+    real_t nodal_displacements[MAX_ELEM_NODES][3];
+    real_t nodal_density[MAX_ELEM_NODES];
+
+    //acquire set of nodes, nodal displacements and densities for this local element
+    for(int node_loop = 0; node_loop < nodes_per_elem; node_loop++){
+      GO node_gid = nodes_in_elem(ielem, quadrature_node_order(node_loop));
+      LO local_node_id = all_node_local_map.getLocalElement(node_gid);
+      LO local_dof_id = all_dof_local_map.getLocalElement(node_gid*3);
+      for(int idim = 0; idim < 3; idim++){
+        nodal_positions[node_loop][idim] = all_node_coords(local_node_id,idim);
+        nodal_displacements[node_loop][idim] = all_node_displacements(local_dof_id + idim,0);
+      }
+      nodal_density[node_loop] = all_node_densities(local_node_id,0);
+    }
+
+    for(int iquad = 0; iquad < num_quad; iquad++){
+      //transpose of the Jacobian; row i holds derivatives of x,y,z w.r.t reference direction i
+      real_t JT[3][3] = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+      for(int node_loop = 0; node_loop < nodes_per_elem; node_loop++){
+        for(int irow = 0; irow < 3; irow++){
+          for(int idim = 0; idim < 3; idim++){
+            JT[irow][idim] += nodal_positions[node_loop][idim]*quadrature_basis_derivatives(iquad, irow, node_loop);
+          }
+        }
+      }
+
+      //compute the determinant of the Jacobian
+      real_t Jacobian = JT[0][0]*(JT[1][1]*JT[2][2]-JT[2][1]*JT[1][2])-
+                        JT[0][1]*(JT[1][0]*JT[2][2]-JT[2][0]*JT[1][2])+
+                        JT[0][2]*(JT[1][0]*JT[2][1]-JT[2][0]*JT[1][1]);
+      if(Jacobian < 0) Jacobian = -Jacobian;
+      real_t invJacobian = 1/Jacobian;
+      real_t weight_multiply = quadrature_weights(iquad);
+
+      //compute density
+      real_t current_density = 0;
+      for(int node_loop = 0; node_loop < nodes_per_elem; node_loop++){
+        current_density += nodal_density[node_loop]*quadrature_basis_values(iquad, node_loop);
+      }
+
+      //strain of this quadrature point scaled by the Jacobian; the B matrix rows applied to the displacements
+      real_t strain[6] = {0, 0, 0, 0, 0, 0};
+      for(int ishape = 0; ishape < nodes_per_elem; ishape++){
+        real_t s1 = quadrature_basis_derivatives(iquad, 0, ishape);
+        real_t s2 = quadrature_basis_derivatives(iquad, 1, ishape);
+        real_t s3 = quadrature_basis_derivatives(iquad, 2, ishape);
+        real_t dx = s1*(JT[1][1]*JT[2][2]-JT[2][1]*JT[1][2])-
+                    s2*(JT[0][1]*JT[2][2]-JT[2][1]*JT[0][2])+
+                    s3*(JT[0][1]*JT[1][2]-JT[1][1]*JT[0][2]);
+        real_t dy = -s1*(JT[1][0]*JT[2][2]-JT[2][0]*JT[1][2])+
+                     s2*(JT[0][0]*JT[2][2]-JT[2][0]*JT[0][2])-
+                     s3*(JT[0][0]*JT[1][2]-JT[1][0]*JT[0][2]);
+        real_t dz = s1*(JT[1][0]*JT[2][1]-JT[2][0]*JT[1][1])-
+                    s2*(JT[0][0]*JT[2][1]-JT[2][0]*JT[0][1])+
+                    s3*(JT[0][0]*JT[1][1]-JT[1][0]*JT[0][1]);
+        strain[0] += dx*nodal_displacements[ishape][0];
+        strain[1] += dy*nodal_displacements[ishape][1];
+        strain[2] += dz*nodal_displacements[ishape][2];
+        strain[3] += dy*nodal_displacements[ishape][0] + dx*nodal_displacements[ishape][1];
+        strain[4] += dz*nodal_displacements[ishape][0] + dx*nodal_displacements[ishape][2];
+        strain[5] += dz*nodal_displacements[ishape][1] + dy*nodal_displacements[ishape][2];
+      }
+
+      //look up element material properties at this point as a function of density
+      real_t density = current_density;
+      if(density < 0) density = 0;
+      real_t penalty_product = 1;
+      if(SIMP_modulus){
+        for(int i = 0; i < simp_power - 1; i++)
+          penalty_product *= density;
+      }
+
+      real_t C_matrix[6][6];
+      for(int irow = 0; irow < 6; irow++)
+        for(int icol = 0; icol < 6; icol++)
+          C_matrix[irow][icol] = 0;
+
+      real_t Elastic_Constant = 0;
+      if(anisotropic_lattice){
+        real_t Elastic_Moduli[3] = {0, 0, 0}, Shear_Moduli[3] = {0, 0, 0}, Poisson_Ratios[3] = {0, 0, 0};
+        for(int idim = 0; idim < 3; idim++){
+          if(SIMP_modulus){
+            Elastic_Moduli[idim] = simp_power*(1 - density_epsilon)*penalty_product*elastic_moduli[idim]*modulus_scale;
+            Shear_Moduli[idim] = simp_power*(1 - density_epsilon)*penalty_product*shear_moduli[idim]*modulus_scale;
+            Poisson_Ratios[idim] = poisson_ratios[idim];
+          }
+          else if(linear_cell_modulus){
+            Elastic_Moduli[idim] = modulus_density_slope;
+            Poisson_Ratios[idim] = poisson_ratios[idim];
+            Shear_Moduli[idim] = shear_modulus_density_slope;
+          }
+        }
+        real_t Lower_Poisson_Ratios[3];
+        Lower_Poisson_Ratios[0] = Poisson_Ratios[0]*Elastic_Moduli[1]/Elastic_Moduli[0];
+        Lower_Poisson_Ratios[1] = Poisson_Ratios[1]*Elastic_Moduli[2]/Elastic_Moduli[0];
+        Lower_Poisson_Ratios[2] = Poisson_Ratios[2]*Elastic_Moduli[2]/Elastic_Moduli[1];
+        Elastic_Constant = 1/(1-Poisson_Ratios[0]*Lower_Poisson_Ratios[0] - Poisson_Ratios[1]*Lower_Poisson_Ratios[1] - Poisson_Ratios[2]*Lower_Poisson_Ratios[2]
+                            -2*Poisson_Ratios[0]*Poisson_Ratios[1]*Poisson_Ratios[2]);
+        C_matrix[0][0] = Elastic_Moduli[0]*(1-Poisson_Ratios[2]*Lower_Poisson_Ratios[2]);
+        C_matrix[1][1] = Elastic_Moduli[1]*(1-Poisson_Ratios[1]*Lower_Poisson_Ratios[1]);
+        C_matrix[2][2] = Elastic_Moduli[2]*(1-Poisson_Ratios[0]*Lower_Poisson_Ratios[0]);
+        C_matrix[0][1] = Elastic_Moduli[0]*(Lower_Poisson_Ratios[0]+Lower_Poisson_Ratios[1]*Poisson_Ratios[2]);
+        C_matrix[0][2] = Elastic_Moduli[0]*(Lower_Poisson_Ratios[1]+Lower_Poisson_Ratios[0]*Lower_Poisson_Ratios[2]);
+        C_matrix[1][0] = C_matrix[0][1];
+        C_matrix[1][2] = Elastic_Moduli[1]*(Lower_Poisson_Ratios[2]+Lower_Poisson_Ratios[1]*Poisson_Ratios[0]);
+        C_matrix[2][0] = C_matrix[0][2];
+        C_matrix[2][1] = C_matrix[1][2];
+        C_matrix[3][3] = 2*Shear_Moduli[0]/Elastic_Constant;
+        C_matrix[4][4] = 2*Shear_Moduli[1]/Elastic_Constant;
+        C_matrix[5][5] = 2*Shear_Moduli[2]/Elastic_Constant;
+      }
+      else{
+        real_t Element_Modulus_Gradient = 0;
+        real_t Poisson_Ratio = 0;
+        if(SIMP_modulus){
+          Element_Modulus_Gradient = simp_power*(1 - density_epsilon)*penalty_product*elastic_modulus*modulus_scale;
+          Poisson_Ratio = poisson_ratio;
+        }
+        else if(linear_cell_modulus){
+          Element_Modulus_Gradient = modulus_density_slope;
+          Poisson_Ratio = poisson_ratio;
+        }
+        Elastic_Constant = Element_Modulus_Gradient/((1 + Poisson_Ratio)*(1 - 2*Poisson_Ratio));
+        real_t Shear_Term = 0.5-Poisson_Ratio;
+        real_t Pressure_Term = 1 - Poisson_Ratio;
+        for(int irow = 0; irow < 3; irow++){
+          for(int icol = 0; icol < 3; icol++)
+            C_matrix[irow][icol] = Poisson_Ratio;
+          C_matrix[irow][irow] = Pressure_Term;
+          C_matrix[irow+3][irow+3] = Shear_Term;
+        }
+      }
+
+      //u^T B^T C B u for this quadrature point, the same product as the local stiffness matrix contraction
+      real_t inner_product = 0;
+      for(int irow = 0; irow < 6; irow++){
+        for(int icol = 0; icol < 6; icol++){
+          inner_product += strain[irow]*C_matrix[irow][icol]*strain[icol];
+        }
+      }
+
+      //gradient of the body force work
+      real_t body_product = 0;
+      if(body_term){
+        for(int node_loop = 0; node_loop < nodes_per_elem; node_loop++){
+          for(int idim = 0; idim < 3; idim++){
+            body_product += gradient_force_density[idim]*nodal_displacements[node_loop][idim]*quadrature_basis_values(iquad, node_loop);
+          }
+        }
+      }
+
+      //evaluate local stiffness matrix gradient for each locally owned node
+      for(int igradient = 0; igradient < nodes_per_elem; igradient++){
+        LO local_node_id = node_local_map.getLocalElement(nodes_in_elem(ielem, quadrature_node_order(igradient)));
+        if(local_node_id == invalid_index) continue;
+        real_t basis_value = quadrature_basis_values(iquad, igradient);
+        real_t gradient = -inner_product*Elastic_Constant*basis_value*weight_multiply*0.5*invJacobian;
+        if(body_term)
+          gradient += body_product*basis_value*weight_multiply*Jacobian;
+        Kokkos::atomic_add(&design_gradients(local_node_id,0), gradient);
+      }
+    }
+  }); // end parallel for
+  Kokkos::fence();
+}
+
 /* ------------------------------------------------------------------------------------
    Compute the hessian*vector product of strain energy with respect to nodal densities
 ---------------------------------------------------------------------------------------*/
@@ -4260,8 +4503,6 @@ void FEA_Module_Elasticity::compute_adjoint_hessian_vec(const_host_vec_array des
     adjoints_allocated = true;
   }
   Teuchos::RCP<MV> lambda = adjoint_displacements_distributed;
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xlambda = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(lambda));
-  Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xB = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(adjoint_equation_RHS_distributed));
   
   host_vec_array adjoint_equation_RHS_view = adjoint_equation_RHS_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
   
@@ -4670,48 +4911,12 @@ void FEA_Module_Elasticity::compute_adjoint_hessian_vec(const_host_vec_array des
   //*fos << "RHS vector" << std::endl;
   //Global_Nodal_RHS->describe(*fos,Teuchos::VERB_EXTREME);
 
-  //assign old stiffness matrix entries
-  if(!matrix_bc_reduced){
-  LO stride_index;
-  for(LO i=0; i < local_nrows; i++){
-    if((Node_DOF_Boundary_Condition_Type(i)==DISPLACEMENT_CONDITION)){
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        Original_Stiffness_Entries(i,j) = Stiffness_Matrix(i,j);
-        Original_Stiffness_Entry_Indices(i,j) = j;
-        if(local_dof_id == i){
-          Stiffness_Matrix(i,j) = 1;
-        }
-        else{     
-          Stiffness_Matrix(i,j) = 0;
-        }
-      }//stride for
-    }
-    else{
-      stride_index = 0;
-      for(LO j = 0; j < Stiffness_Matrix_Strides(i); j++){
-        global_dof_id = DOF_Graph_Matrix(i,j);
-        local_dof_id = all_dof_map->getLocalElement(global_dof_id);
-        if((Node_DOF_Boundary_Condition_Type(local_dof_id)==DISPLACEMENT_CONDITION)){
-          Original_Stiffness_Entries(i,stride_index) = Stiffness_Matrix(i,j);
-          Original_Stiffness_Entry_Indices(i,stride_index) = j;   
-          Stiffness_Matrix(i,j) = 0;
-          stride_index++;
-        }
-      }
-    }
-  }//row for
-  
-  matrix_bc_reduced = true;
-  }
+  //assign reduced stiffness matrix entries for linear solver
+  reduce_bc_matrix();
   
   //solve for adjoint vector
   int num_iter = 2000;
   double solve_tol = 1e-05;
-  int cacheSize = 0;
-  std::string solveType         = "belos";
-  std::string belosType         = "cg";
   // =========================================================================
   // Preconditioner construction
   // =========================================================================
@@ -4734,7 +4939,7 @@ void FEA_Module_Elasticity::compute_adjoint_hessian_vec(const_host_vec_array des
   // }
   real_t current_cpu_time2 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xlambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  linear_solve(lambda, adjoint_equation_RHS_distributed, num_iter, solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time2;
 
@@ -5176,15 +5381,7 @@ void FEA_Module_Elasticity::compute_adjoint_hessian_vec(const_host_vec_array des
   }//end element loop for hessian vector product
 
   //restore values of K for any scalar or matrix vector products
-  if(matrix_bc_reduced){
-    for(LO i = 0; i < local_nrows; i++){
-      for(LO j = 0; j < Original_Stiffness_Entries_Strides(i); j++){
-        access_index = Original_Stiffness_Entry_Indices(i,j);
-        Stiffness_Matrix(i,access_index) = Original_Stiffness_Entries(i,j);
-      }
-    }//row for
-    matrix_bc_reduced = false;
-  }
+  restore_bc_matrix();
 
   hessvec_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time;
 }
@@ -5909,12 +6106,7 @@ void FEA_Module_Elasticity::linear_solver_parameters(){
 int FEA_Module_Elasticity::solve(){
   //local variable for host view in the dual view
   int num_dim = simparam->num_dims;
-  int nodes_per_elem = max_nodes_per_element;
-  int local_node_index, current_row, current_column;
-  int max_stride = 0;
-  size_t row_access_index, row_counter;
-  GO global_index, global_dof_index;
-  LO local_dof_index, access_index;
+  size_t row_counter;
 
   //*fos << Amesos2::version() << std::endl << std::endl;
 
@@ -5949,9 +6141,6 @@ int FEA_Module_Elasticity::solve(){
       }
     }//row for
   }//end view scope
-  //change entries of Stiffness matrix corresponding to BCs to 0s (off diagonal elements) and 1 (diagonal elements)
-  //storage for original stiffness matrix values
-  Original_Stiffness_Entries_Strides = CArrayKokkos<size_t, array_layout, device_type, memory_traits>(local_nrows);
 
   //debug print of A matrix before applying BCS
   //*fos << "Reduced Stiffness Matrix :" << std::endl;
@@ -5960,8 +6149,110 @@ int FEA_Module_Elasticity::solve(){
   //Tpetra::MatrixMarket::Writer<MAT> market_writer();
   //Tpetra::MatrixMarket::Writer<MAT>::writeSparseFile("A_matrix.txt", *Global_Stiffness_Matrix, "A_matrix", "Stores stiffness matrix values");
 
+  //change entries of Stiffness matrix corresponding to BCs to 0s (off diagonal elements) and the diagonal scaling (diagonal elements)
+  reduce_bc_matrix();
+  //This completes the setup for A matrix of the linear system
+
+  //debug print of A matrix after balancing
+  /*
+  if(myrank==0)
+  *fos << "Reduced RHS :" << std::endl;
+  Global_Nodal_RHS->describe(*fos,Teuchos::VERB_EXTREME);
+  *fos << std::endl;
+  std::fflush(stdout);
+  */
+
+  X = node_displacements_distributed;
+  xX = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(X));
+
+  //randomize initial vector
+  xX->setSeed(100);
+  xX->randomize();
+
+  // if(module_params->equilibrate_matrix_flag){
+  //   Implicit_Solver_Pointer_->equilibrateMatrix(xA,"diag");
+  //   Implicit_Solver_Pointer_->preScaleRightHandSides(*Global_Nodal_RHS,"diag");
+  //   Implicit_Solver_Pointer_->preScaleInitialGuesses(*X,"diag");
+  // }
+    
+  int num_iter = 3000;
+  double solve_tol = 1e-06;
+  real_t current_cpu_time = Implicit_Solver_Pointer_->CPU_Time();
+
+  // =========================================================================
+  // Preconditioner construction for the new matrix values
+  // =========================================================================
+  comm->barrier();
+  setup_linear_solver();
+  comm->barrier();
+    
+  // =========================================================================
+  // System solution (Ax = b)
+  // =========================================================================
+  linear_solve(X, Global_Nodal_RHS, num_iter, solve_tol);
+  linear_solve_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time;
+  comm->barrier();
+
+  // if(module_params->equilibrate_matrix_flag){
+  //   Implicit_Solver_Pointer_->postScaleSolutionVectors(*X,"diag");
+  //   Implicit_Solver_Pointer_->postScaleSolutionVectors(*Global_Nodal_RHS,"diag");
+  // }
+
+  if(module_params->multigrid_timers){
+    Teuchos::RCP<Teuchos::ParameterList> reportParams = rcp(new Teuchos::ParameterList);
+    reportParams->set("How to merge timer sets",   "Union");
+    reportParams->set("alwaysWriteLocal",          false);
+    reportParams->set("writeGlobalStats",          true);
+    reportParams->set("writeZeroTimers",           false);
+    std::ios_base::fmtflags ff(fos->flags());
+    *fos << std::fixed;
+    Teuchos::TimeMonitor::report(comm.ptr(), *fos, "", reportParams);
+    *fos << std::setiosflags(ff);
+    //xA->describe(*fos,Teuchos::VERB_EXTREME);
+  }
+  
+  //Print solution vector
+  //print allocation of the solution vector to check distribution
+  
+  //if(myrank==0)
+  //*fos << "Solution:" << std::endl;
+  //X->describe(*fos,Teuchos::VERB_EXTREME);
+  //*fos << std::endl;
+
+  //comms to get displacements on all node map
+  all_node_displacements_distributed->doImport(*node_displacements_distributed, *dof_importer, Tpetra::INSERT);
+
+  //reinsert global stiffness values corresponding to BC indices to facilitate strain energy calculation
+  restore_bc_matrix();
+
+  //compute nodal force vector (used by other functions such as TO) due to inputs and constraints
+  Global_Stiffness_Matrix->apply(*node_displacements_distributed,*Global_Nodal_Forces);
+
+  //if(myrank==0)
+  //*fos << "All displacements :" << std::endl;
+  //all_node_displacements_distributed->describe(*fos,Teuchos::VERB_EXTREME);
+  //*fos << std::endl;
+  
+  return EXIT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------
+   Replace the stiffness matrix rows and columns of displacement boundary
+   condition DOFs with a scaled identity; the original entries are stored
+   so restore_bc_matrix can put them back
+------------------------------------------------------------------------- */
+
+void FEA_Module_Elasticity::reduce_bc_matrix(){
+  if(matrix_bc_reduced) return;
+
+  int num_dim = simparam->num_dims;
+  size_t local_nrows = nlocal_nodes*num_dim;
+  GO global_dof_index;
+  LO local_dof_index, stride_index;
+  real_t diagonal_bc_scaling = Stiffness_Matrix(0,0);
+
   //first pass counts strides for storage
-  if(!matrix_bc_reduced){
+  Original_Stiffness_Entries_Strides = CArrayKokkos<size_t, array_layout, device_type, memory_traits>(local_nrows);
   for(LO i=0; i < local_nrows; i++){
     Original_Stiffness_Entries_Strides(i) = 0;
     if((Node_DOF_Boundary_Condition_Type(i)==DISPLACEMENT_CONDITION)){
@@ -5979,7 +6270,6 @@ int FEA_Module_Elasticity::solve(){
   }//row for
   
   //assign old stiffness matrix entries
-  LO stride_index;
   Original_Stiffness_Entries = RaggedRightArrayKokkos<real_t, array_layout, device_type, memory_traits>(Original_Stiffness_Entries_Strides);
   Original_Stiffness_Entry_Indices = RaggedRightArrayKokkos<LO, array_layout, device_type, memory_traits>(Original_Stiffness_Entries_Strides);
   for(LO i=0; i < local_nrows; i++){
@@ -6013,24 +6303,38 @@ int FEA_Module_Elasticity::solve(){
   }//row for
 
   matrix_bc_reduced = true;
-  }
-  //This completes the setup for A matrix of the linear system
+}
 
-  //debug print of A matrix
-  /*
-  *fos << "Reduced Stiffness Matrix :" << std::endl;
-  Global_Stiffness_Matrix->describe(*fos,Teuchos::VERB_EXTREME);
-  *fos << std::endl;
-  */
+/* ----------------------------------------------------------------------
+   Reinsert the stiffness matrix entries removed by reduce_bc_matrix
+------------------------------------------------------------------------- */
 
-  //debug print of A matrix after balancing
-  /*
-  if(myrank==0)
-  *fos << "Reduced RHS :" << std::endl;
-  Global_Nodal_RHS->describe(*fos,Teuchos::VERB_EXTREME);
-  *fos << std::endl;
-  std::fflush(stdout);
-  */
+void FEA_Module_Elasticity::restore_bc_matrix(){
+  if(!matrix_bc_reduced) return;
+
+  int num_dim = simparam->num_dims;
+  size_t local_nrows = nlocal_nodes*num_dim;
+  LO access_index;
+
+  for(LO i = 0; i < local_nrows; i++){
+    for(LO j = 0; j < Original_Stiffness_Entries_Strides(i); j++){
+      access_index = Original_Stiffness_Entry_Indices(i,j);
+      Stiffness_Matrix(i,access_index) = Original_Stiffness_Entries(i,j);
+    }
+  }//row for
+  matrix_bc_reduced = false;
+}
+
+/* ----------------------------------------------------------------------
+   Build the preconditioner for the current BC reduced stiffness matrix;
+   the MueLu hierarchy is constructed on the first call and only has its
+   operators recomputed afterwards since the matrix graph never changes
+------------------------------------------------------------------------- */
+
+void FEA_Module_Elasticity::setup_linear_solver(){
+  int num_dim = simparam->num_dims;
+  size_t local_nrows = nlocal_nodes*num_dim;
+  LO access_index;
 
   //dimension of the nullspace for linear elasticity
   int nulldim = 6;
@@ -6039,9 +6343,6 @@ int FEA_Module_Elasticity::solve(){
     typename Kokkos::Details::ArithTraits<real_t>::val_type;
   using mag_type = typename Kokkos::ArithTraits<impl_scalar_type>::mag_type;
 
-  xB = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(Global_Nodal_RHS));
-  X = node_displacements_distributed;
-  xX = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(X));
   //Teuchos::RCP<Tpetra::Map<LO,GO,node_type> > reduced_node_map = 
   //Teuchos::rcp( new Tpetra::Map<LO,GO,node_type>(nrows_reduced/num_dim,0,comm));
 
@@ -6161,134 +6462,86 @@ int FEA_Module_Elasticity::solve(){
   Teuchos::RCP<Xpetra::CrsMatrix<real_t,LO,GO,node_type>> xcrs_A = Teuchos::rcp(new Xpetra::TpetraCrsMatrix<real_t,LO,GO,node_type>(Global_Stiffness_Matrix));
   xA = Teuchos::rcp(new Xpetra::CrsMatrixWrap<real_t,LO,GO,node_type>(xcrs_A));
   xA->SetFixedBlockSize(num_dim);
-   
-  //randomize initial vector
-  xX->setSeed(100);
-  xX->randomize();
-
-  //initialize BC components
-  /*
-  host_vec_array X_view = X->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
-  for(LO i=0; i < local_nrows; i++){
-    if((Node_DOF_Boundary_Condition_Type(i)==DISPLACEMENT_CONDITION)){
-      X_view(i,0) = Node_DOF_Displacement_Boundary_Conditions(i);
-    }
-  }//row for
-  */
-  // if(module_params->equilibrate_matrix_flag){
-  //   Implicit_Solver_Pointer_->equilibrateMatrix(xA,"diag");
-  //   Implicit_Solver_Pointer_->preScaleRightHandSides(*Global_Nodal_RHS,"diag");
-  //   Implicit_Solver_Pointer_->preScaleInitialGuesses(*X,"diag");
-  // }
 
-  //debug print
-  //if(myrank==0)
-  //*fos << "Xpetra A matrix :" << std::endl;
-  //xX->describe(*fos,Teuchos::VERB_EXTREME);
-  //*fos << std::endl;
-  //std::fflush(stdout);
-    
-  int num_iter = 3000;
-  double solve_tol = 1e-06;
-  int cacheSize = 0;
-  std::string solveType         = "belos";
-  std::string belosType         = "cg";
-  // =========================================================================
-  // Preconditioner construction
-  // =========================================================================
-  //bool useML   = Linear_Solve_Params->isParameter("use external multigrid package") && (Linear_Solve_Params->get<std::string>("use external multigrid package") == "ml");
-  //out<<"*********** MueLu ParameterList ***********"<<std::endl;
-  //out<<*Linear_Solve_Params;
-  //out<<"*******************************************"<<std::endl;
-    
-  //xA->describe(*fos,Teuchos::VERB_EXTREME);
-  //debug print
-  //Tpetra::MatrixMarket::Writer<MAT> market_writer();
-  //Tpetra::MatrixMarket::Writer<MAT>::writeSparseFile("A_matrix2.txt", *Global_Stiffness_Matrix, "A_matrix2", "Stores stiffness matrix values");  
-  //Xpetra::IO<real_t,LO,GO,node_type>WriteLocal("A_matrixlocal.txt", *xA);
-  comm->barrier();
-  //PreconditionerSetup(A,coordinates,nullspace,material,paramList,false,false,useML,0,H,Prec);
-  //xA->describe(*fos,Teuchos::VERB_EXTREME);
-  Teuchos::RCP<Tpetra::Vector<real_t,LO,GO,node_type>> tdiagonal = Teuchos::rcp(new Tpetra::Vector<real_t,LO,GO,node_type>(local_dof_map));
-  //Teuchos::RCP<Xpetra::Vector<real_t,LO,GO,node_type>> diagonal = Teuchos::rcp(new Xpetra::Vector<real_t,LO,GO,node_type>(tdiagonal));
-  //Global_Stiffness_Matrix->getLocalDiagCopy(*tdiagonal);
-  //tdiagonal->describe(*fos,Teuchos::VERB_EXTREME);
-  real_t current_cpu_time = Implicit_Solver_Pointer_->CPU_Time();
-  if(Hierarchy_Constructed){
+  if(module_params->direct_solver_flag){
+    //matrix values for this design are new; redo the numeric factorization only
+    direct_factorization_current = false;
+  }
+#ifdef HAVE_TPETRA_INST_FLOAT
+  else if(module_params->mixed_precision_preconditioner){
+    if(mixed_precision_prec.is_null())
+      mixed_precision_prec = Teuchos::rcp(new MixedPrecisionPreconditioner<real_t,float,LO,GO,node_type>());
+    mixed_precision_prec->setup(Global_Stiffness_Matrix,tcoordinates,tnullspace,*Linear_Solve_Params,num_dim);
+  }
+#endif
+  else if(Hierarchy_Constructed){
     ReuseXpetraPreconditioner(xA, H);
   }
   else{
     PreconditionerSetup(xA,coordinates,nullspace,material,*Linear_Solve_Params,false,false,false,0,H,Prec);
     Hierarchy_Constructed = true;
   }
-  comm->barrier();
-    
-  //H->Write(-1, -1);
-  //H->describe(*fos,Teuchos::VERB_EXTREME);
-    
-  // =========================================================================
-  // System solution (Ax = b)
-  // =========================================================================
+}
 
-  SystemSolve(xA,xX,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
-  linear_solve_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time;
-  comm->barrier();
+/* ----------------------------------------------------------------------
+   Solve the BC reduced system with the direct, mixed precision or Belos
+   solver. Forward solves and adjoint solves share the preconditioner
+   built by setup_linear_solver.
+   The caller reduces the matrix and zeroes or sets the BC rows of rhs.
+------------------------------------------------------------------------- */
 
-  // if(module_params->equilibrate_matrix_flag){
-  //   Implicit_Solver_Pointer_->postScaleSolutionVectors(*X,"diag");
-  //   Implicit_Solver_Pointer_->postScaleSolutionVectors(*Global_Nodal_RHS,"diag");
-  // }
+void FEA_Module_Elasticity::linear_solve(Teuchos::RCP<MV> solution, Teuchos::RCP<const MV> rhs, int num_iter, double solve_tol){
+  int cacheSize = 0;
+  std::string solveType         = "belos";
+  std::string belosType         = "cg";
 
-  if(module_params->multigrid_timers){
-    Teuchos::RCP<Teuchos::ParameterList> reportParams = rcp(new Teuchos::ParameterList);
-    reportParams->set("How to merge timer sets",   "Union");
-    reportParams->set("alwaysWriteLocal",          false);
-    reportParams->set("writeGlobalStats",          true);
-    reportParams->set("writeZeroTimers",           false);
-    std::ios_base::fmtflags ff(fos->flags());
-    *fos << std::fixed;
-    Teuchos::TimeMonitor::report(comm.ptr(), *fos, "", reportParams);
-    *fos << std::setiosflags(ff);
-    //xA->describe(*fos,Teuchos::VERB_EXTREME);
+  //adjoint solves normally reuse the preconditioner of the last forward solve
+  if(!module_params->direct_solver_flag){
+    bool preconditioner_built = Hierarchy_Constructed;
+#ifdef HAVE_TPETRA_INST_FLOAT
+    if(module_params->mixed_precision_preconditioner) preconditioner_built = !mixed_precision_prec.is_null();
+#endif
+    if(!preconditioner_built) setup_linear_solver();
   }
-  //return !EXIT_SUCCESS;
-  //timing statistics for LU solver
-  //solver->printTiming(*fos);
-  
-  //Print solution vector
-  //print allocation of the solution vector to check distribution
-  
-  //if(myrank==0)
-  //*fos << "Solution:" << std::endl;
-  //X->describe(*fos,Teuchos::VERB_EXTREME);
-  //*fos << std::endl;
-  
-  //import for displacement of ghosts
-  //Tpetra::Import<LO, GO> ghost_displacement_importer(local_dof_map, all_dof_map);
 
-  //comms to get displacements on all node map
-  all_node_displacements_distributed->doImport(*node_displacements_distributed, *dof_importer, Tpetra::INSERT);
+  if(module_params->direct_solver_flag){
+    direct_solve(solution, rhs);
+  }
+#ifdef HAVE_TPETRA_INST_FLOAT
+  else if(module_params->mixed_precision_preconditioner){
+    mixed_precision_prec->solve(Global_Stiffness_Matrix,solution,rhs,*fos,num_iter,solve_tol);
+  }
+#endif
+  else{
+    Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xsolution = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(solution));
+    Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xrhs = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(Teuchos::rcp_const_cast<MV>(rhs)));
+    SystemSolve(xA,xsolution,xrhs,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+  }
+}
 
-  //reinsert global stiffness values corresponding to BC indices to facilitate strain energy calculation
-  if(matrix_bc_reduced){
-    for(LO i = 0; i < local_nrows; i++){
-      for(LO j = 0; j < Original_Stiffness_Entries_Strides(i); j++){
-        access_index = Original_Stiffness_Entry_Indices(i,j);
-        Stiffness_Matrix(i,access_index) = Original_Stiffness_Entries(i,j);
-      }
-    }//row for
-    matrix_bc_reduced = false;
+/* ----------------------------------------------------------------------
+   Solve the BC reduced system with Amesos2; the sparsity pattern is the
+   same for every design so the ordering and symbolic factorization are
+   computed once and only the numeric factorization is redone after the
+   matrix values change. Adjoint solves for the same design reuse the factors.
+------------------------------------------------------------------------- */
+
+void FEA_Module_Elasticity::direct_solve(Teuchos::RCP<MV> solution, Teuchos::RCP<const MV> rhs){
+  if(direct_solver.is_null()){
+    direct_solver = Amesos2::create<MAT,MV>("SuperLU_DIST", Global_Stiffness_Matrix);
+    direct_solver->setParameters(Linear_Solve_Params);
+    direct_solver->symbolicFactorization();
+    direct_factorization_current = false;
   }
 
-  //compute nodal force vector (used by other functions such as TO) due to inputs and constraints
-  Global_Stiffness_Matrix->apply(*node_displacements_distributed,*Global_Nodal_Forces);
+  if(!direct_factorization_current){
+    //keep the symbolic phase and pick up the current matrix values
+    direct_solver->setA(Global_Stiffness_Matrix, Amesos2::SYMBFACT);
+    direct_solver->numericFactorization();
+    direct_factorization_current = true;
+  }
 
-  //if(myrank==0)
-  //*fos << "All displacements :" << std::endl;
-  //all_node_displacements_distributed->describe(*fos,Teuchos::VERB_EXTREME);
-  //*fos << std::endl;
-  
-  return EXIT_SUCCESS;
+  direct_solver->solve(solution.ptr(), rhs.ptr());
 }
 
 /* -------------------------------------------------------------------------------------------
@@ -6372,6 +6625,14 @@ int FEA_Module_Elasticity::eigensolve(){
   size_t access_index, row_access_index, row_counter;
   bool free_bcs = false;
   if(num_boundary_conditions==0) free_bcs = true;
+  bool shift_invert = module_params->eigensolver_type == "shift_invert";
+  bool lobpcg = module_params->eigensolver_type == "lobpcg";
+  //BC rows get the same stiffness diagonal as the static solve, so the static solve hierarchy preconditions this K as is.
+  //Their mass diagonal puts the decoupled BC eigenvalue K_bc/M_bc far outside the wanted band:
+  //far above the spectrum for the smallest modes and shift-invert, far below it for the largest modes
+  real_t bc_stiffness_diagonal = Stiffness_Matrix(0,0);
+  real_t bc_mass_diagonal = Mass_Matrix(0,0)*1e-8;
+  if(module_params->largest_modes&&!shift_invert) bc_mass_diagonal = Mass_Matrix(0,0)*1e8;
 
   // Create initial vectors
   Teuchos::RCP<MV> ivec = Teuchos::rcp (new MV (local_dof_map,blocksize));
@@ -6418,8 +6679,8 @@ int FEA_Module_Elasticity::eigensolve(){
           Original_Mass_Entries(i,j) = Mass_Matrix(i,j);
           Original_Stiffness_Entry_Indices(i,j) = j;
           if(local_dof_index == i){
-            Stiffness_Matrix(i,j) = 0;
-            Mass_Matrix(i,j) = 1;
+            Stiffness_Matrix(i,j) = bc_stiffness_diagonal;
+            Mass_Matrix(i,j) = bc_mass_diagonal;
           }
           else{  
             Mass_Matrix(i,j) = Stiffness_Matrix(i,j) = 0;
@@ -6556,8 +6817,8 @@ int FEA_Module_Elasticity::eigensolve(){
   Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> coordinates = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t,LO,GO,node_type>(tcoordinates));
   Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> material = Teuchos::null;
   Teuchos::RCP<Xpetra::CrsMatrix<real_t,LO,GO,node_type>> xcrs_A = Teuchos::rcp(new Xpetra::TpetraCrsMatrix<real_t,LO,GO,node_type>(Global_Stiffness_Matrix));
-  xA = Teuchos::rcp(new Xpetra::CrsMatrixWrap<real_t,LO,GO,node_type>(xcrs_A));
-  xA->SetFixedBlockSize(num_dim);
+  Teuchos::RCP<Xpetra::Matrix<real_t,LO,GO,node_type>> eigen_xA = Teuchos::rcp(new Xpetra::CrsMatrixWrap<real_t,LO,GO,node_type>(xcrs_A));
+  eigen_xA->SetFixedBlockSize(num_dim);
   comm->barrier();
   //PreconditionerSetup(A,coordinates,nullspace,material,paramList,false,false,useML,0,H,Prec);
   //xA->describe(*fos,Teuchos::VERB_EXTREME);
@@ -6566,19 +6827,30 @@ int FEA_Module_Elasticity::eigensolve(){
   //Global_Stiffness_Matrix->getLocalDiagCopy(*tdiagonal);
   //tdiagonal->describe(*fos,Teuchos::VERB_EXTREME);
   real_t current_cpu_time = Implicit_Solver_Pointer_->CPU_Time();
-  if(Eigen_Hierarchy_Constructed){
-    ReuseXpetraPreconditioner(xA, eigen_H);
-  }
-  else{
-    PreconditionerSetup(xA,coordinates,nullspace,material,*Linear_Solve_Params,false,false,false,0,eigen_H,eigen_Prec);
-    Eigen_Hierarchy_Constructed = true;
+  //the BC reduced K is the operator the static solve just built H for, so every mode reuses that hierarchy as is;
+  //it is only built here when the static solve used the direct or mixed precision solver
+  if(!Hierarchy_Constructed){
+    PreconditionerSetup(eigen_xA,coordinates,nullspace,material,*Linear_Solve_Params,false,false,false,0,H,Prec);
+    Hierarchy_Constructed = true;
   }
   comm->barrier();
-  
+
   Teuchos::RCP<Tpetra::Operator<real_t,LO,GO,node_type>> eigen_Prec_Pass = Teuchos::rcp(new MueLu::TpetraOperator<real_t,LO,GO,node_type>(H));
-  
+
   problem->setPrec(eigen_Prec_Pass);
 
+  //shift-invert solves the standard problem for (K - shift*M)^{-1} M; the preconditioned inner solves reuse the hierarchy
+  Teuchos::RCP<ShiftInvertOperator<real_t,LO,GO,node_type>> shift_invert_op;
+  if(shift_invert){
+    Teuchos::RCP<const MAT> shifted_stiffness = Global_Stiffness_Matrix;
+    if(module_params->eigen_shift != 0)
+      shifted_stiffness = Tpetra::MatrixMatrix::add(1.0, false, *Global_Stiffness_Matrix, -module_params->eigen_shift, false, *Global_Mass_Matrix);
+    shift_invert_op = Teuchos::rcp(new ShiftInvertOperator<real_t,LO,GO,node_type>(shifted_stiffness, Global_Mass_Matrix, eigen_Prec_Pass, 1000, 1e-10));
+    problem = Teuchos::rcp (new Anasazi::BasicEigenproblem<real_t,MV,OP> (shift_invert_op, Global_Mass_Matrix, ivec));
+    problem->setHermitian (true);
+    problem->setNEV (nev);
+  }
+
   Kokkos::View<impl_scalar_type*, HostSpace> scaling_values("scaling_values", nulldim);
 
   //set nullspace for eigenvalue problem
@@ -6619,9 +6891,15 @@ int FEA_Module_Elasticity::eigensolve(){
     which = "SM";
   if(module_params->largest_modes)
     which = "LM";
+  //modes closest to the shift are the largest magnitude modes of the inverted operator
+  if(shift_invert)
+    which = "LM";
   int NumImages = nranks;
   int numBlocks = 3 * NumImages;
-  int maxRestarts = 50;
+  if(module_params->eigen_num_blocks > 0) numBlocks = module_params->eigen_num_blocks;
+  int maxRestarts = module_params->eigen_max_restarts;
+  int maxLocked = nev;
+  if(module_params->eigen_max_locked > 0) maxLocked = module_params->eigen_max_locked;
   bool insitu = false;
   std::string whenToShift = "Always";
   //
@@ -6642,11 +6920,26 @@ int FEA_Module_Elasticity::eigensolve(){
   MyPL.set("Num Blocks", numBlocks);                   // Maximum number of blocks in the subspace
   //
   // Create the solver manager
-  Anasazi::BlockDavidsonSolMgr<real_t,MV,OP> MySolverMgr(problem, MyPL);
+  Teuchos::RCP<Anasazi::SolverManager<real_t,MV,OP>> MySolverMgr;
+  if(lobpcg){
+    MyPL.set( "Maximum Iterations", module_params->eigen_max_iterations );
+    MyPL.set( "Use Locking", module_params->eigen_locking );
+    MyPL.set( "Max Locked", maxLocked );
+    MyPL.set( "Full Ortho", true );
+    MySolverMgr = Teuchos::rcp(new Anasazi::LOBPCGSolMgr<real_t,MV,OP>(problem, MyPL));
+  }
+  else if(shift_invert){
+    MySolverMgr = Teuchos::rcp(new Anasazi::BlockKrylovSchurSolMgr<real_t,MV,OP>(problem, MyPL));
+  }
+  else{
+    MyPL.set( "Use Locking", module_params->eigen_locking );
+    MyPL.set( "Max Locked", maxLocked );
+    MySolverMgr = Teuchos::rcp(new Anasazi::BlockDavidsonSolMgr<real_t,MV,OP>(problem, MyPL));
+  }
   //Anasazi::Experimental::TraceMinDavidsonSolMgr<real_t,MV,OP> MySolverMgr(problem, MyPL);
 
   // Solve the problem to the specified tolerances or length
-  Anasazi::ReturnType returnCode = MySolverMgr.solve();
+  Anasazi::ReturnType returnCode = MySolverMgr->solve();
   bool testFailed = false;
   if (returnCode != Anasazi::Converged) {
     testFailed = true;
@@ -6659,6 +6952,13 @@ int FEA_Module_Elasticity::eigensolve(){
   evecs = sol->Evecs;
   numev = sol->numVecs;
 
+  //map eigenvalues of the inverted operator back to the original problem
+  if(shift_invert){
+    for (int i=0; i<numev; i++)
+      sol->Evals[i].realpart = module_params->eigen_shift + 1/sol->Evals[i].realpart;
+    *fos << "Shift-invert linear iterations: " << shift_invert_op->getTotalIterations() << std::endl;
+  }
+
    *fos << "Direct residual norms computed in Tpetra_BlockDavidson_lap_test.exe" << std::endl
        << std::setw(20) << "Eigenvalue" << std::setw(20) << "Residual  " << std::endl
        << "----------------------------------------" << std::endl;
@@ -49,11 +49,21 @@ namespace MueLu{
   class Hierarchy;
 }
 
+namespace Amesos2{
+  template<class matrixtype, class vectortype> 
+  class Solver;
+}
+
 namespace Anasazi{
   template<class floattype, class vectortype> 
   class Eigensolution;
 }
 
+#ifdef HAVE_TPETRA_INST_FLOAT
+template<class floattype, class precfloattype, class local_ind, class global_ind, class nodetype> 
+class MixedPrecisionPreconditioner;
+#endif
+
 namespace Xpetra{
   template<class floattype, class local_ind, class global_ind, class nodetype> 
   class Operator;
@@ -99,6 +109,16 @@ public:
 
   int solve();
 
+  void reduce_bc_matrix();
+
+  void restore_bc_matrix();
+
+  void setup_linear_solver();
+
+  void linear_solve(Teuchos::RCP<MV> solution, Teuchos::RCP<const MV> rhs, int num_iter, double solve_tol);
+
+  void direct_solve(Teuchos::RCP<MV> solution, Teuchos::RCP<const MV> rhs);
+
   int eigensolve();
 
   void linear_solver_parameters();
@@ -109,6 +129,8 @@ public:
 
   void compute_adjoint_gradients(const_host_vec_array design_densities, host_vec_array gradients);
 
+  void compute_adjoint_gradients(const_vec_array design_densities, vec_array gradients);
+
   void compute_adjoint_hessian_vec(const_host_vec_array design_densities, host_vec_array hessvec, Teuchos::RCP<const MV> direction_vec_distributed);
 
   void compute_nodal_strains();
@@ -231,10 +253,15 @@ public:
   Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xB;
   Teuchos::RCP<MueLu::Hierarchy<real_t,LO,GO,node_type>> H;
   Teuchos::RCP<Xpetra::Operator<real_t,LO,GO,node_type>> Prec;
-  Teuchos::RCP<MueLu::Hierarchy<real_t,LO,GO,node_type>> eigen_H;
-  Teuchos::RCP<Xpetra::Operator<real_t,LO,GO,node_type>> eigen_Prec;
+  //single precision hierarchy used by the mixed precision refinement solve
+#ifdef HAVE_TPETRA_INST_FLOAT
+  Teuchos::RCP<MixedPrecisionPreconditioner<real_t,float,LO,GO,node_type>> mixed_precision_prec;
+#endif
   bool Hierarchy_Constructed;
-  bool Eigen_Hierarchy_Constructed;
+
+  //direct solver data; symbolic factorization is kept since the sparsity pattern never changes
+  Teuchos::RCP<Amesos2::Solver<MAT,MV>> direct_solver;
+  bool direct_factorization_current;
 
   //Eigenvalue solution data
   Teuchos::RCP<Anasazi::Eigensolution<real_t,MV>> sol;
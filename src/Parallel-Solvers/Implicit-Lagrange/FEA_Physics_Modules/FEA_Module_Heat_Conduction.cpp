@@ -90,6 +90,7 @@
 #include <MueLu_ParameterListInterpreter.hpp>
 #include <MueLu_Utilities.hpp>
 #include <DriverCore.hpp>
+#include <MixedPrecisionCore.hpp>
 
 #define MAX_ELEM_NODES 8
 #define FLUX_EPSILON 0.000000001
@@ -113,6 +114,10 @@ FEA_Module_Heat_Conduction::FEA_Module_Heat_Conduction(
 
   module_params = in_params;
   simparam = &Implicit_Solver_Pointer_->simparam;
+#ifndef HAVE_TPETRA_INST_FLOAT
+  if(module_params.mixed_precision_preconditioner)
+    throw std::runtime_error("mixed_precision_preconditioner requires Trilinos built with float scalar instantiation (Tpetra_INST_FLOAT=ON)");
+#endif
   
   //TO parameters
   penalty_power = simparam->optimization_options.simp_penalty_power;
@@ -2592,7 +2597,12 @@ void FEA_Module_Heat_Conduction::compute_adjoint_hessian_vec(const_host_vec_arra
   // }
   real_t current_cpu_time2 = Implicit_Solver_Pointer_->CPU_Time();
   comm->barrier();
-  SystemSolve(xA,xlambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+#ifdef HAVE_TPETRA_INST_FLOAT
+  if(module_params.mixed_precision_preconditioner)
+    mixed_precision_prec->solve(Global_Conductivity_Matrix,lambda,adjoint_equation_RHS_distributed,*fos,num_iter,solve_tol);
+  else
+#endif
+    SystemSolve(xA,xlambda,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
   comm->barrier();
   hessvec_linear_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time2;
 
@@ -3629,6 +3639,14 @@ int FEA_Module_Heat_Conduction::solve(){
   //Teuchos::RCP<Xpetra::Vector<real_t,LO,GO,node_type>> diagonal = Teuchos::rcp(new Xpetra::Vector<real_t,LO,GO,node_type>(tdiagonal));
   //Global_Conductivity_Matrix->getLocalDiagCopy(*tdiagonal);
   //tdiagonal->describe(*fos,Teuchos::VERB_EXTREME);
+#ifdef HAVE_TPETRA_INST_FLOAT
+  if(module_params.mixed_precision_preconditioner){
+    if(mixed_precision_prec.is_null())
+      mixed_precision_prec = Teuchos::rcp(new MixedPrecisionPreconditioner<real_t,float,LO,GO,node_type>());
+    mixed_precision_prec->setup(Global_Conductivity_Matrix,tcoordinates,tnullspace,*Linear_Solve_Params,1);
+  }
+  else
+#endif
   if(Hierarchy_Constructed){
     ReuseXpetraPreconditioner(xA, H);
   }
@@ -3646,7 +3664,12 @@ int FEA_Module_Heat_Conduction::solve(){
   // =========================================================================
 
   real_t current_cpu_time = Implicit_Solver_Pointer_->CPU_Time();
-  SystemSolve(xA,xX,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
+#ifdef HAVE_TPETRA_INST_FLOAT
+  if(module_params.mixed_precision_preconditioner)
+    mixed_precision_prec->solve(Global_Conductivity_Matrix,X,Global_Nodal_RHS,*fos,num_iter,solve_tol);
+  else
+#endif
+    SystemSolve(xA,xX,xB,H,Prec,*fos,solveType,belosType,false,false,false,cacheSize,0,true,true,num_iter,solve_tol);
   linear_solve_time += Implicit_Solver_Pointer_->CPU_Time() - current_cpu_time;
   comm->barrier();
 
@@ -47,6 +47,11 @@ namespace MueLu{
   class Hierarchy;
 }
 
+#ifdef HAVE_TPETRA_INST_FLOAT
+template<class floattype, class precfloattype, class local_ind, class global_ind, class nodetype> 
+class MixedPrecisionPreconditioner;
+#endif
+
 namespace Xpetra{
   template<class floattype, class local_ind, class global_ind, class nodetype> 
   class Operator;
@@ -199,6 +204,10 @@ public:
   Teuchos::RCP<Xpetra::MultiVector<real_t,LO,GO,node_type>> xB;
   Teuchos::RCP<MueLu::Hierarchy<real_t,LO,GO,node_type>> H;
   Teuchos::RCP<Xpetra::Operator<real_t,LO,GO,node_type>> Prec;
+  //single precision hierarchy used by the mixed precision refinement solve
+#ifdef HAVE_TPETRA_INST_FLOAT
+  Teuchos::RCP<MixedPrecisionPreconditioner<real_t,float,LO,GO,node_type>> mixed_precision_prec;
+#endif
   bool Hierarchy_Constructed;
 
   //output dof data
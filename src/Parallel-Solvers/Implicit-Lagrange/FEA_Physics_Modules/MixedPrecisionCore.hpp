@@ -0,0 +1,229 @@
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+#ifndef MIXED_PRECISION_CORE_HPP
+#define MIXED_PRECISION_CORE_HPP
+
+#include <algorithm>
+#include <vector>
+
+//Trilinos
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_FancyOStream.hpp>
+#include <Tpetra_Operator.hpp>
+#include <Tpetra_MultiVector.hpp>
+#include <Tpetra_CrsMatrix.hpp>
+#include <MueLu_TpetraOperator.hpp>
+#include <MueLu_CreateTpetraPreconditioner.hpp>
+#include <BelosLinearProblem.hpp>
+#include <BelosSolverFactory.hpp>
+#include <BelosTpetraAdapter.hpp>
+
+//float scalar types only exist when Tpetra was built with float instantiation
+#ifdef HAVE_TPETRA_INST_FLOAT
+
+/* ----------------------------------------------------------------------
+   Applies an operator stored in a lower precision (PrecScalar) to
+   multivectors of the working precision (Scalar). Input columns are
+   rounded down, the operator is applied, and the result promoted back.
+------------------------------------------------------------------------- */
+
+template<class Scalar, class PrecScalar, class LocalOrdinal, class GlobalOrdinal, class Node>
+class MixedPrecisionOperator : public Tpetra::Operator<Scalar,LocalOrdinal,GlobalOrdinal,Node> {
+public:
+  typedef Tpetra::MultiVector<Scalar,LocalOrdinal,GlobalOrdinal,Node> vector_type;
+  typedef Tpetra::MultiVector<PrecScalar,LocalOrdinal,GlobalOrdinal,Node> prec_vector_type;
+  typedef Tpetra::Operator<PrecScalar,LocalOrdinal,GlobalOrdinal,Node> prec_operator_type;
+  typedef Tpetra::Map<LocalOrdinal,GlobalOrdinal,Node> map_type;
+
+  MixedPrecisionOperator(Teuchos::RCP<prec_operator_type> prec_op) : prec_op_(prec_op) {}
+
+  Teuchos::RCP<const map_type> getDomainMap() const override { return prec_op_->getDomainMap(); }
+
+  Teuchos::RCP<const map_type> getRangeMap() const override { return prec_op_->getRangeMap(); }
+
+  void apply(const vector_type &X, vector_type &Y, Teuchos::ETransp mode = Teuchos::NO_TRANS,
+             Scalar alpha = Teuchos::ScalarTraits<Scalar>::one(),
+             Scalar beta = Teuchos::ScalarTraits<Scalar>::zero()) const override {
+    const Scalar one = Teuchos::ScalarTraits<Scalar>::one();
+    const Scalar zero = Teuchos::ScalarTraits<Scalar>::zero();
+    size_t num_vectors = X.getNumVectors();
+
+    //work vectors are kept between applications; only reallocated when the block size changes
+    if(X_prec_.is_null() || X_prec_->getNumVectors() != num_vectors){
+      X_prec_ = Teuchos::rcp(new prec_vector_type(prec_op_->getDomainMap(), num_vectors));
+      Y_prec_ = Teuchos::rcp(new prec_vector_type(prec_op_->getRangeMap(), num_vectors));
+    }
+
+    Tpetra::deep_copy(*X_prec_, X);
+    prec_op_->apply(*X_prec_, *Y_prec_, mode);
+
+    if(alpha == one && beta == zero){
+      Tpetra::deep_copy(Y, *Y_prec_);
+    }
+    else{
+      vector_type Y_promoted(Y.getMap(), num_vectors);
+      Tpetra::deep_copy(Y_promoted, *Y_prec_);
+      Y.update(alpha, Y_promoted, beta);
+    }
+  }
+
+private:
+  Teuchos::RCP<prec_operator_type> prec_op_;
+  mutable Teuchos::RCP<prec_vector_type> X_prec_;
+  mutable Teuchos::RCP<prec_vector_type> Y_prec_;
+};
+
+/* ----------------------------------------------------------------------
+   MueLu hierarchy built and applied in PrecScalar (typically float) used
+   to precondition solves in Scalar (typically double). The outer loop is
+   iterative refinement: residuals and corrections are accumulated in
+   Scalar while the inner Krylov solve is preconditioned by the low
+   precision hierarchy, so the final accuracy is set by the outer loop.
+------------------------------------------------------------------------- */
+
+template<class Scalar, class PrecScalar, class LocalOrdinal, class GlobalOrdinal, class Node>
+class MixedPrecisionPreconditioner {
+public:
+  typedef Tpetra::CrsMatrix<Scalar,LocalOrdinal,GlobalOrdinal,Node> matrix_type;
+  typedef Tpetra::CrsMatrix<PrecScalar,LocalOrdinal,GlobalOrdinal,Node> prec_matrix_type;
+  typedef Tpetra::MultiVector<Scalar,LocalOrdinal,GlobalOrdinal,Node> vector_type;
+  typedef Tpetra::MultiVector<PrecScalar,LocalOrdinal,GlobalOrdinal,Node> prec_vector_type;
+  typedef Tpetra::Operator<Scalar,LocalOrdinal,GlobalOrdinal,Node> operator_type;
+  typedef Tpetra::Operator<PrecScalar,LocalOrdinal,GlobalOrdinal,Node> prec_operator_type;
+  typedef typename Teuchos::ScalarTraits<PrecScalar>::coordinateType prec_coordinate_type;
+  typedef Tpetra::MultiVector<prec_coordinate_type,LocalOrdinal,GlobalOrdinal,Node> prec_coordinate_vector_type;
+
+  MixedPrecisionPreconditioner() : max_refinements_(10), inner_tolerance_(1e-4) {}
+
+  //build the hierarchy on the first call; later calls keep the aggregates and only recompute operators for new values
+  void setup(Teuchos::RCP<matrix_type> A, Teuchos::RCP<vector_type> coordinates, Teuchos::RCP<vector_type> nullspace,
+             const Teuchos::ParameterList &mueluList, int block_size){
+    A_prec_ = A->template convert<PrecScalar>();
+
+    if(hierarchy_op_.is_null()){
+      Teuchos::ParameterList prec_list(mueluList);
+      //the Xpetra path sets this through SetFixedBlockSize on the wrapped matrix
+      if(!prec_list.isParameter("number of equations")) prec_list.set("number of equations", block_size);
+      Teuchos::ParameterList& user_list = prec_list.sublist("user data");
+      if(!coordinates.is_null()){
+        Teuchos::RCP<prec_coordinate_vector_type> prec_coordinates =
+          Teuchos::rcp(new prec_coordinate_vector_type(coordinates->getMap(), coordinates->getNumVectors()));
+        Tpetra::deep_copy(*prec_coordinates, *coordinates);
+        user_list.set<Teuchos::RCP<prec_coordinate_vector_type>>("Coordinates", prec_coordinates);
+      }
+      if(!nullspace.is_null()){
+        Teuchos::RCP<prec_vector_type> prec_nullspace = Teuchos::rcp(new prec_vector_type(nullspace->getMap(), nullspace->getNumVectors()));
+        Tpetra::deep_copy(*prec_nullspace, *nullspace);
+        user_list.set<Teuchos::RCP<prec_vector_type>>("Nullspace", prec_nullspace);
+      }
+      Teuchos::RCP<prec_operator_type> A_prec_op = A_prec_;
+      hierarchy_op_ = MueLu::CreateTpetraPreconditioner(A_prec_op, prec_list);
+      prec_op_ = Teuchos::rcp(new MixedPrecisionOperator<Scalar,PrecScalar,LocalOrdinal,GlobalOrdinal,Node>(hierarchy_op_));
+    }
+    else{
+      MueLu::ReuseTpetraPreconditioner(A_prec_, *hierarchy_op_);
+    }
+  }
+
+  bool is_setup() const { return !hierarchy_op_.is_null(); }
+
+  Teuchos::RCP<operator_type> getOperator() const { return prec_op_; }
+
+  //solve A X = B to tol (relative to each column of B); returns the total number of inner iterations
+  int solve(Teuchos::RCP<matrix_type> A, Teuchos::RCP<vector_type> X, Teuchos::RCP<const vector_type> B,
+            Teuchos::FancyOStream &out, int maxIts, double tol){
+    typedef typename Teuchos::ScalarTraits<Scalar>::magnitudeType mag_type;
+    size_t num_vectors = B->getNumVectors();
+    std::vector<mag_type> B_norms(num_vectors), R_norms(num_vectors);
+    Teuchos::ArrayView<mag_type> B_norms_view(B_norms.data(), num_vectors);
+    Teuchos::ArrayView<mag_type> R_norms_view(R_norms.data(), num_vectors);
+
+    Teuchos::RCP<vector_type> R = Teuchos::rcp(new vector_type(*B, Teuchos::Copy));
+    Teuchos::RCP<vector_type> D = Teuchos::rcp(new vector_type(X->getMap(), num_vectors));
+    X->putScalar(Teuchos::ScalarTraits<Scalar>::zero());
+    B->norm2(B_norms_view);
+
+    Teuchos::RCP<Teuchos::ParameterList> belosList = Teuchos::parameterList();
+    belosList->set("Maximum Iterations",    maxIts);
+    belosList->set("Convergence Tolerance", std::max(tol, inner_tolerance_));
+
+    Belos::SolverFactory<Scalar,vector_type,operator_type> solverFactory;
+    Teuchos::RCP<Belos::SolverManager<Scalar,vector_type,operator_type>> solver = solverFactory.create("Pseudo Block CG", belosList);
+
+    int total_iterations = 0;
+    bool converged = false;
+    for(int irefine = 0; irefine < max_refinements_; irefine++){
+      //correction solve; the low precision preconditioner limits this to a modest relative tolerance
+      D->putScalar(Teuchos::ScalarTraits<Scalar>::zero());
+      Teuchos::RCP<Belos::LinearProblem<Scalar,vector_type,operator_type>> problem =
+        Teuchos::rcp(new Belos::LinearProblem<Scalar,vector_type,operator_type>(A, D, R));
+      problem->setRightPrec(prec_op_);
+      problem->setProblem();
+      solver->setProblem(problem);
+      solver->solve();
+      total_iterations += solver->getNumIters();
+
+      //accumulate correction and recompute the true residual in the working precision
+      X->update(Teuchos::ScalarTraits<Scalar>::one(), *D, Teuchos::ScalarTraits<Scalar>::one());
+      A->apply(*X, *R);
+      R->update(Teuchos::ScalarTraits<Scalar>::one(), *B, -Teuchos::ScalarTraits<Scalar>::one());
+      R->norm2(R_norms_view);
+
+      converged = true;
+      for(size_t ivector = 0; ivector < num_vectors; ivector++)
+        if(R_norms[ivector] > tol*B_norms[ivector]) converged = false;
+      if(converged) break;
+    }
+
+    if(!converged)
+      out << std::endl << "ERROR:  mixed precision refinement did not converge! " << std::endl;
+
+    return total_iterations;
+  }
+
+private:
+  int max_refinements_;
+  double inner_tolerance_;
+  Teuchos::RCP<prec_matrix_type> A_prec_;
+  Teuchos::RCP<MueLu::TpetraOperator<PrecScalar,LocalOrdinal,GlobalOrdinal,Node>> hierarchy_op_;
+  Teuchos::RCP<operator_type> prec_op_;
+};
+
+#endif // HAVE_TPETRA_INST_FLOAT
+
+#endif // end MIXED_PRECISION_CORE_HPP
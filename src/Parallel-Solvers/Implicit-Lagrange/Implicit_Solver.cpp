@@ -80,6 +80,7 @@
 #include "ROL_StdBoundConstraint.hpp"
 #include "ROL_ParameterList.hpp"
 #include <ROL_TpetraMultiVector.hpp>
+#include "ROL_SecantFactory.hpp"
 
 //Objective Functions and Constraint Functions
 #include "Topology_Optimization_Function_Headers.h"
@@ -1094,9 +1095,9 @@ void Implicit_Solver::setup_optimization_problem(){
   //Design variables to optimize
   ROL::Ptr<ROL::Vector<real_t>> x;
   if(nodal_density_flag)
-    x = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(design_node_densities_distributed);
+    x = ROL::makePtr<ROL_MV>(design_node_densities_distributed);
   else
-    x = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities);
+    x = ROL::makePtr<ROL_MV>(Global_Element_Densities);
 
   //set bounds on design variables
   ROL::Ptr<ROL::BoundConstraint<real_t> > bnd, mma_bnd;
@@ -1135,8 +1136,8 @@ void Implicit_Solver::setup_optimization_problem(){
       
       mma_lower_bound_node_densities_distributed->putScalar(-0.1);
       mma_upper_bound_node_densities_distributed->putScalar(0.1);
-      mma_lower_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(mma_lower_bound_node_densities_distributed);
-      mma_upper_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(mma_upper_bound_node_densities_distributed);
+      mma_lower_bounds = ROL::makePtr<ROL_MV>(mma_lower_bound_node_densities_distributed);
+      mma_upper_bounds = ROL::makePtr<ROL_MV>(mma_upper_bound_node_densities_distributed);
       
       mma_bnd = ROL::makePtr<ROL::Bounds<real_t>>(mma_lower_bounds, mma_upper_bounds);
     }
@@ -1270,12 +1271,12 @@ void Implicit_Solver::setup_optimization_problem(){
   }
     
   if(nodal_density_flag){
-    lower_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(lower_bound_node_densities_distributed);
-    upper_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(upper_bound_node_densities_distributed);
+    lower_bounds = ROL::makePtr<ROL_MV>(lower_bound_node_densities_distributed);
+    upper_bounds = ROL::makePtr<ROL_MV>(upper_bound_node_densities_distributed);
   }
   else{
-    lower_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities_Lower_Bound);
-    upper_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities_Upper_Bound);
+    lower_bounds = ROL::makePtr<ROL_MV>(Global_Element_Densities_Lower_Bound);
+    upper_bounds = ROL::makePtr<ROL_MV>(Global_Element_Densities_Upper_Bound);
   }
   bnd = ROL::makePtr<ROL::Bounds<real_t>>(lower_bounds, upper_bounds);
   
@@ -1570,12 +1571,29 @@ void Implicit_Solver::setup_optimization_problem(){
   //obj->checkGradient(*rol_x, *rol_d);
   
 
+  //periodic optimizer state checkpoints and resume from a previous checkpoint
+  ROL::Ptr<ROL::Secant<real_t>> secant;
+  ROL::Ptr<OptimizationCheckpoint_TopOpt> checkpoint;
+  Optimization_Options &optimization_options = simparam.optimization_options;
+  if(nodal_density_flag && (optimization_options.optimization_checkpoint_freq > 0 || !optimization_options.optimization_resume_file.empty())){
+    //the solver uses this secant so its history can be saved
+    secant = ROL::SecantFactory<real_t>(*parlist);
+    checkpoint = ROL::makePtr<OptimizationCheckpoint_TopOpt>(this, secant, optimization_options.optimization_checkpoint_file,
+                                                             optimization_options.optimization_checkpoint_freq);
+    if(!optimization_options.optimization_resume_file.empty())
+      checkpoint->resume(optimization_options.optimization_resume_file, *problem, *parlist);
+  }
+
   // Instantiate Solver.
-  ROL::Solver<real_t> solver(problem,*parlist);
+  ROL::Solver<real_t> solver(problem,*parlist,secant);
     
   // Solve optimization problem.
   //std::ostream outStream;
-  solver.solve(*fos);
+  solver.solve(*fos,checkpoint);
+
+  //lattice design for continuing on a finer mesh
+  if(!simparam.optimization_options.continuation_design_output.empty())
+    write_design_field(simparam.optimization_options.continuation_design_output);
 
   //print final constraint satisfaction
   //fea_elasticity->compute_element_masses(design_densities,false);
@@ -3108,6 +3126,10 @@ void Implicit_Solver::init_design(){
       node_densities(inode,0) = 1;
     }
 
+    //start from the design of a coarser run
+    if(!simparam.optimization_options.continuation_design_input.empty())
+      prolongate_design_field(simparam.optimization_options.continuation_design_input, node_densities);
+
     //sync device view
     //dual_node_densities.sync_device();
     }
@@ -84,6 +84,7 @@ class StrainEnergyMinimize_TopOpt : public ROL::Objective<real_t> {
   typedef MV::dual_view_type::t_dev vec_array;
   typedef MV::dual_view_type::t_host host_vec_array;
   typedef Kokkos::View<const real_t**, array_layout, HostSpace, memory_traits> const_host_vec_array;
+  typedef Kokkos::View<const real_t**, array_layout, device_type, memory_traits> const_vec_array;
   typedef MV::dual_view_type dual_vec_array;
 
 private:
@@ -152,7 +153,6 @@ public:
 
     current_step++;
     ROL::Ptr<const MV> zp = getVector(z);
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
 
     if (type == ROL::UpdateType::Initial)  {
       // This is the first call to update
@@ -219,7 +219,6 @@ public:
     //*fos << std::endl;
     //std::fflush(stdout);
 
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
     //communicate ghosts and solve for nodal degrees of freedom as a function of the current design variables
     /*
     if(last_comm_step!=current_step){
@@ -278,11 +277,12 @@ public:
     }
     */
     //FEM_->gradient_print_sync=0;
-    //get local view of the data
-    host_vec_array objective_gradients = gp->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
-
-    FEM_->compute_adjoint_gradients(design_densities, objective_gradients);
+    //get local view of the data on the device, the gradient is computed without a host copy
+    { //view scope
+      vec_array objective_gradients = gp->getLocalView<device_type> (Tpetra::Access::ReadWrite);
+      const_vec_array design_densities = zp->getLocalView<device_type> (Tpetra::Access::ReadOnly);
+      FEM_->compute_adjoint_gradients(design_densities, objective_gradients);
+    } //end view scope
     gp->scale(1/initial_strain_energy);
       //debug print of gradient
       //std::ostream &out = std::cout;
@@ -51,5 +51,6 @@
 #include "Heat_Capacity_Potential_Constraint.h"
 #include "Multi_Objective.h"
 #include "MMA_Objective.hpp"
+#include "Optimization_Checkpoint.h"
 
 #endif // end HEADER_H
@@ -83,6 +83,7 @@ class MassConstraint_TopOpt : public ROL::Constraint<real_t> {
   typedef MV::dual_view_type::t_dev vec_array;
   typedef MV::dual_view_type::t_host host_vec_array;
   typedef Kokkos::View<const real_t**, array_layout, HostSpace, memory_traits> const_host_vec_array;
+  typedef Kokkos::View<const real_t**, array_layout, device_type, memory_traits> const_vec_array;
   typedef MV::dual_view_type dual_vec_array;
 
 private:
@@ -119,7 +120,7 @@ public:
     inequality_flag_ = inequality_flag;
     constraint_value_ = constraint_value;
     ROL_Element_Masses = ROL::makePtr<ROL_MV>(FEM_->Global_Element_Masses);
-    const_host_vec_array design_densities = FEM_->design_node_densities_distributed->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
+    const_vec_array design_densities = FEM_->design_node_densities_distributed->getLocalView<device_type> (Tpetra::Access::ReadOnly);
     
     FEM_->compute_element_masses(design_densities,true,use_initial_coords_);
     FEM_->mass_init = true;
@@ -143,7 +144,6 @@ public:
     current_step++;
 
     ROL::Ptr<const MV> zp = getVector(z);
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
 
     if (type == ROL::UpdateType::Initial)  {
 
@@ -176,7 +176,7 @@ public:
     //std::cout << "Started constraint value on task " <<FEM_->myrank <<std::endl;
     ROL::Ptr<const MV> zp = getVector(z);
     ROL::Ptr<std::vector<real_t>> cp = dynamic_cast<ROL::StdVector<real_t>&>(c).getVector();
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
+    const_vec_array design_densities = zp->getLocalView<device_type> (Tpetra::Access::ReadOnly);
 
     //communicate ghosts and solve for nodal degrees of freedom as a function of the current design variables
     /*
@@ -220,10 +220,7 @@ public:
     //ROL::Ptr<ROL_MV> ROL_Element_Volumes;
 
     //get local view of the data
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
-    //host_vec_array constraint_gradients = constraint_gradients_distributed->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
-    host_vec_array constraint_gradients = ajvp->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
-    //host_vec_array dual_constraint_vector = vp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
+    const_vec_array design_densities = zp->getLocalView<device_type> (Tpetra::Access::ReadOnly);
 
     //communicate ghosts
     /*
@@ -232,10 +229,11 @@ public:
       last_comm_step = current_step;
     }
     */
-    int rnum_elem = FEM_->rnum_elem;
-
     if(nodal_density_flag_){
-      FEM_->compute_nodal_gradients(design_densities, constraint_gradients, use_initial_coords_);
+      { //view scope
+        vec_array constraint_gradients = ajvp->getLocalView<device_type> (Tpetra::Access::ReadWrite);
+        FEM_->compute_nodal_gradients(design_densities, constraint_gradients, use_initial_coords_);
+      } //end view scope
       //debug print of gradient
       //std::ostream &out = std::cout;
       //Teuchos::RCP<Teuchos::FancyOStream> fos = Teuchos::fancyOStream(Teuchos::rcpFromRef(out));
@@ -244,18 +242,13 @@ public:
       //ajvp->describe(*fos,Teuchos::VERB_EXTREME);
       //*fos << std::endl;
       //std::fflush(stdout);
-      for(int i = 0; i < FEM_->nlocal_nodes; i++){
-        constraint_gradients(i,0) *= (*vp)[0]/initial_mass;
-      }
+      ajvp->scale((*vp)[0]/initial_mass);
     }
     else{
       //update per element volumes
       FEM_->compute_element_volumes();
       //ROL_Element_Volumes = ROL::makePtr<ROL_MV>(FEM_->Global_Element_Volumes);
-      //local view of element volumes
-      const_host_vec_array element_volumes = FEM_->Global_Element_Volumes->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
-      for(int ig = 0; ig < rnum_elem; ig++)
-        constraint_gradients(ig,0) = element_volumes(ig,0)*(*vp)[0]/initial_mass;
+      ajvp->update((*vp)[0]/initial_mass, *FEM_->Global_Element_Volumes, 0);
     }
     
     //std::cout << "Ended constraint adjoint grad on task " <<FEM_->myrank  << std::endl;
@@ -277,8 +270,7 @@ public:
     //ROL::Ptr<ROL_MV> ROL_Element_Volumes;
 
     //get local view of the data
-    const_host_vec_array design_densities = zp->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
-    host_vec_array constraint_gradients = constraint_gradients_distributed->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
+    const_vec_array design_densities = zp->getLocalView<device_type> (Tpetra::Access::ReadOnly);
 
     //communicate ghosts and solve for nodal degrees of freedom as a function of the current design variables
     //communicate ghosts
@@ -288,22 +280,18 @@ public:
       last_comm_step = current_step;
     }
     */
-    int rnum_elem = FEM_->rnum_elem;
-
     if(nodal_density_flag_){
-      FEM_->compute_nodal_gradients(design_densities, constraint_gradients);
-      for(int i = 0; i < FEM_->nlocal_nodes; i++){
-        constraint_gradients(i,0) /= initial_mass;
-      }
+      { //view scope
+        vec_array constraint_gradients = constraint_gradients_distributed->getLocalView<device_type> (Tpetra::Access::ReadWrite);
+        FEM_->compute_nodal_gradients(design_densities, constraint_gradients);
+      } //end view scope
+      constraint_gradients_distributed->scale(1/initial_mass);
     }
     else{
       //update per element volumes
       FEM_->compute_element_volumes();
       //ROL_Element_Volumes = ROL::makePtr<ROL_MV>(FEM_->Global_Element_Volumes);
-      //local view of element volumes
-      const_host_vec_array element_volumes = FEM_->Global_Element_Volumes->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
-      for(int ig = 0; ig < rnum_elem; ig++)
-        constraint_gradients(ig,0) = element_volumes(ig,0)/initial_mass;
+      constraint_gradients_distributed->update(1/initial_mass, *FEM_->Global_Element_Volumes, 0);
     }
 
     ROL_Gradients = ROL::makePtr<ROL_MV>(constraint_gradients_distributed);
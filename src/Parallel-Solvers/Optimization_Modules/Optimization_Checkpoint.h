@@ -0,0 +1,352 @@
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+ 
+#ifndef OPTIMIZATION_CHECKPOINT_TOPOPT_H
+#define OPTIMIZATION_CHECKPOINT_TOPOPT_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <mpi.h>
+#include "matar.h"
+#include <Teuchos_RCP.hpp>
+
+#include <Tpetra_Core.hpp>
+#include <Tpetra_Map.hpp>
+#include <Tpetra_MultiVector.hpp>
+#include "Tpetra_Import.hpp"
+
+#include "ROL_Types.hpp"
+#include <ROL_TpetraMultiVector.hpp>
+#include "ROL_PartitionedVector.hpp"
+#include "ROL_StatusTest.hpp"
+#include "ROL_Secant.hpp"
+#include "ROL_Problem.hpp"
+#include "ROL_ParameterList.hpp"
+#include "Solver.h"
+
+/* ----------------------------------------------------------------------------------------
+   Status test that periodically writes the optimizer state (design, iteration counter,
+   trust region radius or penalty parameter, Lagrange multipliers and quasi-Newton pairs)
+   and restores it when a run is resumed. It never stops the optimizer itself; ROL
+   combines it with the status test from the parameter list.
+
+   Nodal vectors go to <file>.bin in global node order, one slab per rank written with
+   MPI-IO; the scalar state goes to <file>.txt. Both are written to temporaries and renamed
+   so an interrupted write keeps the previous checkpoint.
+------------------------------------------------------------------------------------------- */
+
+class OptimizationCheckpoint_TopOpt : public ROL::StatusTest<real_t> {
+  
+  typedef Tpetra::Map<>::local_ordinal_type LO;
+  typedef Tpetra::Map<>::global_ordinal_type GO;
+  typedef Tpetra::Map<>::node_type Node;
+  typedef Tpetra::Map<LO, GO, Node> Map;
+  typedef Tpetra::MultiVector<real_t, LO, GO, Node> MV;
+  typedef ROL::Vector<real_t> V;
+  typedef ROL::TpetraMultiVector<real_t,LO,GO,Node> ROL_MV;
+  
+  using traits = Kokkos::ViewTraits<LO*, Kokkos::LayoutLeft, void, void>;
+  using array_layout    = typename traits::array_layout;
+  using device_type     = typename traits::device_type;
+  using memory_traits   = typename traits::memory_traits;
+
+  typedef MV::dual_view_type::t_host host_vec_array;
+  typedef Kokkos::View<const real_t**, array_layout, HostSpace, memory_traits> const_host_vec_array;
+
+private:
+
+  Solver *solver_;
+  ROL::Ptr<ROL::Secant<real_t>> secant_;
+  std::string file_name_;
+  int checkpoint_freq_;
+  int iteration_offset_;
+  Teuchos::RCP<MV> sorted_vector_;
+
+  ROL::Ptr<const MV> getVector( const V& x ) {
+    const ROL_MV *xp = dynamic_cast<const ROL_MV*>(&x);
+    if(xp == nullptr) return ROL::nullPtr;
+    return xp->getVector();
+  }
+
+  //design part of an iterate; inequality constraints append slack variables to it
+  ROL::Ptr<const MV> getDesignVector( const ROL::Ptr<V>& x ) {
+    if(x != ROL::nullPtr){
+      ROL::Ptr<const MV> xp = getVector(*x);
+      if(xp != ROL::nullPtr) return xp;
+      const ROL::PartitionedVector<real_t> *xpart = dynamic_cast<const ROL::PartitionedVector<real_t>*>(x.get());
+      if(xpart != nullptr) return getVector(*xpart->get(0));
+    }
+    return solver_->design_node_densities_distributed;
+  }
+
+  //file offset of this rank's slab of a nodal vector
+  MPI_Offset slabOffset(int slot) {
+    MPI_Offset first_gid = 0;
+    if(solver_->sorted_map->getLocalNumElements())
+      first_gid = solver_->sorted_map->getMinGlobalIndex();
+    return ((MPI_Offset) slot*solver_->num_nodes + first_gid)*sizeof(real_t);
+  }
+
+  void writeVector(MPI_File file, int slot, const MV &source) {
+    sorted_vector_->doImport(source, *solver_->node_sorting_importer, Tpetra::INSERT);
+    const_host_vec_array values = sorted_vector_->getLocalView<HostSpace> (Tpetra::Access::ReadOnly);
+    MPI_File_write_at_all(file, slabOffset(slot), values.data(), (int) values.extent(0), MPI_DOUBLE, MPI_STATUS_IGNORE);
+  }
+
+  void readVector(MPI_File file, int slot, MV &target) {
+    {
+      host_vec_array values = sorted_vector_->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
+      MPI_File_read_at_all(file, slabOffset(slot), values.data(), (int) values.extent(0), MPI_DOUBLE, MPI_STATUS_IGNORE);
+    }
+    //reverse of the sorting import returns the values to the partitioned node map
+    target.doExport(*sorted_vector_, *solver_->node_sorting_importer, Tpetra::INSERT);
+  }
+
+public:
+
+  OptimizationCheckpoint_TopOpt(Solver *solver, ROL::Ptr<ROL::Secant<real_t>> secant, std::string file_name, int checkpoint_freq)
+  {
+    solver_ = solver;
+    secant_ = secant;
+    file_name_ = file_name;
+    checkpoint_freq_ = checkpoint_freq;
+    iteration_offset_ = 0;
+    sorted_vector_ = Teuchos::rcp(new MV(solver_->sorted_map, 1));
+  }
+
+  /* --------------------------------------------------------------------------------------
+   Write a checkpoint every checkpoint_freq iterations; always lets the optimizer continue
+  ----------------------------------------------------------------------------------------- */
+
+  bool check( ROL::AlgorithmState<real_t> &state ) override {
+    if(checkpoint_freq_ > 0 && state.iter > 0 && state.iter%checkpoint_freq_ == 0)
+      writeCheckpoint(state);
+    return true;
+  }
+
+  /* --------------------------------------------------------------------------------------
+   Write the current optimizer state
+  ----------------------------------------------------------------------------------------- */
+
+  void writeCheckpoint( const ROL::AlgorithmState<real_t> &state ) {
+    int iteration = iteration_offset_ + state.iter;
+    std::string data_name = file_name_ + ".bin";
+    std::string header_name = file_name_ + ".txt";
+    ROL::Ptr<const MV> design = getDesignVector(state.iterateVec);
+
+    //quasi-Newton pairs; only kept when they live on the design vector alone
+    std::vector<ROL::Ptr<const MV>> secant_vectors;
+    std::vector<real_t> secant_products;
+    if(secant_ != ROL::nullPtr){
+      const ROL::Ptr<ROL::SecantState<real_t>> &secant_state = secant_->get_state();
+      for(int ipair = 0; ipair <= secant_state->current; ipair++){
+        ROL::Ptr<const MV> step = getVector(*secant_state->iterDiff[ipair]);
+        ROL::Ptr<const MV> gradient_change = getVector(*secant_state->gradDiff[ipair]);
+        if(step == ROL::nullPtr || gradient_change == ROL::nullPtr){
+          secant_vectors.clear();
+          secant_products.clear();
+          break;
+        }
+        secant_vectors.push_back(step);
+        secant_vectors.push_back(gradient_change);
+        secant_products.push_back(secant_state->product[ipair]);
+      }
+    }
+
+    //Lagrange multipliers of the (few) design constraints
+    std::vector<real_t> multipliers;
+    if(state.lagmultVec != ROL::nullPtr){
+      for(int imult = 0; imult < state.lagmultVec->dimension(); imult++)
+        multipliers.push_back(state.lagmultVec->dot(*state.lagmultVec->basis(imult)));
+    }
+
+    //nodal vectors in parallel
+    MPI_File data_file;
+    std::string temp_data_name = data_name + ".tmp";
+    MPI_File_open(solver_->world, temp_data_name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &data_file);
+    writeVector(data_file, 0, *design);
+    for(int ivector = 0; ivector < secant_vectors.size(); ivector++)
+      writeVector(data_file, ivector + 1, *secant_vectors[ivector]);
+    MPI_File_close(&data_file);
+
+    if(solver_->myrank == 0){
+      std::string temp_header_name = header_name + ".tmp";
+      std::ofstream header(temp_header_name);
+      header.precision(17);
+      header << "iteration " << iteration << std::endl;
+      header << "objective " << state.value << std::endl;
+      header << "gradient_norm " << state.gnorm << std::endl;
+      header << "constraint_norm " << state.cnorm << std::endl;
+      header << "step_norm " << state.snorm << std::endl;
+      header << "search_size " << state.searchSize << std::endl;
+      header << "objective_normalization_constant " << solver_->simparam.optimization_options.objective_normalization_constant << std::endl;
+      header << "num_nodes " << solver_->num_nodes << std::endl;
+      header << "multipliers " << multipliers.size();
+      for(int imult = 0; imult < multipliers.size(); imult++)
+        header << " " << multipliers[imult];
+      header << std::endl << "secant_pairs " << secant_products.size();
+      for(int ipair = 0; ipair < secant_products.size(); ipair++)
+        header << " " << secant_products[ipair];
+      header << std::endl;
+      header.close();
+
+      std::rename(temp_data_name.c_str(), data_name.c_str());
+      std::rename(temp_header_name.c_str(), header_name.c_str());
+      std::cout << "Wrote optimizer checkpoint for iteration " << iteration << " to " << file_name_ << std::endl;
+    }
+    MPI_Barrier(solver_->world);
+  }
+
+  /* --------------------------------------------------------------------------------------
+   Restore a checkpoint into the finalized problem and adjust the parameter list so the
+   optimizer continues from the checkpointed iteration
+  ----------------------------------------------------------------------------------------- */
+
+  void resume( const std::string &file_name, ROL::Problem<real_t> &problem, ROL::ParameterList &parlist ) {
+    int read_status = 1;
+    int iteration = 0;
+    long long int num_nodes = 0;
+    real_t search_size = 0;
+    real_t normalization_constant = 0;
+    int num_multipliers = 0, num_pairs = 0;
+    std::vector<real_t> multipliers, secant_products;
+
+    if(solver_->myrank == 0){
+      std::ifstream header(file_name + ".txt");
+      std::string label;
+      real_t unused;
+      header >> label >> iteration;
+      header >> label >> unused >> label >> unused >> label >> unused >> label >> unused;
+      header >> label >> search_size;
+      header >> label >> normalization_constant;
+      header >> label >> num_nodes;
+      header >> label >> num_multipliers;
+      multipliers.resize(num_multipliers > 0 ? num_multipliers : 0);
+      for(int imult = 0; imult < multipliers.size(); imult++)
+        header >> multipliers[imult];
+      header >> label >> num_pairs;
+      secant_products.resize(num_pairs > 0 ? num_pairs : 0);
+      for(int ipair = 0; ipair < secant_products.size(); ipair++)
+        header >> secant_products[ipair];
+      if(!header){
+        std::cout << "Could not read the optimizer checkpoint " << file_name << ".txt" << std::endl;
+        read_status = 0;
+      }
+      else if(num_nodes != solver_->num_nodes){
+        std::cout << "Optimizer checkpoint " << file_name << " was written for " << num_nodes
+                  << " nodes; this mesh has " << solver_->num_nodes << std::endl;
+        read_status = 0;
+      }
+    }
+
+    MPI_Bcast(&read_status, 1, MPI_INT, 0, solver_->world);
+    if(!read_status)
+      solver_->exit_solver(0);
+
+    MPI_Bcast(&iteration, 1, MPI_INT, 0, solver_->world);
+    MPI_Bcast(&search_size, 1, MPI_DOUBLE, 0, solver_->world);
+    MPI_Bcast(&normalization_constant, 1, MPI_DOUBLE, 0, solver_->world);
+    MPI_Bcast(&num_multipliers, 1, MPI_INT, 0, solver_->world);
+    MPI_Bcast(&num_pairs, 1, MPI_INT, 0, solver_->world);
+    multipliers.resize(num_multipliers);
+    secant_products.resize(num_pairs);
+    MPI_Bcast(multipliers.data(), num_multipliers, MPI_DOUBLE, 0, solver_->world);
+    MPI_Bcast(secant_products.data(), num_pairs, MPI_DOUBLE, 0, solver_->world);
+
+    iteration_offset_ = iteration;
+    //keep the objective scaled by the initial design of the first run
+    if(normalization_constant != 0)
+      solver_->simparam.optimization_options.objective_normalization_constant = normalization_constant;
+
+    //design and quasi-Newton pairs
+    MPI_File data_file;
+    std::string data_name = file_name + ".bin";
+    MPI_File_open(solver_->world, data_name.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &data_file);
+    readVector(data_file, 0, *solver_->design_node_densities_distributed);
+    solver_->all_node_densities_distributed->doImport(*solver_->design_node_densities_distributed, *solver_->importer, Tpetra::INSERT);
+
+    if(secant_ != ROL::nullPtr && num_pairs > 0){
+      const ROL::Ptr<ROL::SecantState<real_t>> &secant_state = secant_->get_state();
+      secant_state->iterDiff.clear();
+      secant_state->gradDiff.clear();
+      secant_state->product.clear();
+      //keep the most recent pairs if the storage shrank
+      int first_pair = std::max(num_pairs - secant_state->storage, 0);
+      for(int ipair = first_pair; ipair < num_pairs; ipair++){
+        Teuchos::RCP<MV> step = Teuchos::rcp(new MV(solver_->map, 1));
+        Teuchos::RCP<MV> gradient_change = Teuchos::rcp(new MV(solver_->map, 1));
+        readVector(data_file, 2*ipair + 1, *step);
+        readVector(data_file, 2*ipair + 2, *gradient_change);
+        secant_state->iterDiff.push_back(ROL::makePtr<ROL_MV>(step));
+        secant_state->gradDiff.push_back(ROL::makePtr<ROL_MV>(gradient_change));
+        secant_state->product.push_back(secant_products[ipair]);
+      }
+      secant_state->current = num_pairs - first_pair - 1;
+    }
+    MPI_File_close(&data_file);
+
+    //initial multipliers
+    const ROL::Ptr<V> &multiplier = problem.getMultiplierVector();
+    if(multiplier != ROL::nullPtr && multiplier->dimension() == num_multipliers){
+      for(int imult = 0; imult < num_multipliers; imult++){
+        ROL::Ptr<V> direction = multiplier->basis(imult);
+        multiplier->axpy(multipliers[imult] - multiplier->dot(*direction), *direction);
+      }
+    }
+
+    //remaining iterations and the last trust region radius or penalty parameter
+    ROL::ParameterList &status_list = parlist.sublist("Status Test");
+    int iteration_limit = status_list.get("Iteration Limit", 100);
+    status_list.set("Iteration Limit", std::max(iteration_limit - iteration_offset_, 0));
+    if(search_size > 0){
+      ROL::EProblem problem_type = problem.getProblemType();
+      if(problem_type == ROL::TYPE_E || problem_type == ROL::TYPE_EB)
+        parlist.sublist("Step").sublist("Augmented Lagrangian").set("Initial Penalty Parameter", search_size);
+      else if(parlist.sublist("Step").get("Type", std::string("")) == "Trust Region")
+        parlist.sublist("Step").sublist("Trust Region").set("Initial Radius", search_size);
+    }
+
+    if(solver_->myrank == 0)
+      std::cout << "Resuming optimization from iteration " << iteration_offset_ << " of checkpoint " << file_name << std::endl;
+  }
+};
+
+#endif // end header guard
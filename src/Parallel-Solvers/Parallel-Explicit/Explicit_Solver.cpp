@@ -84,6 +84,7 @@
 #include "ROL_StdBoundConstraint.hpp"
 #include "ROL_ParameterList.hpp"
 #include <ROL_TpetraMultiVector.hpp>
+#include "ROL_SecantFactory.hpp"
 
 //Objective Functions and Constraint Functions
 //#include "Topology_Optimization_Function_Headers.h"
@@ -91,6 +92,7 @@
 #include "Moment_of_Inertia_Constraint.h"
 #include "Kinetic_Energy_Minimize.h"
 #include "Area_Normals.h"
+#include "Optimization_Checkpoint.h"
 
 #define BUFFER_LINES 20000
 #define MAX_WORD 30
@@ -1147,10 +1149,10 @@ void Explicit_Solver::setup_optimization_problem(){
   //Design variables to optimize
   ROL::Ptr<ROL::Vector<real_t>> x;
   if(nodal_density_flag){
-    x = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(design_node_densities_distributed);
+    x = ROL::makePtr<ROL_MV>(design_node_densities_distributed);
   }
   else
-    x = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities);
+    x = ROL::makePtr<ROL_MV>(Global_Element_Densities);
   
   //Instantiate (the one) objective function for the problem
   ROL::Ptr<ROL::Objective<real_t>> obj;
@@ -1417,12 +1419,12 @@ void Explicit_Solver::setup_optimization_problem(){
   ROL::Ptr<ROL::Vector<real_t> > lower_bounds;
   ROL::Ptr<ROL::Vector<real_t> > upper_bounds;
   if(nodal_density_flag){
-    lower_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(lower_bound_node_densities_distributed);
-    upper_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(upper_bound_node_densities_distributed);
+    lower_bounds = ROL::makePtr<ROL_MV>(lower_bound_node_densities_distributed);
+    upper_bounds = ROL::makePtr<ROL_MV>(upper_bound_node_densities_distributed);
   }
   else{
-    lower_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities_Lower_Bound);
-    upper_bounds = ROL::makePtr<ROL::TpetraMultiVector<real_t,LO,GO>>(Global_Element_Densities_Upper_Bound);
+    lower_bounds = ROL::makePtr<ROL_MV>(Global_Element_Densities_Lower_Bound);
+    upper_bounds = ROL::makePtr<ROL_MV>(Global_Element_Densities_Upper_Bound);
   }
   ROL::Ptr<ROL::BoundConstraint<real_t> > bnd = ROL::makePtr<ROL::Bounds<real_t>>(lower_bounds, upper_bounds);
   problem->addBoundConstraint(bnd);
@@ -1491,12 +1493,29 @@ void Explicit_Solver::setup_optimization_problem(){
   //obj->checkGradient(*rol_x, *rol_d);
   
 
+  //periodic optimizer state checkpoints and resume from a previous checkpoint
+  ROL::Ptr<ROL::Secant<real_t>> secant;
+  ROL::Ptr<OptimizationCheckpoint_TopOpt> checkpoint;
+  Optimization_Options &optimization_options = simparam.optimization_options;
+  if(nodal_density_flag && (optimization_options.optimization_checkpoint_freq > 0 || !optimization_options.optimization_resume_file.empty())){
+    //the solver uses this secant so its history can be saved
+    secant = ROL::SecantFactory<real_t>(*parlist);
+    checkpoint = ROL::makePtr<OptimizationCheckpoint_TopOpt>(this, secant, optimization_options.optimization_checkpoint_file,
+                                                             optimization_options.optimization_checkpoint_freq);
+    if(!optimization_options.optimization_resume_file.empty())
+      checkpoint->resume(optimization_options.optimization_resume_file, *problem, *parlist);
+  }
+
   // Instantiate Solver.
-  ROL::Solver<real_t> solver(problem,*parlist);
+  ROL::Solver<real_t> solver(problem,*parlist,secant);
     
   // Solve optimization problem.
   //std::ostream outStream;
-  solver.solve(*fos);
+  solver.solve(*fos,checkpoint);
+
+  //lattice design for continuing on a finer mesh
+  if(!simparam.optimization_options.continuation_design_output.empty())
+    write_design_field(simparam.optimization_options.continuation_design_output);
 
   //print final constraint satisfaction
   //fea_elasticity->compute_element_masses(design_densities,false);
@@ -3313,8 +3332,14 @@ void Explicit_Solver::init_design(){
         design_node_densities_distributed = Teuchos::rcp(new MV(map, 1));
         host_vec_array node_densities = design_node_densities_distributed->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
       
-        for(int inode = 0; inode < nlocal_nodes; inode++){
-          node_densities(inode,0) = 1;
+        if(simparam.optimization_options.continuation_design_input.empty()){
+          for(int inode = 0; inode < nlocal_nodes; inode++){
+            node_densities(inode,0) = 1;
+          }
+        }
+        else{
+          //start from the design of a coarser run
+          prolongate_design_field(simparam.optimization_options.continuation_design_input, node_densities);
         }
       }
     }
@@ -3322,8 +3347,14 @@ void Explicit_Solver::init_design(){
       design_node_densities_distributed = Teuchos::rcp(new MV(map, 1));
       host_vec_array node_densities = design_node_densities_distributed->getLocalView<HostSpace> (Tpetra::Access::ReadWrite);
     
-      for(int inode = 0; inode < nlocal_nodes; inode++){
-        node_densities(inode,0) = 1;
+      if(simparam.optimization_options.continuation_design_input.empty()){
+        for(int inode = 0; inode < nlocal_nodes; inode++){
+          node_densities(inode,0) = 1;
+        }
+      }
+      else{
+        //start from the design of a coarser run
+        prolongate_design_field(simparam.optimization_options.continuation_design_input, node_densities);
       }
     }
       //allocate global vector information
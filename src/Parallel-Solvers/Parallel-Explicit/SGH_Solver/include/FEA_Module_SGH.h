@@ -78,6 +78,8 @@ public:
 
     void setup();
 
+    void init_mesh_state();
+
     void cleanup_material_models();
 
     int solve();
@@ -86,6 +88,10 @@ public:
 
     void sgh_solve();
 
+    bool check_load_balance(double element_time, bool repartition);
+
+    void repartition_state(Teuchos::RCP<MV> node_weights_distributed);
+
     void get_force_sgh(const DCArrayKokkos<material_t>& material,
                        const mesh_t& mesh,
                        const DViewCArrayKokkos<double>& node_coords,
@@ -420,6 +426,14 @@ public:
 
     virtual void update_forward_solve(Teuchos::RCP<const MV> zp);
 
+    bool forward_solve_matches(Teuchos::RCP<const MV> solved_design, Teuchos::RCP<const MV> zp);
+
+    bool forward_solve_is_current(Teuchos::RCP<const MV> zp);
+
+    bool forward_solve_is_cached(Teuchos::RCP<const MV> zp);
+
+    void swap_forward_solve_cache();
+
     void comm_node_masses();
 
     void comm_adjoint_vector(int cycle);
@@ -616,6 +630,22 @@ public:
     std::vector<real_t> time_data;
     int max_time_steps, last_time_step;
 
+    // forward solve cache; a second set of forward buffers holding the previous design's solve
+    bool forward_solve_cache;
+    Teuchos::RCP<MV> forward_solve_design; // design the current forward buffers were solved for
+    Teuchos::RCP<MV> cached_forward_solve_design; // design of the cached buffers, null when empty
+    Teuchos::RCP<MV> forward_solve_design_difference;
+    Teuchos::RCP<std::vector<Teuchos::RCP<MV>>> cached_forward_solve_velocity_data;
+    Teuchos::RCP<std::vector<Teuchos::RCP<MV>>> cached_forward_solve_coordinate_data;
+    Teuchos::RCP<std::vector<Teuchos::RCP<MV>>> cached_forward_solve_internal_energy_data;
+    std::vector<real_t> cached_time_data;
+    int cached_last_time_step;
+    DCArrayKokkos<double> cached_relative_element_densities;
+    CArrayKokkos<double>  cached_elem_den;
+    CArrayKokkos<double>  cached_elem_mass;
+    CArrayKokkos<double>  cached_node_mass;
+    CArrayKokkos<double>  cached_corner_mass;
+
     // ---------------------------------------------------------------------
     //    state data type declarations (must stay in scope for output after run)
     // ---------------------------------------------------------------------
@@ -42,6 +42,8 @@
 #include <sys/stat.h>
 #include <mpi.h>
 #include <chrono>
+#include <vector>
+#include <utility>
 #include <Teuchos_ScalarTraits.hpp>
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_oblackholestream.hpp>
@@ -176,6 +178,26 @@ FEA_Module_SGH::FEA_Module_SGH(
             (*phi_adjoint_vector_data)[istep] = Teuchos::rcp(new MV(all_node_map, simparam->num_dims));
             (*psi_adjoint_vector_data)[istep] = Teuchos::rcp(new MV(all_element_map, 1));
         }
+
+        // second set of forward buffers so rejected trial designs can be reverted without a solve
+        forward_solve_cache = simparam->optimization_options.forward_solve_cache;
+        if (forward_solve_cache) {
+            forward_solve_design_difference    = Teuchos::rcp(new MV(map, 1));
+            cached_forward_solve_velocity_data = Teuchos::rcp(new std::vector<Teuchos::RCP<MV>>(max_time_steps + 1));
+            cached_forward_solve_coordinate_data = Teuchos::rcp(new std::vector<Teuchos::RCP<MV>>(max_time_steps + 1));
+            cached_forward_solve_internal_energy_data = Teuchos::rcp(new std::vector<Teuchos::RCP<MV>>(max_time_steps + 1));
+            cached_time_data.resize(max_time_steps + 1);
+            cached_last_time_step = -1;
+
+            for (int istep = 0; istep < max_time_steps + 1; istep++) {
+                (*cached_forward_solve_velocity_data)[istep]   = Teuchos::rcp(new MV(all_node_map, simparam->num_dims));
+                (*cached_forward_solve_coordinate_data)[istep] = Teuchos::rcp(new MV(all_node_map, simparam->num_dims));
+                (*cached_forward_solve_internal_energy_data)[istep] = Teuchos::rcp(new MV(all_element_map, 1));
+            }
+        }
+    }
+    else {
+        forward_solve_cache = false;
     }
 
     have_loading_conditions = false;
@@ -1104,6 +1126,26 @@ void FEA_Module_SGH::sgh_solve()
         (*forward_solve_coordinate_data)[0]->assign(*Explicit_Solver_Pointer_->all_node_coords_distributed);
     }
 
+    // wall time spent in element kernels between load balance checks
+    const int load_balance_check_freq = dynamic_options.load_balance_check_freq;
+    double    element_time = 0.0;
+    double    element_time_start = 0.0;
+
+    // the state migrated by repartition_state is that of a 3D run of this module alone
+    bool repartition_on_imbalance = num_dim == 3 && !topology_optimization_on && !shape_optimization_on
+                                    && Explicit_Solver_Pointer_->nfea_modules == 1;
+    for (size_t mat_id = 0; mat_id < material.size(); mat_id++) {
+        // EVPFFT models hold per element state outside the state vars
+        if (material.host(mat_id).strength_model == STRENGTH_MODEL::evpfft
+            || material.host(mat_id).strength_model == STRENGTH_MODEL::ls_evpfft) {
+            repartition_on_imbalance = false;
+        }
+    }
+    if (load_balance_check_freq > 0 && !repartition_on_imbalance && myrank == 0) {
+        printf("WARNING: repartitioning during the run needs a 3D mesh, a single module, no optimization and no EVPFFT strength model; "
+               "imbalance checks will only write partition weights \n");
+    }
+
     // loop over the max number of time integration cycles
     for (cycle = 0; cycle < cycle_stop; cycle++) {
         // get the step
@@ -1175,6 +1217,10 @@ void FEA_Module_SGH::sgh_solve()
             } // end if 2D
 
             // ---- calculate the forces on the vertices and evolve stress (hypo model) ----
+            if (load_balance_check_freq > 0) {
+                Kokkos::fence();
+                element_time_start = Explicit_Solver_Pointer_->CPU_Time();
+            }
             if (num_dim == 2) {
                 get_force_sgh2D(material,
                                 *mesh,
@@ -1209,6 +1255,10 @@ void FEA_Module_SGH::sgh_solve()
                               rk_alpha,
                               cycle);
             }
+            if (load_balance_check_freq > 0) {
+                Kokkos::fence();
+                element_time += Explicit_Solver_Pointer_->CPU_Time() - element_time_start;
+            }
 
 #ifdef DEBUG
             if (myrank == 1) {
@@ -1335,6 +1385,10 @@ void FEA_Module_SGH::sgh_solve()
             get_vol();
 
             // ---- Calculate elem state (den, pres, sound speed, stress) for next time step ----
+            if (load_balance_check_freq > 0) {
+                Kokkos::fence();
+                element_time_start = Explicit_Solver_Pointer_->CPU_Time();
+            }
             if (num_dim == 2) {
                 update_state2D(material,
                                *mesh,
@@ -1367,6 +1421,10 @@ void FEA_Module_SGH::sgh_solve()
                              rk_alpha,
                              cycle);
             }
+            if (load_balance_check_freq > 0) {
+                Kokkos::fence();
+                element_time += Explicit_Solver_Pointer_->CPU_Time() - element_time_start;
+            }
             // ----
             // Notes on strength:
             //    1) hyper-elastic strength models are called in update_state
@@ -1640,6 +1698,18 @@ void FEA_Module_SGH::sgh_solve()
             }
         }
 
+        if (load_balance_check_freq > 0 && (cycle + 1) % load_balance_check_freq == 0) {
+            if (check_load_balance(element_time, repartition_on_imbalance)) {
+                // sizes taken from the previous decomposition
+                nlocal_elem_non_overlapping = Explicit_Solver_Pointer_->nlocal_elem_non_overlapping;
+                node_extensive_mass = CArrayKokkos<double>(nall_nodes, "node_extensive_mass");
+                FOR_ALL_CLASS(node_gid, 0, nall_nodes, {
+                    node_extensive_mass(node_gid) = node_mass(node_gid);
+                }); // end parallel for
+            }
+            element_time = 0.0;
+        }
+
         size_t write = 0;
         if ((cycle + 1) % graphics_cyc_ival == 0 && cycle > 0) {
             write = 1;
@@ -1765,3 +1835,501 @@ void FEA_Module_SGH::sgh_solve()
 
     return;
 } // end of SGH solve
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn check_load_balance
+///
+/// \brief Compare the element work measured on each rank and, when the
+///        ranks are out of balance, weight the nodes by the measured element
+///        costs; the weights repartition the running mesh and are written
+///        for the startup partition of the next run when a file is given
+///
+/// \param Wall time this rank spent in element kernels since the last check
+/// \param Whether the mesh and state may be repartitioned during the run
+///
+/// \return True when the mesh and state were repartitioned
+///
+/////////////////////////////////////////////////////////////////////////////
+bool FEA_Module_SGH::check_load_balance(double element_time, bool repartition)
+{
+    const int    myrank = Explicit_Solver_Pointer_->myrank;
+    const int    nranks = Explicit_Solver_Pointer_->nranks;
+    const size_t num_materials = simparam->material.size();
+    const size_t num_nodes_in_elem = mesh->num_nodes_in_elem;
+
+    double max_element_time, total_element_time;
+    MPI_Allreduce(&element_time, &max_element_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&element_time, &total_element_time, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    if (total_element_time <= 0.0) {
+        return false;
+    }
+
+    double imbalance = max_element_time * nranks / total_element_time;
+    if (myrank == 0) {
+        printf("element work imbalance across ranks = %f \n", imbalance);
+    }
+    if (imbalance <= simparam->dynamic_options.load_balance_tolerance || (!repartition && simparam->partition_weights_file.empty())) {
+        return false;
+    }
+
+    // each rank's time is the sum of its element counts times a per element cost for each
+    // material; fit those costs to all ranks in the least squares sense
+    std::vector<double> elem_count(num_materials, 0.0);
+    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
+        elem_count[elem_mat_id.host(elem_gid)] += 1.0;
+    }
+
+    std::vector<double> normal_matrix(num_materials * num_materials), normal_rhs(num_materials);
+    for (size_t imat = 0; imat < num_materials; imat++) {
+        for (size_t jmat = 0; jmat < num_materials; jmat++) {
+            normal_matrix[imat * num_materials + jmat] = elem_count[imat] * elem_count[jmat];
+        }
+        normal_rhs[imat] = elem_count[imat] * element_time;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, normal_matrix.data(), num_materials * num_materials, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, normal_rhs.data(), num_materials, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+    double local_elems = rnum_elem, total_elems;
+    MPI_Allreduce(&local_elems, &total_elems, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    double mean_cost = total_element_time / total_elems;
+
+    // pull materials that no mix of ranks separates toward the mean cost
+    double trace = 0.0;
+    for (size_t imat = 0; imat < num_materials; imat++) {
+        trace += normal_matrix[imat * num_materials + imat];
+    }
+    double regularization = 1e-3 * trace / num_materials;
+    for (size_t imat = 0; imat < num_materials; imat++) {
+        normal_matrix[imat * num_materials + imat] += regularization;
+        normal_rhs[imat] += regularization * mean_cost;
+    }
+
+    // gaussian elimination with partial pivoting on the small normal system
+    for (size_t icol = 0; icol < num_materials; icol++) {
+        size_t pivot = icol;
+        for (size_t irow = icol + 1; irow < num_materials; irow++) {
+            if (fabs(normal_matrix[irow * num_materials + icol]) > fabs(normal_matrix[pivot * num_materials + icol])) {
+                pivot = irow;
+            }
+        }
+        for (size_t jcol = 0; jcol < num_materials; jcol++) {
+            std::swap(normal_matrix[icol * num_materials + jcol], normal_matrix[pivot * num_materials + jcol]);
+        }
+        std::swap(normal_rhs[icol], normal_rhs[pivot]);
+        for (size_t irow = icol + 1; irow < num_materials; irow++) {
+            double factor = normal_matrix[irow * num_materials + icol] / normal_matrix[icol * num_materials + icol];
+            for (size_t jcol = icol; jcol < num_materials; jcol++) {
+                normal_matrix[irow * num_materials + jcol] -= factor * normal_matrix[icol * num_materials + jcol];
+            }
+            normal_rhs[irow] -= factor * normal_rhs[icol];
+        }
+    }
+
+    DCArrayKokkos<double> material_cost(num_materials, "material_cost");
+    for (int imat = num_materials - 1; imat >= 0; imat--) {
+        double cost = normal_rhs[imat];
+        for (size_t jmat = imat + 1; jmat < num_materials; jmat++) {
+            cost -= normal_matrix[imat * num_materials + jmat] * material_cost.host(jmat);
+        }
+        material_cost.host(imat) = cost / normal_matrix[imat * num_materials + imat];
+    }
+    for (size_t imat = 0; imat < num_materials; imat++) {
+        material_cost.host(imat) = fmax(material_cost.host(imat), 0.01 * mean_cost);
+        if (myrank == 0) {
+            printf("measured cost per element of material %lu = %e s \n", imat, material_cost.host(imat));
+        }
+    }
+    material_cost.update_device();
+
+    // spread the element costs to their nodes, the objects the partitioner moves
+    Teuchos::RCP<MV> node_weights_distributed = Teuchos::rcp(new MV(map, 1));
+    {
+        vec_array node_weights = node_weights_distributed->getLocalView<device_type>(Tpetra::Access::ReadWrite);
+        CArrayKokkos<size_t> num_corners_in_node = mesh->num_corners_in_node;
+        RaggedRightArrayKokkos<size_t> elems_in_node = mesh->elems_in_node;
+        FOR_ALL_CLASS(node_gid, 0, nlocal_nodes, {
+            double weight = 0.0;
+            for (size_t corner_lid = 0; corner_lid < num_corners_in_node(node_gid); corner_lid++) {
+                size_t elem_gid = elems_in_node(node_gid, corner_lid);
+                weight += material_cost(elem_mat_id(elem_gid)) / num_nodes_in_elem;
+            }
+            node_weights(node_gid, 0) = weight;
+        }); // end parallel for
+        Kokkos::fence();
+    }
+
+    // each rank writes its slab of the weights in global node order
+    if (!simparam->partition_weights_file.empty()) {
+        Teuchos::RCP<MV> sorted_node_weights_distributed = Teuchos::rcp(new MV(Explicit_Solver_Pointer_->sorted_map, 1));
+        sorted_node_weights_distributed->doImport(*node_weights_distributed, *Explicit_Solver_Pointer_->node_sorting_importer, Tpetra::INSERT);
+        {
+            const_host_vec_array sorted_node_weights = sorted_node_weights_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+            MPI_Offset first_gid = 0;
+            if (sorted_node_weights.extent(0)) {
+                first_gid = Explicit_Solver_Pointer_->sorted_map->getMinGlobalIndex();
+            }
+            MPI_File weights_file;
+            MPI_File_open(MPI_COMM_WORLD, simparam->partition_weights_file.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &weights_file);
+            MPI_File_set_size(weights_file, (MPI_Offset)Explicit_Solver_Pointer_->num_nodes * sizeof(double));
+            MPI_File_write_at_all(weights_file, first_gid * sizeof(double), sorted_node_weights.data(),
+                                  (int)sorted_node_weights.extent(0), MPI_DOUBLE, MPI_STATUS_IGNORE);
+            MPI_File_close(&weights_file);
+        }
+
+        if (myrank == 0) {
+            printf("Wrote cost weighted partition node weights to %s \n", simparam->partition_weights_file.c_str());
+        }
+    }
+
+    if (!repartition) {
+        return false;
+    }
+
+    if (myrank == 0) {
+        printf("Repartitioning the mesh by measured element cost \n");
+    }
+    repartition_state(node_weights_distributed);
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn repartition_state
+///
+/// \brief Repartition the nodes with the given weights and migrate the
+///        nodal and element state of the current cycle to the new
+///        decomposition
+///
+/// The solver rebuilds its maps, importers and distributed vectors; the
+/// mesh connectivity, state arrays and material models of this module are
+/// then rebuilt over them and filled with the migrated state. Boundary set
+/// membership travels with the nodes, so boundary sets are not retagged.
+///
+/// \param Weight of each local node
+///
+/////////////////////////////////////////////////////////////////////////////
+void FEA_Module_SGH::repartition_state(Teuchos::RCP<MV> node_weights_distributed)
+{
+    const size_t rk_level    = simparam->dynamic_options.rk_num_bins - 1;
+    const size_t rk_num_bins = simparam->dynamic_options.rk_num_bins;
+    const size_t num_bcs     = module_params->boundary_conditions.size();
+    const int    num_dim     = simparam->num_dims;
+    const DCArrayKokkos<material_t> material = simparam->material;
+
+    const size_t num_eos_state_vars      = simparam->max_num_eos_state_vars;
+    const size_t num_strength_state_vars = simparam->max_num_strength_state_vars;
+    const size_t num_user_output_vars    = simparam->output_options.max_num_user_output_vars;
+
+    // node state columns: velocity, initial coordinates, mass, then a flag per boundary set
+    const size_t initial_coords_column = num_dim;
+    const size_t node_mass_column      = 2 * num_dim;
+    const size_t bdy_column = node_mass_column + 1;
+    const size_t num_node_columns = bdy_column + num_bdy_sets;
+
+    // element state columns: den, pres, sspd, sie, vol, div, mass, mat_id, stress, then the model state
+    const size_t stress_column   = 8;
+    const size_t eos_column      = stress_column + 9;
+    const size_t strength_column = eos_column + num_eos_state_vars;
+    const size_t output_column   = strength_column + num_strength_state_vars;
+    const size_t num_elem_columns = output_column + num_user_output_vars;
+
+    // ---------------------------------------------------------------------
+    //    pack the state owned by this rank under the current maps
+    // ---------------------------------------------------------------------
+    Teuchos::RCP<MV> node_state_distributed = Teuchos::rcp(new MV(map, num_node_columns));
+    { // view scope
+        vec_array node_state     = node_state_distributed->getLocalView<device_type>(Tpetra::Access::ReadWrite);
+        vec_array node_coords_interface = Explicit_Solver_Pointer_->node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadWrite);
+        const_vec_array initial_node_coords = Explicit_Solver_Pointer_->initial_node_coords_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+        FOR_ALL_CLASS(node_gid, 0, nlocal_nodes, {
+            for (int idim = 0; idim < num_dim; idim++) {
+                node_coords_interface(node_gid, idim) = node_coords(rk_level, node_gid, idim);
+                node_state(node_gid, idim) = node_vel(rk_level, node_gid, idim);
+                node_state(node_gid, initial_coords_column + idim) = initial_node_coords(node_gid, idim);
+            }
+            node_state(node_gid, node_mass_column) = node_mass(node_gid);
+            for (size_t bdy_set = 0; bdy_set < num_bdy_sets; bdy_set++) {
+                node_state(node_gid, bdy_column + bdy_set) = 0.0;
+            }
+        }); // end parallel for
+        Kokkos::fence();
+
+        // flag the boundary sets each owned node belongs to
+        FOR_ALL_CLASS(bdy_set, 0, num_bdy_sets, {
+            for (size_t bdy_node_lid = 0; bdy_node_lid < num_bdy_nodes_in_set(bdy_set); bdy_node_lid++) {
+                size_t bdy_node_gid = bdy_nodes_in_set(bdy_set, bdy_node_lid);
+                if (bdy_node_gid < nlocal_nodes) {
+                    node_state(bdy_node_gid, bdy_column + bdy_set) = 1.0;
+                }
+            }
+        }); // end parallel for
+        Kokkos::fence();
+    } // end view scope
+
+    // local ids of the elements in the non-overlapping element map
+    const size_t nlocal_elem_non_overlapping = Explicit_Solver_Pointer_->nlocal_elem_non_overlapping;
+    DCArrayKokkos<size_t> nonoverlapping_elem_gids(nlocal_elem_non_overlapping, "nonoverlapping_elem_gids");
+    for (size_t ielem = 0; ielem < nlocal_elem_non_overlapping; ielem++) {
+        nonoverlapping_elem_gids.host(ielem) = all_element_map->getLocalElement(element_map->getGlobalElement(ielem));
+    }
+    nonoverlapping_elem_gids.update_device();
+
+    Teuchos::RCP<MV> elem_state_distributed = Teuchos::rcp(new MV(element_map, num_elem_columns));
+    { // view scope
+        vec_array elem_state = elem_state_distributed->getLocalView<device_type>(Tpetra::Access::ReadWrite);
+        FOR_ALL_CLASS(ielem, 0, nlocal_elem_non_overlapping, {
+            size_t elem_gid = nonoverlapping_elem_gids(ielem);
+            elem_state(ielem, 0) = elem_den(elem_gid);
+            elem_state(ielem, 1) = elem_pres(elem_gid);
+            elem_state(ielem, 2) = elem_sspd(elem_gid);
+            elem_state(ielem, 3) = elem_sie(rk_level, elem_gid);
+            elem_state(ielem, 4) = elem_vol(elem_gid);
+            elem_state(ielem, 5) = elem_div(elem_gid);
+            elem_state(ielem, 6) = elem_mass(elem_gid);
+            elem_state(ielem, 7) = elem_mat_id(elem_gid);
+            for (size_t i = 0; i < 3; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    elem_state(ielem, stress_column + 3 * i + j) = elem_stress(rk_level, elem_gid, i, j);
+                }
+            }
+            for (size_t ivar = 0; ivar < num_eos_state_vars; ivar++) {
+                elem_state(ielem, eos_column + ivar) = eos_state_vars(elem_gid, ivar);
+            }
+            for (size_t ivar = 0; ivar < num_strength_state_vars; ivar++) {
+                elem_state(ielem, strength_column + ivar) = strength_state_vars(elem_gid, ivar);
+            }
+            for (size_t ivar = 0; ivar < num_user_output_vars; ivar++) {
+                elem_state(ielem, output_column + ivar) = elem_user_output_vars(elem_gid, ivar);
+            }
+        }); // end parallel for
+        Kokkos::fence();
+    } // end view scope
+
+    // models run on the host keep their state current on the host side
+    { // view scope
+        host_vec_array elem_state = elem_state_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
+        for (size_t ielem = 0; ielem < nlocal_elem_non_overlapping; ielem++) {
+            size_t elem_gid = nonoverlapping_elem_gids.host(ielem);
+            size_t mat_id   = elem_mat_id.host(elem_gid);
+            if (material.host(mat_id).eos_run_location == RUN_LOCATION::host) {
+                for (size_t ivar = 0; ivar < num_eos_state_vars; ivar++) {
+                    elem_state(ielem, eos_column + ivar) = eos_state_vars.host(elem_gid, ivar);
+                }
+            }
+            if (material.host(mat_id).strength_run_location == RUN_LOCATION::host) {
+                for (size_t ivar = 0; ivar < num_strength_state_vars; ivar++) {
+                    elem_state(ielem, strength_column + ivar) = strength_state_vars.host(elem_gid, ivar);
+                }
+                for (size_t ivar = 0; ivar < num_user_output_vars; ivar++) {
+                    elem_state(ielem, output_column + ivar) = elem_user_output_vars.host(elem_gid, ivar);
+                }
+            }
+        }
+    } // end view scope
+
+    cleanup_material_models();
+
+    // ---------------------------------------------------------------------
+    //    repartition and rebuild the solver maps and vectors
+    // ---------------------------------------------------------------------
+    Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> previous_map = map;
+    Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> previous_element_map = element_map;
+
+    std::vector<real_t> node_weights(nlocal_nodes);
+    { // view scope
+        const_host_vec_array node_weights_host = node_weights_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        for (size_t node_gid = 0; node_gid < nlocal_nodes; node_gid++) {
+            node_weights[node_gid] = node_weights_host(node_gid, 0);
+        }
+    } // end view scope
+
+    Explicit_Solver_Pointer_->partition_nodes(node_weights);
+    Explicit_Solver_Pointer_->repartition_elements(previous_map);
+    Explicit_Solver_Pointer_->init_maps();
+    Explicit_Solver_Pointer_->init_state_vectors();
+    Explicit_Solver_Pointer_->init_boundaries();
+
+    // copies of the solver data held by this module
+    nlocal_nodes = Explicit_Solver_Pointer_->nlocal_nodes;
+    nghost_nodes = Explicit_Solver_Pointer_->nghost_nodes;
+    nall_nodes   = Explicit_Solver_Pointer_->nall_nodes;
+    rnum_elem    = Explicit_Solver_Pointer_->rnum_elem;
+    importer       = Explicit_Solver_Pointer_->importer;
+    ghost_importer = Explicit_Solver_Pointer_->ghost_importer;
+    node_sorting_importer    = Explicit_Solver_Pointer_->node_sorting_importer;
+    element_sorting_importer = Explicit_Solver_Pointer_->element_sorting_importer;
+    dof_importer    = Explicit_Solver_Pointer_->dof_importer;
+    map             = Explicit_Solver_Pointer_->map;
+    ghost_node_map  = Explicit_Solver_Pointer_->ghost_node_map;
+    all_node_map    = Explicit_Solver_Pointer_->all_node_map;
+    element_map     = Explicit_Solver_Pointer_->element_map;
+    all_element_map = Explicit_Solver_Pointer_->all_element_map;
+    local_dof_map   = Explicit_Solver_Pointer_->local_dof_map;
+    all_dof_map     = Explicit_Solver_Pointer_->all_dof_map;
+    global_nodes_in_elem_distributed    = Explicit_Solver_Pointer_->global_nodes_in_elem_distributed;
+    node_nconn_distributed              = Explicit_Solver_Pointer_->node_nconn_distributed;
+    node_coords_distributed             = Explicit_Solver_Pointer_->node_coords_distributed;
+    all_node_coords_distributed         = Explicit_Solver_Pointer_->all_node_coords_distributed;
+    initial_node_coords_distributed     = Explicit_Solver_Pointer_->initial_node_coords_distributed;
+    all_initial_node_coords_distributed = Explicit_Solver_Pointer_->all_initial_node_coords_distributed;
+    design_node_densities_distributed   = Explicit_Solver_Pointer_->design_node_densities_distributed;
+    all_node_densities_distributed      = Explicit_Solver_Pointer_->all_node_densities_distributed;
+    Global_Element_Densities            = Explicit_Solver_Pointer_->Global_Element_Densities;
+    Element_Types      = Explicit_Solver_Pointer_->Element_Types;
+    nboundary_patches  = Explicit_Solver_Pointer_->nboundary_patches;
+    Boundary_Patches   = Explicit_Solver_Pointer_->Boundary_Patches;
+    Local_Index_Boundary_Patches        = Explicit_Solver_Pointer_->Local_Index_Boundary_Patches;
+    initial_node_velocities_distributed = Explicit_Solver_Pointer_->initial_node_velocities_distributed;
+    node_velocities_distributed     = Explicit_Solver_Pointer_->node_velocities_distributed;
+    all_node_velocities_distributed = Explicit_Solver_Pointer_->all_node_velocities_distributed;
+
+    if (design_node_densities_distributed != Teuchos::null) {
+        all_node_densities_distributed->doImport(*design_node_densities_distributed, *importer, Tpetra::INSERT);
+    }
+
+    // ---------------------------------------------------------------------
+    //    migrate the state to the local and ghost nodes and elements
+    // ---------------------------------------------------------------------
+    Teuchos::RCP<MV> all_node_state_distributed = Teuchos::rcp(new MV(all_node_map, num_node_columns));
+    Tpetra::Import<LO, GO> node_state_importer(previous_map, all_node_map);
+    all_node_state_distributed->doImport(*node_state_distributed, node_state_importer, Tpetra::INSERT);
+
+    Teuchos::RCP<MV> all_elem_state_distributed = Teuchos::rcp(new MV(all_element_map, num_elem_columns));
+    Tpetra::Import<LO, GO> elem_state_importer(previous_element_map, all_element_map);
+    all_elem_state_distributed->doImport(*elem_state_distributed, elem_state_importer, Tpetra::INSERT);
+
+    init_mesh_state();
+
+    { // view scope
+        const_host_vec_array all_node_state = all_node_state_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        host_vec_array all_node_velocities  = all_node_velocities_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
+        host_vec_array all_initial_node_coords = all_initial_node_coords_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
+        for (size_t node_gid = 0; node_gid < nall_nodes; node_gid++) {
+            for (int idim = 0; idim < num_dim; idim++) {
+                for (size_t rk = 0; rk < rk_num_bins; rk++) {
+                    node_vel.host(rk, node_gid, idim) = all_node_state(node_gid, idim);
+                }
+                all_node_velocities(node_gid, idim)     = all_node_state(node_gid, idim);
+                all_initial_node_coords(node_gid, idim) = all_node_state(node_gid, initial_coords_column + idim);
+            }
+            node_mass.host(node_gid) = all_node_state(node_gid, node_mass_column);
+        }
+    } // end view scope
+    node_coords.update_device();
+    node_vel.update_device();
+    node_mass.update_device();
+
+    { // view scope
+        const_host_vec_array all_elem_state = all_elem_state_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
+            elem_den.host(elem_gid)    = all_elem_state(elem_gid, 0);
+            elem_pres.host(elem_gid)   = all_elem_state(elem_gid, 1);
+            elem_sspd.host(elem_gid)   = all_elem_state(elem_gid, 2);
+            elem_vol.host(elem_gid)    = all_elem_state(elem_gid, 4);
+            elem_div.host(elem_gid)    = all_elem_state(elem_gid, 5);
+            elem_mass.host(elem_gid)   = all_elem_state(elem_gid, 6);
+            elem_mat_id.host(elem_gid) = (size_t)all_elem_state(elem_gid, 7);
+            for (size_t rk = 0; rk < rk_num_bins; rk++) {
+                elem_sie.host(rk, elem_gid) = all_elem_state(elem_gid, 3);
+                for (size_t i = 0; i < 3; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        elem_stress.host(rk, elem_gid, i, j) = all_elem_state(elem_gid, stress_column + 3 * i + j);
+                    }
+                }
+            }
+        }
+    } // end view scope
+    elem_den.update_device();
+    elem_pres.update_device();
+    elem_sspd.update_device();
+    elem_sie.update_device();
+    elem_vol.update_device();
+    elem_div.update_device();
+    elem_mass.update_device();
+    elem_mat_id.update_device();
+    elem_stress.update_device();
+
+    // the models are built over the new elements, then given the migrated state
+    init_state_vars(material,
+                    elem_mat_id,
+                    eos_state_vars,
+                    strength_state_vars,
+                    eos_global_vars,
+                    strength_global_vars,
+                    elem_user_output_vars,
+                    rnum_elem);
+
+    { // view scope
+        const_host_vec_array all_elem_state = all_elem_state_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
+            for (size_t ivar = 0; ivar < num_eos_state_vars; ivar++) {
+                eos_state_vars.host(elem_gid, ivar) = all_elem_state(elem_gid, eos_column + ivar);
+            }
+            for (size_t ivar = 0; ivar < num_strength_state_vars; ivar++) {
+                strength_state_vars.host(elem_gid, ivar) = all_elem_state(elem_gid, strength_column + ivar);
+            }
+            for (size_t ivar = 0; ivar < num_user_output_vars; ivar++) {
+                elem_user_output_vars.host(elem_gid, ivar) = all_elem_state(elem_gid, output_column + ivar);
+            }
+        }
+    } // end view scope
+    eos_state_vars.update_device();
+    strength_state_vars.update_device();
+    elem_user_output_vars.update_device();
+
+    init_strength_model(elem_strength,
+                        material,
+                        elem_mat_id,
+                        eos_state_vars,
+                        strength_state_vars,
+                        eos_global_vars,
+                        strength_global_vars,
+                        elem_user_output_vars,
+                        rnum_elem);
+
+    init_eos_model(elem_eos,
+                   material,
+                   elem_mat_id,
+                   eos_state_vars,
+                   strength_state_vars,
+                   eos_global_vars,
+                   strength_global_vars,
+                   elem_user_output_vars,
+                   rnum_elem);
+
+    // ---------------------------------------------------------------------
+    //    boundary sets from the migrated membership flags
+    // ---------------------------------------------------------------------
+    mesh->init_bdy_sets(num_bcs);
+    bdy_patches_in_set = mesh->bdy_patches_in_set;
+
+    num_bdy_nodes_in_set = mesh->num_bdy_nodes_in_set = DCArrayKokkos<size_t>(num_bdy_sets, "num_bdy_nodes_in_set");
+    { // view scope
+        const_vec_array all_node_state = all_node_state_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
+        FOR_ALL_CLASS(bdy_set, 0, num_bdy_sets, {
+            num_bdy_nodes_in_set(bdy_set) = 0;
+            for (size_t node_gid = 0; node_gid < nall_nodes; node_gid++) {
+                if (all_node_state(node_gid, bdy_column + bdy_set) > 0.5) {
+                    num_bdy_nodes_in_set(bdy_set)++;
+                }
+            }
+        }); // end parallel for
+        Kokkos::fence();
+
+        bdy_nodes_in_set = mesh->bdy_nodes_in_set = RaggedRightArrayKokkos<size_t>(num_bdy_nodes_in_set, "bdy_nodes_in_set");
+
+        FOR_ALL_CLASS(bdy_set, 0, num_bdy_sets, {
+            size_t bdy_node_lid = 0;
+            for (size_t node_gid = 0; node_gid < nall_nodes; node_gid++) {
+                if (all_node_state(node_gid, bdy_column + bdy_set) > 0.5) {
+                    bdy_nodes_in_set(bdy_set, bdy_node_lid) = node_gid;
+                    bdy_node_lid++;
+                }
+            }
+        }); // end parallel for
+        Kokkos::fence();
+    } // end view scope
+    num_bdy_nodes_in_set.update_host();
+}
@@ -107,11 +107,8 @@ void FEA_Module_SGH::get_force_vgradient_sgh(const DCArrayKokkos<material_t>& ma
     Kokkos::fence();
 
     // --- calculate the forces acting on the nodes from the element ---
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
-
+    FOR_ALL_CLASS(elem_gid, 0, rnum_elem, {
         const size_t num_nodes_in_elem = 8;
-        real_t gradient_result[num_dims];
         // total Cauchy stress
         double tau_array[9];
         double tau_gradient_array[9];
@@ -124,18 +121,18 @@ void FEA_Module_SGH::get_force_vgradient_sgh(const DCArrayKokkos<material_t>& ma
 
         // the sums in the Riemann solver
         double sum_array[4];
-        double sum_gradient_array[4 * max_nodes_per_element * num_dims];
+        double sum_gradient_array[4 * 8 * 3];
 
         // corner shock impeadance x |corner area normal dot shock_dir|
         double muc_array[8];
-        double muc_gradient_array[8 * max_nodes_per_element * num_dims];
+        double muc_gradient_array[8 * 8 * 3];
 
         // Riemann velocity
         double vel_star_array[3];
-        double vel_star_gradient_array[num_dims * max_nodes_per_element * num_dims];
+        double vel_star_gradient_array[3 * 8 * 3];
 
         // mag_vel gradient
-        double mag_vel_gradient_array[max_nodes_per_element * num_dims];
+        double mag_vel_gradient_array[8 * 3];
 
         // velocity gradient
         double vel_grad_array[9];
@@ -499,7 +496,6 @@ void FEA_Module_SGH::get_force_vgradient_sgh(const DCArrayKokkos<material_t>& ma
         // loop over the each node in the elem
         for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
             size_t corner_lid = node_lid;
-            size_t column_index;
 
             // Get corner gid
             size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
@@ -509,24 +505,14 @@ void FEA_Module_SGH::get_force_vgradient_sgh(const DCArrayKokkos<material_t>& ma
 
             // loop over dimension
             for (int dim = 0; dim < num_dims; dim++) {
-                // assign gradient of corner contribution of force to relevant matrix entries with non-zero node velocity gradient
+                // store the gradient of the corner force; it is gathered into the node rows below
                 for (int igradient = 0; igradient < num_nodes_in_elem; igradient++) {
-                    size_t gradient_node_gid = nodes_in_elem(elem_gid, igradient);
-                    column_index = num_dims * Global_Gradient_Matrix_Assembly_Map(elem_gid, igradient, node_lid);
                     for (int jdim = 0; jdim < num_dims; jdim++) {
                         if (node_lid == igradient && jdim == dim) {
-                            if (map->isNodeLocalElement(gradient_node_gid)) {
-                                Force_Gradient_Velocities(gradient_node_gid * num_dims + jdim, column_index + dim) += phi * (muc(node_lid) * (vel_star_gradient(dim, igradient, jdim) - 1) +
-                                                                                                                             muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim)));
-                            }
                             corner_gradient_storage(corner_gid, dim, igradient, jdim) = phi * (muc(node_lid) * (vel_star_gradient(dim, igradient, jdim) - 1) +
                                                                                                muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim)));
                         }
                         else {
-                            if (map->isNodeLocalElement(gradient_node_gid)) {
-                                Force_Gradient_Velocities(gradient_node_gid * num_dims + jdim, column_index + dim) += phi * (muc(node_lid) * (vel_star_gradient(dim, igradient, jdim)) +
-                                                                                                                             muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim)));
-                            }
                             corner_gradient_storage(corner_gid, dim, igradient, jdim) = phi * (muc(node_lid) * (vel_star_gradient(dim, igradient, jdim)) +
                                                                                                muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim)));
                         }
@@ -539,8 +525,40 @@ void FEA_Module_SGH::get_force_vgradient_sgh(const DCArrayKokkos<material_t>& ma
         // calculate the new stress at the next rk level, if it is a hypo model
         size_t mat_id = elem_mat_id(elem_gid);
 
-        // }); // end parallel for loop over elements
-    }
+    }); // end parallel for loop over elements
+    Kokkos::fence();
+
+    // --- gather the corner force gradients into the rows of the local nodes ---
+    // each matrix row belongs to exactly one node, so the rows are assembled
+    // without write conflicts by looping over the corners attached to that node
+    FOR_ALL_CLASS(node_gid, 0, nlocal_nodes, {
+        for (size_t corner_lid = 0; corner_lid < num_corners_in_node(node_gid); corner_lid++) {
+            // Get the element and corner of this node
+            size_t elem_gid   = elems_in_node(node_gid, corner_lid);
+            size_t corner_gid = corners_in_node(node_gid, corner_lid);
+
+            // the local index of this node in the element is the gradient index
+            size_t igradient = 0;
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                if (corners_in_elem(elem_gid, node_lid) == corner_gid) {
+                    igradient = node_lid;
+                }
+            }
+
+            // sum the contribution of every corner force in the element
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                size_t force_corner_gid = corners_in_elem(elem_gid, node_lid);
+                size_t column_index     = num_dims * Global_Gradient_Matrix_Assembly_Map(elem_gid, igradient, node_lid);
+                for (int dim = 0; dim < num_dims; dim++) {
+                    for (int jdim = 0; jdim < num_dims; jdim++) {
+                        Force_Gradient_Velocities(node_gid * num_dims + jdim, column_index + dim) +=
+                            corner_gradient_storage(force_corner_gid, dim, igradient, jdim);
+                    }
+                }
+            } // end for node_lid
+        } // end for corner_lid
+    }); // end parallel for loop over nodes
+    Kokkos::fence();
 
     /*
     //accumulate node values from corner storage
@@ -615,11 +633,8 @@ void FEA_Module_SGH::get_force_egradient_sgh(const DCArrayKokkos<material_t>& ma
     Kokkos::fence();
 
     // --- calculate the forces acting on the nodes from the element ---
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
-
+    FOR_ALL_CLASS(elem_gid, 0, rnum_elem, {
         const size_t num_nodes_in_elem = 8;
-        real_t gradient_result[num_dims];
         // total Cauchy stress
         double tau_array[9];
         double tau_gradient_array[9];
@@ -968,8 +983,8 @@ void FEA_Module_SGH::get_force_egradient_sgh(const DCArrayKokkos<material_t>& ma
         // calculate the new stress at the next rk level, if it is a hypo model
 
         size_t mat_id = elem_mat_id(elem_gid);
-    }
-    // }); // end parallel for loop over elements
+    }); // end parallel for loop over elements
+    Kokkos::fence();
 
     /*
     //accumulate node values from corner storage
@@ -1042,37 +1057,34 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
     }); // end parallel for loop over nodes
     Kokkos::fence();
     // --- calculate the forces acting on the nodes from the element ---
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
-
+    FOR_ALL_CLASS(elem_gid, 0, rnum_elem, {
         const size_t num_nodes_in_elem = 8;
-        real_t gradient_result[num_dims];
         // total Cauchy stress
         double tau_array[9];
-        double tau_gradient_array[9 * max_nodes_per_element * num_dims];
+        double tau_gradient_array[9 * 8 * 3];
 
         // corner area normals
-        double area_normal_gradients_array[max_nodes_per_element * max_nodes_per_element * num_dims * num_dims];
+        double area_normal_gradients_array[8 * 8 * 3 * 3];
         double area_normal_array[24];
 
         // volume data
         double volume;
-        double volume_gradients_array[max_nodes_per_element * num_dims];
+        double volume_gradients_array[8 * 3];
 
         // estimate of shock direction
         double shock_dir_array[3];
 
         // the sums in the Riemann solver
         double sum_array[4];
-        double sum_gradient_array[4 * max_nodes_per_element * num_dims];
+        double sum_gradient_array[4 * 8 * 3];
 
         // corner shock impeadance x |corner area normal dot shock_dir|
         double muc_array[8];
-        double muc_gradient_array[8 * max_nodes_per_element * num_dims];
+        double muc_gradient_array[8 * 8 * 3];
 
         // Riemann velocity
         double vel_star_array[3];
-        double vel_star_gradient_array[num_dims * max_nodes_per_element * num_dims];
+        double vel_star_gradient_array[3 * 8 * 3];
 
         // velocity gradient
         double vel_grad_array[9];
@@ -1080,13 +1092,13 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
         // --- Create views of arrays to aid the force calculation ---
 
         ViewCArrayKokkos<double> tau(tau_array, num_dims, num_dims);
-        ViewCArrayKokkos<double> tau_gradient(tau_gradient_array, num_dims, num_dims, max_nodes_per_element, num_dims);
+        ViewCArrayKokkos<double> tau_gradient(tau_gradient_array, num_dims, num_dims, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> volume_gradients(volume_gradients_array, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> area_normal(area_normal_array, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> area_normal_gradients(area_normal_gradients_array, num_nodes_in_elem, num_dims, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> shock_dir(shock_dir_array, num_dims);
         ViewCArrayKokkos<double> sum(sum_array, 4);
-        ViewCArrayKokkos<double> sum_gradient(sum_gradient_array, 4, max_nodes_per_element, num_dims);
+        ViewCArrayKokkos<double> sum_gradient(sum_gradient_array, 4, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> muc(muc_array, num_nodes_in_elem);
         ViewCArrayKokkos<double> muc_gradient(muc_gradient_array, num_nodes_in_elem, num_nodes_in_elem, num_dims);
         ViewCArrayKokkos<double> vel_star(vel_star_array, num_dims);
@@ -1460,7 +1472,6 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
         // loop over the each node in the elem
         for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
             size_t corner_lid = node_lid;
-            size_t column_index;
 
             // Get corner gid
             size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
@@ -1470,22 +1481,9 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
 
             // loop over dimension
             for (int dim = 0; dim < num_dims; dim++) {
-                // assign gradient of corner contribution of force to relevant matrix entries with non-zero node velocity gradient
+                // store the gradient of the corner force; it is gathered into the node rows below
                 for (int igradient = 0; igradient < num_nodes_in_elem; igradient++) {
                     for (int jdim = 0; jdim < num_dims; jdim++) {
-                        size_t gradient_node_gid = nodes_in_elem(elem_gid, igradient);
-                        // if(!map->isNodeLocalElement(gradient_node_gid)) continue;
-                        column_index = num_dims * Global_Gradient_Matrix_Assembly_Map(elem_gid, igradient, node_lid);
-                        if (map->isNodeLocalElement(gradient_node_gid)) {
-                            Force_Gradient_Positions(gradient_node_gid * num_dims + jdim, column_index + dim) += area_normal(node_lid, 0) * tau_gradient(0, dim, igradient, jdim)
-                                                                                                                 + area_normal(node_lid, 1) * tau_gradient(1, dim, igradient, jdim)
-                                                                                                                 + area_normal(node_lid, 2) * tau_gradient(2, dim, igradient, jdim)
-                                                                                                                 + area_normal_gradients(node_lid, 0, igradient, jdim) * tau(0, dim)
-                                                                                                                 + area_normal_gradients(node_lid, 1, igradient, jdim) * tau(1, dim)
-                                                                                                                 + area_normal_gradients(node_lid, 2, igradient, jdim) * tau(2, dim)
-                                                                                                                 + phi * muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim))
-                                                                                                                 + phi * muc(node_lid) * (vel_star_gradient(dim, igradient, jdim));
-                        }
                         corner_gradient_storage(corner_gid, dim, igradient, jdim) = area_normal(node_lid, 0) * tau_gradient(0, dim, igradient, jdim)
                                                                                     + area_normal(node_lid, 1) * tau_gradient(1, dim, igradient, jdim)
                                                                                     + area_normal(node_lid, 2) * tau_gradient(2, dim, igradient, jdim)
@@ -1494,16 +1492,6 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
                                                                                     + area_normal_gradients(node_lid, 2, igradient, jdim) * tau(2, dim)
                                                                                     + phi * muc_gradient(node_lid, igradient, jdim) * (vel_star(dim) - node_vel(rk_level, node_gid, dim))
                                                                                     + phi * muc(node_lid) * (vel_star_gradient(dim, igradient, jdim));
-                        // if(map->isNodeLocalElement(gradient_node_gid)){
-                        //     Force_Gradient_Positions(gradient_node_gid*num_dims+jdim, column_index+dim) +=
-                        //             + area_normal_gradients(node_lid, 0, igradient, jdim)*tau(0, dim)
-                        //             + area_normal_gradients(node_lid, 1, igradient, jdim)*tau(1, dim)
-                        //             + area_normal_gradients(node_lid, 2, igradient, jdim)*tau(2, dim);
-                        // }
-                        // corner_gradient_storage(corner_gid,dim,igradient,jdim) =
-                        //         + area_normal_gradients(node_lid, 0, igradient, jdim)*tau(0, dim)
-                        //         + area_normal_gradients(node_lid, 1, igradient, jdim)*tau(1, dim)
-                        //         + area_normal_gradients(node_lid, 2, igradient, jdim)*tau(2, dim);
                     }
                 }
             } // end loop over dimension
@@ -1513,8 +1501,40 @@ void FEA_Module_SGH::get_force_ugradient_sgh(const DCArrayKokkos<material_t>& ma
         // calculate the new stress at the next rk level, if it is a hypo model
 
         size_t mat_id = elem_mat_id(elem_gid);
-    }
-    // }); // end parallel for loop over elements
+    }); // end parallel for loop over elements
+    Kokkos::fence();
+
+    // --- gather the corner force gradients into the rows of the local nodes ---
+    // each matrix row belongs to exactly one node, so the rows are assembled
+    // without write conflicts by looping over the corners attached to that node
+    FOR_ALL_CLASS(node_gid, 0, nlocal_nodes, {
+        for (size_t corner_lid = 0; corner_lid < num_corners_in_node(node_gid); corner_lid++) {
+            // Get the element and corner of this node
+            size_t elem_gid   = elems_in_node(node_gid, corner_lid);
+            size_t corner_gid = corners_in_node(node_gid, corner_lid);
+
+            // the local index of this node in the element is the gradient index
+            size_t igradient = 0;
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                if (corners_in_elem(elem_gid, node_lid) == corner_gid) {
+                    igradient = node_lid;
+                }
+            }
+
+            // sum the contribution of every corner force in the element
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                size_t force_corner_gid = corners_in_elem(elem_gid, node_lid);
+                size_t column_index     = num_dims * Global_Gradient_Matrix_Assembly_Map(elem_gid, igradient, node_lid);
+                for (int dim = 0; dim < num_dims; dim++) {
+                    for (int jdim = 0; jdim < num_dims; jdim++) {
+                        Force_Gradient_Positions(node_gid * num_dims + jdim, column_index + dim) +=
+                            corner_gradient_storage(force_corner_gid, dim, igradient, jdim);
+                    }
+                }
+            } // end for node_lid
+        } // end for corner_lid
+    }); // end parallel for loop over nodes
+    Kokkos::fence();
 
     /*
     //accumulate node values from corner storage
@@ -1753,11 +1773,8 @@ void FEA_Module_SGH::get_force_dgradient_sgh(const DCArrayKokkos<material_t>& ma
     const size_t rk_level = simparam->dynamic_options.rk_num_bins - 1;
     const size_t num_dims = simparam->num_dims;
     // --- calculate the forces acting on the nodes from the element ---
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
-
+    FOR_ALL_CLASS(elem_gid, 0, rnum_elem, {
         const size_t num_nodes_in_elem = 8;
-        real_t gradient_result[num_dims];
         // total Cauchy stress
         double tau_array[9];
         double tau_gradient_array[9];
@@ -2080,8 +2097,8 @@ void FEA_Module_SGH::get_force_dgradient_sgh(const DCArrayKokkos<material_t>& ma
         // calculate the new stress at the next rk level, if it is a hypo model
 
         size_t mat_id = elem_mat_id(elem_gid);
-    }
-    // }); // end parallel for loop over elements
+    }); // end parallel for loop over elements
+    Kokkos::fence();
 
     /*
     //accumulate node values from corner storage
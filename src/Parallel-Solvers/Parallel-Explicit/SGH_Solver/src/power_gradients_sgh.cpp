@@ -348,48 +348,51 @@ void FEA_Module_SGH::get_power_ugradient_sgh(double rk_alpha,
     }); // end parallel for loop over nodes
     Kokkos::fence();
 
-    // loop over all the elements in the mesh
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
+    // gather the element power gradients into the rows of the local nodes;
+    // each row belongs to one node so there are no write conflicts
+    FOR_ALL_CLASS(gradient_node_gid, 0, nlocal_nodes, {
+        for (size_t elem_lid = 0; elem_lid < num_corners_in_node(gradient_node_gid); elem_lid++) {
+            size_t elem_gid = elems_in_node(gradient_node_gid, elem_lid);
+            size_t gradient_corner_gid = corners_in_node(gradient_node_gid, elem_lid);
+
+            // the local index of the gradient node in the element
+            size_t igradient = 0;
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                if (corners_in_elem(elem_gid, node_lid) == gradient_corner_gid) {
+                    igradient = node_lid;
+                }
+            }
 
-        double elem_power = 0.0;
+            size_t column_id = Element_Gradient_Matrix_Assembly_Map(elem_gid, igradient);
 
-        // --- tally the contribution from each corner to the element ---
+            // --- tally the contribution from each corner to the element ---
 
-        // Loop over the nodes in the element
-        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
-            size_t corner_lid = node_lid;
-            size_t column_id;
-            size_t gradient_node_id;
-            // Get node global id for the local node id
-            size_t node_gid = nodes_in_elem(elem_gid, node_lid);
+            // Loop over the nodes in the element
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                size_t corner_lid = node_lid;
 
-            // Get the corner global id for the local corner id
-            size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
+                // Get node global id for the local node id
+                size_t node_gid = nodes_in_elem(elem_gid, node_lid);
 
-            double node_radius = 1;
-            if (num_dims == 2) {
-                node_radius = node_coords(rk_level, node_gid, 1);
-            }
+                // Get the corner global id for the local corner id
+                size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
 
-            // calculate the Power=F dot V for this corner
-            for (size_t dim = 0; dim < num_dims; dim++) {
-                for (int igradient = 0; igradient < num_nodes_in_elem; igradient++) {
+                double node_radius = 1;
+                if (num_dims == 2) {
+                    node_radius = node_coords(rk_level, node_gid, 1);
+                }
+
+                // calculate the Power=F dot V for this corner
+                for (size_t dim = 0; dim < num_dims; dim++) {
                     for (size_t jdim = 0; jdim < num_dims; jdim++) {
-                        column_id = Element_Gradient_Matrix_Assembly_Map(elem_gid, igradient);
-                        gradient_node_id = nodes_in_elem(elem_gid, igradient);
-                        if (!map->isNodeLocalElement(gradient_node_id)) {
-                            continue;
-                        }
-                        Power_Gradient_Positions(gradient_node_id * num_dims + jdim, column_id) -=
+                        Power_Gradient_Positions(gradient_node_gid * num_dims + jdim, column_id) -=
                             corner_gradient_storage(corner_gid, dim, igradient, jdim) * node_vel(rk_level, node_gid, dim) * node_radius;
                     }
-                }
-            } // end for dim
-        } // end for node_lid
-
-        // }); // end parallel loop over the elements
-    }
+                } // end for dim
+            } // end for node_lid
+        } // end for elem_lid
+    }); // end parallel loop over the nodes
+    Kokkos::fence();
 
     return;
 } // end subroutine
@@ -422,55 +425,58 @@ void FEA_Module_SGH::get_power_vgradient_sgh(double rk_alpha,
     }); // end parallel for loop over nodes
     Kokkos::fence();
 
-    // loop over all the elements in the mesh
-    for (size_t elem_gid = 0; elem_gid < rnum_elem; elem_gid++) {
-        // FOR_ALL_CLASS (elem_gid, 0, rnum_elem, {
+    // gather the element power gradients into the rows of the local nodes;
+    // each row belongs to one node so there are no write conflicts
+    FOR_ALL_CLASS(gradient_node_gid, 0, nlocal_nodes, {
+        for (size_t elem_lid = 0; elem_lid < num_corners_in_node(gradient_node_gid); elem_lid++) {
+            size_t elem_gid = elems_in_node(gradient_node_gid, elem_lid);
+            size_t gradient_corner_gid = corners_in_node(gradient_node_gid, elem_lid);
+
+            // the local index of the gradient node in the element
+            size_t igradient = 0;
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                if (corners_in_elem(elem_gid, node_lid) == gradient_corner_gid) {
+                    igradient = node_lid;
+                }
+            }
 
-        double elem_power = 0.0;
+            size_t column_id = Element_Gradient_Matrix_Assembly_Map(elem_gid, igradient);
 
-        // --- tally the contribution from each corner to the element ---
+            // --- tally the contribution from each corner to the element ---
 
-        // Loop over the nodes in the element
-        for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
-            size_t corner_lid = node_lid;
-            size_t column_id;
-            size_t gradient_node_id;
-            // Get node global id for the local node id
-            size_t node_gid = nodes_in_elem(elem_gid, node_lid);
+            // Loop over the nodes in the element
+            for (size_t node_lid = 0; node_lid < num_nodes_in_elem; node_lid++) {
+                size_t corner_lid = node_lid;
 
-            // Get the corner global id for the local corner id
-            size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
+                // Get node global id for the local node id
+                size_t node_gid = nodes_in_elem(elem_gid, node_lid);
 
-            double node_radius = 1;
-            if (num_dims == 2) {
-                node_radius = node_coords(rk_level, node_gid, 1);
-            }
+                // Get the corner global id for the local corner id
+                size_t corner_gid = corners_in_elem(elem_gid, corner_lid);
 
-            // calculate the Power=F dot V for this corner
-            for (size_t dim = 0; dim < num_dims; dim++) {
-                for (int igradient = 0; igradient < num_nodes_in_elem; igradient++) {
-                    column_id = Element_Gradient_Matrix_Assembly_Map(elem_gid, igradient);
-                    gradient_node_id = nodes_in_elem(elem_gid, igradient);
-                    if (!map->isNodeLocalElement(gradient_node_id)) {
-                        continue;
-                    }
+                double node_radius = 1;
+                if (num_dims == 2) {
+                    node_radius = node_coords(rk_level, node_gid, 1);
+                }
+
+                // calculate the Power=F dot V for this corner
+                for (size_t dim = 0; dim < num_dims; dim++) {
                     for (size_t jdim = 0; jdim < num_dims; jdim++) {
                         if (node_lid == igradient && jdim == dim) {
-                            Power_Gradient_Velocities(gradient_node_id * num_dims + jdim, column_id) -=
+                            Power_Gradient_Velocities(gradient_node_gid * num_dims + jdim, column_id) -=
                                 corner_gradient_storage(corner_gid, dim, igradient, jdim) * node_vel(rk_level, node_gid, dim)
                                 * node_radius + corner_force(corner_gid, dim) * node_radius;
                         }
                         else {
-                            Power_Gradient_Velocities(gradient_node_id * num_dims + jdim, column_id) -=
+                            Power_Gradient_Velocities(gradient_node_gid * num_dims + jdim, column_id) -=
                                 corner_gradient_storage(corner_gid, dim, igradient, jdim) * node_vel(rk_level, node_gid, dim) * node_radius;
                         }
                     }
-                }
-            } // end for dim
-        } // end for node_lid
-
-        // }); // end parallel loop over the elements
-    }
+                } // end for dim
+            } // end for node_lid
+        } // end for elem_lid
+    }); // end parallel loop over the nodes
+    Kokkos::fence();
 
     return;
 } // end subroutine
@@ -63,68 +63,13 @@ void FEA_Module_SGH::setup()
     }
 
     // ---------------------------------------------------------------------
-    //    obtain mesh data
-    // ---------------------------------------------------------------------
-    sgh_interface_setup(node_interface, elem_interface, corner_interface);
-    mesh->build_corner_connectivity();
-    mesh->build_elem_elem_connectivity();
-    mesh->num_bdy_patches = nboundary_patches;
-    if (num_dim == 2) {
-        mesh->build_patch_connectivity();
-        mesh->build_node_node_connectivity();
-    }
-
-    // ---------------------------------------------------------------------
-    //    allocate memory
+    //    obtain mesh data and allocate state
     // ---------------------------------------------------------------------
-
-    // shorthand names
-    const size_t num_nodes   = mesh->num_nodes;
-    const size_t num_elems   = mesh->num_elems;
-    const size_t num_corners = mesh->num_corners;
-
-    // --- make dual views of data on CPU and GPU ---
-    //  Notes:
-    //     Instead of using a struct of dual types like the mesh type,
-    //     individual dual views will be made for all the state
-    //     variables.  The motivation is to reduce memory movement
-    //     when passing state into a function.  Passing a struct by
-    //     reference will copy the meta data and pointers for the
-    //     variables held inside the struct.  Since all the mesh
-    //     variables are typically used by most functions, a single
-    //     mesh struct or passing the arrays will be roughly equivalent
-    //     for memory movement.
-
-    // create Dual Views of the individual node struct variables
-    node_coords = DViewCArrayKokkos<double>(node_interface.coords.get_kokkos_dual_view().view_host().data(), rk_num_bins, num_nodes, num_dim);
-    node_vel    = DViewCArrayKokkos<double>(node_interface.vel.get_kokkos_dual_view().view_host().data(), rk_num_bins, num_nodes, num_dim);
-    node_mass   = DViewCArrayKokkos<double>(node_interface.mass.get_kokkos_dual_view().view_host().data(), num_nodes);
-
-    // create Dual Views of the individual elem struct variables
-    elem_den    = DViewCArrayKokkos<double>(&elem_interface.den(0), num_elems);
-    elem_pres   = DViewCArrayKokkos<double>(&elem_interface.pres(0), num_elems);
-    elem_stress = DViewCArrayKokkos<double>(&elem_interface.stress(0, 0, 0, 0), rk_num_bins, num_elems, 3, 3); // always 3D even in 2D-RZ
-    elem_sspd   = DViewCArrayKokkos<double>(&elem_interface.sspd(0), num_elems);
-    elem_sie    = DViewCArrayKokkos<double>(&elem_interface.sie(0, 0), rk_num_bins, num_elems);
-    elem_vol    = DViewCArrayKokkos<double>(&elem_interface.vol(0), num_elems);
-    elem_div    = DViewCArrayKokkos<double>(&elem_interface.div(0), num_elems);
-    elem_mass   = DViewCArrayKokkos<double>(&elem_interface.mass(0), num_elems);
-    elem_mat_id = DViewCArrayKokkos<size_t>(&elem_interface.mat_id(0), num_elems);
-
-    // create Dual Views of the corner struct variables
-    corner_force = DViewCArrayKokkos<double>(&corner_interface.force(0, 0), num_corners, num_dim);
-    corner_mass  = DViewCArrayKokkos<double>(&corner_interface.mass(0), num_corners);
-
-    // allocate elem_vel_grad
-    elem_vel_grad = DCArrayKokkos<double>(num_elems, 3, 3);
-
-    // allocate material models
-    elem_eos = DCArrayKokkos<eos_t>(num_elems);
-    elem_strength = DCArrayKokkos<strength_t>(num_elems);
+    init_mesh_state();
 
     // optimization flags
     if (topology_optimization_on) {
-        elem_extensive_initial_energy_condition = DCArrayKokkos<bool>(num_elems);
+        elem_extensive_initial_energy_condition = DCArrayKokkos<bool>(mesh->num_elems);
     }
 
     // ---------------------------------------------------------------------
@@ -142,13 +87,6 @@ void FEA_Module_SGH::setup()
     DCArrayKokkos<mat_fill_t> mat_fill = simparam->mat_fill;
     const DCArrayKokkos<material_t> material = simparam->material;
 
-    // Constitutive model data
-    eos_global_vars = simparam->eos_global_vars;
-    strength_global_vars = simparam->strength_global_vars;
-    eos_state_vars = DCArrayKokkos<double>(rnum_elem, simparam->max_num_eos_state_vars);
-    strength_state_vars   = DCArrayKokkos<double>(rnum_elem, simparam->max_num_strength_state_vars);
-    elem_user_output_vars = DCArrayKokkos<double>(rnum_elem, simparam->output_options.max_num_user_output_vars);
-
     // --- calculate bdy sets ---//
     mesh->num_nodes_in_patch  = 2 * (num_dim - 1); // 2 (2D) or 4 (3D)
     mesh->num_patches_in_elem = 2 * num_dim; // 4 (2D) or 6 (3D)
@@ -171,29 +109,6 @@ void FEA_Module_SGH::setup()
     bdy_nodes_in_set     = mesh->bdy_nodes_in_set;
     num_bdy_nodes_in_set = mesh->num_bdy_nodes_in_set;
 
-    // assign mesh views needed by the FEA module
-
-    // elem ids in elem
-    elems_in_elem     = mesh->elems_in_elem;
-    num_elems_in_elem = mesh->num_elems_in_elem;
-
-    // corners
-    num_corners_in_node = mesh->num_corners_in_node;
-    corners_in_node     = mesh->corners_in_node;
-    corners_in_elem     = mesh->corners_in_elem;
-
-    // elem-node conn & node-node conn
-    elems_in_node = mesh->elems_in_node;
-    if (num_dim == 2) {
-        nodes_in_node     = mesh->nodes_in_node;
-        num_nodes_in_node = mesh->num_nodes_in_node;
-        // patch conn
-
-        patches_in_elem = mesh->patches_in_elem;
-        nodes_in_patch  = mesh->nodes_in_patch;
-        elems_in_patch  = mesh->elems_in_patch;
-    }
-
     // loop over BCs
     for (size_t this_bdy = 0; this_bdy < num_bcs; this_bdy++) {
         RUN_CLASS({
@@ -578,6 +493,110 @@ void FEA_Module_SGH::setup()
     return;
 } // end of setup
 
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn init_mesh_state
+///
+/// \brief Build the mesh connectivity for the solver's current maps and
+///        allocate the state arrays over it
+///
+/////////////////////////////////////////////////////////////////////////////
+void FEA_Module_SGH::init_mesh_state()
+{
+    const size_t rk_num_bins = simparam->dynamic_options.rk_num_bins;
+    const int    num_dim     = simparam->num_dims;
+
+    // ---------------------------------------------------------------------
+    //    obtain mesh data
+    // ---------------------------------------------------------------------
+    sgh_interface_setup(node_interface, elem_interface, corner_interface);
+    mesh->build_corner_connectivity();
+    mesh->build_elem_elem_connectivity();
+    mesh->num_bdy_patches = nboundary_patches;
+    if (num_dim == 2) {
+        mesh->build_patch_connectivity();
+        mesh->build_node_node_connectivity();
+    }
+
+    // ---------------------------------------------------------------------
+    //    allocate memory
+    // ---------------------------------------------------------------------
+
+    // shorthand names
+    const size_t num_nodes   = mesh->num_nodes;
+    const size_t num_elems   = mesh->num_elems;
+    const size_t num_corners = mesh->num_corners;
+
+    // --- make dual views of data on CPU and GPU ---
+    //  Notes:
+    //     Instead of using a struct of dual types like the mesh type,
+    //     individual dual views will be made for all the state
+    //     variables.  The motivation is to reduce memory movement
+    //     when passing state into a function.  Passing a struct by
+    //     reference will copy the meta data and pointers for the
+    //     variables held inside the struct.  Since all the mesh
+    //     variables are typically used by most functions, a single
+    //     mesh struct or passing the arrays will be roughly equivalent
+    //     for memory movement.
+
+    // create Dual Views of the individual node struct variables
+    node_coords = DViewCArrayKokkos<double>(node_interface.coords.get_kokkos_dual_view().view_host().data(), rk_num_bins, num_nodes, num_dim);
+    node_vel    = DViewCArrayKokkos<double>(node_interface.vel.get_kokkos_dual_view().view_host().data(), rk_num_bins, num_nodes, num_dim);
+    node_mass   = DViewCArrayKokkos<double>(node_interface.mass.get_kokkos_dual_view().view_host().data(), num_nodes);
+
+    // create Dual Views of the individual elem struct variables
+    elem_den    = DViewCArrayKokkos<double>(&elem_interface.den(0), num_elems);
+    elem_pres   = DViewCArrayKokkos<double>(&elem_interface.pres(0), num_elems);
+    elem_stress = DViewCArrayKokkos<double>(&elem_interface.stress(0, 0, 0, 0), rk_num_bins, num_elems, 3, 3); // always 3D even in 2D-RZ
+    elem_sspd   = DViewCArrayKokkos<double>(&elem_interface.sspd(0), num_elems);
+    elem_sie    = DViewCArrayKokkos<double>(&elem_interface.sie(0, 0), rk_num_bins, num_elems);
+    elem_vol    = DViewCArrayKokkos<double>(&elem_interface.vol(0), num_elems);
+    elem_div    = DViewCArrayKokkos<double>(&elem_interface.div(0), num_elems);
+    elem_mass   = DViewCArrayKokkos<double>(&elem_interface.mass(0), num_elems);
+    elem_mat_id = DViewCArrayKokkos<size_t>(&elem_interface.mat_id(0), num_elems);
+
+    // create Dual Views of the corner struct variables
+    corner_force = DViewCArrayKokkos<double>(&corner_interface.force(0, 0), num_corners, num_dim);
+    corner_mass  = DViewCArrayKokkos<double>(&corner_interface.mass(0), num_corners);
+
+    // allocate elem_vel_grad
+    elem_vel_grad = DCArrayKokkos<double>(num_elems, 3, 3);
+
+    // allocate material models
+    elem_eos = DCArrayKokkos<eos_t>(num_elems);
+    elem_strength = DCArrayKokkos<strength_t>(num_elems);
+
+    // Constitutive model data
+    eos_global_vars = simparam->eos_global_vars;
+    strength_global_vars = simparam->strength_global_vars;
+    eos_state_vars = DCArrayKokkos<double>(rnum_elem, simparam->max_num_eos_state_vars);
+    strength_state_vars   = DCArrayKokkos<double>(rnum_elem, simparam->max_num_strength_state_vars);
+    elem_user_output_vars = DCArrayKokkos<double>(rnum_elem, simparam->output_options.max_num_user_output_vars);
+
+    // assign mesh views needed by the FEA module
+
+    // elem ids in elem
+    elems_in_elem     = mesh->elems_in_elem;
+    num_elems_in_elem = mesh->num_elems_in_elem;
+
+    // corners
+    num_corners_in_node = mesh->num_corners_in_node;
+    corners_in_node     = mesh->corners_in_node;
+    corners_in_elem     = mesh->corners_in_elem;
+
+    // elem-node conn & node-node conn
+    elems_in_node = mesh->elems_in_node;
+    if (num_dim == 2) {
+        nodes_in_node     = mesh->nodes_in_node;
+        num_nodes_in_node = mesh->num_nodes_in_node;
+        // patch conn
+
+        patches_in_elem = mesh->patches_in_elem;
+        nodes_in_patch  = mesh->nodes_in_patch;
+        elems_in_patch  = mesh->elems_in_patch;
+    }
+} // end of init_mesh_state
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /// \fn sgh_interface_setup
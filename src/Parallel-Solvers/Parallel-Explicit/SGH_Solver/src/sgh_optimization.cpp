@@ -36,6 +36,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <utility>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>  // fmin, fmax, abs note: fminl is long
@@ -104,7 +105,6 @@ void FEA_Module_SGH::update_forward_solve(Teuchos::RCP<const MV> zp)
     const DCArrayKokkos<mat_fill_t> mat_fill = simparam->mat_fill;
     const DCArrayKokkos<boundary_t> boundary = module_params->boundary;
     const DCArrayKokkos<material_t> material = simparam->material;
-    CArray<double> current_element_nodal_densities = CArray<double>(num_nodes_in_elem);
 
     std::vector<std::vector<int>> FEA_Module_My_TO_Modules = simparam->FEA_Module_My_TO_Modules;
     problem = Explicit_Solver_Pointer_->problem; // Pointer to ROL optimization problem object
@@ -115,19 +115,20 @@ void FEA_Module_SGH::update_forward_solve(Teuchos::RCP<const MV> zp)
 
     // compute element averaged density ratios corresponding to nodal density design variables
     { // view scope
-        const_host_vec_array all_node_densities = all_node_densities_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        const_vec_array all_node_densities = all_node_densities_distributed->getLocalView<device_type>(Tpetra::Access::ReadOnly);
         // debug print
         // std::cout << "NODE DENSITY TEST " << all_node_densities(0,0) << std::endl;
-        for (int elem_id = 0; elem_id < rnum_elem; elem_id++) {
+        FOR_ALL_CLASS(elem_id, 0, rnum_elem, {
+            double element_density = 0;
             for (int inode = 0; inode < num_nodes_in_elem; inode++) {
-                current_element_nodal_densities(inode) = all_node_densities(nodes_in_elem(elem_id, inode), 0);
+                element_density += all_node_densities(nodes_in_elem(elem_id, inode), 0) / num_nodes_in_elem;
             }
-            relative_element_densities.host(elem_id) = average_element_density(num_nodes_in_elem, current_element_nodal_densities);
-        } // for
+            relative_element_densities(elem_id) = element_density;
+        }); // end parallel for
+        Kokkos::fence();
     } // view scope
     // debug print
     // std::cout << "ELEMENT RELATIVE DENSITY TEST " << relative_element_densities.host(0) << std::endl;
-    relative_element_densities.update_device();
 
     // set density vector to the current value chosen by the optimizer
     test_node_densities_distributed = zp;
@@ -513,6 +514,146 @@ void FEA_Module_SGH::update_forward_solve(Teuchos::RCP<const MV> zp)
 
     // execute solve
     sgh_solve();
+
+    // key the forward buffers with the design they were solved for
+    if (forward_solve_cache) {
+        if (forward_solve_design.is_null()) {
+            forward_solve_design = Teuchos::rcp(new MV(map, 1));
+        }
+        forward_solve_design->assign(*zp);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn forward_solve_matches
+///
+/// \brief Test if a forward solve key equals the design vector (collective)
+///
+/// \param Design the forward solve was computed for
+/// \param Design vector to test
+///
+/// \return True if every design variable matches exactly
+///
+/////////////////////////////////////////////////////////////////////////////
+bool FEA_Module_SGH::forward_solve_matches(Teuchos::RCP<const MV> solved_design, Teuchos::RCP<const MV> zp)
+{
+    if (!forward_solve_cache || solved_design.is_null()) {
+        return false;
+    }
+
+    Kokkos::View<real_t*, Kokkos::HostSpace> difference_norm("difference_norm", 1);
+    forward_solve_design_difference->update(1.0, *solved_design, -1.0, *zp, 0.0);
+    forward_solve_design_difference->normInf(difference_norm);
+
+    return difference_norm(0) == 0.0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn forward_solve_is_current
+///
+/// \brief Test if the current forward buffers were solved for this design
+///
+/// \param Design vector to test
+///
+/////////////////////////////////////////////////////////////////////////////
+bool FEA_Module_SGH::forward_solve_is_current(Teuchos::RCP<const MV> zp)
+{
+    return forward_solve_matches(forward_solve_design, zp);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn forward_solve_is_cached
+///
+/// \brief Test if the cached forward buffers were solved for this design
+///
+/// \param Design vector to test
+///
+/////////////////////////////////////////////////////////////////////////////
+bool FEA_Module_SGH::forward_solve_is_cached(Teuchos::RCP<const MV> zp)
+{
+    return forward_solve_matches(cached_forward_solve_design, zp);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn swap_forward_solve_cache
+///
+/// \brief Exchange the current forward solve with the cached one.
+///
+/// The time histories used by the adjoint are swapped by pointer; the
+/// design dependent mass and density fields are exchanged in place.
+/// Callers must swap the objective value they accumulate alongside.
+///
+/////////////////////////////////////////////////////////////////////////////
+void FEA_Module_SGH::swap_forward_solve_cache()
+{
+    const int num_dim     = simparam->num_dims;
+    const int num_corners = rnum_elem * num_nodes_in_elem;
+
+    // first swap moves the current solve into empty cache storage; the unkeyed
+    // buffers it swaps back are overwritten by the next forward solve
+    if (cached_elem_den.size() == 0) {
+        cached_relative_element_densities = DCArrayKokkos<double>(rnum_elem, "cached_relative_element_densities");
+        cached_elem_den    = CArrayKokkos<double>(rnum_elem, "cached_elem_den");
+        cached_elem_mass   = CArrayKokkos<double>(rnum_elem, "cached_elem_mass");
+        cached_node_mass   = CArrayKokkos<double>(nall_nodes, "cached_node_mass");
+        cached_corner_mass = CArrayKokkos<double>(num_corners, "cached_corner_mass");
+    }
+
+    std::swap(forward_solve_design, cached_forward_solve_design);
+    std::swap(forward_solve_velocity_data, cached_forward_solve_velocity_data);
+    std::swap(forward_solve_coordinate_data, cached_forward_solve_coordinate_data);
+    std::swap(forward_solve_internal_energy_data, cached_forward_solve_internal_energy_data);
+    std::swap(time_data, cached_time_data);
+    std::swap(last_time_step, cached_last_time_step);
+    std::swap(relative_element_densities, cached_relative_element_densities);
+
+    // the buffer growth in sgh_solve keys off the velocity history, so keep
+    // the swapped in histories as long as the adjoint buffers
+    const size_t old_max_forward_buffer = forward_solve_velocity_data->size();
+    if (adjoint_vector_data->size() > old_max_forward_buffer) {
+        time_data.resize(adjoint_vector_data->size());
+        forward_solve_velocity_data->resize(adjoint_vector_data->size());
+        forward_solve_coordinate_data->resize(adjoint_vector_data->size());
+        forward_solve_internal_energy_data->resize(adjoint_vector_data->size());
+        for (size_t istep = old_max_forward_buffer; istep < adjoint_vector_data->size(); istep++) {
+            (*forward_solve_velocity_data)[istep]   = Teuchos::rcp(new MV(all_node_map, num_dim));
+            (*forward_solve_coordinate_data)[istep] = Teuchos::rcp(new MV(all_node_map, num_dim));
+            (*forward_solve_internal_energy_data)[istep] = Teuchos::rcp(new MV(all_element_map, 1));
+        }
+    }
+
+    // state arrays are shared with the solver, exchange their contents
+    FOR_ALL_CLASS(elem_gid, 0, rnum_elem, {
+        double temp = elem_den(elem_gid);
+        elem_den(elem_gid) = cached_elem_den(elem_gid);
+        cached_elem_den(elem_gid) = temp;
+
+        temp = elem_mass(elem_gid);
+        elem_mass(elem_gid) = cached_elem_mass(elem_gid);
+        cached_elem_mass(elem_gid) = temp;
+    }); // end parallel for
+
+    FOR_ALL_CLASS(node_gid, 0, nall_nodes, {
+        double temp = node_mass(node_gid);
+        node_mass(node_gid) = cached_node_mass(node_gid);
+        cached_node_mass(node_gid) = temp;
+    }); // end parallel for
+
+    FOR_ALL_CLASS(corner_gid, 0, num_corners, {
+        double temp = corner_mass(corner_gid);
+        corner_mass(corner_gid) = cached_corner_mass(corner_gid);
+        cached_corner_mass(corner_gid) = temp;
+    }); // end parallel for
+    Kokkos::fence();
+
+    elem_den.update_host();
+    elem_mass.update_host();
+    node_mass.update_host();
+    corner_mass.update_host();
 }
 
 /////////////////////////////////////////////////////////////////////////////
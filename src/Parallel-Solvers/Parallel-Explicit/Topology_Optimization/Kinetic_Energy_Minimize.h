@@ -38,6 +38,7 @@
 #include "matar.h"
 #include "elements.h"
 #include <string>
+#include <utility>
 #include <Teuchos_ScalarTraits.hpp>
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_oblackholestream.hpp>
@@ -95,6 +96,9 @@ private:
     ROL::Ptr<ROL_MV> ROL_Velocities;
     ROL::Ptr<ROL_MV> ROL_Gradients;
     real_t initial_kinetic_energy;
+    real_t cached_objective_accumulation; // objective of the forward solve held in the SGH cache
+    bool   accepted_in_cache; // the accepted iterate's forward solve is in the cache, not current
+
 
     bool useLC_; // Use linear form of energy.  Otherwise use quadratic form.
 
@@ -166,6 +170,8 @@ public:
         current_step      = 0;
         time_accumulation = true;
         objective_accumulation = 0;
+        cached_objective_accumulation = 0;
+        accepted_in_cache = false;
 
         // ROL_Force = ROL::makePtr<ROL_MV>(FEM_->Global_Nodal_Forces);
         if (set_module_type == FEA_MODULE_TYPE::SGH) {
@@ -202,7 +208,6 @@ public:
 
         current_step++;
         ROL::Ptr<const MV>   zp = getVector(z);
-        const_host_vec_array design_densities = zp->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
 
         if (type == ROL::UpdateType::Initial) {
             // This is the first call to update
@@ -265,7 +270,6 @@ public:
 
         current_step++;
         ROL::Ptr<const MV>   zp = getVector(z);
-        const_host_vec_array design_densities = zp->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
 
         if (type == ROL::UpdateType::Initial) {
             // This is the first call to update
@@ -275,33 +279,36 @@ public:
 
             FEM_SGH_->comm_variables(zp);
             FEM_SGH_->update_forward_solve(zp);
+            accepted_in_cache = false;
             // initial design density data was already communicated for ghost nodes in init_design()
             // decide to output current optimization state
             // FEM_SGH_->Explicit_Solver_Pointer_->write_outputs();
         }
         else if (type == ROL::UpdateType::Accept) {
+            // the accepted design is normally the last trial, which is already current
+            if (FEM_SGH_->forward_solve_cache) {
+                sync_forward_solve_sgh(zp);
+                accepted_in_cache = false;
+            }
         }
         else if (type == ROL::UpdateType::Revert) {
             // u_ was set to u=S(x) during a trial update
             // and has been rejected as the new iterate
             // Revert to cached value
-            // This is a new value of x
             // communicate density variables for ghosts
             if (Explicit_Solver_Pointer_->myrank == 0) { *fos << "called SGH Revert" << std::endl; }
 
-            FEM_SGH_->comm_variables(zp);
-            // update deformation variables
-            FEM_SGH_->update_forward_solve(zp);
+            // update deformation variables; a buffer swap when the accepted solve is cached
+            sync_forward_solve_sgh(zp);
+            accepted_in_cache = false;
             if (Explicit_Solver_Pointer_->myrank == 0) {
                 *fos << "called Revert" << std::endl;
             }
         }
         else if (type == ROL::UpdateType::Trial) {
             // This is a new value of x
-            // communicate density variables for ghosts
-            FEM_SGH_->comm_variables(zp);
-            // update deformation variables
-            FEM_SGH_->update_forward_solve(zp);
+            // communicate density variables for ghosts and update deformation variables
+            sync_forward_solve_sgh(zp);
             if (Explicit_Solver_Pointer_->myrank == 0) {
                 *fos << "called Trial" << std::endl;
             }
@@ -315,11 +322,40 @@ public:
             if (Explicit_Solver_Pointer_->myrank == 0) {
                 *fos << "called SGH Temp" << std::endl;
             }
-            FEM_SGH_->comm_variables(zp);
-            FEM_SGH_->update_forward_solve(zp);
+            sync_forward_solve_sgh(zp);
         }
     }
 
+  /* --------------------------------------------------------------------------------------
+   Make the SGH forward solve current for z, reusing the current or cached solve when one
+   was already computed for this design. The accepted iterate is moved into the cache
+   before a new solve overwrites it, so a later Revert is a buffer swap.
+  ----------------------------------------------------------------------------------------- */
+
+    void sync_forward_solve_sgh(ROL::Ptr<const MV> zp)
+    {
+        FEM_SGH_->comm_variables(zp);
+
+        if (FEM_SGH_->forward_solve_is_current(zp)) {
+            return;
+        }
+
+        if (FEM_SGH_->forward_solve_is_cached(zp)) {
+            FEM_SGH_->swap_forward_solve_cache();
+            std::swap(objective_accumulation, cached_objective_accumulation);
+            accepted_in_cache = !accepted_in_cache;
+            return;
+        }
+
+        if (FEM_SGH_->forward_solve_cache && !accepted_in_cache) {
+            FEM_SGH_->swap_forward_solve_cache();
+            std::swap(objective_accumulation, cached_objective_accumulation);
+            accepted_in_cache = true;
+        }
+
+        FEM_SGH_->update_forward_solve(zp);
+    }
+
   /* --------------------------------------------------------------------------------------
    Update objective value with the current design variable vector, z
   ----------------------------------------------------------------------------------------- */
@@ -339,7 +375,6 @@ public:
         // *fos << std::endl;
         // std::fflush(stdout);
 
-        const_host_vec_array design_densities = zp->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
         // communicate ghosts and solve for nodal degrees of freedom as a function of the current design variables
         /*
         if(last_comm_step!=current_step){
@@ -23,6 +23,8 @@ struct Dynamic_Options : Yaml::DerivedFields {
     int rk_num_stages = 2;
     int rk_num_bins   = -1;
     double time_value = -1;
+    int load_balance_check_freq = 0; // cycles between element work imbalance checks, 0 disables
+    double load_balance_tolerance = 1.1; // imbalance above which the mesh is repartitioned by element cost
 
     // Non-serialized Fields
     double dt;
@@ -37,5 +39,6 @@ struct Dynamic_Options : Yaml::DerivedFields {
 };
 IMPL_YAML_SERIALIZABLE_FOR(Dynamic_Options, output_time_sequence_level,
   time_initial, time_value, time_final, dt_min, dt_max, dt_start, dt_cfl,
-  cycle_stop, fuzz, tiny, small, rk_num_stages, rk_num_bins
+  cycle_stop, fuzz, tiny, small, rk_num_stages, rk_num_bins,
+  load_balance_check_freq, load_balance_tolerance
 )
\ No newline at end of file
@@ -13,6 +13,17 @@ struct Elasticity_Parameters
     bool smallest_modes = true;
     bool largest_modes = false;
     real_t convergence_tolerance = 1.0e-18;
+    // modal analysis eigensolver: block_davidson, lobpcg or shift_invert
+    std::string eigensolver_type = "block_davidson";
+    // shift_invert extracts the modes closest to this eigenvalue
+    real_t eigen_shift = 0;
+    int eigen_max_restarts = 50;
+    int eigen_max_iterations = 500;
+    // 0 keeps the default subspace size of 3 blocks per rank
+    int eigen_num_blocks = 0;
+    bool eigen_locking = true;
+    // 0 locks up to the number of requested modes
+    int eigen_max_locked = 0;
 
     Elasticity_Parameters() : FEA_Module_Parameters({
         FIELD::displacement,
@@ -21,5 +32,7 @@ struct Elasticity_Parameters
     }) { }
 };
 IMPL_YAML_SERIALIZABLE_WITH_BASE(Elasticity_Parameters, ImplicitModule,
-    strain_max_flag, modal_analysis, anisotropic_lattice, num_modes, smallest_modes, largest_modes, convergence_tolerance
+    strain_max_flag, modal_analysis, anisotropic_lattice, num_modes, smallest_modes, largest_modes, convergence_tolerance,
+    eigensolver_type, eigen_shift, eigen_max_restarts, eigen_max_iterations,
+    eigen_num_blocks, eigen_locking, eigen_max_locked
 )
@@ -8,11 +8,15 @@ struct ImplicitModule
     bool equilibrate_matrix_flag = false;
     bool direct_solver_flag = false;
     bool multigrid_timers = false;
+    // build the multigrid preconditioner in single precision and refine the solution in double
+    // (needs Trilinos configured with Tpetra_INST_FLOAT=ON)
+    bool mixed_precision_preconditioner = false;
     
     // Implement default copy constructor to avoid the compiler double moving.
     // Let it double copy instead.
     ImplicitModule& operator=(const ImplicitModule&) = default;
 };
 IMPL_YAML_SERIALIZABLE_WITH_BASE(ImplicitModule, FEA_Module_Parameters, 
-    equilibrate_matrix_flag, direct_solver_flag, multigrid_timers
+    equilibrate_matrix_flag, direct_solver_flag, multigrid_timers,
+    mixed_precision_preconditioner
 )
\ No newline at end of file
@@ -9,7 +9,7 @@
 using namespace mtr;
 KOKKOS_FUNCTION
 static int get_id(int i, int j, int k, int num_i, int num_j);
-static std::tuple<CArray<bool>, double, double, double, double, double, double, size_t, size_t, size_t> user_voxel_init(std::string vtk_file_path);
+static std::tuple<CArray<int>, double, double, double, double, double, double, size_t, size_t, size_t> user_voxel_init(std::string vtk_file_path);
 static std::vector<std::string> split (std::string s, std::string delimiter);
 static std::string ltrim(const std::string &s);
 static std::string rtrim(const std::string &s);
@@ -38,6 +38,7 @@ struct Volume : Yaml::ValidatedYaml {
     size_t num_voxel_z;
     mtr::CArray<bool> voxel_elem_values;
     std::string vtk_file_path;
+    int voxel_value = -1; // fill only the voxels with this value, any nonzero value when negative
     double orig_x = 0;
     double orig_y = 0;
     double orig_z = 0;
@@ -64,7 +65,19 @@ struct Volume : Yaml::ValidatedYaml {
     
     // Run scheme on vtk file
     void vtk() {
-        std::tie(voxel_elem_values, voxel_dx, voxel_dy, voxel_dz, orig_x, orig_y, orig_z, num_voxel_x, num_voxel_y, num_voxel_z) = user_voxel_init(vtk_file_path);
+        CArray<int> voxel_file_values;
+        std::tie(voxel_file_values, voxel_dx, voxel_dy, voxel_dz, orig_x, orig_y, orig_z, num_voxel_x, num_voxel_y, num_voxel_z) = user_voxel_init(vtk_file_path);
+
+        // a voxel file can hold several material ids, keep only the voxels of this volume
+        voxel_elem_values = CArray<bool>(voxel_file_values.size());
+        for (size_t voxel_id = 0; voxel_id < voxel_file_values.size(); voxel_id++) {
+            if (voxel_value < 0) {
+                voxel_elem_values(voxel_id) = voxel_file_values(voxel_id) != 0;
+            }
+            else {
+                voxel_elem_values(voxel_id) = voxel_file_values(voxel_id) == voxel_value;
+            }
+        }
     }
     
     KOKKOS_FUNCTION
@@ -134,9 +147,11 @@ struct Volume : Yaml::ValidatedYaml {
             j0_real = (elem_coords[1] - orig_y)/(voxel_dy);
             k0_real = (elem_coords[2] - orig_z)/(voxel_dz);
             
-            i0 = (int)i0_real;
-            j0 = (int)j0_real;
-            k0 = (int)k0_real;
+            // the origin is the center of the first voxel, so round to the closest voxel;
+            // truncating would put an element centered on a voxel into its neighbour
+            i0 = (int)floor(i0_real + 0.5);
+            j0 = (int)floor(j0_real + 0.5);
+            k0 = (int)floor(k0_real + 0.5);
             
             // look for the closest element in the voxel mesh
             elem_id0 = get_id(i0,j0,k0,num_voxel_x,num_voxel_y);
@@ -205,7 +220,7 @@ struct Volume : Yaml::ValidatedYaml {
     }
 };
 
-IMPL_YAML_SERIALIZABLE_FOR(Volume, type, radius1, radius2, x1, x2, y1, y2, z1, z2, stl_file_path, vtk_file_path, num_voxel_x, num_voxel_y, num_voxel_z, orig_x, orig_y, orig_z, length_x, length_y, length_z)
+IMPL_YAML_SERIALIZABLE_FOR(Volume, type, radius1, radius2, x1, x2, y1, y2, z1, z2, stl_file_path, vtk_file_path, voxel_value, num_voxel_x, num_voxel_y, num_voxel_z, orig_x, orig_y, orig_z, length_x, length_y, length_z)
 
 // -------------------------------------------------------
 // This gives the index value of the point or the elem
@@ -223,7 +238,7 @@ static int get_id(int i, int j, int k, int num_i, int num_j)
 // -----------------------------------------------------------------------------
 // The function to read a voxel vtk file from Dream3d and intialize the mesh
 //------------------------------------------------------------------------------
-std::tuple<CArray<bool>, double, double, double, double, double, double, size_t, size_t, size_t> user_voxel_init(std::string vtk_file_path) {
+std::tuple<CArray<int>, double, double, double, double, double, double, size_t, size_t, size_t> user_voxel_init(std::string vtk_file_path) {
 
     std::string MESH = vtk_file_path; // user specified
     
@@ -486,7 +501,7 @@ std::tuple<CArray<bool>, double, double, double, double, double, double, size_t,
 
     
     // allocate memory for element voxel values
-    CArray<bool> elem_values(num_elems);
+    CArray<int> elem_values(num_elems);
     
     // reading the cell data
     while (found==false) {
@@ -514,7 +529,7 @@ std::tuple<CArray<bool>, double, double, double, double, double, double, size_t,
                 // loop over the contents of the vector v_coords
                 for (size_t this_elem=0; this_elem<v_values.size(); this_elem++){
                     
-                    // save integers (0 or 1) to host side
+                    // save integers (0 for void, else the material id) to host side
                     elem_values(num_saved) = std::stoi(v_values[this_elem]);
                     num_saved++;
                     
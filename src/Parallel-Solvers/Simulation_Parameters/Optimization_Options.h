@@ -113,6 +113,12 @@ struct Optimization_Options: Yaml::DerivedFields {
   double maximum_density = 1;
   double shell_density = 1;
   real_t objective_normalization_constant = 0;
+  bool forward_solve_cache = true;
+  std::string continuation_design_input;
+  std::string continuation_design_output;
+  int optimization_checkpoint_freq = 0;
+  std::string optimization_checkpoint_file = "optimization_checkpoint";
+  std::string optimization_resume_file;
 
   MULTI_OBJECTIVE_STRUCTURE multi_objective_structure = MULTI_OBJECTIVE_STRUCTURE::linear;
   std::vector<MultiObjectiveModule> multi_objective_modules;
@@ -135,5 +141,7 @@ IMPL_YAML_SERIALIZABLE_FOR(Optimization_Options,
   simp_penalty_power, density_epsilon, thick_condition_boundary,
   optimization_output_freq, density_filter, minimum_density, maximum_density,
   multi_objective_modules, multi_objective_structure, density_filter, retain_outer_shell,
-  variable_outer_shell, shell_density, objective_normalization_constant
+  variable_outer_shell, shell_density, objective_normalization_constant,
+  forward_solve_cache, continuation_design_input, continuation_design_output,
+  optimization_checkpoint_freq, optimization_checkpoint_file, optimization_resume_file
 )
@@ -36,6 +36,10 @@ struct Simulation_Parameters
     bool gravity_flag = false;
     std::vector<double> gravity_vector {9.81, 0, 0};
 
+    // node weights for a cost weighted partition; read at startup when present,
+    // written by explicit runs whose ranks are out of balance
+    std::string partition_weights_file;
+
     // Non-serialized fields
     // TODO: implement restart files.
     bool restart_file = false;
@@ -401,6 +405,6 @@ IMPL_YAML_SERIALIZABLE_FOR(Simulation_Parameters,
     num_dims, input_options, mesh_generation_options, output_options, materials, regions,
     fea_module_parameters, optimization_options,
     nodal_density_flag, num_gauss_points,
-    gravity_flag, gravity_vector
+    gravity_flag, gravity_vector, partition_weights_file
 )
 #endif
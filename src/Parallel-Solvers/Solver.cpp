@@ -277,6 +277,182 @@ void Solver::generate_mesh(const std::shared_ptr<MeshBuilderInput>& mesh_generat
     all_element_map = Teuchos::rcp(new Tpetra::Map<LO, GO, node_type>(Teuchos::OrdinalTraits<GO>::invalid(), All_Element_Global_Indices.d_view, 0, comm));
 }
 
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn write_design_field
+///
+/// \brief Write the nodal design densities of a generated box mesh on its
+///        point lattice so that a run on a finer box can continue from them
+///
+/// \param Name of the design field file
+///
+/////////////////////////////////////////////////////////////////////////////
+void Solver::write_design_field(const std::string& file_name)
+{
+    // global node ids of generated boxes follow the point lattice (i fastest)
+    std::shared_ptr<Input_Rectilinear> box;
+    if (simparam.mesh_generation_options.has_value() && simparam.mesh_generation_options.value()->type == MeshType::Box)
+    {
+        box = std::dynamic_pointer_cast<Input_Rectilinear>(simparam.mesh_generation_options.value());
+    }
+    if (!box || box->p_order != 1)
+    {
+        if (myrank == 0)
+        {
+            std::cout << "Skipping design field output; continuation requires a generated first order box mesh" << std::endl;
+        }
+        return;
+    }
+
+    // gather the densities in global node order on rank 0
+    Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> collection_map =
+        Teuchos::rcp(new Tpetra::Map<LO, GO, node_type>(num_nodes, myrank == 0 ? num_nodes : 0, 0, comm));
+    Teuchos::RCP<MV> collected_densities = Teuchos::rcp(new MV(collection_map, 1));
+    Tpetra::Import<LO, GO> collection_importer(map, collection_map);
+    collected_densities->doImport(*design_node_densities_distributed, collection_importer, Tpetra::INSERT);
+
+    if (myrank == 0)
+    {
+        const_host_vec_array densities = collected_densities->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        std::ofstream out(file_name);
+        out << "# Fierro design field" << std::endl;
+        out << "num_points " << box->num_points[0] << " " << box->num_points[1] << " " << box->num_points[2] << std::endl;
+        out.precision(17);
+        out << "lower_bound";
+        for (int idim = 0; idim < 3; idim++)
+        {
+            out << " " << box->origin[idim] + box->lower_bound[idim];
+        }
+        out << std::endl << "upper_bound";
+        for (int idim = 0; idim < 3; idim++)
+        {
+            out << " " << box->origin[idim] + box->upper_bound[idim];
+        }
+        out << std::endl;
+        for (long long int inode = 0; inode < num_nodes; inode++)
+        {
+            out << densities(inode, 0) << "\n";
+        }
+        std::cout << "Wrote design field for continuation to " << file_name << std::endl;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/// \fn prolongate_design_field
+///
+/// \brief Interpolate a design field written by a coarser run onto the
+///        local nodes of this mesh
+///
+/// \param Name of the design field file
+/// \param Local view of the design densities to fill
+///
+/////////////////////////////////////////////////////////////////////////////
+void Solver::prolongate_design_field(const std::string& file_name, host_vec_array node_densities)
+{
+    int    num_dim = simparam.num_dims;
+    int    num_points[3] = { 1, 1, 1 };
+    double lower_bound[3] = { 0, 0, 0 };
+    double upper_bound[3] = { 0, 0, 0 };
+    long long int num_lattice_points = 0;
+    int read_status = 1;
+    std::vector<double> lattice_densities;
+
+    if (myrank == 0)
+    {
+        std::ifstream in(file_name);
+        std::string   label;
+        // skip the title line
+        std::getline(in, label);
+        in >> label >> num_points[0] >> num_points[1] >> num_points[2];
+        in >> label >> lower_bound[0] >> lower_bound[1] >> lower_bound[2];
+        in >> label >> upper_bound[0] >> upper_bound[1] >> upper_bound[2];
+        num_lattice_points = (long long int)num_points[0] * num_points[1] * num_points[2];
+        if (in && num_lattice_points > 0)
+        {
+            lattice_densities.resize(num_lattice_points);
+            for (long long int ipoint = 0; ipoint < num_lattice_points; ipoint++)
+            {
+                in >> lattice_densities[ipoint];
+            }
+        }
+        if (!in || num_lattice_points <= 0)
+        {
+            std::cout << "Could not read the design field file " << file_name << std::endl;
+            read_status = 0;
+        }
+    }
+
+    MPI_Bcast(&read_status, 1, MPI_INT, 0, world);
+    if (!read_status)
+    {
+        exit_solver(0);
+    }
+
+    // the coarse lattice is small enough to hold on every rank
+    MPI_Bcast(num_points, 3, MPI_INT, 0, world);
+    MPI_Bcast(lower_bound, 3, MPI_DOUBLE, 0, world);
+    MPI_Bcast(upper_bound, 3, MPI_DOUBLE, 0, world);
+    MPI_Bcast(&num_lattice_points, 1, MPI_LONG_LONG_INT, 0, world);
+    lattice_densities.resize(num_lattice_points);
+    MPI_Bcast(lattice_densities.data(), num_lattice_points, MPI_DOUBLE, 0, world);
+
+    real_t min_density = simparam.optimization_options.density_epsilon;
+    real_t max_density = simparam.optimization_options.maximum_density;
+    int    num_corners = 1 << num_dim;
+
+    const_host_vec_array node_coords = node_coords_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+    for (int inode = 0; inode < nlocal_nodes; inode++)
+    {
+        // lattice cell containing the node and its local coordinate in that cell
+        int    cell[3]   = { 0, 0, 0 };
+        double weight[3] = { 0, 0, 0 };
+        for (int idim = 0; idim < num_dim; idim++)
+        {
+            if (num_points[idim] < 2)
+            {
+                continue;
+            }
+            double position = (node_coords(inode, idim) - lower_bound[idim]) / (upper_bound[idim] - lower_bound[idim]) * (num_points[idim] - 1);
+            position     = fmin(fmax(position, 0.0), (double)(num_points[idim] - 1));
+            cell[idim]   = std::min((int)position, num_points[idim] - 2);
+            weight[idim] = position - cell[idim];
+        }
+
+        // multilinear interpolation over the corners of the cell
+        real_t density = 0;
+        for (int icorner = 0; icorner < num_corners; icorner++)
+        {
+            int    index[3] = { cell[0], cell[1], cell[2] };
+            double corner_weight = 1;
+            for (int idim = 0; idim < num_dim; idim++)
+            {
+                if (icorner & (1 << idim))
+                {
+                    index[idim]   += 1;
+                    corner_weight *= weight[idim];
+                }
+                else
+                {
+                    corner_weight *= 1 - weight[idim];
+                }
+            }
+            if (corner_weight == 0)
+            {
+                continue;
+            }
+            density += corner_weight * lattice_densities[index[0] + index[1] * num_points[0] + (long long int)index[2] * num_points[0] * num_points[1]];
+        }
+        node_densities(inode, 0) = fmin(fmax(density, min_density), max_density);
+    }
+
+    if (myrank == 0)
+    {
+        std::cout << "Prolongated design field from " << file_name << " (" << num_points[0] << " x " << num_points[1] << " x "
+                  << num_points[2] << " points)" << std::endl;
+    }
+}
+
 /* ----------------------------------------------------------------------
    Read Ensight format mesh file
 ------------------------------------------------------------------------- */
@@ -3069,17 +3245,45 @@ void Solver::read_mesh_abaqus_inp(const char *MESH){
 
 void Solver::repartition_nodes()
 {
-    char ch;
-
-    int num_dim = simparam.num_dims;
-    int local_node_index, current_column_index, nodes_per_element;
+    // node weights measured by a previous run; nodes stay unweighted without them
+    std::vector<real_t> node_weights;
+    if (!simparam.partition_weights_file.empty())
+    {
+        MPI_File weights_file;
+        if (MPI_File_open(world, simparam.partition_weights_file.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &weights_file) == MPI_SUCCESS)
+        {
+            MPI_Offset file_size;
+            MPI_File_get_size(weights_file, &file_size);
+            if (file_size == (MPI_Offset)num_nodes * sizeof(real_t))
+            {
+                // the map is still contiguous here, so each rank reads one slab
+                node_weights.resize(nlocal_nodes);
+                MPI_Offset first_gid = nlocal_nodes ? map->getMinGlobalIndex() : 0;
+                MPI_File_read_at_all(weights_file, first_gid * sizeof(real_t), node_weights.data(), (int)nlocal_nodes, MPI_DOUBLE, MPI_STATUS_IGNORE);
+                if (myrank == 0)
+                {
+                    std::cout << "Partitioning with node weights from " << simparam.partition_weights_file << std::endl;
+                }
+            }
+            else if (myrank == 0)
+            {
+                std::cout << "Ignoring partition weights in " << simparam.partition_weights_file << "; they were written for another mesh" << std::endl;
+            }
+            MPI_File_close(&weights_file);
+        }
+    }
 
-    size_t strain_count;
+    partition_nodes(node_weights);
+}
 
-    std::stringstream line_parse;
-    CArrayKokkos<char, array_layout, HostSpace, memory_traits> read_buffer;
+/* ----------------------------------------------------------------------
+   Partition the nodes with Zoltan2 multijagged on their current coordinates,
+   weighting each node when node_weights holds one entry per local node
+------------------------------------------------------------------------- */
 
-    GO node_gid;
+void Solver::partition_nodes(const std::vector<real_t>& node_weights)
+{
+    int num_dim = simparam.num_dims;
 
     // construct input adapted needed by Zoltan2 problem
     typedef Xpetra::MultiVector<real_t, LO, GO, node_type> xvector_t;
@@ -3088,7 +3292,23 @@ void Solver::repartition_nodes()
 
     Teuchos::RCP<xvector_t> xpetra_node_coords = Teuchos::rcp(new Xpetra::TpetraMultiVector<real_t, LO, GO, node_type>(node_coords_distributed));
 
-    Teuchos::RCP<inputAdapter_t> problem_adapter =  Teuchos::rcp(new inputAdapter_t(xpetra_node_coords));
+    std::vector<const real_t*> node_weight_pointers;
+    std::vector<int> node_weight_strides;
+    if (node_weights.size())
+    {
+        node_weight_pointers.push_back(node_weights.data());
+        node_weight_strides.push_back(1);
+    }
+
+    Teuchos::RCP<inputAdapter_t> problem_adapter;
+    if (node_weight_pointers.size())
+    {
+        problem_adapter = Teuchos::rcp(new inputAdapter_t(xpetra_node_coords, node_weight_pointers, node_weight_strides));
+    }
+    else
+    {
+        problem_adapter = Teuchos::rcp(new inputAdapter_t(xpetra_node_coords));
+    }
 
     // Create parameters for an RCB problem
 
@@ -3159,8 +3379,8 @@ void Solver::repartition_nodes()
     node_coords_distributed = partitioned_node_coords_one_to_one_distributed;
     partitioned_map = Teuchos::rcp(new Tpetra::Map<LO, GO, node_type>(*partitioned_map_one_to_one));
 
-    // migrate density vector if this is a restart file read
-    if (simparam.restart_file)
+    // migrate the density vector when one exists (restart file read or a repartition during a run)
+    if (design_node_densities_distributed != Teuchos::null)
     {
         Teuchos::RCP<MV> partitioned_node_densities_distributed = Teuchos::rcp(new MV(partitioned_map, 1));
 
@@ -3177,6 +3397,133 @@ void Solver::repartition_nodes()
     nlocal_nodes = map->getLocalNumElements();
 }
 
+/* ----------------------------------------------------------------------
+   Collect the elements connected to the nodes of a new node map; map still
+   holds the new decomposition while the element maps and connectivity are
+   those built by init_maps for previous_map. Call init_maps afterwards
+------------------------------------------------------------------------- */
+
+void Solver::repartition_elements(Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> previous_map)
+{
+    int    num_dim = simparam.num_dims;
+    int    nodes_per_element;
+    size_t nprevious_nodes = previous_map->getLocalNumElements();
+    GO     node_gid;
+
+    const_host_elem_conn_array nodes_in_elem = global_nodes_in_elem_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+
+    // every element touching a node owned under the previous map is local, so these lists are complete
+    std::vector<std::vector<GO>> elems_in_node(nprevious_nodes);
+    for (int ielem = 0; ielem < rnum_elem; ielem++)
+    {
+        if (num_dim == 2)
+        {
+            element_select->choose_2Delem_type(Element_Types(ielem), elem2D);
+            nodes_per_element = elem2D->num_nodes();
+        }
+        else
+        {
+            element_select->choose_3Delem_type(Element_Types(ielem), elem);
+            nodes_per_element = elem->num_nodes();
+        }
+        for (int lnode = 0; lnode < nodes_per_element; lnode++)
+        {
+            node_gid = nodes_in_elem(ielem, lnode);
+            if (previous_map->isNodeGlobalElement(node_gid))
+            {
+                elems_in_node[previous_map->getLocalElement(node_gid)].push_back(all_element_map->getGlobalElement(ielem));
+            }
+        }
+    }
+
+    int max_elems_in_node = 0, global_max_elems_in_node;
+    for (size_t inode = 0; inode < nprevious_nodes; inode++)
+    {
+        if (elems_in_node[inode].size() > max_elems_in_node)
+        {
+            max_elems_in_node = elems_in_node[inode].size();
+        }
+    }
+    MPI_Allreduce(&max_elems_in_node, &global_max_elems_in_node, 1, MPI_INT, MPI_MAX, world);
+
+    // send each node's element list to the node's new owner
+    Teuchos::RCP<MCONN> previous_elems_in_node_distributed = Teuchos::rcp(new MCONN(previous_map, global_max_elems_in_node));
+    {
+        host_elem_conn_array previous_elems_in_node = previous_elems_in_node_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadWrite);
+        for (size_t inode = 0; inode < nprevious_nodes; inode++)
+        {
+            for (int ielem = 0; ielem < global_max_elems_in_node; ielem++)
+            {
+                previous_elems_in_node(inode, ielem) = ielem < elems_in_node[inode].size() ? elems_in_node[inode][ielem] : -1;
+            }
+        }
+    }
+    std::vector<std::vector<GO>>().swap(elems_in_node);
+
+    Teuchos::RCP<MCONN> partitioned_elems_in_node_distributed = Teuchos::rcp(new MCONN(map, global_max_elems_in_node));
+    Tpetra::Import<LO, GO> node_importer(previous_map, map);
+    partitioned_elems_in_node_distributed->doImport(*previous_elems_in_node_distributed, node_importer, Tpetra::INSERT);
+
+    std::set<GO> element_set;
+    {
+        const_host_elem_conn_array partitioned_elems_in_node = partitioned_elems_in_node_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        for (size_t inode = 0; inode < nlocal_nodes; inode++)
+        {
+            for (int ielem = 0; ielem < global_max_elems_in_node; ielem++)
+            {
+                if (partitioned_elems_in_node(inode, ielem) >= 0)
+                {
+                    element_set.insert(partitioned_elems_in_node(inode, ielem));
+                }
+            }
+        }
+    }
+
+    elements::elem_types::elem_type mesh_element_type = Element_Types(0);
+    rnum_elem = element_set.size();
+
+    Kokkos::DualView<GO*, array_layout, device_type, memory_traits> All_Element_Global_Indices("All_Element_Global_Indices", rnum_elem);
+    int  ielem_set = 0;
+    auto it = element_set.begin();
+    while (it != element_set.end()) {
+        All_Element_Global_Indices.h_view(ielem_set++) = *it;
+        it++;
+    }
+    All_Element_Global_Indices.modify_host();
+    All_Element_Global_Indices.sync_device();
+    Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> partitioned_element_map =
+        Teuchos::rcp(new Tpetra::Map<LO, GO, node_type>(Teuchos::OrdinalTraits<GO>::invalid(), All_Element_Global_Indices.d_view, 0, comm));
+
+    // pull connectivity from the previous owners of the non-overlapping element map
+    Teuchos::RCP<MCONN> nonoverlapping_nodes_in_elem_distributed = Teuchos::rcp(new MCONN(*global_nodes_in_elem_distributed, element_map));
+    Teuchos::RCP<MCONN> partitioned_nodes_in_elem_distributed    = Teuchos::rcp(new MCONN(partitioned_element_map, max_nodes_per_element));
+    Tpetra::Import<LO, GO> element_importer(element_map, partitioned_element_map);
+    partitioned_nodes_in_elem_distributed->doImport(*nonoverlapping_nodes_in_elem_distributed, element_importer, Tpetra::INSERT);
+
+    dual_nodes_in_elem = dual_elem_conn_array("dual_nodes_in_elem", rnum_elem, max_nodes_per_element);
+    {
+        host_elem_conn_array partitioned_nodes_in_elem = dual_nodes_in_elem.view_host();
+        const_host_elem_conn_array imported_nodes_in_elem = partitioned_nodes_in_elem_distributed->getLocalView<HostSpace>(Tpetra::Access::ReadOnly);
+        dual_nodes_in_elem.modify_host();
+        for (int ielem = 0; ielem < rnum_elem; ielem++)
+        {
+            for (int lnode = 0; lnode < max_nodes_per_element; lnode++)
+            {
+                partitioned_nodes_in_elem(ielem, lnode) = imported_nodes_in_elem(ielem, lnode);
+            }
+        }
+    }
+
+    // 1 type per mesh for now
+    Element_Types = CArrayKokkos<elements::elem_types::elem_type, array_layout, HostSpace, memory_traits>(rnum_elem);
+    for (int ielem = 0; ielem < rnum_elem; ielem++)
+    {
+        Element_Types(ielem) = mesh_element_type;
+    }
+
+    all_element_map = partitioned_element_map;
+}
+
 /* ----------------------------------------------------------------------
    Initialize Ghost and Non-Overlapping Element Maps
 ------------------------------------------------------------------------- */
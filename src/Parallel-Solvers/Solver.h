@@ -130,6 +130,11 @@ public:
 
     virtual void generate_mesh(const std::shared_ptr<MeshBuilderInput>& mesh_generation_options);
 
+    // coarse-to-fine design continuation between generated box meshes
+    void write_design_field(const std::string& file_name);
+
+    void prolongate_design_field(const std::string& file_name, host_vec_array node_densities);
+
     virtual void read_mesh_ensight(const char* MESH);
 
     virtual void init_design() {}
@@ -142,6 +147,11 @@ public:
 
     virtual void repartition_nodes();
 
+    virtual void partition_nodes(const std::vector<real_t>& node_weights);
+
+    // collect the elements around the nodes of a new node map
+    virtual void repartition_elements(Teuchos::RCP<Tpetra::Map<LO, GO, node_type>> previous_map);
+
     virtual void comm_importer_setup();
 
     virtual void comm_coordinates();